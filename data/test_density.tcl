@@ -0,0 +1,32 @@
+# compare binned (FFT) density estimate against exact estimate
+
+proc normal_values { n mean sigma } {
+  set values {}
+
+  for {set i 0} {$i < $n} {incr i} {
+    # Box-Muller
+    set u1 [expr {1.0 - rand()}]
+    set u2 [expr {rand()}]
+
+    lappend values [expr {$mean + $sigma*sqrt(-2.0*log($u1))*cos(2.0*3.14159265358979*$u2)}]
+  }
+
+  return $values
+}
+
+expr {srand(1)}
+
+# single peak
+set values1 [normal_values 5000 0.0 1.0]
+
+echo "normal: [test_charts_density -values $values1 -tolerance 0.001]"
+
+# two peaks with different spreads
+set values2 [concat [normal_values 3000 -5.0 0.5] [normal_values 2000 3.0 2.0]]
+
+echo "bimodal: [test_charts_density -values $values2 -tolerance 0.001]"
+
+# small number of values
+set values3 [normal_values 50 10.0 3.0]
+
+echo "small: [test_charts_density -values $values3 -tolerance 0.001]"
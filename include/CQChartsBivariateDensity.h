@@ -7,6 +7,14 @@
 class CQChartsPlot;
 class CQChartsPaintDevice;
 
+/*!
+ * \brief Bivariate density map
+ * \ingroup Charts
+ *
+ * The density is estimated on a fixed grid in data space using a binned gaussian
+ * kernel density estimate (normalized to a maximum of 1). The grid can be calculated
+ * once and cached so drawing only resamples and color maps the grid values.
+ */
 class CQChartsBivariateDensity {
  public:
   using Values = std::vector<CQChartsGeom::Point>;
@@ -19,10 +27,33 @@ class CQChartsBivariateDensity {
     CQChartsGeom::RMinMax yrange;
   };
 
+  //! density values at grid points in data space
+  struct Grid {
+    using Reals = std::vector<float>;
+
+    int                   nx { 0 }; //!< number of x grid points
+    int                   ny { 0 }; //!< number of y grid points
+    CQChartsGeom::RMinMax xrange;   //!< x data range
+    CQChartsGeom::RMinMax yrange;   //!< y data range
+    Reals                 values;   //!< normalized density values (row major)
+
+    bool isValid() const { return (nx > 1 && ny > 1); }
+
+    //! get interpolated value at data point
+    double value(double x, double y) const;
+  };
+
  public:
   CQChartsBivariateDensity() { }
 
+  //! calc density grid for values
+  static void calcGrid(const Values &values, const CQChartsGeom::RMinMax &xrange,
+                       const CQChartsGeom::RMinMax &yrange, Grid &grid, int gridPoints=128);
+
   void draw(const CQChartsPlot *plot, CQChartsPaintDevice *device, const Data &data);
+
+  void draw(const CQChartsPlot *plot, CQChartsPaintDevice *device, const Grid &grid,
+            int gridSize, double delta);
 };
 
 #endif
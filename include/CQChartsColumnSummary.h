@@ -0,0 +1,116 @@
+#ifndef CQChartsColumnSummary_H
+#define CQChartsColumnSummary_H
+
+#include <QVariant>
+#include <QString>
+#include <unordered_set>
+#include <vector>
+#include <random>
+#include <cstdint>
+
+/*!
+ * \brief Mergeable single pass summary statistics of column values
+ * \ingroup Charts
+ *
+ * Values are added to partial summaries (e.g. one per thread row range) which are
+ * merged in row order. Memory is independent of the number of values:
+ *  . count, mean and standard deviation use Welford's update and Chan's merge
+ *  . min/max and monotonic state are merged from range end points
+ *  . unique count is exact up to maxExactUnique values and then a HyperLogLog estimate
+ *  . median is calculated from a fixed size (mergeable) random sample, so is exact
+ *    up to sampleSize values and approximate after that
+ *
+ * Exact values are available from the model column details value set.
+ */
+class CQChartsColumnSummary {
+ public:
+  enum class Type {
+    NONE,
+    REAL,
+    STRING
+  };
+
+  static const int maxExactUnique = 4096; //!< max number of exact unique values
+  static const int sampleSize     = 4096; //!< median sample size
+
+ public:
+  CQChartsColumnSummary();
+
+  //! reset
+  void reset();
+
+  //! get value type
+  const Type &type() const { return type_; }
+
+  //! add real value (NaN is null)
+  void addReal(double r);
+
+  //! add string value
+  void addString(const QString &s);
+
+  //! add summary of values after this summary's values
+  void merge(const CQChartsColumnSummary &summary);
+
+  //! get number of (non-null) values
+  long count() const { return n_; }
+
+  //! get number of null values
+  long numNull() const { return numNull_; }
+
+  //! get min/max values (real or string)
+  QVariant minValue() const;
+  QVariant maxValue() const;
+
+  //! get mean and (population) standard deviation (real only)
+  double mean  () const { return mean_; }
+  double stddev() const;
+
+  //! get if values are monotonic and if increasing
+  bool isMonotonic () const { return monotonicSet_ && monotonic_; }
+  bool isIncreasing() const { return increasing_; }
+
+  //! get number of unique values (and if exact)
+  long numUnique() const;
+  bool isUniqueExact() const { return registers_.empty(); }
+
+  //! get median value (real only) and if exact
+  double median() const;
+  bool isMedianExact() const { return n_ <= long(sample_.size()); }
+
+ private:
+  using Hashes    = std::unordered_set<uint64_t>;
+  using Registers = std::vector<uint8_t>;
+  using Reals     = std::vector<double>;
+
+  void addHash(uint64_t h);
+  void addRegister(uint64_t h);
+  void toRegisters();
+
+  void addSample(double r);
+
+  void addMonotonic(int cmp);
+
+ private:
+  Type         type_         { Type::NONE }; //!< value type
+  long         n_            { 0 };          //!< number of values
+  long         numNull_      { 0 };          //!< number of null values
+  double       mean_         { 0.0 };        //!< running mean
+  double       m2_           { 0.0 };        //!< running sum of squared differences
+  double       rmin_         { 0.0 };        //!< real min
+  double       rmax_         { 0.0 };        //!< real max
+  double       rfirst_       { 0.0 };        //!< first real value
+  double       rlast_        { 0.0 };        //!< last real value
+  QString      smin_;                        //!< string min
+  QString      smax_;                        //!< string max
+  QString      sfirst_;                      //!< first string value
+  QString      slast_;                       //!< last string value
+  bool         monotonicSet_ { false };      //!< monotonic direction known
+  bool         monotonic_    { true };       //!< values are monotonic
+  bool         increasing_   { true };       //!< values are increasing
+  Hashes       hashes_;                      //!< exact unique value hashes
+  Registers    registers_;                   //!< HyperLogLog registers (if not exact)
+  Reals        sample_;                      //!< median sample
+  std::mt19937 rand_;                        //!< sample random generator
+};
+
+#endif
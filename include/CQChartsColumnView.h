@@ -0,0 +1,60 @@
+#ifndef CQChartsColumnView_H
+#define CQChartsColumnView_H
+
+#include <CQChartsColumn.h>
+#include <vector>
+
+class CQCharts;
+class QAbstractItemModel;
+
+/*!
+ * \brief Cached real values for a (root) model column
+ * \ingroup Charts
+ *
+ * Values are read once through the model (so after filter and expression
+ * mapping) and stored in a contiguous array with a valid flag per row.
+ */
+class CQChartsColumnView {
+ public:
+  using Reals = std::vector<double>;
+  using Valid = std::vector<bool>;
+
+ public:
+  CQChartsColumnView(CQCharts *charts, const QAbstractItemModel *model,
+                     const CQChartsColumn &column);
+
+  //! get column
+  const CQChartsColumn &column() const { return column_; }
+
+  //! get number of rows
+  int numRows() const { return int(values_.size()); }
+
+  //! get number of valid (non-null) values
+  int numValid() const { return numValid_; }
+
+  //! get raw values array (invalid values are zero)
+  const double *data() const { return values_.data(); }
+
+  //! get if row value is valid (not null)
+  bool isValid(int row) const { return valid_[row]; }
+
+  //! get row value
+  double value(int row, bool &ok) const {
+    if (row < 0 || row >= numRows()) { ok = false; return 0.0; }
+
+    ok = valid_[row];
+
+    return values_[row];
+  }
+
+ private:
+  void init(CQCharts *charts, const QAbstractItemModel *model);
+
+ private:
+  CQChartsColumn column_;         //!< column
+  Reals          values_;         //!< row values
+  Valid          valid_;          //!< row value valid (null bitmap)
+  int            numValid_ { 0 }; //!< number of valid values
+};
+
+#endif
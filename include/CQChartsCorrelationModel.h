@@ -5,33 +5,51 @@
 #include <CQChartsFitData.h>
 #include <CQChartsDensity.h>
 #include <CQDataModel.h>
+#include <memory>
+#include <mutex>
+#include <list>
+#include <map>
 
 /*!
  * \brief Wrapper class for CQDataModel to remember correlation input data
  * \ingroup Charts
+ *
+ * Per cell points are not stored for each column pair. The shared column values are
+ * kept and the (downsampled) points and best fit for a cell are calculated on first
+ * access (when the cell is drawn). Points are sampled to the requested size (e.g. cell
+ * pixel size) and held in a least recently used cache bounded by total point count.
  */
 class CQChartsCorrelationModel : public CQDataModel {
  public:
-  using Points = std::vector<CQChartsGeom::Point>;
+  using Points        = std::vector<CQChartsGeom::Point>;
+  using Values        = std::vector<double>;
+  using ColumnValues  = std::vector<Values>;
+  using ColumnValuesP = std::shared_ptr<ColumnValues>;
+  using Columns       = std::vector<int>;
+  using Reals         = std::vector<double>;
+  using PointsP       = std::shared_ptr<const Points>;
+  using FitDataP      = std::shared_ptr<const CQChartsFitData>;
 
  public:
   CQChartsCorrelationModel(int numCols);
 
-  const Points &points(int i, int j) const {
-    auto pi = ijPoints_.find(i);
-    assert(pi != ijPoints_.end());
+  //---
 
-    auto pj = (*pi).second.find(j);
-    assert(pj != (*pi).second.end());
+  //! set column values and model column to values column map (for cell points)
+  void setColumnValues(const ColumnValuesP &columnValues, const Columns &columns);
 
-    return (*pj).second;
-  }
+  //! get/set max number of points for cell (values are sampled if more)
+  int maxPoints() const { return maxPoints_; }
+  void setMaxPoints(int n);
 
-  void setPoints(int i, int j, const Points &points) {
-    ijPoints_[i][j] = points;
+  //! get/set max number of points held in cell points cache (least recently used evicted)
+  int maxCachePoints() const { return maxCachePoints_; }
+  void setMaxCachePoints(int n);
 
-    ijBestFit_[i][j].calc(points);
-  }
+  //---
+
+  //! get (cached) points for cell sampled to at most maxPoints (<= 0 for model max points)
+  PointsP points(int i, int j, int maxPoints=-1) const;
 
   const CQChartsGeom::RMinMax &minMax(int i) {
     auto p = iMinMax_.find(i);
@@ -59,15 +77,8 @@ class CQChartsCorrelationModel : public CQDataModel {
     ijDevData_[i][j] = DevData(x, y);
   }
 
-  CQChartsFitData &bestFit(int i, int j) {
-    auto pi = ijBestFit_.find(i);
-    assert(pi != ijBestFit_.end());
-
-    auto pj = (*pi).second.find(j);
-    assert(pj != (*pi).second.end());
-
-    return (*pj).second;
-  }
+  //! get (cached) best fit for cell (from model max points sample)
+  FitDataP bestFit(int i, int j) const;
 
   CQChartsDensity *density(int i) {
     auto p = iDensity_.find(i);
@@ -80,6 +91,18 @@ class CQChartsCorrelationModel : public CQDataModel {
     iDensity_[i] = densiy;
   }
 
+  //---
+
+  //! calc correlation matrix (n x n, row major) for column values in a single pass
+  //! over blocks of rows using centered co-moments
+  static void calcCorrelation(const ColumnValues &columnValues, Reals &corr,
+                              int numThreads=-1);
+
+ private:
+  void calcPoints(int i, int j, int maxPoints, Points &points) const;
+
+  void clearCache();
+
  private:
   struct DevData {
     double x { 0.0 };
@@ -90,20 +113,45 @@ class CQChartsCorrelationModel : public CQDataModel {
     }
   };
 
-  using JPoints   = std::map<int,Points>;
-  using IJPoints  = std::map<int,JPoints>;
+  //! cell points cache key (cell and sample size)
+  struct PointsKey {
+    int i { 0 };
+    int j { 0 };
+    int n { 0 };
+
+    PointsKey(int i1, int j1, int n1) :
+     i(i1), j(j1), n(n1) {
+    }
+
+    friend bool operator<(const PointsKey &lhs, const PointsKey &rhs) {
+      if (lhs.i != rhs.i) return lhs.i < rhs.i;
+      if (lhs.j != rhs.j) return lhs.j < rhs.j;
+      return lhs.n < rhs.n;
+    }
+  };
+
+  using PointsEntry = std::pair<PointsKey,PointsP>;
+  using PointsLRU   = std::list<PointsEntry>;
+  using PointsMap   = std::map<PointsKey,PointsLRU::iterator>;
   using IMinMax   = std::map<int,CQChartsGeom::RMinMax>;
   using JDevData  = std::map<int,DevData>;
   using IJDevData = std::map<int,JDevData>;
-  using JBestFit  = std::map<int,CQChartsFitData>;
+  using JBestFit  = std::map<int,FitDataP>;
   using IJBestFit = std::map<int,JBestFit>;
   using IDensity  = std::map<int,CQChartsDensity *>;
 
-  IJPoints  ijPoints_;
-  IMinMax   iMinMax_;
-  IJDevData ijDevData_;
-  IJBestFit ijBestFit_;
-  IDensity  iDensity_;
+  IMinMax            iMinMax_;
+  IJDevData          ijDevData_;
+  IDensity           iDensity_;
+  ColumnValuesP      columnValues_;              //!< shared column values
+  Columns            columns_;                   //!< model column to values column
+  int                maxPoints_      { 10000 };  //!< max points per cell
+  int                maxCachePoints_ { 500000 }; //!< max cached points (all cells)
+  mutable std::mutex mutex_;                     //!< cache mutex (cells drawn in threads)
+  mutable PointsLRU  pointsLRU_;                 //!< cached points (most recent first)
+  mutable PointsMap  pointsMap_;                 //!< cached points lookup
+  mutable int        numCachePoints_ { 0 };      //!< number of cached points
+  mutable IJBestFit  ijBestFit_;                 //!< cached best fits
 };
 
 #endif
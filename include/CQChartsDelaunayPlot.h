@@ -34,6 +34,7 @@ class CQChartsDelaunayPlotType : public CQChartsPlotType {
 
 class CQChartsDelaunayPlot;
 class CQChartsDelaunay;
+class CQChartsSweepDelaunay;
 
 //---
 
@@ -108,6 +109,9 @@ class CQChartsDelaunayPlot : public CQChartsPlot,
   Q_PROPERTY(bool voronoiCircles READ isVoronoiCircles WRITE setVoronoiCircles)
   Q_PROPERTY(bool voronoiPolygon READ isVoronoiPolygon WRITE setVoronoiPolygon)
 
+  // algorithm
+  Q_PROPERTY(bool sweepHull READ isSweepHull WRITE setSweepHull)
+
   // delaunay lines
   CQCHARTS_NAMED_LINE_DATA_PROPERTIES (Delaunay, delaunay)
 
@@ -154,6 +158,12 @@ class CQChartsDelaunayPlot : public CQChartsPlot,
 
   //---
 
+  // use sweep hull (O(n log n)) algorithm instead of 3d hull
+  bool isSweepHull() const { return sweepHull_; }
+  void setSweepHull(bool b);
+
+  //---
+
   const QString &yname() const { return yname_; }
 
   //---
@@ -184,21 +194,50 @@ class CQChartsDelaunayPlot : public CQChartsPlot,
   void setVoronoi(bool b);
 
  private:
+  void calcGeomData();
+
   void drawDelaunay(CQChartsPaintDevice *device) const;
   void drawVoronoi (CQChartsPaintDevice *device) const;
 
  private:
-  CQChartsColumn        xColumn_;                    //!< x column
-  CQChartsColumn        yColumn_;                    //!< y column
-  CQChartsColumn        nameColumn_;                 //!< name column
-  CQChartsColumn        valueColumn_;                //!< value column
-  bool                  delaunay_       { false };   //!< is delaunay
-  bool                  voronoi_        { true };    //!< is voronoi
-  bool                  voronoiCircles_ { false };   //!< voronoi circle
-  bool                  voronoiPolygon_ { false };   //!< voronoi polygon
-  CQChartsGeom::RMinMax valueRange_;                 //!< value range
-  CQChartsDelaunay*     delaunayData_   { nullptr }; //!< delaunay data
-  QString               yname_;                      //!< y name
+  using Points   = std::vector<CQChartsGeom::Point>;
+  using Polygons = CQChartsGeom::Polygons;
+  using Reals    = std::vector<double>;
+
+  //! calculated delaunay/voronoi geometry (for draw)
+  struct GeomData {
+    Points   triangles;     //!< delaunay triangle points (3 per triangle)
+    Points   voronoiPoints; //!< voronoi points (triangle circle centers)
+    Reals    voronoiRadii;  //!< voronoi point circle radii
+    Points   voronoiEdges;  //!< voronoi edge points (2 per edge)
+    Polygons cellPolygons;  //!< voronoi polygon of each point
+    Reals    cellValues;    //!< value of each point
+
+    void clear() {
+      triangles    .clear();
+      voronoiPoints.clear();
+      voronoiRadii .clear();
+      voronoiEdges .clear();
+      cellPolygons .clear();
+      cellValues   .clear();
+    }
+  };
+
+ private:
+  CQChartsColumn         xColumn_;                    //!< x column
+  CQChartsColumn         yColumn_;                    //!< y column
+  CQChartsColumn         nameColumn_;                 //!< name column
+  CQChartsColumn         valueColumn_;                //!< value column
+  bool                   delaunay_       { false };   //!< is delaunay
+  bool                   voronoi_        { true };    //!< is voronoi
+  bool                   voronoiCircles_ { false };   //!< voronoi circle
+  bool                   voronoiPolygon_ { false };   //!< voronoi polygon
+  bool                   sweepHull_      { false };   //!< use sweep hull algorithm
+  CQChartsGeom::RMinMax  valueRange_;                 //!< value range
+  CQChartsDelaunay*      delaunayData_   { nullptr }; //!< 3d hull delaunay data
+  CQChartsSweepDelaunay* sweepData_      { nullptr }; //!< sweep hull delaunay data
+  GeomData               geomData_;                   //!< delaunay/voronoi geometry
+  QString                yname_;                      //!< y name
 };
 
 #endif
@@ -25,6 +25,7 @@ class CQChartsDensity : public QObject {
 
   Q_PROPERTY(int             numSamples      READ numSamples      WRITE setNumSamples     )
   Q_PROPERTY(double          smoothParameter READ smoothParameter WRITE setSmoothParameter)
+  Q_PROPERTY(int             binnedThreshold READ binnedThreshold WRITE setBinnedThreshold)
   Q_PROPERTY(DrawType        drawType        READ drawType        WRITE setDrawType       )
   Q_PROPERTY(Qt::Orientation orientation     READ orientation     WRITE setOrientation    )
 
@@ -62,6 +63,16 @@ class CQChartsDensity : public QObject {
   double smoothParameter() const { return smoothParameter_; }
   void setSmoothParameter(double r) { smoothParameter_ = r; invalidate(); }
 
+  //! number of values above which binned (FFT) estimation is used (<= 0 for always exact)
+  int binnedThreshold() const { return binnedThreshold_; }
+  void setBinnedThreshold(int i) { binnedThreshold_ = i; invalidate(); }
+
+  //! is binned estimation used
+  bool isBinned() const { constCalc(); return ! gridValues_.empty(); }
+
+  //! max difference of binned and exact estimate at n points, relative to max exact value
+  double binnedError(int n=1000) const;
+
   //---
 
   double xmin() const { constCalc(); return xmin_; }
@@ -135,7 +146,12 @@ class CQChartsDensity : public QObject {
   void constInit() const;
   void init();
 
+  double bandwidth() const;
+
+  void initGrid();
+
   double eval(double x) const;
+  double evalExact(double x) const;
 
  signals:
   void dataChanged();
@@ -147,6 +163,7 @@ class CQChartsDensity : public QObject {
   Points          opoints_;
   double          smoothParameter_  { -1.0 };
   int             numSamples_       { 100 };
+  int             binnedThreshold_  { 1000 };
   bool            initialized_      { false };
   bool            calced_           { false };
   int             nx_               { 0 };
@@ -168,6 +185,11 @@ class CQChartsDensity : public QObject {
   double          ymin1_            { 0.0 };
   double          ymax1_            { 0.0 };
   double          area_             { 1.0 };
+
+  // binned estimation data (density at grid points)
+  double          gridMin_          { 0.0 };
+  double          gridStep_         { 1.0 };
+  XVals           gridValues_;
 };
 
 #endif
@@ -0,0 +1,139 @@
+#ifndef CQChartsExprCompiler_H
+#define CQChartsExprCompiler_H
+
+#include <QVariant>
+#include <vector>
+
+/*!
+ * \brief Compile column expression to native evaluator
+ * \ingroup Charts
+ *
+ * Supports the common subset of tcl expressions used for expression columns:
+ * numbers, column values ($<name>, column(<n>)), row and column numbers (\@r, \@c),
+ * arithmetic, comparison and logical operators, ternary operator, tcl math functions
+ * and source functions (norm, scale, bucket, color, ...).
+ *
+ * The expression is compiled once to a list of stack operations which are applied to
+ * arrays of row values so each referenced column is read once per row and no tcl
+ * parsing, variable traces or command callbacks are needed.
+ *
+ * Rows which can't be evaluated natively (non-numeric values, divide by zero, domain
+ * errors, ...) are reported as failed so they can be evaluated (and errors reported) by tcl.
+ */
+class CQChartsExprCompiler {
+ public:
+  using Values  = std::vector<QVariant>;
+  using Bools   = std::vector<bool>;
+  using Columns = std::vector<int>;
+
+  //! expression data source
+  class Source {
+   public:
+    Source() { }
+
+    virtual ~Source() { }
+
+    //! get number of columns
+    virtual int numColumns() const = 0;
+
+    //! get current column (for \@c and $column)
+    virtual int currentColumn() const = 0;
+
+    //! get column for variable name (-1 if none)
+    virtual int nameColumn(const QString &name) const = 0;
+
+    //! get column value for row
+    virtual QVariant columnValue(int row, int column) const = 0;
+
+    //! is named function supported by source (column or callFunction)
+    virtual bool hasFunction(const QString &) const { return false; }
+
+    //! is named function defined by user (hides tcl math function)
+    virtual bool isCustomFunction(const QString &) const { return false; }
+
+    //! call source function for row
+    virtual QVariant callFunction(const QString &, int, const Values &) const {
+      return QVariant(); }
+  };
+
+ public:
+  CQChartsExprCompiler();
+
+  //! compile expression for source (returns false if not supported)
+  bool compile(const QString &expr, const Source &source);
+
+  //! get compiled expression
+  const QString &expr() const { return expr_; }
+
+  //! is expression compiled
+  bool isValid() const { return valid_; }
+
+  //! get columns referenced by expression
+  const Columns &columns() const { return columns_; }
+
+  //! evaluate for row (returns false if row needs tcl evaluation)
+  bool eval(const Source &source, int row, QVariant &value) const;
+
+  //! evaluate for rows [row1, row2) (oks false for rows which need tcl evaluation)
+  void evalRows(const Source &source, int row1, int row2, Values &values, Bools &oks) const;
+
+ private:
+  enum class OpType {
+    NUMBER,
+    COLUMN,
+    ROW,
+    CURRENT_COLUMN,
+    UNARY,
+    BINARY,
+    SELECT,
+    FUNCTION,
+    SOURCE_FUNCTION
+  };
+
+  //! source function argument (stack value, string literal or raw column value)
+  struct FunctionArg {
+    enum class Type {
+      VALUE,
+      STRING,
+      COLUMN
+    };
+
+    Type    type   { Type::VALUE }; //!< argument type
+    QString str;                    //!< string literal
+    int     column { -1 };          //!< column index
+  };
+
+  using FunctionArgs = std::vector<FunctionArg>;
+
+  struct Op {
+    OpType       type   { OpType::NUMBER }; //!< operation type
+    int          code   { 0 };              //!< operator or function
+    double       value  { 0.0 };            //!< constant value
+    bool         isInt  { false };          //!< constant is integer
+    int          column { -1 };             //!< column index
+    int          nargs  { 0 };              //!< number of stack args
+    QString      name;                      //!< source function name
+    FunctionArgs args;                      //!< source function args
+  };
+
+  using Ops = std::vector<Op>;
+
+  class Parser;
+
+  friend class Parser;
+
+ private:
+  void addOp(const Op &op);
+
+  int columnIndex(int column);
+
+ private:
+  QString expr_;                 //!< expression
+  bool    valid_     { false };  //!< is compiled
+  Ops     ops_;                  //!< stack operations
+  Columns columns_;              //!< referenced columns
+  int     depth_     { 0 };      //!< current stack depth
+  int     maxDepth_  { 0 };      //!< max stack depth
+};
+
+#endif
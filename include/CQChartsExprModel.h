@@ -9,9 +9,11 @@
 #include <set>
 #include <vector>
 #include <future>
+#include <memory>
 
 class CQChartsModelFilter;
 class CQChartsExprModelFn;
+class CQChartsExprCompiler;
 class CQChartsModelData;
 class CQChartsExprTcl;
 class CQChartsExprCmdValues;
@@ -64,6 +66,10 @@ class CQTcl;
  *   // time
  *   timeval : time value from column value
  *
+ * Expressions using the common subset of tcl expression syntax (arithmetic, math
+ * functions, column, norm, scale, bucket and color) are compiled and evaluated natively
+ * for all rows of an extra column, other expressions are evaluated by tcl.
+ *
  *  Supports variables:
  *    row        : current row
  *    column/col : current column
@@ -195,6 +201,7 @@ class CQChartsExprModel : public QAbstractProxyModel {
   using OptReal    = boost::optional<double>;
   using VariantMap = std::map<int,QVariant>;
   using Args       = std::vector<QString>;
+  using CompilerP  = std::shared_ptr<CQChartsExprCompiler>;
 
   struct ExtraColumn {
     QString               expr;                          //!< expression
@@ -206,6 +213,7 @@ class CQChartsExprModel : public QAbstractProxyModel {
     Values                values;                        //!< assign values
     Function              function   { Function::EVAL }; //!< current eval function
     std::atomic<bool>     evaluating { false };          //!< is evaluating column
+    CompilerP             compiler;                      //!< compiled expression
 
     ExtraColumn(const QString &expr, const QString &header="") :
      expr(expr), header(header) {
@@ -221,6 +229,7 @@ class CQChartsExprModel : public QAbstractProxyModel {
   using TclCmds = std::vector<CQChartsExprModelFn *>;
 
   friend class CQChartsExprModelFn;
+  friend class CQChartsExprModelSource;
 
  private:
   void addBuiltinFunctions();
@@ -239,6 +248,12 @@ class CQChartsExprModel : public QAbstractProxyModel {
 
   QVariant calcExtraColumnValue(int row, int column, int ecolumn, bool &rc);
 
+  void calcCompiledExtraColumn(int column, int ecolumn);
+
+  const CQChartsExprCompiler *extraColumnCompiler(int ecolumn);
+
+  void updateExtraColumnType(ExtraColumn &extraColumn, const QVariant &var);
+
   //---
 
   void initCalc();
@@ -1,19 +1,25 @@
 #ifndef CQChartsExprTcl_H
 #define CQChartsExprTcl_H
 
+#include <CQChartsExprCompiler.h>
 #include <CQTclUtil.h>
 #include <CMathUtil.h>
 
 #include <QAbstractItemModel>
+#include <memory>
+#include <mutex>
+#include <set>
 
 class CQChartsExprTcl : public CQTcl {
  public:
   CQChartsExprTcl(QAbstractItemModel *model=nullptr) :
-   model_(model) {
+   model_(model), compileSource_(this) {
   }
 
   const QAbstractItemModel *model() const { return model_; }
-  void setModel(QAbstractItemModel *p) { model_ = p; }
+  void setModel(QAbstractItemModel *p) {
+    if (p != model_) { model_ = p; resetCompiled(); }
+  }
 
   int row() const { return row_; }
   void setRow(int i) { row_ = i; }
@@ -35,6 +41,8 @@ class CQChartsExprTcl : public CQTcl {
     nameColumns_[name] = column;
 
     traceVar(name);
+
+    resetCompiled();
   }
 
   static QString encodeColumnName(const QString &name) {
@@ -66,7 +74,20 @@ class CQChartsExprTcl : public CQTcl {
     columnRoles_[column] = role;
   }
 
-  void resetColumns() { nameColumns_.clear(); columnRoles_.clear(); }
+  void resetColumns() { nameColumns_.clear(); columnRoles_.clear(); resetCompiled(); }
+
+  //! create expression function (recorded so compiled expressions don't hide it)
+  Tcl_Command createExprCommand(const QString &name, ObjCmdProc proc, ObjCmdData data) {
+    exprFunctions_.insert(name);
+
+    resetCompiled();
+
+    return CQTcl::createExprCommand(name, proc, data);
+  }
+
+  bool isExprFunction(const QString &name) const {
+    return (exprFunctions_.find(name) != exprFunctions_.end());
+  }
 
   void handleTrace(const char *name, int flags) override {
     if (flags & TCL_TRACE_READS)
@@ -85,6 +106,10 @@ class CQChartsExprTcl : public CQTcl {
   }
 
   void defineProc(const QString &name, const QString &args, const QString &body) {
+    exprFunctions_.insert(name);
+
+    resetCompiled();
+
     eval(QString("proc ::tcl::mathfunc::%1 {%2} {%3}").arg(name).arg(args).arg(body));
   }
 
@@ -117,31 +142,102 @@ class CQChartsExprTcl : public CQTcl {
     return true;
   }
 
+  //! evaluate expression using native compiled expression if supported (tcl if not)
+  bool evaluateCompiledExpression(const QString &expr, QVariant &value,
+                                  bool showError=false) const {
+    auto *th = const_cast<CQChartsExprTcl *>(this);
+
+    auto compiler = compiledExpression(expr);
+
+    if (compiler->isValid() && compiler->eval(compileSource_, row(), value)) {
+      th->setLastValue(value);
+
+      return true;
+    }
+
+    return evaluateExpression(expr, value, showError);
+  }
+
  private:
-  void setVar(const QString &name, int row, int column) {
-    int nameCol = (model_ ? nameColumn(name) : -1);
+  //! compiled expression source for model column values
+  class CompileSource : public CQChartsExprCompiler::Source {
+   public:
+    CompileSource(const CQChartsExprTcl *qtcl) :
+     qtcl_(qtcl) {
+    }
 
-    if      (nameCol >= 0) {
-      // get model value
-      QModelIndex parent; // TODO
+    int numColumns() const override {
+      return (qtcl_->model_ ? qtcl_->model_->columnCount() : 0); }
+
+    int currentColumn() const override { return qtcl_->column(); }
 
-      QModelIndex ind = model_->index(row, nameCol, parent);
+    int nameColumn(const QString &name) const override {
+      return (qtcl_->model_ ? qtcl_->nameColumn(name) : -1); }
 
-      QVariant var;
+    QVariant columnValue(int row, int column) const override {
+      return qtcl_->columnValue(row, column); }
 
-      auto pr = columnRoles_.find(column);
+    bool hasFunction(const QString &name) const override {
+      return (name == "column" && qtcl_->isExprFunction(name)); }
 
-      if (pr != columnRoles_.end())
-        var = model_->data(ind, (*pr).second);
+    bool isCustomFunction(const QString &name) const override {
+      return qtcl_->isExprFunction(name); }
 
-      if (! var.isValid())
-        var = model_->data(ind, Qt::EditRole);
+   private:
+    const CQChartsExprTcl* qtcl_ { nullptr };
+  };
 
-      if (! var.isValid())
-        var = model_->data(ind, Qt::DisplayRole);
+  using CompilerP = std::shared_ptr<CQChartsExprCompiler>;
 
-      // store value in column variable
-      createVar(name, var);
+  //! get cached compiled expression (compiled on first use)
+  CompilerP compiledExpression(const QString &expr) const {
+    std::unique_lock<std::mutex> lock(compiledMutex_);
+
+    auto &compiler = compiled_[expr];
+
+    if (! compiler) {
+      compiler = std::make_shared<CQChartsExprCompiler>();
+
+      (void) compiler->compile(expr, compileSource_);
+    }
+
+    return compiler;
+  }
+
+  void resetCompiled() {
+    std::unique_lock<std::mutex> lock(compiledMutex_);
+
+    compiled_.clear();
+  }
+
+  QVariant columnValue(int row, int nameCol) const {
+    // get model value
+    QModelIndex parent; // TODO
+
+    QModelIndex ind = model_->index(row, nameCol, parent);
+
+    QVariant var;
+
+    auto pr = columnRoles_.find(column());
+
+    if (pr != columnRoles_.end())
+      var = model_->data(ind, (*pr).second);
+
+    if (! var.isValid())
+      var = model_->data(ind, Qt::EditRole);
+
+    if (! var.isValid())
+      var = model_->data(ind, Qt::DisplayRole);
+
+    return var;
+  }
+
+  void setVar(const QString &name, int row, int column) {
+    int nameCol = (model_ ? nameColumn(name) : -1);
+
+    if      (nameCol >= 0) {
+      // store model value in column variable
+      createVar(name, columnValue(row, nameCol));
     }
     else if (name == "row" || name == "x") {
       createVar(name, row);
@@ -164,8 +260,10 @@ class CQChartsExprTcl : public CQTcl {
   }
 
  private:
-  using NameColumns = std::map<QString,int>;
-  using ColumnRoles = std::map<int,int>;
+  using NameColumns   = std::map<QString,int>;
+  using ColumnRoles   = std::map<int,int>;
+  using Compiled      = std::map<QString,CompilerP>;
+  using ExprFunctions = std::set<QString>;
 
   QAbstractItemModel *model_  { nullptr };
   int                 row_    { -1 };
@@ -173,6 +271,10 @@ class CQChartsExprTcl : public CQTcl {
   QVariant            lastValue_;
   NameColumns         nameColumns_;
   ColumnRoles         columnRoles_;
+  CompileSource       compileSource_;
+  mutable Compiled    compiled_;
+  mutable std::mutex  compiledMutex_;
+  ExprFunctions       exprFunctions_;
 };
 
 #endif
@@ -12,6 +12,8 @@ class CQChartsForceDirected {
   CQChartsForceDirected() {
     graph_  = new Springy::Graph;
     layout_ = new Springy::Layout(graph_, stiffness_, repulsion_, damping_);
+
+    initLayout();
   }
 
  ~CQChartsForceDirected() {
@@ -28,12 +30,23 @@ class CQChartsForceDirected {
   double damping() const { return damping_; }
   void setDamping(double r) { damping_ = r; }
 
+  bool isApproximate() const { return approximate_; }
+  void setApproximate(bool b) { approximate_ = b; layout_->setApproximate(b); }
+
+  double theta() const { return theta_; }
+  void setTheta(double r) { theta_ = r; layout_->setTheta(r); }
+
+  int numThreads() const { return numThreads_; }
+  void setNumThreads(int n) { numThreads_ = n; layout_->setNumThreads(n); }
+
   void reset() {
     delete graph_;
     delete layout_;
 
     graph_  = new Springy::Graph;
     layout_ = new Springy::Layout(graph_, stiffness_, repulsion_, damping_);
+
+    initLayout();
   }
 
   Springy::Node *newNode() {
@@ -77,10 +90,20 @@ class CQChartsForceDirected {
     layout_->calcRange(xmin, ymin, xmax, ymax);
   }
 
+ private:
+  void initLayout() {
+    layout_->setApproximate(approximate_);
+    layout_->setTheta      (theta_);
+    layout_->setNumThreads (numThreads_);
+  }
+
  private:
   double           stiffness_    { 400.0 };
   double           repulsion_    { 400.0 };
   double           damping_      { 0.5 };
+  bool             approximate_  { false };
+  double           theta_        { 0.5 };
+  int              numThreads_   { 1 };
   Springy::Graph*  graph_        { nullptr };
   Springy::Layout* layout_       { nullptr };
   Springy::Node*   currentNode_  { nullptr };
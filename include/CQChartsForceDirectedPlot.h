@@ -75,6 +75,11 @@ class CQChartsForceDirectedPlot : public CQChartsPlot,
   Q_PROPERTY(bool   running    READ isRunning  WRITE setRunning   )
   Q_PROPERTY(double nodeRadius READ nodeRadius WRITE setNodeRadius)
 
+  // repulsion
+  Q_PROPERTY(bool   approximate READ isApproximate WRITE setApproximate)
+  Q_PROPERTY(double theta       READ theta         WRITE setTheta      )
+  Q_PROPERTY(int    numThreads  READ numThreads    WRITE setNumThreads )
+
   // node stroke/fill
   CQCHARTS_NAMED_SHAPE_DATA_PROPERTIES(Node,node)
 
@@ -130,6 +135,18 @@ class CQChartsForceDirectedPlot : public CQChartsPlot,
   bool isEdgeLinesValueWidth() const { return edgeLinesValueWidth_; }
   void setEdgeLinesValueWidth(bool b);
 
+  // use Barnes-Hut approximation for node repulsion
+  bool isApproximate() const;
+  void setApproximate(bool b);
+
+  // Barnes-Hut accuracy (cell size to distance ratio)
+  double theta() const;
+  void setTheta(double r);
+
+  // number of threads used for node repulsion
+  int numThreads() const;
+  void setNumThreads(int n);
+
   //---
 
   bool isAnimated() const override { return true; }
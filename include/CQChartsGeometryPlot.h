@@ -6,6 +6,7 @@
 #include <CQChartsPlotObj.h>
 #include <CQChartsPath.h>
 #include <CQChartsStyle.h>
+#include <CQChartsPolygonPyramid.h>
 
 class CQChartsDataLabel;
 
@@ -108,6 +109,9 @@ class CQChartsGeometryObj : public CQChartsPlotObj {
   double value() const { return value_; }
   void setValue(double r) { value_ = r; hasValue_ = true; }
 
+  //! set simplified polygons (one for each polygon, shared with plot geometry)
+  void setPyramids(const CQChartsPolygonPyramidsP &pyramids) { pyramids_ = pyramids; }
+
   bool inside(const CQChartsGeom::Point &p) const override;
 
   void getSelectIndices(Indices &inds) const override;
@@ -129,6 +133,7 @@ class CQChartsGeometryObj : public CQChartsPlotObj {
  private:
   const CQChartsGeometryPlot* plot_     { nullptr }; //!< parent plot
   CQChartsGeom::Polygons      polygons_;             //!< geometry polygons
+  CQChartsPolygonPyramidsP    pyramids_;             //!< simplified geometry polygons
   QString                     name_;                 //!< geometry name
   CQChartsColor               color_;                //!< optional color
   CQChartsStyle               style_;                //!< optional style
@@ -165,6 +170,10 @@ class CQChartsGeometryPlot : public CQChartsPlot,
   // selectable
   Q_PROPERTY(bool geometrySelectable READ isGeometrySelectable WRITE setGeometrySelectable)
 
+  // simplify
+  Q_PROPERTY(bool   simplify          READ isSimplify        WRITE setSimplify         )
+  Q_PROPERTY(double simplifyTolerance READ simplifyTolerance WRITE setSimplifyTolerance)
+
   // shape
   CQCHARTS_SHAPE_DATA_PROPERTIES
 
@@ -181,13 +190,14 @@ class CQChartsGeometryPlot : public CQChartsPlot,
 
   //! geometry data
   struct Geometry {
-    QString                name;     //!< name
-    CQChartsGeom::Polygons polygons; //!< polygon list
-    OptReal                value;    //!< value
-    CQChartsColor          color;    //!< custom color
-    CQChartsStyle          style;    //!< custom style
-    CQChartsGeom::BBox     bbox;     //!< bounding box
-    QModelIndex            ind;      //!< associated model index
+    QString                  name;     //!< name
+    CQChartsGeom::Polygons   polygons; //!< polygon list
+    CQChartsPolygonPyramidsP pyramids; //!< simplified polygons
+    OptReal                  value;    //!< value
+    CQChartsColor            color;    //!< custom color
+    CQChartsStyle            style;    //!< custom style
+    CQChartsGeom::BBox       bbox;     //!< bounding box
+    QModelIndex              ind;      //!< associated model index
   };
 
  public:
@@ -235,6 +245,15 @@ class CQChartsGeometryPlot : public CQChartsPlot,
 
   //---
 
+  // simplify polygons when drawn (tolerance in pixels)
+  bool isSimplify() const { return simplify_; }
+  void setSimplify(bool b);
+
+  double simplifyTolerance() const { return simplifyTolerance_; }
+  void setSimplifyTolerance(double r);
+
+  //---
+
   // balloon min/max size
   double minBalloonSize() const { return minBalloonSize_; }
   void setMinBalloonSize(double r) { minBalloonSize_ = r; }
@@ -277,6 +296,8 @@ class CQChartsGeometryPlot : public CQChartsPlot,
 
   bool decodeGeometry(const QString &geomStr, CQChartsGeom::Polygons &polygons) const;
 
+  void calcPyramids();
+
  private:
   using Geometries = std::vector<Geometry>;
 
@@ -301,6 +322,10 @@ class CQChartsGeometryPlot : public CQChartsPlot,
   // selectable
   bool geometrySelectable_ { true }; //!< is geometry object selectable
 
+  // simplify
+  bool   simplify_          { true }; //!< simplify polygons when drawn
+  double simplifyTolerance_ { 1.0 };  //!< simplify tolerance (pixels)
+
   // balloon
   double minBalloonSize_ { 0.01 }; //!< min balloon size (fraction of height)
   double maxBalloonSize_ { 0.25 }; //!< max balloon size (fraction of height)
@@ -3,6 +3,7 @@
 
 #include <CQChartsHierPlot.h>
 #include <CQChartsPlotObj.h>
+#include <CQChartsHierBuilder.h>
 #include <CQChartsCirclePack.h>
 #include <CQChartsDisplayRange.h>
 #include <CQChartsData.h>
@@ -45,6 +46,7 @@ class CQChartsHierBubblePlotType : public CQChartsHierPlotType {
 
 class CQChartsHierBubblePlot;
 class CQChartsHierBubbleHierNode;
+class CQChartsHierBuilder;
 
 /*!
  * \brief Hierarchical Bubble Plot Node
@@ -78,7 +80,7 @@ class CQChartsHierBubbleNode : public CQChartsCircleNode {
   virtual const QString &name() const { return name_; }
 
   virtual double size() const { return size_; }
-  virtual void setSize(double s) { size_ = s; }
+  virtual void setSize(double s);
 
   virtual double radius() const override { return r_; }
   virtual void setRadius(double r) { r_ = r; }
@@ -177,8 +179,14 @@ class CQChartsHierBubbleHierNode : public CQChartsHierBubbleNode {
 
   //---
 
+  void setSize(double s) override;
+
+  //! get size of node and all child nodes (cached)
   double hierSize() const override;
 
+  //! invalidate cached size of node and parents
+  void invalidateHierSize();
+
   //---
 
   bool hasNodes() const { return ! nodes_.empty(); }
@@ -203,11 +211,12 @@ class CQChartsHierBubbleHierNode : public CQChartsHierBubbleNode {
                      const ColorInd &colorInd, int n) const override;
 
  protected:
-  Nodes    nodes_;             //!< child nodes
-  Pack     pack_;              //!< circle pack
-  Children children_;          //!< child hier nodes
-  int      hierInd_  { -1 };   //!< hier index
-  bool     expanded_ { true }; //!< is expanded
+  Nodes            nodes_;             //!< child nodes
+  Pack             pack_;              //!< circle pack
+  Children         children_;          //!< child hier nodes
+  int              hierInd_  { -1 };   //!< hier index
+  bool             expanded_ { true }; //!< is expanded
+  CQChartsHierSize hierSize_;          //!< cached hier size
 };
 
 //---
@@ -460,10 +469,18 @@ class CQChartsHierBubblePlot : public CQChartsHierPlot,
   CQChartsHierBubbleNode *addNode(CQChartsHierBubbleHierNode *parent, const QString &name,
                                   double size, const QModelIndex &nameInd) const;
 
+  //! flat model row data (path and size are added to hier builder)
+  struct FlatRowData {
+    QModelIndex   ind;   //!< node model index
+    CQChartsColor color; //!< node color
+  };
+
+  using FlatRows = std::vector<FlatRowData>;
+
   void loadFlat() const;
 
-  CQChartsHierBubbleNode *addNode(const QStringList &nameStrs, double size,
-                                  const QModelIndex &nameInd) const;
+  void addFlatNodes(const CQChartsHierBuilder &builder, const FlatRows &flatRows, int ind,
+                    CQChartsHierBubbleHierNode *parent) const;
 
   void addExtraNodes(CQChartsHierBubbleHierNode *hier) const;
 
@@ -471,8 +488,6 @@ class CQChartsHierBubblePlot : public CQChartsHierPlot,
 
   CQChartsHierBubbleHierNode *childHierNode(CQChartsHierBubbleHierNode *parent,
                                             const QString &name) const;
-  CQChartsHierBubbleNode *childNode(CQChartsHierBubbleHierNode *parent,
-                                    const QString &name) const;
 
   //---
 
@@ -0,0 +1,181 @@
+#ifndef CQChartsHierBuilder_H
+#define CQChartsHierBuilder_H
+
+#include <QStringList>
+#include <QHash>
+#include <algorithm>
+#include <vector>
+#include <mutex>
+
+/*!
+ * \brief Build hierarchy from flat list of name paths
+ * \ingroup Charts
+ *
+ * Rows are added as name paths (e.g. from separated name columns) with a size.
+ * Path segments are interned to integer ids and the tree is built with hashed child
+ * lookup, in parallel for each top level branch.
+ *
+ * Nodes which are the end of a path are leaves, nodes which are a path prefix are
+ * hier nodes. A node can be both (a row for "a" and a row for "a/b") in which case
+ * the leaf size is used as the hier node's own size (see hierNodeSize) so plots can
+ * add it as a filler node.
+ *
+ * Used by tree map, sunburst and hier bubble plots to load flat models.
+ */
+class CQChartsHierBuilder {
+ public:
+  using Rows = std::vector<int>;
+
+  //! hierarchy node
+  struct Node {
+    int  name    { -1 }; //!< interned name id
+    int  parent  { -1 }; //!< parent node
+    int  depth   { 0 };  //!< depth (root is 0)
+    Rows children;       //!< child nodes (first use order)
+    int  hierRow { -1 }; //!< first row using node as path prefix
+    Rows leafRows;       //!< rows with path ending at node
+  };
+
+  using Nodes = std::vector<Node>;
+
+ public:
+  CQChartsHierBuilder();
+
+  //! get/set number of threads used for build
+  int numThreads() const { return numThreads_; }
+  void setNumThreads(int n) { numThreads_ = std::max(n, 1); }
+
+  //! clear rows and nodes
+  void clear();
+
+  //! add row path and size (returns row id or -1 if empty path)
+  int addRow(const QStringList &names, double size);
+
+  //! get number of rows
+  int numRows() const { return int(rowSizes_.size()); }
+
+  //! get row size
+  double rowSize(int row) const { return rowSizes_[row]; }
+
+  //! get row path length
+  int rowDepth(int row) const { return rowStarts_[row + 1] - rowStarts_[row]; }
+
+  //! build tree from added rows
+  void build();
+
+  //! get root node id
+  int root() const { return 0; }
+
+  //! get node
+  const Node &node(int i) const { return nodes_[i]; }
+
+  //! get node name (not root)
+  const QString &nodeName(int i) const { return names_[nodes_[i].name]; }
+
+  //! is hier node (has children)
+  bool isHier(int i) const { return ! nodes_[i].children.empty(); }
+
+  //! get child hier nodes in creation order
+  Rows hierChildren(int i) const;
+
+  //! get child leaf nodes in creation order
+  Rows leafChildren(int i) const;
+
+  //! get leaf row which created hier node (-1 if none)
+  int hierLeafRow(int i) const;
+
+  //! get own size of hier node (size of leaf rows with same path)
+  double hierNodeSize(int i) const;
+
+ private:
+  using NameIds  = QHash<QString,int>;
+  using NameInds = std::vector<int>;
+  using Sizes    = std::vector<double>;
+
+  //! nodes of top level branch
+  struct Branch {
+    int   node { -1 }; //!< top level node
+    Rows  rows;        //!< branch rows
+    Nodes nodes;       //!< branch nodes (excluding top level node)
+  };
+
+  using Branches = std::vector<Branch>;
+
+  void buildBranch(Branch &branch);
+
+ private:
+  QStringList names_;            //!< interned names
+  NameIds     nameIds_;          //!< name ids
+  NameInds    rowNames_;         //!< name ids of all row paths
+  Rows        rowStarts_  { 0 }; //!< start of each row path in rowNames_
+  Sizes       rowSizes_;         //!< row sizes
+  Nodes       nodes_;            //!< tree nodes
+  int         numThreads_ { 1 }; //!< number of threads
+};
+
+//---
+
+/*!
+ * \brief Cached hierarchical size of tree node (own size plus child sizes)
+ * \ingroup Charts
+ *
+ * The size is calculated on demand and can be read from concurrent draw threads.
+ * The calculation runs outside the lock and its result is only stored if the size
+ * was not invalidated while calculating. Nodes invalidate themselves and all parents
+ * when their size or children change.
+ *
+ * Used by tree map, sunburst and hier bubble plot hier nodes.
+ */
+class CQChartsHierSize {
+ public:
+  CQChartsHierSize() { }
+
+  //! get size (calculated using fn if not valid)
+  template<typename FN>
+  double size(const FN &fn) const {
+    int generation = 0;
+
+    {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    if (valid_)
+      return size_;
+
+    generation = generation_;
+    }
+
+    double s = fn();
+
+    {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    if (generation == generation_) {
+      size_  = s;
+      valid_ = true;
+    }
+    }
+
+    return s;
+  }
+
+  //! invalidate size
+  void invalidate() {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    valid_ = false;
+
+    ++generation_;
+  }
+
+ private:
+  CQChartsHierSize(const CQChartsHierSize &) = delete;
+  CQChartsHierSize &operator=(const CQChartsHierSize &) = delete;
+
+ private:
+  mutable std::mutex mutex_;                //!< lock
+  mutable double     size_       { 0.0 };   //!< cached size
+  mutable bool       valid_      { false }; //!< is cached size valid
+  int                generation_ { 0 };     //!< invalidate count
+};
+
+#endif
@@ -22,6 +22,7 @@ struct CQChartsInputData {
   QStringList columns;                     //!< specific input column names/numbers
   int         numRows           { 100 };   //!< number of rows to generate with tcl expression
   int         maxRows           { -1 };    //!< maximum number of rows to read from file
+  bool        columnar          { false }; //!< store file data in typed columns
 
   FilterType  filterType { FilterType::SIMPLE }; //!< filter type
   QString     filter;                            //!< tcl expression filter
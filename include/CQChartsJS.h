@@ -577,6 +577,292 @@ namespace CQChartsJS {
     "}\n"
     "\n";
   }
+
+  void writeBufferProcs(std::ostream &os) {
+    // base64 chunked buffer
+    os <<
+    "function ChartsBuffer() {\n"
+    "  this.chunks = [];\n"
+    "  this.size   = 0;\n"
+    "}\n"
+    "\n";
+
+    os <<
+    "ChartsBuffer.prototype.add = function(s) {\n"
+    "  var b = atob(s);\n"
+    "  var n = b.length;\n"
+    "  var a = new Uint8Array(n);\n"
+    "  for (var i = 0; i < n; ++i)\n"
+    "    a[i] = b.charCodeAt(i);\n"
+    "  this.chunks.push(a);\n"
+    "  this.size += n;\n"
+    "}\n"
+    "\n";
+
+    os <<
+    "ChartsBuffer.prototype.data = function() {\n"
+    "  var a = new Uint8Array(this.size);\n"
+    "  var pos = 0;\n"
+    "  this.chunks.forEach(c => { a.set(c, pos); pos += c.length; });\n"
+    "  this.chunks = [];\n"
+    "  return a.buffer;\n"
+    "}\n"
+    "\n";
+
+    //---
+
+    // plot object buffers (see CQChartsScriptBufferPainter)
+    os <<
+    "function ChartsObjBuffers() {\n"
+    "  this.coordBuffer = new ChartsBuffer();\n"
+    "  this.cmdBuffer   = new ChartsBuffer();\n"
+    "  this.objBuffer   = new ChartsBuffer();\n"
+    "  this.strings     = [];\n"
+    "  this.styles      = [];\n"
+    "  this.images      = [];\n"
+    "  this.ox          = 0.0;\n"
+    "  this.oy          = 0.0;\n"
+    "  this.insideInd   = -1;\n"
+    "}\n"
+    "\n";
+
+    os <<
+    "ChartsObjBuffers.prototype.addCoords = function(s) { this.coordBuffer.add(s); }\n"
+    "ChartsObjBuffers.prototype.addCmds   = function(s) { this.cmdBuffer  .add(s); }\n"
+    "ChartsObjBuffers.prototype.addObjs   = function(s) { this.objBuffer  .add(s); }\n"
+    "\n"
+    "ChartsObjBuffers.prototype.addStrings = function(strs) {\n"
+    "  strs.forEach(s => this.strings.push(s));\n"
+    "}\n"
+    "\n"
+    "ChartsObjBuffers.prototype.addStyles = function(styles) {\n"
+    "  styles.forEach(s => this.styles.push(s));\n"
+    "}\n"
+    "\n";
+
+    os <<
+    "ChartsObjBuffers.prototype.finish = function() {\n"
+    "  this.coords  = new Float32Array(this.coordBuffer.data());\n"
+    "  this.cmds    = new Uint32Array (this.cmdBuffer  .data());\n"
+    "  this.objs    = new Uint32Array (this.objBuffer  .data());\n"
+    "  this.numCmds = this.cmds.length/4;\n"
+    "  this.numObjs = this.objs.length/9;\n"
+    "}\n"
+    "\n";
+
+    os <<
+    "ChartsObjBuffers.prototype.x = function(i) { return this.ox + this.coords[i]; }\n"
+    "ChartsObjBuffers.prototype.y = function(i) { return this.oy + this.coords[i]; }\n"
+    "\n"
+    "ChartsObjBuffers.prototype.px = function(i) { return charts.plotXToPixel(this.x(i)); }\n"
+    "ChartsObjBuffers.prototype.py = function(i) { return charts.plotYToPixel(this.y(i)); }\n"
+    "\n";
+
+    os <<
+    "ChartsObjBuffers.prototype.objId = function(io) {\n"
+    "  return this.strings[this.objs[9*io + 6]];\n"
+    "}\n"
+    "\n"
+    "ChartsObjBuffers.prototype.objTip = function(io) {\n"
+    "  return this.strings[this.objs[9*io + 7]];\n"
+    "}\n"
+    "\n";
+
+    //---
+
+    // draw procs
+    os <<
+    "ChartsObjBuffers.prototype.setStyle = function(s, io) {\n"
+    "  var style = this.styles[s];\n"
+    "  var stroke = style[0];\n"
+    "  var fill   = style[1];\n"
+    "  if (io >= 0) {\n"
+    "    if (this.objs[9*io + 5])\n"
+    "      fill = \"rgb(255,0,0)\";\n"
+    "    else\n"
+    "      stroke = \"rgb(255,0,0)\";\n"
+    "  }\n"
+    "  charts.gc.strokeStyle = stroke;\n"
+    "  charts.gc.fillStyle   = fill;\n"
+    "  charts.gc.lineWidth   = style[2];\n"
+    "}\n"
+    "\n";
+
+    os <<
+    "ChartsObjBuffers.prototype.addPoly = function(o, n) {\n"
+    "  charts.gc.beginPath();\n"
+    "  for (var i = 0; i < n; ++i) {\n"
+    "    var px = this.px(o + 2*i    );\n"
+    "    var py = this.py(o + 2*i + 1);\n"
+    "    if (i == 0)\n"
+    "      charts.gc.moveTo(px, py);\n"
+    "    else\n"
+    "      charts.gc.lineTo(px, py);\n"
+    "  }\n"
+    "}\n"
+    "\n";
+
+    os <<
+    "ChartsObjBuffers.prototype.addPath = function(o, n) {\n"
+    "  charts.gc.beginPath();\n"
+    "  for (var i = 0; i < n; ++i) {\n"
+    "    var j = o + 3*i;\n"
+    "    var t = this.coords[j];\n"
+    "    if      (t == 0)\n"
+    "      charts.gc.moveTo(this.px(j + 1), this.py(j + 2));\n"
+    "    else if (t == 1)\n"
+    "      charts.gc.lineTo(this.px(j + 1), this.py(j + 2));\n"
+    "    else if (t == 2 && i < n - 2) {\n"
+    "      charts.gc.bezierCurveTo(this.px(j + 1), this.py(j + 2),\n"
+    "                              this.px(j + 4), this.py(j + 5),\n"
+    "                              this.px(j + 7), this.py(j + 8));\n"
+    "      i += 2;\n"
+    "    }\n"
+    "  }\n"
+    "}\n"
+    "\n";
+
+    os <<
+    "ChartsObjBuffers.prototype.drawImage = function(o, n) {\n"
+    "  if (! this.images[n]) {\n"
+    "    this.images[n] = new Image();\n"
+    "    this.images[n].src = this.strings[n];\n"
+    "  }\n"
+    "  charts.gc.drawImage(this.images[n], this.px(o), this.py(o + 1));\n"
+    "}\n"
+    "\n";
+
+    os <<
+    "ChartsObjBuffers.prototype.draw = function() {\n"
+    "  var gc = charts.gc;\n"
+    "  var io = 0;\n"
+    "  var lastStyle = -1, lastInside = -1;\n"
+    "  for (var i = 0; i < this.numCmds; ++i) {\n"
+    "    var t = this.cmds[4*i    ];\n"
+    "    var s = this.cmds[4*i + 1];\n"
+    "    var o = this.cmds[4*i + 2];\n"
+    "    var n = this.cmds[4*i + 3];\n"
+    "\n"
+    "    // highlight commands of inside object\n"
+    "    while (io < this.numObjs && this.objs[9*io + 1] <= i) ++io;\n"
+    "    var inside = (io < this.numObjs && this.objs[9*io] <= i &&\n"
+    "                  io == this.insideInd ? io : -1);\n"
+    "    if (s != lastStyle || inside != lastInside) {\n"
+    "      this.setStyle(s, inside);\n"
+    "      lastStyle  = s;\n"
+    "      lastInside = inside;\n"
+    "    }\n"
+    "\n"
+    "    switch (t) {\n"
+    "      case 0: charts.drawRect(this.x(o), this.y(o + 1), this.x(o + 2), this.y(o + 3)); break;\n"
+    "      case 1: charts.fillRect(this.x(o), this.y(o + 1), this.x(o + 2), this.y(o + 3)); break;\n"
+    "      case 2: charts.drawEllipse(this.x(o), this.y(o + 1), this.x(o + 2), this.y(o + 3)); break;\n"
+    "      case 3: this.addPoly(o, n); gc.closePath(); gc.fill(); gc.stroke(); break;\n"
+    "      case 4: this.addPoly(o, n); gc.stroke(); break;\n"
+    "      case 5: charts.drawLine(this.x(o), this.y(o + 1), this.x(o + 2), this.y(o + 3)); break;\n"
+    "      case 6: charts.drawPoint(this.x(o), this.y(o + 1)); break;\n"
+    "      case 7: this.addPath(o, n); gc.fill(); break;\n"
+    "      case 8: this.addPath(o, n); gc.stroke(); break;\n"
+    "      case 9: this.addPath(o, n); gc.fill(); gc.stroke(); break;\n"
+    "      case 10: charts.drawText(this.x(o), this.y(o + 1), this.strings[n]); break;\n"
+    "      case 11: charts.drawRotatedText(this.x(o), this.y(o + 1), this.strings[n],\n"
+    "                                      this.coords[o + 2]); break;\n"
+    "      case 12: charts.setFont(this.coords[o]); break;\n"
+    "      case 13: this.drawImage(o, n); break;\n"
+    "      case 14: gc.save(); break;\n"
+    "      case 15: gc.restore(); lastStyle = -1; break;\n"
+    "      case 16: charts.setClipRect(this.x(o), this.y(o + 1), this.x(o + 2), this.y(o + 3));\n"
+    "               break;\n"
+    "      case 17: this.setRange(o); break;\n"
+    "    }\n"
+    "  }\n"
+    "}\n"
+    "\n";
+
+    //---
+
+    // inside procs
+    os <<
+    "ChartsObjBuffers.prototype.insidePoly = function(px, py, o, n) {\n"
+    "  var counter = 0;\n"
+    "  var i2 = n - 1;\n"
+    "  for (var i1 = 0; i1 < n; ++i1) {\n"
+    "    var px1 = this.px(o + 2*i1), py1 = this.py(o + 2*i1 + 1);\n"
+    "    var px2 = this.px(o + 2*i2), py2 = this.py(o + 2*i2 + 1);\n"
+    "    if (py > Math.min(py1, py2) && py <= Math.max(py1, py2) &&\n"
+    "        px <= Math.max(px1, px2) && py1 != py2) {\n"
+    "      var xinters = (py - py1)*(px2 - px1)/(py2 - py1) + px1;\n"
+    "      if (px1 == px2 || px <= xinters)\n"
+    "        ++counter;\n"
+    "    }\n"
+    "    i2 = i1;\n"
+    "  }\n"
+    "  return ((counter % 2) != 0);\n"
+    "}\n"
+    "\n";
+
+    os <<
+    "ChartsObjBuffers.prototype.insidePolyline = function(px, py, o, n) {\n"
+    "  for (var i = 1; i < n; ++i) {\n"
+    "    var px1 = this.px(o + 2*i - 2), py1 = this.py(o + 2*i - 1);\n"
+    "    var px2 = this.px(o + 2*i    ), py2 = this.py(o + 2*i + 1);\n"
+    "    if (charts.pixelPointLineDistance(px, py, px1, py1, px2, py2) < 3)\n"
+    "      return true;\n"
+    "  }\n"
+    "  return false;\n"
+    "}\n"
+    "\n";
+
+    os <<
+    "ChartsObjBuffers.prototype.setRange = function(o) {\n"
+    "  charts.xmin = this.x(o    ); charts.ymin = this.y(o + 1);\n"
+    "  charts.xmax = this.x(o + 2); charts.ymax = this.y(o + 3);\n"
+    "}\n"
+    "\n";
+
+    os <<
+    "ChartsObjBuffers.prototype.insideObj = function(px, py) {\n"
+    "  var c = this.coords;\n"
+    "  // objects are tested using plot range active when drawn\n"
+    "  var xmin = charts.xmin, ymin = charts.ymin, xmax = charts.xmax, ymax = charts.ymax;\n"
+    "  var range = -1;\n"
+    "  var ind = -1;\n"
+    "  for (var io = this.numObjs - 1; io >= 0; --io) {\n"
+    "    var r = this.objs[9*io + 8];\n"
+    "    if (r != range) {\n"
+    "      if (r != 0xffffffff)\n"
+    "        this.setRange(r);\n"
+    "      else {\n"
+    "        charts.xmin = xmin; charts.ymin = ymin; charts.xmax = xmax; charts.ymax = ymax;\n"
+    "      }\n"
+    "      range = r;\n"
+    "    }\n"
+    "    var shape = this.objs[9*io + 2];\n"
+    "    var o     = this.objs[9*io + 3];\n"
+    "    var n     = this.objs[9*io + 4];\n"
+    "    var inside = false;\n"
+    "    if      (shape == 0)\n"
+    "      inside = charts.pointInsideRect(px, py, this.x(o), this.y(o + 1),\n"
+    "                                      this.x(o + 2), this.y(o + 3));\n"
+    "    else if (shape == 1)\n"
+    "      inside = charts.pointInsideCircle(px, py, this.x(o), this.y(o + 1), c[o + 2]);\n"
+    "    else if (shape == 2)\n"
+    "      inside = this.insidePoly(px, py, o, n);\n"
+    "    else if (shape == 3)\n"
+    "      inside = this.insidePolyline(px, py, o, n);\n"
+    "    else if (shape == 4)\n"
+    "      inside = charts.pointInsideArc(px, py, { cx: this.x(o), cy: this.y(o + 1),\n"
+    "        ri: c[o + 2], ro: c[o + 3], a1: c[o + 4], a2: c[o + 5] });\n"
+    "    if (inside) {\n"
+    "      ind = io;\n"
+    "      break;\n"
+    "    }\n"
+    "  }\n"
+    "  charts.xmin = xmin; charts.ymin = ymin; charts.xmax = xmax; charts.ymax = ymax;\n"
+    "  return ind;\n"
+    "}\n"
+    "\n";
+  }
 };
 
 #endif
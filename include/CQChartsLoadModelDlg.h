@@ -19,6 +19,7 @@ class QRadioButton;
 class QCheckBox;
 class QTextBrowser;
 class QPushButton;
+class QProgressBar;
 
 /*!
  * \brief dialog to load new charts model
@@ -134,6 +135,9 @@ class CQChartsLoadModelDlg : public QDialog {
   CQTableWidget*    columnsTable_           { nullptr };
   QPushButton*      okButton_               { nullptr };
   QPushButton*      applyButton_            { nullptr };
+  QProgressBar*     progressBar_            { nullptr };
+  bool              loading_                { false };
+  bool              loadCancelled_          { false };
   int               previewLines_           { 100 };
   int               expressionRows_         { 100 };
   Lines             lines_;
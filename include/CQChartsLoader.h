@@ -3,6 +3,7 @@
 
 #include <CQChartsFileType.h>
 #include <QVariant>
+#include <functional>
 #include <vector>
 
 class CQCharts;
@@ -20,11 +21,17 @@ class QAbstractItemModel;
  * \ingroup Charts
  */
 class CQChartsLoader {
+ public:
+  //! load progress callback (percent complete, return false to cancel load)
+  using ProgressProc = std::function<bool(int)>;
+
  public:
   CQChartsLoader(CQCharts *charts);
 
   void setQtcl(CQTcl *qtcl);
 
+  void setProgressProc(const ProgressProc &proc) { progressProc_ = proc; }
+
   QAbstractItemModel *loadFile(const QString &filename, CQChartsFileType type,
                                const CQChartsInputData &inputData, bool &hierarchical);
 
@@ -44,9 +51,12 @@ class CQChartsLoader {
  private:
   void setFilter(CQChartsModelFilter *model, const CQChartsInputData &inputData);
 
+  bool loadFilter(const CQChartsInputData &inputData, QString &filter) const;
+
  private:
-  CQCharts* charts_ { nullptr };
-  CQTcl*    qtcl_   { nullptr };
+  CQCharts*    charts_ { nullptr };
+  CQTcl*       qtcl_   { nullptr };
+  ProgressProc progressProc_;
 };
 
 #endif
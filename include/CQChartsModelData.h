@@ -9,8 +9,10 @@
 #include <QItemSelection>
 #include <QPointer>
 #include <future>
+#include <memory>
 
 class CQChartsModelDetails;
+class CQChartsColumnView;
 class CQCharts;
 #ifdef CQCHARTS_FOLDED_MODEL
 class CQFoldedModel;
@@ -37,8 +39,9 @@ class CQChartsModelData : public QObject {
   Q_PROPERTY(int     currentColumn  READ currentColumn    WRITE setCurrentColumn )
 
  public:
-  using ModelP  = QSharedPointer<QAbstractItemModel>;
-  using Columns = std::vector<CQChartsColumn>;
+  using ModelP      = QSharedPointer<QAbstractItemModel>;
+  using Columns     = std::vector<CQChartsColumn>;
+  using ColumnViewP = std::shared_ptr<CQChartsColumnView>;
 
 #ifdef CQCHARTS_FOLDED_MODEL
   using FoldedModels = std::vector<CQFoldedModel *>;
@@ -133,6 +136,11 @@ class CQChartsModelData : public QObject {
 
   //---
 
+  // get cached real values for column (reset on model change)
+  ColumnViewP columnView(const CQChartsColumn &column) const;
+
+  //---
+
   ModelP currentModel() const;
 
   //---
@@ -226,6 +234,8 @@ class CQChartsModelData : public QObject {
 
   void connectModel(bool b);
 
+  void resetColumnViews();
+
  private slots:
   void modelDataChangedSlot(const QModelIndex &, const QModelIndex &);
 
@@ -261,6 +271,7 @@ class CQChartsModelData : public QObject {
  private:
   using SelectionModelP = QPointer<QItemSelectionModel>;
   using SelectionModels = std::vector<SelectionModelP>;
+  using ColumnViews     = std::map<CQChartsColumn,ColumnViewP>;
 
 #ifdef CQCHARTS_FOLDED_MODEL
   using ModelPArray = std::vector<ModelP>;
@@ -276,6 +287,10 @@ class CQChartsModelData : public QObject {
   // details
   CQChartsModelDetails* details_          { nullptr }; //!< model details
 
+  // column views
+  ColumnViews           columnViews_;                  //!< cached column views
+  mutable std::mutex    columnViewMutex_;              //!< column views mutex
+
   // selection models data
   SelectionModels       selectionModels_;              //!< selection models
 
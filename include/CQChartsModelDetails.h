@@ -5,6 +5,7 @@
 #include <CQChartsColumnType.h>
 #include <CQChartsModelTypes.h>
 #include <CQChartsUtil.h>
+#include <CQChartsColumnSummary.h>
 #include <future>
 
 class CQChartsModelColumnDetails;
@@ -40,6 +41,9 @@ class CQChartsModelDetails : public QObject {
   CQChartsModelColumnDetails *columnDetails(const CQChartsColumn &column);
   const CQChartsModelColumnDetails *columnDetails(const CQChartsColumn &column) const;
 
+  //! calc summary data for all columns in a single (multi-threaded) model traversal
+  void initColumnData() const;
+
   CQChartsColumns numericColumns() const;
 
   CQChartsColumns monotonicColumns() const;
@@ -187,6 +191,16 @@ class CQChartsModelColumnDetails {
 
   //---
 
+  //! get single pass summary (approximate unique count and median for large data)
+  //! (nullptr if column needs unmapped values)
+  const CQChartsColumnSummary *summary() const;
+
+  //! get summary min/max value (type custom min/max if defined)
+  QVariant summaryMinValue() const;
+  QVariant summaryMaxValue() const;
+
+  //---
+
   int preferredWidth() const { return preferredWidth_; }
   void setPreferredWidth(int w) { preferredWidth_ = w; }
 
@@ -205,13 +219,21 @@ class CQChartsModelColumnDetails {
 
   void initCache() const;
 
-  void resetTypeInitialized() { typeInitialized_ = false; }
+  void resetTypeInitialized() { typeInitialized_ = false; summaryInitialized_ = false; }
 
   const CQChartsColumnType *columnType() const;
 
  private:
+  friend class CQChartsModelDetails;
+
+  class DetailVisitor;
+
   bool initData();
 
+  bool isUnmappedType() const;
+
+  void setVisitorData(const DetailVisitor &visitor, int numRows);
+
   void initType() const;
   bool calcType();
 
@@ -223,6 +245,8 @@ class CQChartsModelColumnDetails {
 
   void addValue(const QVariant &value);
 
+  void addSummaryValue(CQChartsColumnSummary &summary, const QVariant &var) const;
+
   bool columnColor(const QVariant &var, CQChartsColor &color) const;
 
  private:
@@ -250,6 +274,10 @@ class CQChartsModelColumnDetails {
   CQChartsValueSet*     valueSet_        { nullptr }; //!< values
   VariantInds           valueInds_;                   //!< unique values
 
+  // cached summary data
+  bool                  summaryInitialized_ { false }; //!< is summary set
+  CQChartsColumnSummary summary_;                      //!< summary
+
   // table render data
   int                   preferredWidth_ { -1 };
   CQChartsColor         tableDrawColor_;
@@ -3,16 +3,19 @@
 
 #include <CQChartsRegExp.h>
 #include <CQChartsTypes.h>
+#include <CQModelSortRanks.h>
 
 #include <QObject>
 #include <QSortFilterProxyModel>
 
 #include <set>
 #include <future>
+#include <memory>
 #include <cassert>
 
 class CQCharts;
 class CQChartsModelExprMatch;
+class CQChartsExprCompiler;
 class QItemSelectionModel;
 
 /*!
@@ -23,6 +26,7 @@ class CQChartsModelFilterData {
  public:
   using ColumnFilterMap = std::map<int,CQChartsRegExp>;
   using Type            = CQChartsFilterModelType;
+  using CompilerP       = std::shared_ptr<CQChartsExprCompiler>;
 
  public:
   CQChartsModelFilterData() { }
@@ -61,6 +65,9 @@ class CQChartsModelFilterData {
   const QString &filterExpr() const { return filterExpr_; }
   void setFilterExpr(const QString &filter) { filterExpr_ = filter; }
 
+  const CompilerP &compiler() const { return compiler_; }
+  void setCompiler(const CompilerP &compiler) { compiler_ = compiler; }
+
   QString details() const {
     if      (type_ == Type::EXPRESSION) return filter_;
     else if (type_ == Type::REGEXP    ) return filter_;
@@ -77,6 +84,7 @@ class CQChartsModelFilterData {
   QModelIndexList filterRows_;                          //!< cached rows (for SELECTED)
   ColumnFilterMap columnFilterMap_;                     //!< column filters for SIMPLE
   QString         filterExpr_;                          //!< preprocessed filter for EXPRESSION
+  CompilerP       compiler_;                            //!< compiled filter for EXPRESSION
 };
 
 //------
@@ -154,6 +162,9 @@ class CQChartsModelFilter : public QSortFilterProxyModel {
   const Combine &filterCombine() const { return filterCombine_; }
   void setFilterCombine(const Combine &c);
 
+  //! set filter key column (recalcs cached row matches)
+  void setFilterKeyColumn(int column);
+
   //---
 
   QString filterDetails() const;
@@ -183,6 +194,17 @@ class CQChartsModelFilter : public QSortFilterProxyModel {
 
   void sort(int column, Qt::SortOrder order=Qt::AscendingOrder) override;
 
+  void sortColumns(const std::vector<int> &columns, Qt::SortOrder order=Qt::AscendingOrder);
+
+  //---
+
+  void setSourceModel(QAbstractItemModel *model) override;
+
+ protected slots:
+  void sourceDataChangedSlot(const QModelIndex &from, const QModelIndex &to);
+
+  void sourceRowsChangedSlot();
+
  protected:
   const CQChartsModelFilterData &currentFilterData() const {
     assert(! filterDatas_.empty());
@@ -210,20 +232,39 @@ class CQChartsModelFilter : public QSortFilterProxyModel {
 
   QString replaceNamedColumns(QAbstractItemModel *model, const QString &expr) const;
 
+  //---
+
+  using RowMatches = std::vector<unsigned char>;
+
+  void compileFilterData(CQChartsModelFilterData &filterData);
+
+  void calcRowMatches();
+
+  void calcRowMatches(int row1, int row2, RowMatches &matches) const;
+
+  void calcFilterRowMatches(const CQChartsModelFilterData &filterData,
+                            int row1, int row2, RowMatches &matches) const;
+
+  int keyColumn() const;
+
  protected:
   using IndexMatches = std::map<QModelIndex,bool>;
   using ExpandInds   = std::set<QModelIndex>;
 
   using FilterDatas = std::vector<CQChartsModelFilterData>;
 
-  CQCharts*               charts_         { nullptr };
-  CQChartsModelExprMatch* expr_           { nullptr };
-  QItemSelectionModel*    selectionModel_ { nullptr };
+  CQCharts*               charts_           { nullptr };
+  CQChartsModelExprMatch* expr_             { nullptr };
+  QItemSelectionModel*    selectionModel_   { nullptr };
   FilterDatas             filterDatas_;
-  Combine                 filterCombine_  { Combine::AND };
+  Combine                 filterCombine_    { Combine::AND };
   mutable IndexMatches    matches_;
   mutable ExpandInds      expand_;
-  bool                    mapping_        { true };
+  RowMatches              rowMatches_;
+  bool                    rowMatchesValid_  { false };
+  int                     rowMatchesColumn_ { -1 };
+  CQModelSortRanks        sortRanks_;
+  bool                    mapping_          { true };
   mutable std::mutex      mutex_;
 };
 
@@ -8,6 +8,7 @@
 
 class CQDataModel;
 class CQHierSepModel;
+class CQSummaryModel;
 class CQChartsColumn;
 
 class QSortFilterProxyModel;
@@ -111,6 +112,8 @@ CQDataModel *getDataModel(QAbstractItemModel *model);
 
 CQHierSepModel *getHierSepModel(QAbstractItemModel *model);
 
+CQSummaryModel *getSummaryModel(QAbstractItemModel *model);
+
 QSortFilterProxyModel *getSortFilterProxyModel(QAbstractItemModel *model);
 
 QAbstractItemModel *getBaseModel(QAbstractItemModel *model);
@@ -3,6 +3,7 @@
 
 #include <CQChartsPlot.h>
 #include <QPainter>
+#include <QHash>
 
 class CQChartsPaintDevice {
  public:
@@ -381,6 +382,148 @@ class CQChartsScriptPainter : public CQChartsHtmlPainter {
 
 //---
 
+/*!
+ * \brief Script painter which records drawing into typed buffers
+ * \ingroup Charts
+ *
+ * Draw calls are stored as commands (type, style, coord offset, count) in a Uint32 buffer
+ * referencing a Float32 coord buffer (positions relative to the origin), pen/brush
+ * combinations are stored in a style palette and text in a string table. Objects add
+ * their command range, inside shape, plot range and tip to an object buffer.
+ *
+ * Buffers are written to the output stream as base64 chunks when full (so memory use is
+ * bounded) and are drawn by the generic ChartsObjBuffers javascript renderer.
+ */
+class CQChartsScriptBufferPainter : public CQChartsScriptPainter {
+ public:
+  //! draw command
+  enum class Cmd {
+    RECT,
+    FILL_RECT,
+    ELLIPSE,
+    POLYGON,
+    POLYLINE,
+    LINE,
+    POINT,
+    FILL_PATH,
+    STROKE_PATH,
+    PATH,
+    TEXT,
+    ROTATED_TEXT,
+    FONT,
+    IMAGE,
+    SAVE,
+    RESTORE,
+    CLIP_RECT,
+    RANGE
+  };
+
+  //! object inside shape
+  enum class Shape {
+    RECT,
+    CIRCLE,
+    POLYGON,
+    POLYLINE,
+    ARC
+  };
+
+ public:
+  CQChartsScriptBufferPainter(CQChartsPlot *plot, std::ostream &os);
+
+  //! get/set coord origin
+  const CQChartsGeom::Point &origin() const { return origin_; }
+  void setOrigin(const CQChartsGeom::Point &p);
+
+  void save   () override;
+  void restore() override;
+
+  void setClipPath(const QPainterPath &path, Qt::ClipOperation operation) override;
+  void setClipRect(const CQChartsGeom::BBox &bbox, Qt::ClipOperation operation) override;
+
+  void setPen(const QPen &pen) override;
+
+  void setBrush(const QBrush &brush) override;
+
+  void fillPath  (const QPainterPath &path, const QBrush &brush) override;
+  void strokePath(const QPainterPath &path, const QPen &pen) override;
+  void drawPath  (const QPainterPath &path) override;
+
+  void fillRect(const CQChartsGeom::BBox &bbox, const QBrush &brush) override;
+  void drawRect(const CQChartsGeom::BBox &bbox) override;
+
+  void drawEllipse(const CQChartsGeom::BBox &bbox, const CQChartsAngle &a=CQChartsAngle()) override;
+
+  void drawPolygon (const CQChartsGeom::Polygon &poly) override;
+  void drawPolyline(const CQChartsGeom::Polygon &poly) override;
+
+  void drawLine(const CQChartsGeom::Point &p1, const CQChartsGeom::Point &p2) override;
+
+  void drawPoint(const CQChartsGeom::Point &p) override;
+
+  void drawText(const CQChartsGeom::Point &p, const QString &text) override;
+  void drawTransformedText(const CQChartsGeom::Point &p, const QString &text) override;
+
+  void drawImage(const CQChartsGeom::Point &, const QImage &) override;
+
+  void setFont(const QFont &f) override;
+
+  //! set plot range for following commands
+  void setRange(const CQChartsGeom::BBox &bbox);
+
+  //---
+
+  //! start/end object (commands between start and end are highlighted with object)
+  void startObj();
+  void endObj(const CQChartsPlotObj *obj);
+
+  //! write remaining buffer data
+  void flush();
+
+ private:
+  using Coords  = std::vector<float>;
+  using Inds    = std::vector<uint>;
+  using Strings = std::vector<QString>;
+  using Styles  = QHash<QString,int>;
+
+  void addCmd(const Cmd &cmd, int offset=0, int n=0);
+
+  void addCoord(double r);
+  void addPoint(const CQChartsGeom::Point &p);
+  void addBBox (const CQChartsGeom::BBox &bbox);
+
+  void addPathParts(const QPainterPath &path);
+
+  int addString(const QString &str);
+
+  int styleInd();
+
+  int coordPos() const { return coordBase_ + int(coords_.size()); }
+
+  void flushCoords ();
+  void flushCmds   ();
+  void flushObjs   ();
+  void flushStrings();
+  void flushStyles ();
+
+ private:
+  CQChartsGeom::Point origin_;                 //!< coord origin
+  Coords              coords_;                 //!< pending coords
+  int                 coordBase_   { 0 };      //!< offset of pending coords
+  Inds                cmds_;                   //!< pending commands
+  int                 numCmds_     { 0 };      //!< number of commands
+  Inds                objs_;                   //!< pending objects
+  int                 objCmdStart_ { 0 };      //!< current object first command
+  int                 rangeOffset_ { -1 };     //!< current range coord offset (-1 if none)
+  Strings             strings_;                //!< pending strings
+  int                 numStrings_  { 0 };      //!< number of strings
+  Styles              styles_;                 //!< style palette (key to index)
+  Strings             styleStrs_;              //!< pending style palette entries
+  int                 styleInd_    { 0 };      //!< current style
+  bool                styleValid_  { false };  //!< is current style valid
+};
+
+//---
+
 class CQChartsSVGPainter : public CQChartsHtmlPainter {
  public:
   CQChartsSVGPainter(CQChartsView *view, std::ostream &os);
@@ -303,6 +303,7 @@ class CQChartsPivotPlot : public CQChartsPlot,
     COUNT_UNIQUE,
     SUM,
     MEAN,
+    MEDIAN,
     MIN,
     MAX
   };
@@ -395,7 +396,7 @@ class CQChartsPivotPlot : public CQChartsPlot,
 
   std::vector<ValueType> valueTypes() const { return
     {{ ValueType::COUNT, ValueType::COUNT_UNIQUE, ValueType::SUM,
-       ValueType::MEAN, ValueType::MIN, ValueType::MAX }};
+       ValueType::MEAN, ValueType::MEDIAN, ValueType::MIN, ValueType::MAX }};
   };
 
   QString plotTypeName (const PlotType  &plotType ) const;
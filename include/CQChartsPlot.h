@@ -70,6 +70,8 @@ class CQChartsDisplayRange;
 class CQChartsValueSet;
 class CQChartsModelColumnDetails;
 class CQChartsModelData;
+class CQChartsColumnView;
+class CQChartsSymbolCache;
 class CQChartsEditHandles;
 class CQChartsTableTip;
 class CQChartsPoints;
@@ -255,6 +257,11 @@ class CQChartsPlot : public CQChartsObj,
   Q_PROPERTY(bool queueUpdate    READ isQueueUpdate  WRITE setQueueUpdate   )
   Q_PROPERTY(bool showBoxes      READ showBoxes      WRITE setShowBoxes     )
 
+  // symbol image cache
+  Q_PROPERTY(bool bufferSymbols     READ isBufferSymbols   WRITE setBufferSymbols)
+  Q_PROPERTY(int  symbolCacheHits   READ symbolCacheHits  )
+  Q_PROPERTY(int  symbolCacheMisses READ symbolCacheMisses)
+
   Q_ENUMS(ColorType)
 
  public:
@@ -411,6 +418,8 @@ class CQChartsPlot : public CQChartsObj,
 
   void writeScript(CQChartsScriptPainter *device) const;
 
+  void writeScriptBuffers(CQChartsScriptPainter *device) const;
+
   void writeScriptRange(CQChartsScriptPainter *device) const;
 
   void writeSVG(CQChartsSVGPainter *device) const;
@@ -603,6 +612,16 @@ class CQChartsPlot : public CQChartsObj,
 
   //---
 
+  //! get/set draw symbols using cached images
+  bool isBufferSymbols() const { return bufferSymbols_; }
+  void setBufferSymbols(bool b);
+
+  //! get symbol image cache hit/miss counts
+  int symbolCacheHits  () const;
+  int symbolCacheMisses() const;
+
+  //---
+
   // get/set bbox in view range
   const CQChartsGeom::BBox &viewBBox() const { return viewBBox_; }
   void setViewBBox(const CQChartsGeom::BBox &bbox);
@@ -912,6 +931,19 @@ class CQChartsPlot : public CQChartsObj,
 
   //---
 
+  using ColumnViewP = std::shared_ptr<CQChartsColumnView>;
+
+  // get cached real values for (root) column (null if not available for plot model)
+  ColumnViewP columnView(const CQChartsColumn &column) const;
+
+  // get real value from column view (falls back to model for hierarchical index)
+  double modelReal(const ColumnViewP &view, const CQChartsModelIndex &ind, bool &ok) const;
+
+  bool modelMappedReal(const ColumnViewP &view, const CQChartsModelIndex &ind,
+                       double &r, bool log, double def) const;
+
+  //---
+
   int getRowForId(const QString &id) const;
 
   QString idColumnString(int row, const QModelIndex &parent, bool &ok) const;
@@ -1403,6 +1435,8 @@ class CQChartsPlot : public CQChartsObj,
 
   virtual void clearPlotObjects();
 
+  void initRowObjIndex();
+
   bool updateInsideObjects(const CQChartsGeom::Point &w);
 
   CQChartsObj *insideObject() const;
@@ -1611,6 +1645,9 @@ class CQChartsPlot : public CQChartsObj,
 
   void addTipColumns(CQChartsTableTip &tableTip, const QModelIndex &ind) const;
 
+  // get text describing sampled rows (empty if not sampled)
+  QString sampleText() const;
+
   void resetObjTips();
 
   // handle rect select
@@ -1932,6 +1969,9 @@ class CQChartsPlot : public CQChartsObj,
 
   virtual bool objInsideBox(CQChartsPlotObj *plotObj, const CQChartsGeom::BBox &bbox) const;
 
+  //! can use object tree to find objects to draw (objects must be inside their rect)
+  virtual bool canCullDrawObjs() const { return cullDrawObjs_; }
+
   //---
 
   // draw axes on foreground
@@ -2019,8 +2059,9 @@ class CQChartsPlot : public CQChartsObj,
                   const CQChartsPenBrush &penBrush) const;
 #endif
 
-  void drawBufferedSymbol(QPainter *painter, const CQChartsGeom::Point &p,
-                          const CQChartsSymbol &symbol, double size) const;
+  void drawBufferedSymbol(CQChartsPaintDevice *device, QPainter *painter,
+                          const CQChartsGeom::Point &p, const CQChartsSymbol &symbol,
+                          double size) const;
 
   //---
 
@@ -2107,6 +2148,18 @@ class CQChartsPlot : public CQChartsObj,
   ColorInd calcColorInd(const CQChartsPlotObj *obj, const CQChartsKeyColorBox *keyBox,
                         const ColorInd &is, const ColorInd &ig, const ColorInd &iv) const;
 
+  //! calc color ind using point for x/y color value (for objects with multiple points)
+  ColorInd calcColorInd(const CQChartsPlotObj *obj, const CQChartsKeyColorBox *keyBox,
+                        const ColorInd &is, const ColorInd &ig, const ColorInd &iv,
+                        const CQChartsGeom::Point &p) const;
+
+ private:
+  ColorInd calcColorIndI(const CQChartsPlotObj *obj, const CQChartsKeyColorBox *keyBox,
+                         const ColorInd &is, const ColorInd &ig, const ColorInd &iv,
+                         const CQChartsGeom::Point *p) const;
+
+ public:
+
   //---
 
   bool checkColumns(const CQChartsColumns &columns, const QString &name,
@@ -2463,7 +2516,7 @@ class CQChartsPlot : public CQChartsObj,
 
  protected:
   using IdHidden        = std::map<int,bool>;
-  using Rows            = std::set<int>;
+  using Rows            = std::vector<bool>;
   using ColumnRows      = std::map<int,Rows>;
   using IndexColumnRows = std::map<QModelIndex,ColumnRows>;
 
@@ -2641,6 +2694,7 @@ class CQChartsPlot : public CQChartsObj,
   bool sequential_    { false }; //!< is sequential (non-threaded)
   bool queueUpdate_   { true };  //!< is queued update
   bool bufferSymbols_ { false }; //!< buffer symbols
+  bool cullDrawObjs_  { true };  //!< draw only objects in object tree touching display
   bool showBoxes_     { false }; //!< show debug boxes
   bool overview_      { false }; //!< is overview
 
@@ -2681,6 +2735,34 @@ class CQChartsPlot : public CQChartsObj,
 
   //---
 
+  //! model row to plot objects index (for model selection sync)
+  struct RowObjIndex {
+    //! object for select index column
+    struct Entry {
+      int column { -1 }; //!< select index column
+      int obj    { -1 }; //!< plot object index
+    };
+
+    using RowStart = std::vector<int>;
+    using Entries  = std::vector<Entry>;
+
+    //! entries sorted by row for parent
+    struct ParentRows {
+      RowStart rowStart; //!< first entry for row (num rows + 1)
+      Entries  entries;  //!< entries
+    };
+
+    using ParentRowsMap = std::map<QModelIndex,ParentRows>;
+
+    ParentRowsMap parentRows;        //!< rows per parent
+    int           numObjs { 0 };     //!< number of indexed objects
+    bool          valid   { false }; //!< is valid
+  };
+
+  RowObjIndex rowObjIndex_; //!< row to plot objects index
+
+  //---
+
   UpdateData  updateData_;  //!< update data
   MouseData   mouseData_;   //!< mouse event data
   AnimateData animateData_; //!< animation data
@@ -2697,6 +2779,7 @@ class CQChartsPlot : public CQChartsObj,
 
   // edit handles
   CQChartsEditHandles* editHandles_ { nullptr }; //!< edit controls
+  CQChartsSymbolCache* symbolCache_ { nullptr }; //!< symbol image cache
   bool                 editing_     { false };   //!< is editing
 
   // annotations
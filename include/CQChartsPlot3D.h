@@ -91,6 +91,8 @@ class CQChartsPlot3D : public CQChartsGroupPlot {
 
   bool objInsideBox(CQChartsPlotObj *, const CQChartsGeom::BBox &) const override { return true; }
 
+  bool canCullDrawObjs() const override { return false; }
+
  protected:
   struct Axis {
     enum class Dir {
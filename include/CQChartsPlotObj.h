@@ -137,6 +137,15 @@ class CQChartsPlotObj : public CQChartsObj {
       return r.overlaps(rect());
   }
 
+  // get object for single item at point (override if object contains multiple items)
+  virtual CQChartsPlotObj *detailObjAt(const CQChartsGeom::Point &) const { return nullptr; }
+
+  // set rect for select of item subset (override if object contains multiple items)
+  virtual void setSelectRect(const CQChartsGeom::BBox &, bool /*inside*/) { }
+
+  // set model indices for select of item subset (override if object contains multiple items)
+  virtual void setSelectIndices(const Indices &) { }
+
   //virtual void postResize() { }
 
   virtual void selectPress() { }
@@ -162,7 +171,7 @@ class CQChartsPlotObj : public CQChartsObj {
 
   bool getSelectIndices(const Indices &inds) const;
 
-  void addSelectIndices();
+  virtual void addSelectIndices();
 
   void getHierSelectIndices(Indices &inds) const;
 
@@ -1,18 +1,24 @@
 #ifndef CQChartsPlotObjTree_H
 #define CQChartsPlotObjTree_H
 
-#include <CQChartsQuadTree.h>
+#include <CQChartsRTree.h>
 #include <CQChartsGeom.h>
 #include <vector>
 #include <future>
+#include <atomic>
 
 class CQChartsPlot;
 class CQChartsPlotObj;
 class QPainter;
 
 /*!
- * \brief Charts Plot object quad tree
+ * \brief Charts Plot object spatial index
  * \ingroup Charts
+ *
+ * All plot objects with a rect are bulk loaded, with their draw order, into a single
+ * packed R-tree in a background thread. The tree is used for point/rect queries (visible
+ * objects), to find the objects to draw for the display rect (restoring draw order)
+ * and to find empty space (see findEmptyBBox).
  */
 class CQChartsPlotObjTree {
  public:
@@ -34,8 +40,13 @@ class CQChartsPlotObjTree {
   bool objectNearest(const CQChartsGeom::Point &p, double searchX, double searchY,
                      CQChartsPlotObj* &obj) const;
 
+  bool objectsToDraw(const CQChartsGeom::BBox &r, Objs &objs) const;
+
   bool isBusy() const { return busy_.load(); }
 
+  //! mark objects as changed (draw tree not used until objects are added again)
+  void invalidateObjects() { valid_.store(false); }
+
   CQChartsGeom::BBox findEmptyBBox(double w, double h) const;
 
   bool waitTree() const;
@@ -43,7 +54,17 @@ class CQChartsPlotObjTree {
   void draw(QPainter *painter);
 
  private:
-  using PlotObjTree       = CQChartsQuadTree<CQChartsPlotObj,CQChartsGeom::BBox>;
+  //! plot object with draw order
+  struct DrawObj {
+    CQChartsPlotObj*   obj { nullptr }; //!< plot object
+    int                ind { 0 };       //!< draw order
+    CQChartsGeom::BBox bbox;            //!< object rect
+
+    const CQChartsGeom::BBox &rect() const { return bbox; }
+  };
+
+  using DrawObjs          = std::vector<DrawObj>;
+  using PlotObjTree       = CQChartsRTree<DrawObj,CQChartsGeom::BBox>;
   using PlotObjTreeFuture = std::future<PlotObjTree*>;
 
  private:
@@ -55,10 +76,13 @@ class CQChartsPlotObjTree {
 
  private:
   CQChartsPlot*      plot_              { nullptr }; //!< parent plot
-  PlotObjTree*       plotObjTree_       { nullptr }; //!< object tree
+  PlotObjTree*       plotObjTree_       { nullptr }; //!< object tree (all objects with rect)
   PlotObjTreeFuture  plotObjTreeFuture_;             //!< future
+  DrawObjs           drawObjs_;                      //!< objects with rect (draw order)
+  DrawObjs           noRectDrawObjs_;                //!< objects without rect (draw order)
   bool               wait_              { false };   //!< wait for thread
   std::atomic<bool>  busy_              { false };   //!< busy flag
+  std::atomic<bool>  valid_             { false };   //!< draw tree matches plot objects
   std::atomic<bool>  interrupt_         { false };   //!< interrupt flag
 };
 
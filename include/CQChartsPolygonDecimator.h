@@ -0,0 +1,71 @@
+#ifndef CQChartsPolygonDecimator_H
+#define CQChartsPolygonDecimator_H
+
+#include <CQChartsGeom.h>
+#include <vector>
+
+/*!
+ * \brief Decimate polygon points to pixel columns
+ * \ingroup Charts
+ *
+ * Points are split into runs of monotonic x and for each pixel column of a run
+ * the first, last, min y and max y points are kept (M4). Drawing the kept points
+ * as lines gives the same pixels as drawing all points.
+ *
+ * Decimated points are cached for the most recently used pixel scales. Pixel columns
+ * are relative to x=0 so a cached level is reused when panning by whole pixels.
+ */
+class CQChartsPolygonDecimator {
+ public:
+  using Polygon = CQChartsGeom::Polygon;
+
+ public:
+  CQChartsPolygonDecimator(int maxLevels=4);
+
+  //! get/set max number of cached levels
+  int maxLevels() const { return maxLevels_; }
+  void setMaxLevels(int n) { maxLevels_ = std::max(n, 1); }
+
+  //! get/set min number of points to decimate
+  int minPoints() const { return minPoints_; }
+  void setMinPoints(int n) { minPoints_ = n; }
+
+  //! clear cached levels
+  void clear();
+
+  //! get decimated polygon for pixel mapping (px = scale*x + offset)
+  const Polygon &decimate(const Polygon &poly, double scale, double offset);
+
+  //! is polygon x increasing (valid after decimate)
+  bool isIncreasing() const { return increasing_; }
+
+  //! get range of decimated points touching x range (only valid for increasing x)
+  void xRange(const Polygon &poly, double xmin, double xmax, int &i1, int &i2) const;
+
+ private:
+  struct Level {
+    double  scale  { 0.0 };   //!< pixel scale
+    double  offset { 0.0 };   //!< pixel offset fraction
+    Polygon poly;             //!< decimated polygon
+    bool    full   { false }; //!< use full polygon
+    int     age    { 0 };     //!< last use
+  };
+
+  using Levels = std::vector<Level>;
+  using Bools  = std::vector<bool>;
+
+ private:
+  void initPoly(const Polygon &poly);
+
+  void calcLevel(const Polygon &poly, Level &level) const;
+
+ private:
+  int       maxLevels_  { 4 };     //!< max cached levels
+  int       minPoints_  { 1024 };  //!< min points to decimate
+  int       numPoints_  { -1 };    //!< number of polygon points
+  bool      increasing_ { false }; //!< is polygon x increasing
+  Levels    levels_;               //!< cached levels
+  int       age_        { 0 };     //!< use counter
+};
+
+#endif
@@ -56,6 +56,14 @@ class CQChartsPolygonList {
 
   //---
 
+  //! decode from binary (WKB polygon or multi polygon, rings are added to list)
+  bool fromBinary(const QByteArray &ba);
+
+  //! decode from hex encoded binary (WKB string as written by GIS databases and tools)
+  bool fromHexBinary(const QString &str);
+
+  //---
+
   friend bool operator==(const CQChartsPolygonList &lhs, const CQChartsPolygonList &rhs) {
     if (lhs.polygons_.size() != rhs.polygons_.size()) return false;
 
@@ -0,0 +1,60 @@
+#ifndef CQChartsPolygonPyramid_H
+#define CQChartsPolygonPyramid_H
+
+#include <CQChartsGeom.h>
+#include <memory>
+#include <vector>
+
+/*!
+ * \brief Multi-resolution simplification of polygon
+ * \ingroup Charts
+ *
+ * The effective area (Visvalingam-Whyatt) of each polygon point is calculated once and
+ * used to build a pyramid of simplified polygons, each level keeping about half the
+ * points of the previous level. Each level stores the largest effective area of the
+ * removed points so a level can be picked for a drawing tolerance (area of a pixel
+ * in window units).
+ *
+ * Level 0 is the original polygon. It is not copied into the pyramid, the caller passes
+ * a reference to it when a level is picked.
+ */
+class CQChartsPolygonPyramid {
+ public:
+  using Polygon = CQChartsGeom::Polygon;
+
+ public:
+  CQChartsPolygonPyramid() { }
+
+  explicit CQChartsPolygonPyramid(const Polygon &poly, int minPoints=8) {
+    init(poly, minPoints);
+  }
+
+  //! build levels for polygon (stop when level has less than minPoints points)
+  void init(const Polygon &poly, int minPoints=8);
+
+  //! get number of levels (including original polygon)
+  int numLevels() const { return int(levels_.size()) + 1; }
+
+  //! get coarsest polygon whose removed points have effective area less than tolerance
+  //! (poly is the original polygon the pyramid was built from)
+  const Polygon &simplified(const Polygon &poly, double areaTol) const;
+
+  //! get effective area of each point of polygon (original point order)
+  static void calcPointAreas(const Polygon &poly, std::vector<double> &areas);
+
+ private:
+  //! simplified polygon
+  struct Level {
+    Polygon poly;           //!< level polygon
+    double  maxArea { 0.0 }; //!< max effective area of removed points
+  };
+
+  using Levels = std::vector<Level>;
+
+  Levels levels_; //!< simplified levels (finest first)
+};
+
+using CQChartsPolygonPyramids  = std::vector<CQChartsPolygonPyramid>;
+using CQChartsPolygonPyramidsP = std::shared_ptr<const CQChartsPolygonPyramids>;
+
+#endif
@@ -0,0 +1,471 @@
+#ifndef CQChartsRTree_H
+#define CQChartsRTree_H
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <future>
+#include <vector>
+
+/*!
+ * static (bulk loaded) R-tree containing pointers to items of type DATA with an associated
+ * rect of type RECT
+ *
+ * the tree is built in one pass from the complete item array using Sort-Tile-Recursive (STR)
+ * packing: items are sorted by x center, cut into vertical slices and each slice sorted by
+ * y center, then consecutive runs are packed into full nodes. The same packing is applied
+ * to the nodes of each level until a single root node remains. Sorts are run in parallel
+ * for large arrays.
+ *
+ * item rects and nodes are stored in contiguous arrays (no per node allocation) and
+ * queries use an explicit stack.
+ *
+ * tree does not take ownership of data. The application must ensure elements are not
+ * deleted while in the tree and are deleted when required.
+ *
+ * DATA must support:
+ *   const RECT &rect = data->rect();
+ *
+ * RECT must support:
+ *   constructor RECT(l, b, r, t);
+ *
+ *   T l = rect.getXMin();
+ *   T b = rect.getYMin();
+ *   T r = rect.getXMax();
+ *   T t = rect.getYMax();
+ */
+template<typename DATA, typename RECT, typename T=double>
+class CQChartsRTree {
+ public:
+  using Datas    = std::vector<DATA*>;
+  using DataList = std::vector<DATA*>;
+
+ public:
+  CQChartsRTree() { }
+
+  // get/set number of threads used to build tree
+  int numThreads() const { return numThreads_; }
+  void setNumThreads(int n) { numThreads_ = std::max(n, 1); }
+
+  // get number of items
+  int numElements() const { return int(entries_.size()); }
+
+  bool isEmpty() const { return entries_.empty(); }
+
+  // get bounding rect of all items
+  RECT rect() const {
+    if (nodes_.empty()) return RECT();
+
+    const auto &box = nodes_.back().box;
+
+    return RECT(box.xmin, box.ymin, box.xmax, box.ymax);
+  }
+
+  //----------
+
+ public:
+  // reset tree
+  void reset() {
+    entries_.clear();
+    nodes_  .clear();
+
+    numLeafNodes_ = 0;
+  }
+
+  // build tree from data items (replaces current items)
+  void build(const Datas &datas) {
+    reset();
+
+    int n = int(datas.size());
+
+    if (n == 0)
+      return;
+
+    entries_.resize(n);
+
+    for (int i = 0; i < n; ++i) {
+      auto &entry = entries_[i];
+
+      const RECT &rect = datas[i]->rect();
+
+      entry.box.xmin = rect.getXMin();
+      entry.box.ymin = rect.getYMin();
+      entry.box.xmax = rect.getXMax();
+      entry.box.ymax = rect.getYMax();
+      entry.data     = datas[i];
+    }
+
+    //---
+
+    // pack items into leaf nodes
+    strSort(entries_);
+
+    Nodes level;
+
+    packLevel(entries_, level);
+
+    numLeafNodes_ = int(level.size());
+
+    // pack nodes of each level into parent nodes until single root
+    while (true) {
+      strSort(level);
+
+      int first = int(nodes_.size());
+
+      nodes_.insert(nodes_.end(), level.begin(), level.end());
+
+      if (level.size() == 1)
+        break;
+
+      Nodes parentLevel;
+
+      packLevel(level, parentLevel);
+
+      // child indices are relative to level start
+      for (auto &node : parentLevel)
+        node.first += first;
+
+      level.swap(parentLevel);
+    }
+  }
+
+  //-------
+
+ public:
+  // get data items touching the specified bounding rect
+  void dataTouchingRect(const RECT &rect, DataList &dataList) const {
+    dataList.clear();
+
+    addDataTouchingRect(rect, dataList);
+  }
+
+  void addDataTouchingRect(const RECT &rect, DataList &dataList) const {
+    Box box(rect);
+
+    auto nodeProc = [&](const Box &nbox) {
+      return overlaps(nbox, box);
+    };
+
+    auto entryProc = [&](const Entry &entry) {
+      if (overlaps(entry.box, box))
+        dataList.push_back(entry.data);
+    };
+
+    // if node completely inside, add all items
+    auto insideProc = [&](const Box &nbox) {
+      return inside(nbox, box);
+    };
+
+    search(nodeProc, entryProc, insideProc, dataList);
+  }
+
+  //-------
+
+ public:
+  // get data items inside the specified bounding rect
+  void dataInsideRect(const RECT &rect, DataList &dataList) const {
+    dataList.clear();
+
+    Box box(rect);
+
+    auto nodeProc = [&](const Box &nbox) {
+      return overlaps(nbox, box);
+    };
+
+    auto entryProc = [&](const Entry &entry) {
+      if (inside(entry.box, box))
+        dataList.push_back(entry.data);
+    };
+
+    auto insideProc = [&](const Box &nbox) {
+      return inside(nbox, box);
+    };
+
+    search(nodeProc, entryProc, insideProc, dataList);
+  }
+
+  //-------
+
+ public:
+  // get data items which have the specified point inside them
+  void dataAtPoint(T x, T y, DataList &dataList) const {
+    dataList.clear();
+
+    auto nodeProc = [&](const Box &nbox) {
+      return nbox.contains(x, y);
+    };
+
+    auto entryProc = [&](const Entry &entry) {
+      if (entry.box.contains(x, y))
+        dataList.push_back(entry.data);
+    };
+
+    auto insideProc = [&](const Box &) {
+      return false;
+    };
+
+    search(nodeProc, entryProc, insideProc, dataList);
+  }
+
+  //-------
+
+ public:
+  // process data items
+  template<typename PROC>
+  void process(PROC &proc) const {
+    for (const auto &entry : entries_)
+      proc(entry.data);
+  }
+
+  // process node rects (with number of child items/nodes) and item rects
+  template<typename PROC>
+  void processRect(PROC &proc) const {
+    for (const auto &node : nodes_)
+      proc(RECT(node.box.xmin, node.box.ymin, node.box.xmax, node.box.ymax), node.num);
+
+    for (const auto &entry : entries_)
+      proc(RECT(entry.box.xmin, entry.box.ymin, entry.box.xmax, entry.box.ymax), 0);
+  }
+
+ private:
+  //! bounding box
+  struct Box {
+    T xmin { 0 };
+    T ymin { 0 };
+    T xmax { 0 };
+    T ymax { 0 };
+
+    Box() { }
+
+    explicit Box(const RECT &rect) :
+     xmin(rect.getXMin()), ymin(rect.getYMin()), xmax(rect.getXMax()), ymax(rect.getYMax()) {
+    }
+
+    void add(const Box &box) {
+      xmin = std::min(xmin, box.xmin); ymin = std::min(ymin, box.ymin);
+      xmax = std::max(xmax, box.xmax); ymax = std::max(ymax, box.ymax);
+    }
+
+    bool contains(T x, T y) const {
+      return (x >= xmin && x <= xmax && y >= ymin && y <= ymax);
+    }
+
+    T xmid() const { return (xmin + xmax)/2; }
+    T ymid() const { return (ymin + ymax)/2; }
+  };
+
+  //! data item
+  struct Entry {
+    Box   box;              //!< item rect
+    DATA* data { nullptr }; //!< item data
+  };
+
+  //! tree node (children are items for leaf node, nodes otherwise)
+  struct Node {
+    Box box;         //!< bounding box of children
+    int first { 0 }; //!< first child index
+    int num   { 0 }; //!< number of children
+  };
+
+  using Entries = std::vector<Entry>;
+  using Nodes   = std::vector<Node>;
+
+  enum {
+    nodeSize        = 16,   //!< max children per node
+    minParallelSize = 16384 //!< min number of items for parallel sort
+  };
+
+ private:
+  // Sort-Tile-Recursive order (x slices sorted by y)
+  template<typename ITEM>
+  void strSort(std::vector<ITEM> &items) const {
+    int n = int(items.size());
+
+    if (n <= nodeSize)
+      return;
+
+    auto xcmp = [](const ITEM &lhs, const ITEM &rhs) { return lhs.box.xmid() < rhs.box.xmid(); };
+    auto ycmp = [](const ITEM &lhs, const ITEM &rhs) { return lhs.box.ymid() < rhs.box.ymid(); };
+
+    parallelSort(items.begin(), items.end(), xcmp);
+
+    //---
+
+    // slice into sqrt(num leaves) slices of whole nodes
+    int numNodes  = (n + nodeSize - 1)/nodeSize;
+    int numSlices = int(std::ceil(std::sqrt(double(numNodes))));
+    int sliceSize = ((numNodes + numSlices - 1)/numSlices)*nodeSize;
+
+    auto sortSlices = [&](int is1, int is2) {
+      for (int is = is1; is < is2; ++is) {
+        int i1 = std::min(is*sliceSize, n);
+        int i2 = std::min(i1 + sliceSize, n);
+
+        std::sort(items.begin() + i1, items.begin() + i2, ycmp);
+      }
+    };
+
+    int nt = (n >= minParallelSize ? std::min(numThreads_, numSlices) : 1);
+
+    if (nt <= 1)
+      sortSlices(0, numSlices);
+    else {
+      std::vector<std::future<void>> futures;
+
+      int ds = (numSlices + nt - 1)/nt;
+
+      for (int is = 0; is < numSlices; is += ds)
+        futures.push_back(std::async(std::launch::async, sortSlices, is,
+                                     std::min(is + ds, numSlices)));
+
+      for (auto &future : futures)
+        future.get();
+    }
+  }
+
+  // sort chunks in parallel and merge
+  template<typename ITER, typename CMP>
+  void parallelSort(ITER begin, ITER end, CMP cmp) const {
+    int n = int(end - begin);
+
+    int nt = (n >= minParallelSize ? numThreads_ : 1);
+
+    if (nt <= 1) {
+      std::sort(begin, end, cmp);
+      return;
+    }
+
+    std::vector<ITER> bounds;
+
+    for (int i = 0; i < nt; ++i)
+      bounds.push_back(begin + (long(i)*n)/nt);
+
+    bounds.push_back(end);
+
+    std::vector<std::future<void>> futures;
+
+    for (int i = 0; i < nt; ++i) {
+      futures.push_back(std::async(std::launch::async, [&, i]() {
+        std::sort(bounds[i], bounds[i + 1], cmp);
+      }));
+    }
+
+    for (auto &future : futures)
+      future.get();
+
+    // merge adjacent sorted chunks
+    for (int step = 1; step < nt; step *= 2) {
+      for (int i = 0; i + step < nt; i += 2*step) {
+        int j = std::min(i + 2*step, nt);
+
+        std::inplace_merge(bounds[i], bounds[i + step], bounds[j], cmp);
+      }
+    }
+  }
+
+  // pack consecutive items into nodes
+  template<typename ITEM>
+  void packLevel(const std::vector<ITEM> &items, Nodes &nodes) const {
+    int n = int(items.size());
+
+    nodes.resize((n + nodeSize - 1)/nodeSize);
+
+    int i = 0;
+
+    for (auto &node : nodes) {
+      node.first = i;
+      node.num   = std::min(int(nodeSize), n - i);
+      node.box   = items[i].box;
+
+      for (int j = 1; j < node.num; ++j)
+        node.box.add(items[i + j].box);
+
+      i += node.num;
+    }
+  }
+
+  // depth first search of nodes accepted by node proc
+  template<typename NODE_PROC, typename ENTRY_PROC, typename INSIDE_PROC>
+  void search(const NODE_PROC &nodeProc, const ENTRY_PROC &entryProc,
+              const INSIDE_PROC &insideProc, DataList &dataList) const {
+    if (nodes_.empty())
+      return;
+
+    int root = int(nodes_.size()) - 1;
+
+    if (! nodeProc(nodes_[root].box))
+      return;
+
+    std::vector<int> stack;
+
+    stack.reserve(64);
+
+    stack.push_back(root);
+
+    while (! stack.empty()) {
+      int i = stack.back();
+
+      stack.pop_back();
+
+      const auto &node = nodes_[i];
+
+      if (insideProc(node.box)) {
+        addNodeData(i, dataList);
+        continue;
+      }
+
+      if (i < numLeafNodes_) {
+        for (int j = node.first; j < node.first + node.num; ++j)
+          entryProc(entries_[j]);
+      }
+      else {
+        for (int j = node.first; j < node.first + node.num; ++j) {
+          if (nodeProc(nodes_[j].box))
+            stack.push_back(j);
+        }
+      }
+    }
+  }
+
+  // add all items below node
+  void addNodeData(int i, DataList &dataList) const {
+    std::vector<int> stack;
+
+    stack.push_back(i);
+
+    while (! stack.empty()) {
+      const auto &node = nodes_[stack.back()];
+
+      bool leaf = (stack.back() < numLeafNodes_);
+
+      stack.pop_back();
+
+      for (int j = node.first; j < node.first + node.num; ++j) {
+        if (leaf)
+          dataList.push_back(entries_[j].data);
+        else
+          stack.push_back(j);
+      }
+    }
+  }
+
+  // is box1 inside box2
+  static bool inside(const Box &box1, const Box &box2) {
+    return ((box1.xmin >= box2.xmin && box1.xmax <= box2.xmax) &&
+            (box1.ymin >= box2.ymin && box1.ymax <= box2.ymax));
+  }
+
+  // does box1 overlap box2
+  static bool overlaps(const Box &box1, const Box &box2) {
+    return ((box1.xmax >= box2.xmin && box1.xmin <= box2.xmax) &&
+            (box1.ymax >= box2.ymin && box1.ymin <= box2.ymax));
+  }
+
+ private:
+  Entries entries_;                //!< items (leaf order)
+  Nodes   nodes_;                  //!< nodes (leaf level first, root last)
+  int     numLeafNodes_ { 0 };     //!< number of leaf nodes
+  int     numThreads_   { 1 };     //!< number of build threads
+};
+
+#endif
@@ -4,6 +4,7 @@
 #include <CQChartsPointPlot.h>
 #include <CQChartsPlotObj.h>
 #include <CQChartsBoxWhisker.h>
+#include <CQChartsBivariateDensity.h>
 #include <CQChartsFitData.h>
 #include <CQChartsGridCell.h>
 #include <CQChartsImage.h>
@@ -12,6 +13,7 @@
 #include <CHexMap.h>
 
 class CQChartsScatterPlot;
+class CQChartsScatterPointBatchObj;
 class CQChartsGrahamHull;
 
 //---
@@ -121,6 +123,8 @@ class CQChartsScatterPointObj : public CQChartsPlotObj {
 
   void getSelectIndices(Indices &inds) const override;
 
+  void addSelectIndices() override;
+
   //---
 
   void draw(CQChartsPaintDevice *device) override;
@@ -136,6 +140,15 @@ class CQChartsScatterPointObj : public CQChartsPlotObj {
   double xColorValue(bool relative=true) const override;
   double yColorValue(bool relative=true) const override;
 
+  //---
+
+  //! set parent point batch (selection is stored in batch)
+  void setBatch(const CQChartsScatterPointBatchObj *batch, int ind) {
+    batch_ = batch; batchInd_ = ind; }
+
+  bool isSelected() const override;
+  void setSelected(bool b) override;
+
  private:
   struct ExtraData {
     CQChartsSymbol symbolType { CQChartsSymbol::Type::NONE }; //!< symbol type
@@ -155,6 +168,186 @@ class CQChartsScatterPointObj : public CQChartsPlotObj {
   ExtraData                  edata_;                  //!< extra data
   QString                    name_;                   //!< label name
   CQChartsImage              image_;                  //!< image data
+
+  const CQChartsScatterPointBatchObj* batch_    { nullptr }; //!< parent point batch
+  int                                 batchInd_ { -1 };      //!< index in point batch
+};
+
+//---
+
+/*!
+ * \brief Scatter Plot Point Batch object
+ * \ingroup Charts
+ *
+ * Single object for all points of a large set. Point data is stored in arrays and
+ * point objects are only created on demand when a point is inspected or selected.
+ */
+class CQChartsScatterPointBatchObj : public CQChartsPlotObj {
+  Q_OBJECT
+
+  Q_PROPERTY(int     groupInd  READ groupInd )
+  Q_PROPERTY(QString name      READ name     )
+  Q_PROPERTY(int     numPoints READ numPoints)
+
+ public:
+  using Point = CQChartsGeom::Point;
+  using Dir   = CQChartsScatterPointObj::Dir;
+
+ public:
+  CQChartsScatterPointBatchObj(const CQChartsScatterPlot *plot, int groupInd,
+                               const QString &name, const ColorInd &is, const ColorInd &ig);
+ ~CQChartsScatterPointBatchObj();
+
+  const CQChartsScatterPlot *plot() const { return plot_; }
+
+  int groupInd() const { return groupInd_; }
+
+  //! set name (value set name)
+  const QString &name() const { return name_; }
+
+  //! get/set point label name
+  const QString &pointName() const { return pointName_; }
+  void setPointName(const QString &s) { pointName_ = s; }
+
+  //---
+
+  //! add point with model index and optional size and color
+  void addPoint(const Point &p, const QModelIndex &ind, const CQChartsLength &symbolSize,
+                const CQChartsColor &color);
+
+  //! finish adding points
+  void endPoints();
+
+  int numPoints() const { return int(xs_.size()); }
+
+  Point point(int i) const { return Point(xs_[i], ys_[i]); }
+
+  CQChartsLength pointSymbolSize(int i) const;
+
+  CQChartsColor pointColor(int i) const;
+
+  QModelIndex pointModelInd(int i) const;
+
+  //---
+
+  QString typeName() const override { return "point_batch"; }
+
+  QString calcId() const override;
+
+  QString calcTipId() const override;
+
+  //---
+
+  bool inside(const Point &p) const override;
+
+  bool rectIntersect(const CQChartsGeom::BBox &r, bool inside) const override;
+
+  CQChartsPlotObj *detailObjAt(const Point &p) const override;
+
+  void setSelectRect(const CQChartsGeom::BBox &r, bool inside) override;
+
+  void setSelectIndices(const Indices &inds) override;
+
+  //---
+
+  // selection (by point subset)
+  //  when a select subset (rect or indices) is pending the state and change apply to it
+  bool isSelected() const override;
+  void setSelected(bool b) override;
+
+  bool isPointSelected(int i) const { return (! selected_.empty() && selected_[i]); }
+  void setPointSelected(int i, bool b);
+
+  // inside (per point object)
+  bool isInside() const override;
+  void setInside(bool b) override;
+
+  void getSelectIndices(Indices &inds) const override;
+
+  //---
+
+  void draw(CQChartsPaintDevice *device) override;
+
+  void drawRug(CQChartsPaintDevice *device, const Dir &dir, bool flip) const;
+
+  //---
+
+  double xColorValue(bool relative=true) const override;
+  double yColorValue(bool relative=true) const override;
+
+ private:
+  using Reals     = std::vector<double>;
+  using Ints      = std::vector<int>;
+  using Bools     = std::vector<bool>;
+  using ModelInds = std::vector<QModelIndex>;
+  using UnitsList = std::vector<CQChartsUnits>;
+  using MaxSizes  = std::map<CQChartsUnits,double>;
+  using Colors    = std::vector<CQChartsColor>;
+  using ColorMap  = std::map<CQChartsColor,int>;
+  using PointObjs = std::map<int,CQChartsScatterPointObj *>;
+  using PointFn   = std::function<void(int)>;
+
+  //! grid of point indices for point/rect lookup
+  struct Grid {
+    bool               valid { false }; //!< is valid
+    int                nx    { 0 };     //!< number of x cells
+    int                ny    { 0 };     //!< number of y cells
+    CQChartsGeom::BBox bbox;            //!< points bbox
+    Ints               starts;          //!< cell start in inds
+    Ints               inds;            //!< point indices (by cell)
+  };
+
+ private:
+  void initGrid() const;
+
+  void gridPoints(const CQChartsGeom::BBox &r, const PointFn &fn) const;
+
+  void maxSymbolSize(bool pixel, double &sx, double &sy) const;
+
+  void symbolWindowSize(double &dx, double &dy) const;
+
+  int pointAt(const Point &p) const;
+
+  bool pointInRect(int i, const CQChartsGeom::BBox &r, bool inside) const;
+
+  CQChartsScatterPointObj *pointObj(int i) const;
+
+  void subsetPoints(const PointFn &fn) const;
+
+  void addPointSelectIndices(int i, Indices &inds) const;
+
+  ColorInd pointColorInd(int i) const;
+
+  void calcPointPenBrush(int i, CQChartsPenBrush &penBrush, bool selected) const;
+
+ private:
+  const CQChartsScatterPlot* plot_     { nullptr }; //!< scatter plot
+  int                        groupInd_ { -1 };      //!< plot group index
+  QString                    name_;                 //!< set name
+  QString                    pointName_;            //!< point label name
+
+  // point arrays
+  Reals     xs_;                    //!< x values
+  Reals     ys_;                    //!< y values
+  ModelInds inds_;                  //!< model indices
+  Reals     sizes_;                 //!< symbol size values (optional)
+  UnitsList sizeUnits_;             //!< symbol size units (optional)
+  MaxSizes  maxSizes_;              //!< max symbol size value per units
+  bool      defaultSize_ { false }; //!< any point uses plot symbol size
+  Ints      colorInds_;             //!< index in colors (optional)
+  Colors    colors_;                //!< unique point colors
+  ColorMap  colorMap_;              //!< color index lookup (when adding)
+
+  // selection
+  Bools              selected_;                //!< selected points
+  int                numSelected_  { 0 };      //!< number of selected points
+  CQChartsGeom::BBox selectRect_;              //!< pending select rect
+  bool               selectInside_ { false };  //!< pending select rect inside
+  Indices            selectInds_;              //!< pending select model indices
+
+  // on demand data
+  mutable PointObjs pointObjs_; //!< on demand point objects
+  mutable Grid      grid_;      //!< lookup grid
 };
 
 //---
@@ -406,6 +599,9 @@ class CQChartsScatterPlot : public CQChartsPointPlot,
 
   CQCHARTS_NAMED_SHAPE_DATA_PROPERTIES(GridCell,gridCell)
 
+  // point batch
+  Q_PROPERTY(int pointBatchSize READ pointBatchSize WRITE setPointBatchSize)
+
   // symbol map key
   Q_PROPERTY(bool          symbolMapKey       READ isSymbolMapKey     WRITE setSymbolMapKey      )
   Q_PROPERTY(CQChartsAlpha symbolMapKeyAlpha  READ symbolMapKeyAlpha  WRITE setSymbolMapKeyAlpha )
@@ -443,6 +639,7 @@ class CQChartsScatterPlot : public CQChartsPointPlot,
     Values                values;
     CQChartsGeom::RMinMax xrange;
     CQChartsGeom::RMinMax yrange;
+    bool                  batched { false }; //!< values moved to point batch (first kept)
   };
 
   using NameValues      = std::map<QString,ValuesData>;
@@ -460,6 +657,12 @@ class CQChartsScatterPlot : public CQChartsPointPlot,
   using NameHexData      = std::map<QString,HexMap>;
   using GroupNameHexData = std::map<int,NameHexData>;
 
+  //--
+
+  using DensityGrid          = CQChartsBivariateDensity::Grid;
+  using NameDensityGrid      = std::map<QString,DensityGrid>;
+  using GroupNameDensityGrid = std::map<int,NameDensityGrid>;
+
   //---
 
   enum XSide {
@@ -592,6 +795,12 @@ class CQChartsScatterPlot : public CQChartsPointPlot,
 
   //---
 
+  // min number of points in set to use point batch (0 to disable)
+  int pointBatchSize() const { return pointBatchSize_; }
+  void setPointBatchSize(int n);
+
+  //---
+
   // symbol map key
   bool isSymbolMapKey() const { return symbolMapKeyData_.displayed; }
   void setSymbolMapKey(bool b);
@@ -627,6 +836,8 @@ class CQChartsScatterPlot : public CQChartsPointPlot,
 
   void addNameValues() const;
 
+  void calcDensityMap() const;
+
   //---
 
   QString xHeaderName() const { return columnHeaderName(xColumn()); }
@@ -765,6 +976,9 @@ class CQChartsScatterPlot : public CQChartsPointPlot,
   using GroupHull     = std::map<int,CQChartsGrahamHull *>;
   using GroupWhiskers = std::map<int,CQChartsXYBoxWhisker *>;
 
+  //! get group points (unbatched points and point batch points)
+  void getGroupPoints(int groupInd, Points &points) const;
+
   struct AxisRugData {
     bool  xVisible { false };         //!< x rug
     YSide xSide    { YSide::BOTTOM }; //!< x rug side
@@ -808,7 +1022,8 @@ class CQChartsScatterPlot : public CQChartsPointPlot,
   ColumnType yColumnType_ { ColumnType::NONE }; //!< y column type
 
   // options
-  PlotType plotType_ { PlotType::SYMBOLS }; //!< plot type
+  PlotType plotType_       { PlotType::SYMBOLS }; //!< plot type
+  int      pointBatchSize_ { 10000 };             //!< min set size for point batch
 
   // axis annotation data
   AxisRugData     axisRugData_;     //!< axis rug data
@@ -822,14 +1037,15 @@ class CQChartsScatterPlot : public CQChartsPointPlot,
   int              hexMapMaxN_ { 0 };
 
   // group data
-  GroupNameValues   groupNameValues_;   //!< group name values
-  GroupNameGridData groupNameGridData_; //!< grid cell values
-  GroupNameHexData  groupNameHexData_;  //!< hex celll values
-  GroupPoints       groupPoints_;       //!< group fit points
-  GroupFitData      groupFitData_;      //!< group fit data
-  GroupStatData     groupStatData_;     //!< group stat data
-  GroupHull         groupHull_;         //!< group hull
-  GroupWhiskers     groupWhiskers_;     //!< group whiskers
+  GroupNameValues      groupNameValues_;      //!< group name values
+  GroupNameGridData    groupNameGridData_;    //!< grid cell values
+  GroupNameHexData     groupNameHexData_;     //!< hex celll values
+  GroupNameDensityGrid groupNameDensityGrid_; //!< density map grids
+  GroupPoints          groupPoints_;          //!< group fit points (unbatched)
+  GroupFitData         groupFitData_;         //!< group fit data
+  GroupStatData        groupStatData_;        //!< group stat data
+  GroupHull            groupHull_;            //!< group hull
+  GroupWhiskers        groupWhiskers_;        //!< group whiskers
 
   // symbol map
   SymbolMapKeyData symbolMapKeyData_; //!< symbol map key data
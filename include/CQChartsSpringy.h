@@ -3,6 +3,8 @@
 
 #include <vector>
 #include <map>
+#include <algorithm>
+#include <future>
 #include <cmath>
 
 namespace Springy {
@@ -397,6 +399,225 @@ namespace Springy {
 
   //-----------
 
+  /*!
+   * \brief Barnes-Hut quad tree for approximate repulsion forces
+   * \ingroup Charts
+   *
+   * Each cell stores the number of points it contains and the sum of their positions
+   * so a distant cell can be treated as a single point (of the cell's point count)
+   * at its centroid. Leaf cells hold a single point (or any number of coincident
+   * points at the maximum depth) in a linked list of point indices.
+   */
+  class ForceTree {
+   public:
+    using Positions = std::vector<Vector>;
+
+   public:
+    ForceTree() { }
+
+    //! build tree for point positions
+    void build(const Positions &positions) {
+      cells_.clear();
+
+      positions_ = &positions;
+
+      int np = int(positions.size());
+
+      next_.assign(np, -1);
+
+      if (np == 0)
+        return;
+
+      // square bounding box of points
+      double xmin = positions[0].x(), ymin = positions[0].y();
+      double xmax = xmin, ymax = ymin;
+
+      for (const auto &p : positions) {
+        xmin = std::min(xmin, p.x()); ymin = std::min(ymin, p.y());
+        xmax = std::max(xmax, p.x()); ymax = std::max(ymax, p.y());
+      }
+
+      double size = std::max(std::max(xmax - xmin, ymax - ymin), 1E-6)*1.01;
+
+      cells_.reserve(2*np);
+
+      cells_.emplace_back();
+
+      cells_[0].x = (xmin + xmax - size)/2.0;
+      cells_[0].y = (ymin + ymax - size)/2.0;
+      cells_[0].s = size;
+
+      for (int i = 0; i < np; ++i)
+        insertPoint(0, i, 0);
+    }
+
+    //! calc repulsion force on point at index (force of each other point is
+    //! scale/(d + 0.1)^2 along the separation vector)
+    Vector calcForce(int i, double scale, double theta) const {
+      if (cells_.empty())
+        return Vector();
+
+      const auto &p = (*positions_)[i];
+
+      double fx = 0.0, fy = 0.0;
+
+      auto addForce = [&](double dx, double dy, double n) {
+        double d = std::hypot(dx, dy);
+
+        if (d <= 0.0)
+          return;
+
+        double distance = d + 0.1;
+
+        double f = n*scale/(distance*distance*d);
+
+        fx += f*dx;
+        fy += f*dy;
+      };
+
+      std::vector<int> stack;
+
+      stack.reserve(64);
+
+      stack.push_back(0);
+
+      while (! stack.empty()) {
+        const auto &cell = cells_[stack.back()];
+
+        stack.pop_back();
+
+        if (cell.count == 0)
+          continue;
+
+        // leaf: add force from each (other) point
+        if (cell.child < 0) {
+          for (int j = cell.first; j >= 0; j = next_[j]) {
+            if (j == i) continue;
+
+            const auto &p1 = (*positions_)[j];
+
+            addForce(p.x() - p1.x(), p.y() - p1.y(), 1.0);
+          }
+
+          continue;
+        }
+
+        // distant cell (not containing point): use cell centroid
+        double cx = cell.sx/cell.count;
+        double cy = cell.sy/cell.count;
+
+        double dx = p.x() - cx;
+        double dy = p.y() - cy;
+
+        bool inside = (p.x() >= cell.x && p.x() <= cell.x + cell.s &&
+                       p.y() >= cell.y && p.y() <= cell.y + cell.s);
+
+        if (! inside && cell.s < theta*std::hypot(dx, dy)) {
+          addForce(dx, dy, cell.count);
+
+          continue;
+        }
+
+        for (int ic = 0; ic < 4; ++ic)
+          stack.push_back(cell.child + ic);
+      }
+
+      return Vector(fx, fy);
+    }
+
+   private:
+    //! tree cell (children are stored consecutively from child index)
+    struct Cell {
+      double x     { 0.0 }; //!< min x
+      double y     { 0.0 }; //!< min y
+      double s     { 0.0 }; //!< size
+      double sx    { 0.0 }; //!< sum of point x
+      double sy    { 0.0 }; //!< sum of point y
+      int    count { 0 };   //!< number of points
+      int    child { -1 };  //!< first child cell index
+      int    first { -1 };  //!< first point index (leaf)
+    };
+
+    using Cells   = std::vector<Cell>;
+    using Indices = std::vector<int>;
+
+    static const int maxDepth = 32;
+
+   private:
+    void insertPoint(int ic, int i, int depth) {
+      const auto &p = (*positions_)[i];
+
+      while (true) {
+        auto &cell = cells_[ic];
+
+        cell.sx += p.x();
+        cell.sy += p.y();
+
+        ++cell.count;
+
+        if (cell.child < 0) {
+          // empty leaf or max depth: add to leaf points
+          if (cell.count == 1 || depth >= maxDepth) {
+            next_[i]   = cell.first;
+            cell.first = i;
+            return;
+          }
+
+          // split leaf and move existing point to child (invalidates cell reference)
+          int j = cell.first;
+
+          cell.first = -1;
+
+          splitCell(ic);
+
+          insertPoint(childCell(ic, j), j, depth + 1);
+        }
+
+        ic = childCell(ic, i);
+
+        ++depth;
+      }
+    }
+
+    void splitCell(int ic) {
+      int child = int(cells_.size());
+
+      double x = cells_[ic].x;
+      double y = cells_[ic].y;
+      double s = cells_[ic].s/2.0;
+
+      for (int k = 0; k < 4; ++k) {
+        Cell cell;
+
+        cell.x = x + ((k & 1) ? s : 0.0);
+        cell.y = y + ((k & 2) ? s : 0.0);
+        cell.s = s;
+
+        cells_.push_back(cell);
+      }
+
+      cells_[ic].child = child;
+    }
+
+    int childCell(int ic, int i) const {
+      const auto &cell = cells_[ic];
+      const auto &p    = (*positions_)[i];
+
+      double s = cell.s/2.0;
+
+      int k = (p.x() >= cell.x + s ? 1 : 0) | (p.y() >= cell.y + s ? 2 : 0);
+
+      return cell.child + k;
+    }
+
+   private:
+    const Positions* positions_ { nullptr }; //!< point positions
+    Cells            cells_;                 //!< tree cells
+    Indices          next_;                  //!< next point in leaf list
+  };
+
+  //-----------
+
   /*!
    * \brief Layout
    * \ingroup Charts
@@ -417,6 +638,19 @@ namespace Springy {
 
     Graph *graph() const { return graph_; }
 
+    //! get/set use Barnes-Hut approximation for repulsion
+    bool isApproximate() const { return approximate_; }
+    void setApproximate(bool b) { approximate_ = b; }
+
+    //! get/set Barnes-Hut accuracy (cell size/distance ratio below which cell is
+    //! treated as single point, 0 is exact)
+    double theta() const { return theta_; }
+    void setTheta(double r) { theta_ = std::max(r, 0.0); }
+
+    //! get/set number of threads used to calculate repulsion
+    int numThreads() const { return numThreads_; }
+    void setNumThreads(int n) { numThreads_ = std::max(n, 1); }
+
     Point *nodePoint(Node *node) const {
       auto *th = const_cast<Layout *>(this);
 
@@ -488,15 +722,29 @@ namespace Springy {
 
     // Physics stuff
     void applyCoulombsLaw() {
-      for (auto n1 : graph_->nodes()) {
-        auto point1 = nodePoint(n1);
+      // get node points (once)
+      Points points;
+
+      for (auto n : graph_->nodes())
+        points.push_back(nodePoint(n));
+
+      int np = int(points.size());
+
+      if (np < 2)
+        return;
+
+      //---
+
+      // single threaded exact: apply to each pair of points
+      if (! isApproximate() && numThreads() <= 1) {
+        for (int i1 = 0; i1 < np; ++i1) {
+          auto point1 = points[i1];
 
-        for (auto n2 : graph_->nodes()) {
-          if (n1 == n2) continue;
+          for (int i2 = 0; i2 < np; ++i2) {
+            if (i1 == i2) continue;
 
-          auto point2 = nodePoint(n2);
+            auto point2 = points[i2];
 
-          if (point1 != point2) {
             auto d = point1->p().subtract(point2->p());
 
             // avoid massive forces at small distances (and divide by zero)
@@ -509,7 +757,82 @@ namespace Springy {
             point2->applyForce(direction.multiply(repulsion_).divide(distance*distance*-0.5));
           }
         }
+
+        return;
+      }
+
+      //---
+
+      // calc total force on each point (each pair above applies 4*repulsion/distance^2
+      // to each point) using Barnes-Hut tree if approximate
+      ForceTree::Positions positions;
+
+      positions.reserve(np);
+
+      for (auto point : points)
+        positions.push_back(point->p());
+
+      ForceTree tree;
+
+      if (isApproximate())
+        tree.build(positions);
+
+      double scale = 4.0*repulsion_;
+
+      std::vector<Vector> forces(np);
+
+      auto calcForces = [&](int i1, int i2) {
+        for (int i = i1; i < i2; ++i) {
+          if (isApproximate()) {
+            forces[i] = tree.calcForce(i, scale, theta());
+            continue;
+          }
+
+          const auto &p = positions[i];
+
+          double fx = 0.0, fy = 0.0;
+
+          for (int j = 0; j < np; ++j) {
+            if (i == j) continue;
+
+            double dx = p.x() - positions[j].x();
+            double dy = p.y() - positions[j].y();
+
+            double d = std::hypot(dx, dy);
+
+            if (d <= 0.0) continue;
+
+            double distance = d + 0.1;
+
+            double f = scale/(distance*distance*d);
+
+            fx += f*dx;
+            fy += f*dy;
+          }
+
+          forces[i] = Vector(fx, fy);
+        }
+      };
+
+      // split points into ranges for each thread
+      int nt = std::max(std::min(numThreads(), np/64), 1);
+
+      if (nt > 1) {
+        std::vector<std::future<void>> futures;
+
+        int n = (np + nt - 1)/nt;
+
+        for (int i = 0; i < np; i += n)
+          futures.push_back(std::async(std::launch::async, calcForces, i, std::min(i + n, np)));
+
+        for (auto &future : futures)
+          future.get();
       }
+      else
+        calcForces(0, np);
+
+      for (int i = 0; i < np; ++i)
+        points[i]->applyForce(forces[i]);
     }
 
     void applyHookesLaw() {
@@ -626,11 +949,15 @@ namespace Springy {
    private:
     using NodePoints  = std::map<int,Point*>;
     using EdgeSprings = std::map<int,Spring*>;
+    using Points      = std::vector<Point*>;
 
     Graph*      graph_              { nullptr }; //!< parent graph
     double      stiffness_          { 400.0 };   //!< spring stiffness constant
     double      repulsion_          { 400.0 };   //!< repulsion constant
     double      damping_            { 0.5 };     //!< velocity damping factor
+    bool        approximate_        { false };   //!< use Barnes-Hut approximation
+    double      theta_              { 0.5 };     //!< Barnes-Hut accuracy
+    int         numThreads_         { 1 };       //!< number of repulsion threads
 //  double      minEnergyThreshold_ { 0.0 };     //!< min energy threshold
     NodePoints  nodePoints_;                     //!< keep track of points associated with nodes
     EdgeSprings edgeSprings_;                    //!< keep track of springs associated with edges
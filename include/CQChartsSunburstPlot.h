@@ -3,12 +3,14 @@
 
 #include <CQChartsHierPlot.h>
 #include <CQChartsPlotObj.h>
+#include <CQChartsHierBuilder.h>
 #include <QModelIndex>
 
 class CQChartsSunburstPlot;
 class CQChartsSunburstRootNode;
 class CQChartsSunburstHierNode;
 class CQChartsSunburstNode;
+class CQChartsHierBuilder;
 
 //---
 
@@ -105,7 +107,7 @@ class CQChartsSunburstNode {
   const QString &name() const { return name_; }
 
   virtual double size() const { return size_; }
-  void setSize(double size) { size_ = size; }
+  virtual void setSize(double size);
 
   virtual int depth() const { return 1; }
 
@@ -218,8 +220,14 @@ class CQChartsSunburstHierNode : public CQChartsSunburstNode {
 
   //---
 
+  void setSize(double s) override;
+
+  //! get size of node and all child nodes (cached)
   double hierSize() const override;
 
+  //! invalidate cached size of node and parents
+  void invalidateHierSize();
+
   //---
 
   int depth() const override;
@@ -255,9 +263,10 @@ class CQChartsSunburstHierNode : public CQChartsSunburstNode {
                      const ColorInd &colorInd, int n) const override;
 
  private:
-  Nodes    nodes_;             //!< child nodes
-  Children children_;          //!< child hier nodes
-  bool     expanded_ { true }; //!< is expanded
+  Nodes            nodes_;             //!< child nodes
+  Children         children_;          //!< child hier nodes
+  bool             expanded_ { true }; //!< is expanded
+  CQChartsHierSize hierSize_;          //!< cached hier size
 };
 
 //---
@@ -421,11 +430,19 @@ class CQChartsSunburstPlot : public CQChartsHierPlot,
   CQChartsSunburstNode *addNode(CQChartsSunburstHierNode *hier, const QString &name, double size,
                                 const QModelIndex &nameInd, const QModelIndex &valueInd) const;
 
+  //! flat model row data (path and size are added to hier builder)
+  struct FlatRowData {
+    QModelIndex   nameInd; //!< name model index
+    QModelIndex   ind;     //!< node model index
+    CQChartsColor color;   //!< node color
+  };
+
+  using FlatRows = std::vector<FlatRowData>;
+
   void loadFlat(CQChartsSunburstHierNode *hier) const;
 
-  CQChartsSunburstNode *addNode(CQChartsSunburstHierNode *root, const QStringList &nameStrs,
-                                double size, const QModelIndex &nameInd,
-                                const QModelIndex &valueInd) const;
+  void addFlatNodes(const CQChartsHierBuilder &builder, const FlatRows &flatRows, int ind,
+                    CQChartsSunburstHierNode *parent) const;
 
   void addExtraNodes(CQChartsSunburstHierNode *hier) const;
 
@@ -438,9 +455,6 @@ class CQChartsSunburstPlot : public CQChartsHierPlot,
   CQChartsSunburstHierNode *childHierNode(CQChartsSunburstHierNode *parent,
                                           const QString &name) const;
 
-  CQChartsSunburstNode *childNode(CQChartsSunburstHierNode *parent,
-                                  const QString &name) const;
-
   //---
 
   void addPlotObjs(CQChartsSunburstHierNode *parent, PlotObjs &objs, const ColorInd &ir) const;
@@ -0,0 +1,153 @@
+#ifndef CQChartsSweepDelaunay_H
+#define CQChartsSweepDelaunay_H
+
+#include <vector>
+
+/*!
+ * \brief Delaunay triangulation and voronoi graph using sweep hull
+ * \ingroup Charts
+ *
+ * Points are sorted by distance from the circumcenter of a seed triangle and added to
+ * an advancing convex hull (located using an angular hash), flipping triangle edges
+ * which aren't locally delaunay. Expected O(n log n).
+ *
+ * Triangles and half edges are stored in flat arrays: triangle t uses half edges
+ * 3t, 3t + 1 and 3t + 2, half edge e starts at vertex triangles[e] and its opposite
+ * half edge (in neighbouring triangle) is halfEdges[e] (-1 if on hull).
+ *
+ * The voronoi data matches CQChartsDelaunay: a voronoi vertex (circumcenter) for each
+ * non-degenerate triangle, added to the voronoi list of its three vertices, and a
+ * voronoi edge for each triangle edge connecting the centers of the two triangles
+ * (or an extended point for hull edges).
+ */
+class CQChartsSweepDelaunay {
+ public:
+  using Inds = std::vector<int>;
+
+  //! voronoi vertex (circle center and radius)
+  struct VoronoiVertex {
+    double x { 0.0 }; //!< center x
+    double y { 0.0 }; //!< center y
+    double r { 0.0 }; //!< circle radius (zero for extended hull edge points)
+
+    VoronoiVertex() { }
+
+    VoronoiVertex(double x, double y, double r) :
+     x(x), y(y), r(r) {
+    }
+  };
+
+  //! voronoi edge (voronoi vertex indices)
+  struct VoronoiEdge {
+    int start { -1 }; //!< start vertex (triangle center)
+    int end   { -1 }; //!< end vertex
+
+    VoronoiEdge() { }
+
+    VoronoiEdge(int start, int end) :
+     start(start), end(end) {
+    }
+  };
+
+ public:
+  CQChartsSweepDelaunay() { }
+
+  //! add vertex (returns vertex index)
+  int addVertex(double x, double y, double value=0.0);
+
+  //! remove all vertices (and results)
+  void clearVertices();
+
+  //! calc triangulation and voronoi graph (false if too few points or all collinear)
+  bool calc();
+
+  //---
+
+  // vertices
+  int numVertices() const { return int(values_.size()); }
+
+  double x(int i) const { return coords_[2*i    ]; }
+  double y(int i) const { return coords_[2*i + 1]; }
+
+  double value(int i) const { return values_[i]; }
+
+  //! voronoi vertices of vertex
+  const Inds &voronoi(int i) const { return vertexVoronoi_[i]; }
+
+  //---
+
+  // triangles
+  int numTriangles() const { return int(triangles_.size()/3); }
+
+  //! triangle vertex (i = 0, 1, 2)
+  int triangleVertex(int t, int i) const { return triangles_[3*t + i]; }
+
+  //! triangle voronoi vertex (-1 if degenerate)
+  int triangleVoronoi(int t) const { return triangleVoronoi_[t]; }
+
+  //! half edge start vertices and opposite half edges
+  const Inds &triangles() const { return triangles_; }
+  const Inds &halfEdges() const { return halfEdges_; }
+
+  //---
+
+  // voronoi
+  int numVoronoiVertices() const { return int(voronoiVertices_.size()); }
+
+  const VoronoiVertex &voronoiVertex(int i) const { return voronoiVertices_[i]; }
+
+  int numVoronoiEdges() const { return int(voronoiEdges_.size()); }
+
+  const VoronoiEdge &voronoiEdge(int i) const { return voronoiEdges_[i]; }
+
+ private:
+  using Reals           = std::vector<double>;
+  using VoronoiVertices = std::vector<VoronoiVertex>;
+  using VoronoiEdges    = std::vector<VoronoiEdge>;
+  using VertexVoronoi   = std::vector<Inds>;
+
+  void reset();
+
+  bool triangulate();
+
+  int addTriangle(int i0, int i1, int i2, int a, int b, int c);
+
+  void link(int a, int b);
+
+  int legalize(int a);
+
+  int hashKey(double x, double y) const;
+
+  void calcVoronoi();
+
+  bool triangleCenter(int t, double &xc, double &yc, double &r) const;
+
+  VoronoiVertex calcEdgePoint(int t, const VoronoiVertex &v, int e) const;
+
+ private:
+  // input
+  Reals coords_; //!< vertex coords (x, y pairs)
+  Reals values_; //!< vertex values
+
+  // triangulation
+  Inds triangles_; //!< half edge start vertex
+  Inds halfEdges_; //!< opposite half edge
+
+  // advancing hull
+  Inds   hullPrev_;          //!< previous hull vertex
+  Inds   hullNext_;          //!< next hull vertex
+  Inds   hullTri_;           //!< hull edge triangle half edge
+  Inds   hullHash_;          //!< angular hash of hull vertices
+  int    hullStart_ { -1 };  //!< hull start vertex
+  double cx_        { 0.0 }; //!< sweep center x
+  double cy_        { 0.0 }; //!< sweep center y
+  Inds   edgeStack_;         //!< legalize edge stack
+
+  // voronoi
+  Inds            triangleVoronoi_; //!< triangle voronoi vertex
+  VoronoiVertices voronoiVertices_; //!< voronoi vertices
+  VoronoiEdges    voronoiEdges_;    //!< voronoi edges
+  VertexVoronoi   vertexVoronoi_;   //!< voronoi vertices of each vertex
+};
+
+#endif
@@ -0,0 +1,122 @@
+#ifndef CQChartsSymbolCache_H
+#define CQChartsSymbolCache_H
+
+#include <CQChartsSymbol.h>
+#include <CQChartsGeom.h>
+#include <QImage>
+#include <QPen>
+#include <QBrush>
+#include <QVector>
+#include <algorithm>
+#include <atomic>
+#include <list>
+#include <map>
+#include <mutex>
+
+class QPainter;
+
+/*!
+ * \brief Cache of rendered symbol images
+ * \ingroup Charts
+ *
+ * Images are keyed on symbol, pixel size, pen, brush and device pixel ratio.
+ * Least recently used images are removed when the cache is full.
+ *
+ * Only solid pens and brushes are cached. Gradient, texture and pattern brushes
+ * depend on the brush origin/transform (not just the symbol) so must be drawn directly
+ * (see isCacheable).
+ *
+ * Thread safe so can be used from the draw thread.
+ */
+class CQChartsSymbolCache {
+ public:
+  CQChartsSymbolCache(int maxImages=256);
+
+  //! get/set max number of cached images
+  int maxImages() const { return maxImages_; }
+  void setMaxImages(int n);
+
+  //! get number of cached images
+  int numImages() const;
+
+  //! get cache hit/miss counts
+  int numHits  () const { return numHits_  ; }
+  int numMisses() const { return numMisses_; }
+
+  //! clear images and counts
+  void clear();
+
+  //! get if pen and brush can be keyed (drawn from a cached image)
+  static bool isCacheable(const QPen &pen, const QBrush &brush);
+
+  //! draw symbol image centered at pixel position using painter's pen and brush
+  //! (pen and brush must be cacheable)
+  void drawSymbol(QPainter *painter, const CQChartsGeom::Point &p,
+                  const CQChartsSymbol &symbol, double size);
+
+ private:
+  using Dashes = QVector<qreal>;
+
+  struct Key {
+    CQChartsSymbol::Type symbol      { CQChartsSymbol::Type::NONE };
+    double               size        { 0.0 };
+    Qt::PenStyle         penStyle    { Qt::NoPen };
+    QRgb                 penColor    { 0 };
+    double               penWidth    { 0.0 };
+    Dashes               penDashes;
+    double               penOffset   { 0.0 };
+    Qt::PenCapStyle      penCap      { Qt::SquareCap };
+    Qt::PenJoinStyle     penJoin     { Qt::BevelJoin };
+    double               penMiter    { 2.0 };
+    bool                 penCosmetic { false };
+    Qt::BrushStyle       brushStyle  { Qt::NoBrush };
+    QRgb                 brushColor  { 0 };
+    double               dpr         { 1.0 };
+
+    friend bool operator<(const Key &lhs, const Key &rhs) {
+      if (lhs.symbol      != rhs.symbol     ) return (lhs.symbol      < rhs.symbol     );
+      if (lhs.size        != rhs.size       ) return (lhs.size        < rhs.size       );
+      if (lhs.penStyle    != rhs.penStyle   ) return (lhs.penStyle    < rhs.penStyle   );
+      if (lhs.penColor    != rhs.penColor   ) return (lhs.penColor    < rhs.penColor   );
+      if (lhs.penWidth    != rhs.penWidth   ) return (lhs.penWidth    < rhs.penWidth   );
+      if (lhs.penDashes   != rhs.penDashes  ) return std::lexicographical_compare(
+        lhs.penDashes.begin(), lhs.penDashes.end(), rhs.penDashes.begin(), rhs.penDashes.end());
+      if (lhs.penOffset   != rhs.penOffset  ) return (lhs.penOffset   < rhs.penOffset  );
+      if (lhs.penCap      != rhs.penCap     ) return (lhs.penCap      < rhs.penCap     );
+      if (lhs.penJoin     != rhs.penJoin    ) return (lhs.penJoin     < rhs.penJoin    );
+      if (lhs.penMiter    != rhs.penMiter   ) return (lhs.penMiter    < rhs.penMiter   );
+      if (lhs.penCosmetic != rhs.penCosmetic) return (lhs.penCosmetic < rhs.penCosmetic);
+      if (lhs.brushStyle  != rhs.brushStyle ) return (lhs.brushStyle  < rhs.brushStyle );
+      if (lhs.brushColor  != rhs.brushColor ) return (lhs.brushColor  < rhs.brushColor );
+
+      return (lhs.dpr < rhs.dpr);
+    }
+  };
+
+  struct Entry {
+    Key    key;
+    QImage image;
+  };
+
+  using Entries  = std::list<Entry>;
+  using EntryMap = std::map<Key,Entries::iterator>;
+
+ private:
+  QImage getImage(const Key &key, const CQChartsSymbol &symbol,
+                  const QPen &pen, const QBrush &brush);
+
+  QImage createImage(const Key &key, const CQChartsSymbol &symbol,
+                     const QPen &pen, const QBrush &brush) const;
+
+  void evict();
+
+ private:
+  int                maxImages_ { 256 }; //!< max cached images
+  Entries            entries_;           //!< entries (most recently used first)
+  EntryMap           entryMap_;          //!< entry lookup
+  std::atomic<int>   numHits_   { 0 };   //!< number of cache hits
+  std::atomic<int>   numMisses_ { 0 };   //!< number of cache misses
+  mutable std::mutex mutex_;             //!< lock
+};
+
+#endif
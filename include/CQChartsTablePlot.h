@@ -86,11 +86,12 @@ class CQChartsTablePlot : public CQChartsPlot {
 
  public:
   enum class Mode {
-    NORMAL = (int) CQSummaryModel::Mode::NORMAL,
-    RANDOM = (int) CQSummaryModel::Mode::RANDOM,
-    SORTED = (int) CQSummaryModel::Mode::SORTED,
-    PAGED  = (int) CQSummaryModel::Mode::PAGED,
-    ROWS   = (int) CQSummaryModel::Mode::ROWS
+    NORMAL     = (int) CQSummaryModel::Mode::NORMAL,
+    RANDOM     = (int) CQSummaryModel::Mode::RANDOM,
+    SORTED     = (int) CQSummaryModel::Mode::SORTED,
+    PAGED      = (int) CQSummaryModel::Mode::PAGED,
+    ROWS       = (int) CQSummaryModel::Mode::ROWS,
+    STRATIFIED = (int) CQSummaryModel::Mode::STRATIFIED
   };
 
   using RowNums = CQSummaryModel::RowNums;
@@ -271,6 +272,9 @@ class CQChartsTablePlot : public CQChartsPlot {
 
   void execDrawBackground(CQChartsPaintDevice *device) const override;
 
+  // objects are scrolled so object rects can't be used for draw culling
+  bool canCullDrawObjs() const override { return false; }
+
   //---
 
   void adjustPan() override;
@@ -302,7 +306,7 @@ class CQChartsTablePlot : public CQChartsPlot {
   void createTableObjData() const;
 
   std::vector<Mode> modes() const { return
-    {{ Mode::NORMAL, Mode::RANDOM, Mode::SORTED, Mode::PAGED, Mode::ROWS }};
+    {{ Mode::NORMAL, Mode::RANDOM, Mode::SORTED, Mode::PAGED, Mode::ROWS, Mode::STRATIFIED }};
   }
 
   QString modeName(const Mode &mode) const;
@@ -0,0 +1,133 @@
+#ifndef CQChartsTextCache_H
+#define CQChartsTextCache_H
+
+#include <CQChartsUtil.h>
+#include <CQChartsGeom.h>
+#include <QFont>
+#include <QStringList>
+#include <atomic>
+#include <list>
+#include <map>
+#include <mutex>
+
+#define CQChartsTextCacheInst CQChartsTextCache::instance()
+
+/*!
+ * \brief Cache of text measurements and layouts
+ * \ingroup Charts
+ *
+ * Font metrics, text widths, formatted (wrapped) and elided string layouts are keyed on
+ * font, text and layout options. Least recently used entries are removed when the cache
+ * is full.
+ *
+ * Thread safe so can be used from the draw thread.
+ */
+class CQChartsTextCache {
+ public:
+  //! font metrics data
+  struct FontData {
+    double ascent  { 0.0 }; //!< ascent
+    double descent { 0.0 }; //!< descent
+    double height  { 0.0 }; //!< height
+  };
+
+ public:
+  static CQChartsTextCache *instance();
+
+  CQChartsTextCache(int maxEntries=8192);
+
+  //! get/set max number of cached entries
+  int maxEntries() const { return maxEntries_; }
+  void setMaxEntries(int n);
+
+  //! get number of cached entries
+  int numEntries() const;
+
+  //! get cache hit/miss counts
+  int numHits  () const { return numHits_  ; }
+  int numMisses() const { return numMisses_; }
+
+  //! clear entries and counts
+  void clear();
+
+  //---
+
+  //! get font ascent, descent and height
+  FontData fontData(const QFont &font);
+
+  //! get text width
+  double textWidth(const QFont &font, const QString &text);
+
+  //! get text size (width and font height)
+  CQChartsGeom::Size textSize(const QFont &font, const QString &text);
+
+  //! format string to fit in rect (see CQChartsUtil::formatStringInRect)
+  bool formatStringInRect(const QString &str, const QFont &font, const CQChartsGeom::BBox &rect,
+                          QStringList &strs, const CQChartsUtil::FormatData &formatData);
+
+  //! elide text to fit in width (see QFontMetricsF::elidedText)
+  QString elidedText(const QFont &font, const QString &text, double width,
+                     Qt::TextElideMode mode=Qt::ElideRight);
+
+ private:
+  enum class Type {
+    FONT,
+    WIDTH,
+    FORMAT,
+    ELIDE
+  };
+
+  struct Key {
+    Type    type   { Type::FONT };
+    QFont   font;
+    QString text;
+    double  width  { 0.0 };
+    double  height { 0.0 };
+    QString seps;
+    int     mode   { 0 };
+
+    friend bool operator<(const Key &lhs, const Key &rhs) {
+      if (lhs.type   != rhs.type  ) return (lhs.type   < rhs.type  );
+      if (lhs.width  != rhs.width ) return (lhs.width  < rhs.width );
+      if (lhs.height != rhs.height) return (lhs.height < rhs.height);
+      if (lhs.mode   != rhs.mode  ) return (lhs.mode   < rhs.mode  );
+      if (lhs.text   != rhs.text  ) return (lhs.text   < rhs.text  );
+      if (lhs.seps   != rhs.seps  ) return (lhs.seps   < rhs.seps  );
+
+      return (lhs.font < rhs.font);
+    }
+  };
+
+  struct Value {
+    FontData    fontData;            //!< font metrics
+    double      width     { 0.0 };   //!< text width
+    QStringList strs;                //!< formatted strings
+    QString     elided;              //!< elided text
+    bool        formatted { false }; //!< format result
+  };
+
+  struct Entry {
+    Key   key;
+    Value value;
+  };
+
+  using Entries  = std::list<Entry>;
+  using EntryMap = std::map<Key,Entries::iterator>;
+
+ private:
+  bool findValue(const Key &key, Value &value);
+
+  void addValue(const Key &key, const Value &value);
+
+  void evict();
+
+ private:
+  int                maxEntries_ { 8192 }; //!< max cached entries
+  Entries            entries_;             //!< entries (most recently used first)
+  EntryMap           entryMap_;            //!< entry lookup
+  std::atomic<int>   numHits_    { 0 };    //!< number of cache hits
+  std::atomic<int>   numMisses_  { 0 };    //!< number of cache misses
+  mutable std::mutex mutex_;               //!< lock
+};
+
+#endif
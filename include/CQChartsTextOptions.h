@@ -29,6 +29,7 @@ struct CQChartsTextOptions {
   double        scale            { -1.0 };                              //!< fixed scale
   bool          html             { false };                             //!< html
   bool          clipped          { true };                              //!< clipped
+  bool          elided           { false };                             //!< elided (if not formatted)
   int           margin           { 0 };                                 //!< margin (pixels)
   double        minScaleFontSize { 6.0 };                               //!< min scaled font size
   double        maxScaleFontSize { 48.0 };                              //!< max scaled font size
@@ -99,6 +99,9 @@ class CQChartsTitle : public CQChartsTextBoxObj {
 
   //---
 
+  //! get drawn text (title text with plot sample text)
+  QString calcText() const;
+
   CQChartsGeom::Size calcSize();
 
   CQChartsGeom::BBox fitBBox() const;
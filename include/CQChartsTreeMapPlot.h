@@ -3,6 +3,7 @@
 
 #include <CQChartsHierPlot.h>
 #include <CQChartsPlotObj.h>
+#include <CQChartsHierBuilder.h>
 #include <CQChartsDisplayRange.h>
 #include <CQChartsData.h>
 #include <QModelIndex>
@@ -43,6 +44,7 @@ class CQChartsTreeMapPlotType : public CQChartsHierPlotType {
 
 class CQChartsTreeMapPlot;
 class CQChartsTreeMapHierNode;
+class CQChartsHierBuilder;
 
 /*!
  * \brief Tree Map Node
@@ -74,7 +76,7 @@ class CQChartsTreeMapNode {
   virtual const QString &name() const { return name_; }
 
   virtual double size() const { return size_; }
-  virtual void setSize(double s) { size_ = s; }
+  virtual void setSize(double s);
 
   virtual double x() const { return x_; }
   virtual void setX(double x) { x_ = x; }
@@ -186,8 +188,14 @@ class CQChartsTreeMapHierNode : public CQChartsTreeMapNode {
 
   //---
 
+  void setSize(double s) override;
+
+  //! get size of node and all child nodes (cached)
   double hierSize() const override;
 
+  //! invalidate cached size of node and parents
+  void invalidateHierSize();
+
   //---
 
   bool hasNodes() const { return ! nodes_.empty(); }
@@ -228,11 +236,12 @@ class CQChartsTreeMapHierNode : public CQChartsTreeMapNode {
                      const ColorInd &colorInd, int n) const override;
 
  private:
-  Nodes    nodes_;               //!< child nodes
-  Children children_;            //!< child hier nodes
-  int      hierInd_   { -1 };    //!< hier index
-  bool     showTitle_ { false }; //!< show title
-  bool     expanded_  { true };  //!< is expanded
+  Nodes            nodes_;               //!< child nodes
+  Children         children_;            //!< child hier nodes
+  int              hierInd_   { -1 };    //!< hier index
+  bool             showTitle_ { false }; //!< show title
+  bool             expanded_  { true };  //!< is expanded
+  CQChartsHierSize hierSize_;            //!< cached hier size
 };
 
 //---
@@ -557,10 +566,19 @@ class CQChartsTreeMapPlot : public CQChartsHierPlot,
   CQChartsTreeMapNode *hierAddNode(CQChartsTreeMapHierNode *parent, const QString &name,
                                    double size, const QModelIndex &nameInd) const;
 
+  //! flat model row data (path and size are added to hier builder)
+  struct FlatRowData {
+    QString       name;  //!< node name
+    QModelIndex   ind;   //!< node model index
+    CQChartsColor color; //!< node color
+  };
+
+  using FlatRows = std::vector<FlatRowData>;
+
   void loadFlat() const;
 
-  CQChartsTreeMapNode *flatAddNode(const QStringList &nameStrs, double size,
-                                   const QModelIndex &nameInd, const QString &name) const;
+  void addFlatNodes(const CQChartsHierBuilder &builder, const FlatRows &flatRows, int ind,
+                    CQChartsTreeMapHierNode *parent) const;
 
   void addExtraNodes(CQChartsTreeMapHierNode *hier) const;
 
@@ -568,8 +586,6 @@ class CQChartsTreeMapPlot : public CQChartsHierPlot,
 
   CQChartsTreeMapHierNode *childHierNode(CQChartsTreeMapHierNode *parent,
                                          const QString &name) const;
-  CQChartsTreeMapNode *childNode(CQChartsTreeMapHierNode *parent,
-                                 const QString &name) const;
 
   //---
 
@@ -63,6 +63,7 @@ class QRubberBand;
 class QScrollBar;
 class QLabel;
 class QMenu;
+class QIODevice;
 
 CQCHARTS_NAMED_SHAPE_DATA(Selected,selected)
 CQCHARTS_NAMED_SHAPE_DATA(Inside,inside)
@@ -533,6 +534,8 @@ class CQChartsView : public QFrame,
 
   void doResize(int w, int h);
 
+  void setPixelSize(int w, int h);
+
   //---
 
   // handle paint
@@ -575,9 +578,41 @@ class CQChartsView : public QFrame,
   // write javascript
   bool writeScript(const QString &filename, CQChartsPlot *plot=nullptr);
 
+  //---
+
+  //! headless render data
+  struct RenderData {
+    CQChartsView* view { nullptr }; //!< view to render
+    CQChartsPlot* plot { nullptr }; //!< plot to render (all plots if null)
+    QString       filename;         //!< output file (png or svg)
+    QSize         size;             //!< pixel size (current size if unset)
+    double        dpi  { -1.0 };    //!< dots per inch (default if <= 0)
+  };
+
+  using RenderDatas = std::vector<RenderData>;
+
+  // render (without widget) at explicit pixel size and dpi
+  QImage renderImage(const QSize &size, double dpi=-1.0, CQChartsPlot *plot=nullptr);
+
+  bool renderSVG(QIODevice *device, const QSize &size, double dpi=-1.0,
+                 CQChartsPlot *plot=nullptr);
+
+  bool renderFile(const QString &filename, const QSize &size, double dpi=-1.0,
+                  CQChartsPlot *plot=nullptr);
+
+  bool renderData(QByteArray &data, const QString &format, const QSize &size,
+                  double dpi=-1.0, CQChartsPlot *plot=nullptr);
+
+  // render views to files (calc, paint and file write of separate views run concurrently)
+  static bool renderFiles(const RenderDatas &renderDatas, int numThreads=-1);
+
   const QString &scriptSelectProc() const { return scriptSelectProc_; }
   void setScriptSelectProc(const QString &s) { scriptSelectProc_ = s; }
 
+  //! get/set write script plot objects as typed array buffers (generic js renderer)
+  bool isScriptCompact() const { return scriptCompact_; }
+  void setScriptCompact(bool b) { scriptCompact_ = b; }
+
   //---
 
   // set pen/brush
@@ -1036,6 +1071,30 @@ class CQChartsView : public QFrame,
   void windowToPixelI(double wx, double wy, double &px, double &py) const;
   void pixelToWindowI(double px, double py, double &wx, double &wy) const;
 
+  //! saved plot data range for headless render
+  struct RenderPlotRange {
+    CQChartsPlot*       plot { nullptr }; //!< plot
+    CQChartsGeom::Range range;            //!< saved data range
+  };
+
+  using RenderPlotRanges = std::vector<RenderPlotRange>;
+
+  //! saved state for headless render
+  struct RenderState {
+    QSize            size;                  //!< saved pixel size
+    bool             bufferLayers { true }; //!< saved buffer layers
+    RenderPlotRanges plotRanges;            //!< saved plot data ranges
+  };
+
+  QSize renderSize(const QSize &size) const;
+
+  RenderState beginRender(const QSize &size);
+  void syncRender();
+  void endRender(const RenderState &state);
+
+  QImage paintImage(const QSize &size, double dpi, CQChartsPlot *plot);
+  bool paintSVG(QIODevice *device, const QSize &size, double dpi, CQChartsPlot *plot);
+
  private:
   //! process all mouse point plots using lambda
   template<typename FUNCTION, typename DATA=int>
@@ -1179,6 +1238,7 @@ class CQChartsView : public QFrame,
   CQChartsEditKeyDlg*   editKeyDlg_        { nullptr };           //!< edit key dialog
   CQChartsEditTitleDlg* editTitleDlg_      { nullptr };           //!< edit title dialog
   QString               scriptSelectProc_;                        //!< script select proc
+  bool                  scriptCompact_     { false };             //!< script compact buffers
   Annotations           pressAnnotations_;                        //!< press annotations
   CQChartsDocument*     noDataText_        { nullptr };
   bool                  updateNoData_      { true };
@@ -13,6 +13,7 @@ class CQChartsXYLabelObj;
 class CQChartsXYPolylineObj;
 class CQChartsArrow;
 class CQChartsGrahamHull;
+class CQChartsPolygonDecimator;
 
 //---
 
@@ -424,6 +425,9 @@ class CQChartsXYPolylineObj : public CQChartsPlotObj {
 
   void calcPenBrush(CQChartsPenBrush &penBrush, bool updateState) const;
 
+  //! number of points drawn (after decimation)
+  int numDrawPoints() const { return numDrawPoints_; }
+
   //---
 
   void writeScriptData(CQChartsScriptPainter *device) const override;
@@ -444,6 +448,9 @@ class CQChartsXYPolylineObj : public CQChartsPlotObj {
   CQChartsFitData       bestFit_;              //!< best fit data
   CQStatData            statData_;             //!< statistics data
   CQChartsGrahamHull*   hull_     { nullptr }; //!< hull
+
+  CQChartsPolygonDecimator* decimator_     { nullptr }; //!< line decimator
+  int                       numDrawPoints_ { 0 };       //!< number of drawn points
 };
 
 //---
@@ -504,6 +511,9 @@ class CQChartsXYPolygonObj : public CQChartsPlotObj {
 
   void calcPenBrush(CQChartsPenBrush &penBrush, bool updateState) const;
 
+  //! number of points drawn (after decimation)
+  int numDrawPoints() const { return numDrawPoints_; }
+
   //---
 
   void writeScriptData(CQChartsScriptPainter *device) const override;
@@ -519,6 +529,9 @@ class CQChartsXYPolygonObj : public CQChartsPlotObj {
   QString               name_;                 //!< name
   bool                  under_    { false };   //!< has under points
   CQChartsSmooth*       smooth_   { nullptr }; //!< smooth object
+
+  CQChartsPolygonDecimator* decimator_     { nullptr }; //!< polygon decimator
+  int                       numDrawPoints_ { 0 };       //!< number of drawn points
 };
 
 //---
@@ -626,6 +639,8 @@ class CQChartsXYPlot : public CQChartsPointPlot,
   // lines (selectable, rounded, display, stroke)
   Q_PROPERTY(bool linesSelectable READ isLinesSelectable WRITE setLinesSelectable)
   Q_PROPERTY(bool roundedLines    READ isRoundedLines    WRITE setRoundedLines   )
+  Q_PROPERTY(bool decimateLines   READ isDecimateLines   WRITE setDecimateLines  )
+  Q_PROPERTY(int  decimatedPoints READ numDecimatedPoints)
 
   CQCHARTS_LINE_DATA_PROPERTIES
 
@@ -701,13 +716,24 @@ class CQChartsXYPlot : public CQChartsPointPlot,
 
   //---
 
-  // lines selectable, rounded
+  // lines selectable, rounded, decimate
   bool isLinesSelectable() const { return linesSelectable_; }
   void setLinesSelectable(bool b);
 
   bool isRoundedLines() const { return roundedLines_; }
   void setRoundedLines(bool b);
 
+  // decimate lines to pixel columns
+  bool isDecimateLines() const { return decimateLines_; }
+  void setDecimateLines(bool b);
+
+  int numDecimatedPoints() const;
+
+  const CQChartsGeom::Polygon &decimatedPolygon(CQChartsPaintDevice *device,
+                                                CQChartsPolygonDecimator *decimator,
+                                                const CQChartsGeom::BBox &bbox,
+                                                const CQChartsGeom::Polygon &poly) const;
+
   //---
 
  private:
@@ -753,8 +779,16 @@ class CQChartsXYPlot : public CQChartsPointPlot,
 
   bool headerSeriesData(std::vector<double> &x) const;
 
-  bool rowData(const ModelVisitor::VisitData &data, double &x, std::vector<double> &yv,
-               QModelIndex &ind, bool skipBad) const;
+  //! cached x and y column values
+  struct XYColumnViews {
+    ColumnViewP              x;
+    std::vector<ColumnViewP> y;
+  };
+
+  void initColumnViews(XYColumnViews &views) const;
+
+  bool rowData(const ModelVisitor::VisitData &data, const XYColumnViews &views,
+               double &x, std::vector<double> &yv, QModelIndex &ind, bool skipBad) const;
 
   //---
 
@@ -883,6 +917,7 @@ class CQChartsXYPlot : public CQChartsPointPlot,
   bool cumulative_      { false }; //!< cumulate values
   bool roundedLines_    { false }; //!< draw rounded (smooth) lines
   bool linesSelectable_ { false }; //!< are lines selectable
+  bool decimateLines_   { true };  //!< decimate lines to pixel columns
 
   // fill under data
   FillUnderData fillUnderData_; //!< fill under data
@@ -2,6 +2,7 @@
 #define CQCsvModel_H
 
 #include <CQDataModel.h>
+#include <functional>
 
 /*!
  * \brief load csv into data model
@@ -14,6 +15,10 @@ class CQCsvModel : public CQDataModel {
   Q_PROPERTY(bool  firstColumnHeader READ isFirstColumnHeader WRITE setFirstColumnHeader)
   Q_PROPERTY(QChar separator         READ separator           WRITE setSeparator        )
 
+ public:
+  //! load progress callback (percent complete, return false to cancel load)
+  using ProgressProc = std::function<bool(int)>;
+
  public:
   CQCsvModel();
 
@@ -43,6 +48,9 @@ class CQCsvModel : public CQDataModel {
   const QStringList &columns() const { return columns_; }
   void setColumns(const QStringList &v) { columns_ = v; }
 
+  //! set load progress callback
+  void setProgressProc(const ProgressProc &proc) { progressProc_ = proc; }
+
   //---
 
   //! load CSV from specified file
@@ -62,12 +70,13 @@ class CQCsvModel : public CQDataModel {
   static std::string encodeVariant(const QVariant &var, const QChar &separator=',');
 
  protected:
-  bool        commentHeader_     { false }; //!< first comment line has column names
-  bool        firstLineHeader_   { false }; //!< first non-comment line has column names
-  bool        firstColumnHeader_ { false }; //!< first column in each line is row name
-  QChar       separator_         { ',' };   //!< field separator
-  int         maxRows_           { -1 };    //!< max rows
-  QStringList columns_;                     //!< specific columns (and order)
+  bool         commentHeader_     { false }; //!< first comment line has column names
+  bool         firstLineHeader_   { false }; //!< first non-comment line has column names
+  bool         firstColumnHeader_ { false }; //!< first column in each line is row name
+  QChar        separator_         { ',' };   //!< field separator
+  int          maxRows_           { -1 };    //!< max rows
+  QStringList  columns_;                     //!< specific columns (and order)
+  ProgressProc progressProc_;                //!< load progress callback
 };
 
 #endif
@@ -0,0 +1,93 @@
+#ifndef CQCsvParser_H
+#define CQCsvParser_H
+
+#include <QString>
+#include <vector>
+
+/*!
+ * \brief parse CSV lines and fields from in memory (mapped) file data
+ *
+ * Line boundaries are found by scanning file chunks in parallel, newlines are recorded
+ * for both possible quote states at the chunk start and the correct set is chosen when
+ * the quote counts of the preceding chunks are known.
+ *
+ * Fields are returned as spans of the file data so only required fields need to be
+ * converted to strings.
+ */
+class CQCsvParser {
+ public:
+  //! line type
+  enum class LineType {
+    BLANK,
+    COMMENT,
+    DATA
+  };
+
+  //! field span in data
+  struct Field {
+    qint64 pos    { 0 };     //!< start position
+    int    len    { 0 };     //!< length
+    bool   quoted { false }; //!< starts with quote (needs unquote)
+  };
+
+  using Fields   = std::vector<Field>;
+  using LinePoss = std::vector<qint64>;
+
+ public:
+  CQCsvParser(const char *data, qint64 len);
+
+  //! get/set field separator
+  char separator() const { return separator_; }
+  void setSeparator(char c) { separator_ = c; }
+
+  //! get/set number of threads used to find lines
+  int numThreads() const { return numThreads_; }
+  void setNumThreads(int n) { numThreads_ = std::max(n, 1); }
+
+  //---
+
+  //! find line start positions (stop after max data lines if > 0)
+  void findLines(int maxDataLines=-1);
+
+  //! get number of lines
+  int numLines() const { return int(lineStarts_.size()); }
+
+  //! get line type
+  LineType lineType(int i) const;
+
+  //! get line fields
+  void lineFields(int i, Fields &fields) const;
+
+  //! get field string
+  QString fieldString(const Field &field) const { return fieldString(data_, field); }
+
+  //! get comment line text (after comment char and leading space)
+  QString commentText(int i) const;
+
+  //---
+
+  //! split text into fields
+  static void splitFields(const char *data, qint64 start, qint64 end, char separator,
+                          Fields &fields);
+
+  //! get field string from data
+  static QString fieldString(const char *data, const Field &field);
+
+ private:
+  void findLinesSequential(int maxDataLines);
+  void findLinesParallel();
+
+  void lineRange(int i, qint64 &start, qint64 &end) const;
+
+  LineType calcLineType(qint64 start, qint64 end) const;
+
+ private:
+  const char* data_       { nullptr }; //!< file data
+  qint64      len_        { 0 };       //!< file data length
+  char        separator_  { ',' };     //!< field separator
+  int         numThreads_ { 1 };       //!< number of threads
+  LinePoss    lineStarts_;             //!< line start positions
+  qint64      end_        { 0 };       //!< end of last line
+};
+
+#endif
@@ -3,6 +3,7 @@
 
 #include <CQBaseModel.h>
 #include <QRegExp>
+#include <QHash>
 #include <vector>
 
 class CQModelDetails;
@@ -18,6 +19,7 @@ class CQDataModel : public CQBaseModel {
   Q_PROPERTY(bool    readOnly READ isReadOnly WRITE setReadOnly)
   Q_PROPERTY(QString filter   READ filter     WRITE setFilter  )
   Q_PROPERTY(QString filename READ filename   WRITE setFilename)
+  Q_PROPERTY(bool    columnar READ isColumnar WRITE setColumnar)
 
  public:
   CQDataModel();
@@ -48,6 +50,12 @@ class CQDataModel : public CQBaseModel {
 
   //--
 
+  //! get/set use columnar (typed per column) storage
+  bool isColumnar() const { return columnar_; }
+  void setColumnar(bool b);
+
+  //--
+
   // model interface
   int columnCount(const QModelIndex &parent=QModelIndex()) const override;
 
@@ -77,11 +85,92 @@ class CQDataModel : public CQBaseModel {
   typedef std::vector<QVariant> Cells;
   typedef std::vector<Cells>    Data;
 
+  //! typed storage for a single column (columnar mode)
+  struct ColumnStore {
+    enum class Type {
+      NONE,
+      VARIANT,
+      INTEGER,
+      REAL,
+      STRING
+    };
+
+    //! null value type (empty string or missing value)
+    enum NullType : unsigned char {
+      NOT_NULL,
+      NULL_EMPTY,
+      NULL_INVALID
+    };
+
+    using Integers   = std::vector<qint64>;
+    using Reals      = std::vector<double>;
+    using Codes      = std::vector<int>;
+    using Strings    = std::vector<QString>;
+    using StringInds = QHash<QString,int>;
+    using Nulls      = std::vector<unsigned char>;
+
+    Type       type { Type::NONE }; //!< storage type (none if all null)
+    Integers   integers;            //!< integer values
+    Reals      reals;               //!< real values
+    Codes      codes;               //!< string dictionary codes
+    Strings    strings;             //!< string dictionary
+    StringInds stringInds;          //!< string dictionary code lookup
+    Cells      variants;            //!< fallback variant values
+    Nulls      nulls;               //!< null type per row (size is number of rows)
+
+    int size() const { return int(nulls.size()); }
+  };
+
+  typedef std::vector<ColumnStore> ColumnStores;
+
  protected:
   void init(int numCols, int numRows);
 
   //---
 
+  //! convert between row (variant) and columnar (typed) storage
+  //! (column types are taken from the current base model column types)
+  void packColumns();
+  void unpackColumns();
+
+  //! load rows directly into columnar storage: init, append rows and finish
+  //! (finish applies current base model column types)
+  void initColumnarLoad(int numCols);
+  void appendColumnarRow(const Cells &cells);
+  void finishColumnarLoad();
+
+  //! append first numRows rows of column stores (e.g. parsed block of rows)
+  //! (each store must have at least numRows rows)
+  void appendColumnarStores(ColumnStores &columnStores, int numRows);
+
+  //! append value, string or null to column store (store type is widened as needed)
+  static void appendStoreValue (ColumnStore &store, const QVariant &var);
+  static void appendStoreString(ColumnStore &store, const QString &str);
+  static void appendStoreNull  (ColumnStore &store, ColumnStore::NullType nullType);
+
+  //! append first n rows of column store to column store (types are widened to match)
+  static void appendStore(ColumnStore &store, ColumnStore &store1, int n);
+
+  //! convert column store to storage for column type
+  static void applyStoreColumnType(ColumnStore &store, CQBaseModelType type);
+
+  //! convert column store values to specified storage type
+  static void convertStore(ColumnStore &store, ColumnStore::Type type);
+
+  //! get column store value
+  static QVariant storeValue(const ColumnStore &store, int r);
+
+  //! get dictionary code of string (added if new)
+  static int stringCode(ColumnStore &store, const QString &str);
+
+  //! get/set stored cell value (independent of storage mode)
+  bool isValidCell(int r, int c) const;
+
+  QVariant cellValue(int r, int c) const;
+  void setCellValue(int r, int c, const QVariant &value);
+
+  //---
+
   virtual void initFilter();
 
   virtual bool isFilterInited() const { return filterInited_; }
@@ -112,6 +201,10 @@ class CQDataModel : public CQBaseModel {
   Cells           hheader_;                  //!< horizontal header values
   Cells           vheader_;                  //!< vertical header values
   Data            data_;                     //!< row values
+  bool            columnar_     { false };   //!< use columnar storage
+  bool            packed_       { false };   //!< data is in columnar storage
+  ColumnStores    columnStores_;             //!< column values (columnar mode)
+  int             numRows_      { 0 };       //!< number of rows (columnar mode)
   bool            filterInited_ { false };   //!< filter initialized
   FilterDatas     filterDatas_;              //!< filter datas
   CQModelDetails* details_      { nullptr }; //!< model details
@@ -0,0 +1,132 @@
+#ifndef CQModelSortRanks_H
+#define CQModelSortRanks_H
+
+#include <QModelIndex>
+#include <QVariant>
+#include <QHash>
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+class QAbstractItemModel;
+
+/*!
+ * \brief sort rank of top level model rows for (multi) column key
+ *
+ * Key column values are extracted once into typed arrays (reals for numeric columns,
+ * dictionary codes for string columns, variants otherwise) and the row permutation
+ * is calculated with a parallel stable sort. Rows with equal keys have the same rank.
+ *
+ * A sort proxy model can then compare source rows by rank in lessThan.
+ *
+ * The key values and sorted row order are kept so changed rows can be re-ranked without
+ * extracting and sorting all rows again.
+ */
+class CQModelSortRanks {
+ public:
+  using Columns = std::vector<int>;
+  using Ranks   = std::vector<int>;
+  using CmpFn   = std::function<int (const QVariant &, const QVariant &)>;
+
+ public:
+  CQModelSortRanks();
+
+  //! get/set number of threads used for sort
+  int numThreads() const { return numThreads_; }
+  void setNumThreads(int n) { numThreads_ = std::max(n, 1); }
+
+  //! get/set compare function for non-numeric, non-string values (default cmpVariant)
+  const CmpFn &cmpFn() const { return cmpFn_; }
+  void setCmpFn(const CmpFn &fn) { cmpFn_ = fn; }
+
+  //! get/set string case sensitivity
+  Qt::CaseSensitivity caseSensitivity() const { return caseSensitivity_; }
+  void setCaseSensitivity(Qt::CaseSensitivity cs) { caseSensitivity_ = cs; }
+
+  //! get/set use locale aware string compare
+  bool isLocaleAware() const { return localeAware_; }
+  void setLocaleAware(bool b) { localeAware_ = b; }
+
+  //! are ranks calculated
+  bool isValid() const { return valid_; }
+
+  //! get key columns
+  const Columns &columns() const { return columns_; }
+
+  //! get key role
+  int role() const { return role_; }
+
+  //! reset ranks
+  void reset();
+
+  //! calc ascending ranks of model rows for key columns
+  bool calc(const QAbstractItemModel *model, const Columns &columns, int role=Qt::EditRole);
+
+  //! recalc ranks for current columns
+  bool recalc(const QAbstractItemModel *model) { return calc(model, columns_, role_); }
+
+  //! update ranks for changed rows (recalcs all rows if keys can't be updated)
+  bool updateRows(const QAbstractItemModel *model, int row1, int row2);
+
+  //! get row rank
+  int rank(int row) const { return ranks_[row]; }
+
+  //! compare source rows using ranks (ok is false if ranks don't apply to indices)
+  bool lessThan(const QModelIndex &lhs, const QModelIndex &rhs, bool &ok) const;
+
+  //! default compare function
+  static int cmpVariant(const QVariant &var1, const QVariant &var2,
+                        Qt::CaseSensitivity cs=Qt::CaseSensitive, bool localeAware=false);
+
+  //! compare strings
+  static int cmpString(const QString &str1, const QString &str2,
+                       Qt::CaseSensitivity cs=Qt::CaseSensitive, bool localeAware=false);
+
+  //! is variant a numeric type
+  static bool isNumeric(const QVariant &var);
+
+ private:
+  //! typed key column values
+  struct Key {
+    enum class Type {
+      REAL,
+      CODE,
+      VARIANT
+    };
+
+    Type                  type { Type::VARIANT }; //!< value type
+    std::vector<double>   reals;                  //!< real values
+    std::vector<int>      codes;                  //!< string dictionary codes
+    std::vector<QVariant> vars;                   //!< variant values
+    QHash<QString,int>    strCodes;               //!< string dictionary
+  };
+
+  using Keys = std::vector<Key>;
+  using Rows = std::vector<int>;
+
+  QVariant keyValue(const QAbstractItemModel *model, int row, int column, int role) const;
+
+  void calcKey(const QAbstractItemModel *model, int column, int role, int nr, Key &key) const;
+
+  bool updateKey(Key &key, int row, const QVariant &var) const;
+
+  void calcRanks();
+
+  int cmpRows(const Keys &keys, int row1, int row2) const;
+
+  void sortRows(const Keys &keys, std::vector<int> &rows) const;
+
+ private:
+  Columns             columns_;                               //!< key columns
+  int                 role_            { Qt::EditRole };      //!< key role
+  Ranks               ranks_;                                 //!< rank of each row
+  Keys                keys_;                                  //!< key column values
+  Rows                rows_;                                  //!< rows in key order
+  bool                valid_           { false };             //!< are ranks valid
+  int                 numThreads_      { 1 };                 //!< number of threads
+  CmpFn               cmpFn_;                                 //!< variant compare function (optional)
+  Qt::CaseSensitivity caseSensitivity_ { Qt::CaseSensitive }; //!< string case sensitivity
+  bool                localeAware_     { false };             //!< locale aware string compare
+};
+
+#endif
@@ -4,8 +4,10 @@
 #include <CQBaseModel.h>
 #include <QStringList>
 #include <QString>
-#include <map>
-#include <set>
+#include <QHash>
+#include <algorithm>
+#include <unordered_map>
+#include <memory>
 #include <vector>
 #include <cassert>
 
@@ -17,6 +19,10 @@
  * . cells    are calculated values for x/y key
  *
  * If include totals there is an extra row and column for the column/row totals
+ *
+ * Key column values are dictionary encoded and rows are aggregated into cells using
+ * hash tables of integer keys, partitioned by cell key so partitions are calculated
+ * in parallel. Each cell only keeps the accumulators needed for the value type.
  */
 class CQPivotModel : public CQBaseModel {
   Q_OBJECT
@@ -31,7 +37,8 @@ class CQPivotModel : public CQBaseModel {
     SUM,
     MIN,
     MAX,
-    MEAN
+    MEAN,
+    MEDIAN
   };
 
   Q_ENUMS(ValueType);
@@ -128,83 +135,144 @@ class CQPivotModel : public CQBaseModel {
   void calcData();
 
  private:
-  class Keys {
+  using Codes = std::vector<int>;
+  using Rows  = std::vector<int>;
+
+  //! dictionary of column value strings
+  class Dictionary {
    public:
-    Keys() { }
+    Dictionary() { }
 
-    void add(const QString &str) {
-      keys_.push_back(str);
+    // get code for string (added if new)
+    int code(const QString &str);
 
-      if (key_ != "")
-        key_ += "/";
+    const QString &str(int code) const { return strs_[code]; }
 
-      key_ += str;
-    }
+   private:
+    QHash<QString,int> codes_;
+    QStringList        strs_;
+  };
+
+  using Dictionaries = std::vector<Dictionary>;
 
-    bool empty() const { return keys_.empty(); }
+  //! unique key tuples (column value codes)
+  class KeyTable {
+   public:
+    KeyTable() { }
 
-    QString key() const { return key_; }
+    // get id for key tuple (added if new)
+    int id(const Codes &codes, bool &added);
 
    private:
-    using Strs = std::vector<QString>;
+    struct CodesHash {
+      std::size_t operator()(const Codes &codes) const;
+    };
 
-    QString key_;
-    Strs    keys_;
-  };
+    using CodesIds = std::unordered_map<Codes,int,CodesHash>;
 
-  using KeyInd  = std::map<QString,int>;
-  using IndKeys = std::map<int,Keys>;
+    CodesIds ids_;
+  };
 
-  class Values {
+  //! streaming median estimate (P-square algorithm, exact for less than five values)
+  class MedianSketch {
    public:
-    using Reals = std::vector<double>;
+    MedianSketch() { }
+
+    void add(double r);
+
+    double value() const;
+
+   private:
+    int    n_ { 0 };                             //!< number of values
+    double q_[5] { 0.0, 0.0, 0.0, 0.0, 0.0 };    //!< marker heights
+    double pos_[5] { 1.0, 2.0, 3.0, 4.0, 5.0 };  //!< marker positions
+    double npos_[5] { 1.0, 2.0, 3.0, 4.0, 5.0 }; //!< desired marker positions
+  };
 
+  //! accumulated values for cell (only value type accumulators are updated)
+  class Values {
    public:
     Values() { }
 
     // add real value
-    void add(double r) {
-      min_ = (! rvalues_.empty() ? std::min(min_, r) : r);
-      max_ = (! rvalues_.empty() ? std::max(max_, r) : r);
+    void addReal(double r, bool median) {
+      min_ = (rcount_ > 0 ? std::min(min_, r) : r);
+      max_ = (rcount_ > 0 ? std::max(max_, r) : r);
 
       sum_ += r;
 
-      rvalues_.push_back(r);
+      ++rcount_;
+
+      if (median) {
+        if (! median_)
+          median_ = std::make_shared<MedianSketch>();
+
+        median_->add(r);
+      }
     }
 
-    // add string value and index
-    void add(const QModelIndex &ind, const QString &s) {
-      inds_   .push_back(ind);
-      svalues_.insert(s);
+    // add value row (if needed) and string code
+    void addValue(int row, int str, bool unique, bool keepRow) {
+      ++count_;
+
+      if (keepRow)
+        rows_.push_back(row);
+
+      if (unique)
+        strs_.push_back(str);
     }
 
+    // calc unique count from added string codes
+    void calcUnique();
+
     double sum() const { return sum_; }
     double min() const { return min_; }
     double max() const { return max_; }
 
-    double mean() const { int nv = rvalues_.size(); return (nv > 0 ? sum_/nv : 0.0); }
+    double mean() const { return (rcount_ > 0 ? sum_/rcount_ : 0.0); }
 
-    int count      () const { return inds_.size(); }
-    int countUnique() const { return svalues_.size(); }
+    double median() const { return (median_ ? median_->value() : 0.0); }
 
-    const Inds &inds() const { return inds_; }
+    int count      () const { return count_; }
+    int countUnique() const { return countUnique_; }
 
-    int          rcount () const { return rvalues_.size(); }
-    const Reals &rvalues() const { return rvalues_; }
+    const Rows &rows() const { return rows_; }
+
+    int rcount() const { return rcount_; }
 
    private:
-    using Strings = std::set<QString>;
-
-    Reals   rvalues_;
-    Inds    inds_;
-    Strings svalues_;
-    double  sum_   { 0.0 };
-    double  min_   { 0.0 };
-    double  max_   { 0.0 };
+    using MedianSketchP = std::shared_ptr<MedianSketch>;
+
+    Rows          rows_;               //!< rows of values (model indices)
+    Codes         strs_;               //!< value string codes (count unique)
+    MedianSketchP median_;             //!< median sketch (median)
+    int           count_       { 0 };  //!< number of values
+    int           rcount_      { 0 };  //!< number of real values
+    int           countUnique_ { 0 };  //!< number of unique values
+    double        sum_         { 0.0 }; //!< sum of real values
+    double        min_         { 0.0 }; //!< min real value
+    double        max_         { 0.0 }; //!< max real value
   };
 
-  using VValues  = std::map<QString,Values>;
-  using HVValues = std::map<QString,VValues>;
+  //! encoded source row
+  struct RowData {
+    enum Flags {
+      VALID = (1<<0),
+      REAL  = (1<<1)
+    };
+
+    int    hkey  { -1 };  //!< horizontal key column
+    int    vkey  { -1 };  //!< vertical key row
+    double r     { 0.0 }; //!< real value
+    int    str   { -1 };  //!< value string code
+    uint   flags { 0 };   //!< value flags
+  };
+
+  using RowDatas = std::vector<RowData>;
+
+  //! cell values for partition of cell keys
+  using CellValues    = std::unordered_map<qint64,Values>;
+  using CellValuesArr = std::vector<CellValues>;
 
   //---
 
@@ -217,7 +285,17 @@ class CQPivotModel : public CQBaseModel {
 
   using ValueDatas = std::vector<ValueData>;
 
+  using KeyInd = QHash<QString,int>;
+
  private:
+  static qint64 cellKey(int hkey, int vkey) { return (qint64(hkey) << 32) | qint64(uint(vkey)); }
+
+  int cellPartition(qint64 key) const;
+
+  const Values *cellValues(int hkey, int vkey) const;
+
+  void calcCellValues(const RowDatas &rowDatas, const Rows &rows, CellValues &cellValues) const;
+
   double typeValue(const Values &values) const;
 
  private:
@@ -230,11 +308,12 @@ class CQPivotModel : public CQBaseModel {
 
   // calculated data
   bool                modelValid_ { false }; //!< is data value
+  bool                keepRows_   { false }; //!< keep value rows (model indices requested)
   KeyInd              hKeysCol_;             //!< horizontal key to column
-  IndKeys             hColKeys_;             //!< horizontal column to key
-  KeyInd              vKeysRow_;             //!< vertical key to roe
-  IndKeys             vRowKeys_;             //!< row to vertical key
-  HVValues            values_;               //!< grid values
+  QStringList         hColKeys_;             //!< horizontal column to key
+  KeyInd              vKeysRow_;             //!< vertical key to row
+  QStringList         vRowKeys_;             //!< row to vertical key
+  CellValuesArr       cellValues_;           //!< grid values (partitioned by cell key)
   QString             hheader_;              //!< horizontal header
   QString             vheader_;              //!< vertical header
   ValueDatas          vdata_;                //!< vertical row data
@@ -1,10 +1,13 @@
 #ifndef CQSortModel_H
 #define CQSortModel_H
 
+#include <CQModelSortRanks.h>
 #include <QSortFilterProxyModel>
 
 /*!
  * \brief base class for sort model
+ *
+ * Sort uses key ranks of source rows calculated from typed column values.
  */
 class CQSortModel : public QSortFilterProxyModel {
   Q_OBJECT
@@ -17,8 +20,25 @@ class CQSortModel : public QSortFilterProxyModel {
   const QString &filter() const { return filter_; }
   void setFilter(const QString &filter);
 
+  void setSourceModel(QAbstractItemModel *model) override;
+
+  //! sort by column
+  void sort(int column, Qt::SortOrder order=Qt::AscendingOrder) override;
+
+  //! sort by multiple key columns
+  void sortColumns(const std::vector<int> &columns, Qt::SortOrder order=Qt::AscendingOrder);
+
+ protected:
+  bool lessThan(const QModelIndex &lhs, const QModelIndex &rhs) const override;
+
+ private slots:
+  void sourceDataChangedSlot(const QModelIndex &from, const QModelIndex &to);
+
+  void sourceRowsChangedSlot();
+
  private:
-  QString filter_; //!< filter
+  QString          filter_;    //!< filter
+  CQModelSortRanks sortRanks_; //!< sort key ranks
 };
 
 #endif
@@ -2,8 +2,9 @@
 #define CQSummaryModel_H
 
 #include <QSortFilterProxyModel>
+#include <random>
 #include <vector>
-#include <set>
+#include <map>
 
 class CQSummaryModel : public QAbstractProxyModel {
   Q_OBJECT
@@ -16,6 +17,11 @@ class CQSummaryModel : public QAbstractProxyModel {
 
   // random
   Q_PROPERTY(bool          randomMode  READ isRandomMode WRITE setRandomMode )
+  Q_PROPERTY(int           randomSeed  READ randomSeed   WRITE setRandomSeed )
+
+  // stratified
+  Q_PROPERTY(bool          stratifiedMode READ isStratifiedMode WRITE setStratifiedMode)
+  Q_PROPERTY(int           groupColumn    READ groupColumn      WRITE setGroupColumn   )
 
   // sort
   Q_PROPERTY(bool          sortMode    READ isSortMode   WRITE setSortMode   )
@@ -31,6 +37,9 @@ class CQSummaryModel : public QAbstractProxyModel {
   // rows mode
   Q_PROPERTY(bool          rowsMode    READ isRowsMode   WRITE setRowsMode   )
 
+  // sample
+  Q_PROPERTY(double        sampleFraction READ sampleFraction)
+
   Q_ENUMS(Mode)
 
  public:
@@ -39,7 +48,8 @@ class CQSummaryModel : public QAbstractProxyModel {
     RANDOM,
     SORTED,
     PAGED,
-    ROWS
+    ROWS,
+    STRATIFIED
   };
 
   using RowNums = std::vector<int>;
@@ -69,10 +79,23 @@ class CQSummaryModel : public QAbstractProxyModel {
 
   //---
 
-  // random
+  // random (reservoir sample of rows)
   bool isRandomMode() const { return mode_ == Mode::RANDOM; }
   void setRandomMode(bool b) { setMode(b ? Mode::RANDOM : Mode::NORMAL); }
 
+  // random seed for reproducible sample (-1 for non-deterministic)
+  int randomSeed() const { return randomSeed_; }
+  void setRandomSeed(int i);
+
+  //---
+
+  // stratified (reservoir sample per group)
+  bool isStratifiedMode() const { return mode_ == Mode::STRATIFIED; }
+  void setStratifiedMode(bool b) { setMode(b ? Mode::STRATIFIED : Mode::NORMAL); }
+
+  int groupColumn() const { return groupColumn_; }
+  void setGroupColumn(int i);
+
   //---
 
   // sort data
@@ -111,6 +134,14 @@ class CQSummaryModel : public QAbstractProxyModel {
 
   //---
 
+  // number of source rows
+  int sourceRowCount() const;
+
+  // fraction of source rows in model
+  double sampleFraction() const;
+
+  //---
+
   // # Abstract Model APIS
 
   // get column count
@@ -153,18 +184,42 @@ class CQSummaryModel : public QAbstractProxyModel {
   // map proxy index to source index
   QModelIndex mapToSource(const QModelIndex &proxyIndex) const override;
 
+ private slots:
+  void sourceRowsInsertedSlot(const QModelIndex &parent, int first, int last);
+
+  void sourceResetSlot();
+
  private:
-  using RowSet = std::set<int>;
+  using RowInds = std::vector<int>;
+  using RowMap  = std::map<int,int>;
 
   void resetMapping();
 
   void initMapping();
 
-  void randRows(RowSet &rowSet, int n, int nr) const;
+  bool isSampleMode() const { return mode_ == Mode::RANDOM || mode_ == Mode::STRATIFIED; }
+
+  void initSample();
+
+  bool isValidSample() const;
+
+  void addSampleRows(int row1, int row2);
+
+  void updateSampleMapping();
+
+  double randReal();
 
  private:
-  using RowInds = std::vector<int>;
-  using RowMap  = std::map<int,int>;
+  //! reservoir sample state
+  struct Sample {
+    int     numRows  { 0 };   //!< number of rows seen
+    RowInds rows;             //!< sampled rows
+    double  w        { 1.0 }; //!< skip weight (random mode)
+    int     nextRow  { 0 };   //!< next row to replace (random mode)
+  };
+
+  using GroupSamples = std::map<QString,Sample>;
+  using RandEngine   = std::mt19937;
 
   // mode
   Mode          mode_        { Mode::NORMAL };       //!< summary mode
@@ -172,6 +227,12 @@ class CQSummaryModel : public QAbstractProxyModel {
   // max rows
   int           maxRows_     { 1000 };               //!< max rows
 
+  // random
+  int           randomSeed_  { -1 };                 //!< random seed
+
+  // stratified
+  int           groupColumn_ { 0 };                  //!< group column
+
   // sort
   int           sortColumn_  { 0 };                  //!< sort column
   int           sortRole_    { Qt::EditRole };       //!< sort role
@@ -184,6 +245,11 @@ class CQSummaryModel : public QAbstractProxyModel {
   // rows
   RowNums       rowNums_;                            //!< specific rows numbers
 
+  // sample
+  Sample        sample_;                             //!< random sample
+  GroupSamples  groupSamples_;                       //!< stratified group samples
+  RandEngine    randEngine_;                         //!< random engine
+
   // cache
   RowInds       rowInds_;                            //!< row indices
   RowMap        indRows_;                            //!< index rows
@@ -22,6 +22,7 @@ CQCharts.cpp \
 CQChartsFilterModel.cpp \
 CQChartsExprModel.cpp \
 CQChartsExprModelFn.cpp \
+CQChartsExprCompiler.cpp \
 CQChartsVarsModel.cpp \
 CQChartsTclModel.cpp \
 CQChartsExprDataModel.cpp \
@@ -140,6 +141,8 @@ CQChartsColumnEval.cpp \
 CQChartsFilterEdit.cpp \
 \
 CQChartsModelData.cpp \
+CQChartsColumnView.cpp \
+CQChartsColumnSummary.cpp \
 CQChartsModelDetails.cpp \
 CQChartsModelExprMatch.cpp \
 CQChartsModelFilter.cpp \
@@ -169,6 +172,7 @@ CQChartsColorStops.cpp \
 CQChartsFont.cpp \
 CQChartsNamePair.cpp \
 CQChartsPolygonList.cpp \
+CQChartsPolygonPyramid.cpp \
 CQChartsPosition.cpp \
 CQChartsLength.cpp \
 CQChartsMargin.cpp \
@@ -176,6 +180,7 @@ CQChartsReals.cpp \
 CQChartsPoints.cpp \
 CQChartsRect.cpp \
 CQChartsPolygon.cpp \
+CQChartsPolygonDecimator.cpp \
 CQChartsPlotMargin.cpp \
 CQChartsConnectionList.cpp \
 CQChartsSides.cpp \
@@ -183,12 +188,15 @@ CQChartsFillUnder.cpp \
 CQChartsPaletteName.cpp \
 \
 CQChartsSymbol.cpp \
+CQChartsSymbolCache.cpp \
+CQChartsTextCache.cpp \
 CQChartsImage.cpp \
 CQChartsPath.cpp \
 CQChartsStyle.cpp \
 CQChartsBoxWhisker.cpp \
 CQChartsDensity.cpp \
 CQChartsGrahamHull.cpp \
+CQChartsHierBuilder.cpp \
 CQChartsBivariateDensity.cpp \
 \
 CQChartsAxisSide.cpp \
@@ -218,6 +226,7 @@ CQChartsAnalyzeModel.cpp \
 CQChartsDelaunay.cpp \
 CQChartsDendrogram.cpp \
 CQChartsHull3D.cpp \
+CQChartsSweepDelaunay.cpp \
 \
 CQChartsTitleEdit.cpp \
 CQChartsKeyEdit.cpp \
@@ -279,6 +288,7 @@ CQChartsPropertyViewTree.cpp \
 CQChartsPropertyViewEditor.cpp \
 \
 CQCsvModel.cpp \
+CQCsvParser.cpp \
 CQTsvModel.cpp \
 CQJsonModel.cpp \
 CQGnuDataModel.cpp \
@@ -292,6 +302,7 @@ CQModelNameValues.cpp \
 CQModelUtil.cpp \
 CQModelVisitor.cpp \
 CQSortModel.cpp \
+CQModelSortRanks.cpp \
 CQValueSet.cpp \
 \
 CQSummaryModel.cpp \
@@ -321,6 +332,7 @@ HEADERS += \
 ../include/CQChartsFilterModel.h \
 ../include/CQChartsExprModel.h \
 ../include/CQChartsExprModelFn.h \
+../include/CQChartsExprCompiler.h \
 ../include/CQChartsVarsModel.h \
 ../include/CQChartsTclModel.h \
 ../include/CQChartsExprDataModel.h \
@@ -414,12 +426,15 @@ HEADERS += \
 ../include/CQChartsValueSet.h \
 ../include/CQChartsPlotSymbol.h \
 ../include/CQChartsSymbol.h \
+../include/CQChartsSymbolCache.h \
+../include/CQChartsTextCache.h \
 ../include/CQChartsImage.h \
 ../include/CQChartsPath.h \
 ../include/CQChartsStyle.h \
 ../include/CQChartsBoxWhisker.h \
 ../include/CQChartsDensity.h \
 ../include/CQChartsGrahamHull.h \
+../include/CQChartsHierBuilder.h \
 ../include/CQChartsBivariateDensity.h \
 \
 ../include/CQChartsFillPattern.h \
@@ -434,6 +449,7 @@ HEADERS += \
 ../include/CQChartsValueInd.h \
 ../include/CQChartsNameValues.h \
 ../include/CQChartsQuadTree.h \
+../include/CQChartsRTree.h \
 ../include/CQChartsEnv.h \
 \
 ../include/CQChartsPaintDevice.h \
@@ -472,6 +488,8 @@ HEADERS += \
 ../include/CQChartsFilterEdit.h \
 \
 ../include/CQChartsModelData.h \
+../include/CQChartsColumnView.h \
+../include/CQChartsColumnSummary.h \
 ../include/CQChartsModelDetails.h \
 ../include/CQChartsModelExprMatch.h \
 ../include/CQChartsModelFilter.h \
@@ -495,6 +513,7 @@ HEADERS += \
 ../include/CQChartsFont.h \
 ../include/CQChartsNamePair.h \
 ../include/CQChartsPolygonList.h \
+../include/CQChartsPolygonPyramid.h \
 ../include/CQChartsPosition.h \
 ../include/CQChartsLength.h \
 ../include/CQChartsMargin.h \
@@ -502,6 +521,7 @@ HEADERS += \
 ../include/CQChartsPoints.h \
 ../include/CQChartsRect.h \
 ../include/CQChartsPolygon.h \
+../include/CQChartsPolygonDecimator.h \
 ../include/CQChartsPlotMargin.h \
 ../include/CQChartsConnectionList.h \
 ../include/CQChartsSides.h \
@@ -521,6 +541,7 @@ HEADERS += \
 ../include/CQChartsDelaunay.h \
 ../include/CQChartsDendrogram.h \
 ../include/CQChartsHull3D.h \
+../include/CQChartsSweepDelaunay.h \
 \
 ../include/CQChartsTitleEdit.h \
 ../include/CQChartsKeyEdit.h \
@@ -582,6 +603,7 @@ HEADERS += \
 ../include/CQChartsPropertyViewEditor.h \
 \
 ../include/CQCsvModel.h \
+../include/CQCsvParser.h \
 ../include/CQTsvModel.h \
 ../include/CQJsonModel.h \
 ../include/CQGnuDataModel.h \
@@ -603,6 +625,7 @@ HEADERS += \
 ../include/CQModelUtil.h \
 ../include/CQModelVisitor.h \
 ../include/CQSortModel.h \
+../include/CQModelSortRanks.h \
 ../include/CQStatData.h \
 ../include/CQValueSet.h \
 \
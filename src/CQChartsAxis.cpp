@@ -8,6 +8,7 @@
 #include <CQChartsPaintDevice.h>
 #include <CQChartsDrawUtil.h>
 #include <CQChartsRotatedText.h>
+#include <CQChartsTextCache.h>
 
 #include <CQPropertyViewModel.h>
 #include <CQPropertyViewItem.h>
@@ -1709,11 +1710,13 @@ drawTickLabel(const CQChartsPlot *plot, CQChartsPaintDevice *device,
 
   view()->setPlotPainterFont(plot, device, axesTickLabelTextFont());
 
-  QFontMetricsF fm(device->font());
+  auto *textCache = CQChartsTextCacheInst;
 
-  double tw = fm.width(text);
-  double ta = fm.ascent();
-  double td = fm.descent();
+  auto fontData = textCache->fontData(device->font());
+
+  double tw = textCache->textWidth(device->font(), text);
+  double ta = fontData.ascent;
+  double td = fontData.descent;
 
   CQChartsAngle angle = axesTickLabelTextAngle();
 
@@ -2258,8 +2261,6 @@ drawAxisTickLabelDatas(const CQChartsPlot *plot, CQChartsPaintDevice *device)
 
   //---
 
-  QFontMetricsF fm(device->font());
-
   for (const auto &data : axisTickLabelDrawDatas_) {
     if (! data.visible)
       continue;
@@ -2316,11 +2317,13 @@ drawAxisLabel(const CQChartsPlot *plot, CQChartsPaintDevice *device,
 
   view()->setPlotPainterFont(plot, device, axesLabelTextFont());
 
-  QFontMetricsF fm(device->font());
+  auto *textCache = CQChartsTextCacheInst;
+
+  auto fontData = textCache->fontData(device->font());
 
-  double tw = fm.width(text);
-  double ta = fm.ascent();
-  double td = fm.descent();
+  double tw = textCache->textWidth(device->font(), text);
+  double ta = fontData.ascent;
+  double td = fontData.descent;
 
   CQChartsGeom::BBox bbox;
 
@@ -1,37 +1,196 @@
 #include <CQChartsBivariateDensity.h>
 #include <CQChartsPaintDevice.h>
 
-#include <CMathCorrelation.h>
 #include <CMathRound.h>
+#include <CMathUtil.h>
+#include <algorithm>
+
+namespace {
+
+// normalize value to range (clamped to 0-1)
+double normValue(double v, double vmin, double vmax)
+{
+  if (vmax <= vmin)
+    return 0.0;
+
+  return CMathUtil::clamp(CMathUtil::norm(v, vmin, vmax), 0.0, 1.0);
+}
+
+}
+
+//---
 
 void
 CQChartsBivariateDensity::
-draw(const CQChartsPlot *plot, CQChartsPaintDevice *device, const Data &data)
+calcGrid(const Values &values, const CQChartsGeom::RMinMax &xrange,
+         const CQChartsGeom::RMinMax &yrange, Grid &grid, int gridPoints)
 {
-  const int gridSize = std::max(data.gridSize, 1);
+  grid = Grid();
 
-  const double delta = data.delta;
+  if (values.empty() || ! xrange.isSet() || ! yrange.isSet())
+    return;
 
-  const double xmin = data.xrange.min();
-  const double xmax = data.xrange.max();
-  const double ymin = data.yrange.min();
-  const double ymax = data.yrange.max();
+  const int n = std::max(gridPoints, 2);
+
+  const double xmin = xrange.min();
+  const double xmax = xrange.max();
+  const double ymin = yrange.min();
+  const double ymax = yrange.max();
+
+  grid.nx     = n;
+  grid.ny     = n;
+  grid.xrange = xrange;
+  grid.yrange = yrange;
 
   //---
 
-  // create bivariate map of normalized values
-  std::vector<double> xv;
-  std::vector<double> yv;
+  // linear binning of normalized values to grid points and calc std dev
+  std::vector<double> counts(n*n, 0.0);
+
+  double sx = 0.0, sxx = 0.0, sy = 0.0, syy = 0.0;
+
+  for (const auto &v : values) {
+    double x1 = normValue(v.x, xmin, xmax);
+    double y1 = normValue(v.y, ymin, ymax);
 
-  for (const auto &v : data.values) {
-    double x1 = (xmax > xmin ? CMathUtil::norm(v.x, xmin, xmax) : 0.0);
-    double y1 = (ymax > ymin ? CMathUtil::norm(v.y, ymin, ymax) : 0.0);
+    sx += x1; sxx += x1*x1;
+    sy += y1; syy += y1*y1;
 
-    xv.push_back(x1);
-    yv.push_back(y1);
+    double tx = x1*(n - 1);
+    double ty = y1*(n - 1);
+
+    int ix = std::min(int(tx), n - 2);
+    int iy = std::min(int(ty), n - 2);
+
+    double fx = tx - ix;
+    double fy = ty - iy;
+
+    counts[ iy     *n + ix    ] += (1.0 - fx)*(1.0 - fy);
+    counts[ iy     *n + ix + 1] += fx*(1.0 - fy);
+    counts[(iy + 1)*n + ix    ] += (1.0 - fx)*fy;
+    counts[(iy + 1)*n + ix + 1] += fx*fy;
   }
 
-  CMathBivariate bivariate(xv, yv);
+  //---
+
+  // gaussian kernel bandwidth (Scott's rule) in grid points
+  double nv = values.size();
+
+  auto calcBandwidth = [&](double s, double ss) {
+    double sigma = std::sqrt(std::max(ss/nv - (s/nv)*(s/nv), 0.0));
+
+    double h = sigma*std::pow(nv, -1.0/6.0)*(n - 1);
+
+    return std::max(h, 0.5);
+  };
+
+  double hx = calcBandwidth(sx, sxx);
+  double hy = calcBandwidth(sy, syy);
+
+  // separable convolution of grid rows then columns
+  auto kernelValues = [&](double h) {
+    int nk = std::min(int(std::ceil(4.0*h)), n - 1);
+
+    std::vector<double> k(nk + 1);
+
+    for (int i = 0; i <= nk; ++i)
+      k[i] = std::exp(-0.5*(i/h)*(i/h));
+
+    return k;
+  };
+
+  auto convolve = [&](const std::vector<double> &k, int stride, int step) {
+    int nk = int(k.size()) - 1;
+
+    std::vector<double> line(n);
+
+    for (int j = 0; j < n; ++j) {
+      int start = j*step;
+
+      for (int i = 0; i < n; ++i) {
+        double v = 0.0;
+
+        for (int d = std::max(-nk, -i); d <= std::min(nk, n - 1 - i); ++d)
+          v += k[std::abs(d)]*counts[start + (i + d)*stride];
+
+        line[i] = v;
+      }
+
+      for (int i = 0; i < n; ++i)
+        counts[start + i*stride] = line[i];
+    }
+  };
+
+  convolve(kernelValues(hx), 1, n);
+  convolve(kernelValues(hy), n, 1);
+
+  //---
+
+  // normalize to max value
+  double maxValue = *std::max_element(counts.begin(), counts.end());
+
+  grid.values.resize(n*n);
+
+  for (int i = 0; i < n*n; ++i)
+    grid.values[i] = float(maxValue > 0.0 ? counts[i]/maxValue : 0.0);
+}
+
+double
+CQChartsBivariateDensity::Grid::
+value(double x, double y) const
+{
+  if (! isValid())
+    return 0.0;
+
+  double xmin = xrange.min(), xmax = xrange.max();
+  double ymin = yrange.min(), ymax = yrange.max();
+
+  double x1 = normValue(x, xmin, xmax);
+  double y1 = normValue(y, ymin, ymax);
+
+  // bilinear interpolate grid values
+  double tx = x1*(nx - 1);
+  double ty = y1*(ny - 1);
+
+  int ix = std::min(int(tx), nx - 2);
+  int iy = std::min(int(ty), ny - 2);
+
+  double fx = tx - ix;
+  double fy = ty - iy;
+
+  double v1 = (1.0 - fx)*values[ iy     *nx + ix] + fx*values[ iy     *nx + ix + 1];
+  double v2 = (1.0 - fx)*values[(iy + 1)*nx + ix] + fx*values[(iy + 1)*nx + ix + 1];
+
+  return (1.0 - fy)*v1 + fy*v2;
+}
+
+//---
+
+void
+CQChartsBivariateDensity::
+draw(const CQChartsPlot *plot, CQChartsPaintDevice *device, const Data &data)
+{
+  Grid grid;
+
+  calcGrid(data.values, data.xrange, data.yrange, grid);
+
+  draw(plot, device, grid, data.gridSize, data.delta);
+}
+
+void
+CQChartsBivariateDensity::
+draw(const CQChartsPlot *plot, CQChartsPaintDevice *device, const Grid &grid,
+     int gridSize, double delta)
+{
+  if (! grid.isValid())
+    return;
+
+  gridSize = std::max(gridSize, 1);
+
+  const double xmin = grid.xrange.min();
+  const double xmax = grid.xrange.max();
+  const double ymin = grid.yrange.min();
+  const double ymax = grid.yrange.max();
 
   //---
 
@@ -59,13 +218,10 @@ draw(const CQChartsPlot *plot, CQChartsPaintDevice *device, const Data &data)
   // calc values for grid
   for (int y = y1; y <= y2; y += dy) {
     for (int x = x1; x <= x2; x += dx) {
-      // calc value at normalized pixel sample point (use box center ?)
+      // calc value at pixel sample point (use box center ?)
       auto p = device->pixelToWindow(CQChartsGeom::Point(x, y));
 
-      double x1 = (xmax > xmin ? CMathUtil::norm(p.x, xmin, xmax) : 0.0);
-      double y1 = (ymax > ymin ? CMathUtil::norm(p.y, ymin, ymax) : 0.0);
-
-      double v = bivariate.calc(x1, y1);
+      double v = grid.value(p.x, p.y);
 
       //---
 
@@ -67,7 +67,7 @@ evaluateExpression(const QString &expr, QVariant &value, bool showError)
   qtcl_->setModel(const_cast<QAbstractItemModel *>(model()));
   qtcl_->setRow  (row());
 
-  return qtcl_->evaluateExpression(expr, value, (showError || isDebug()));
+  return qtcl_->evaluateCompiledExpression(expr, value, (showError || isDebug()));
 }
 
 int
@@ -0,0 +1,396 @@
+#include <CQChartsColumnSummary.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+// number of HyperLogLog index bits (2^12 registers)
+const int hllBits = 12;
+const int hllSize = (1<<hllBits);
+
+// mix bits of 64 bit value (splitmix64 finalizer)
+uint64_t mixHash(uint64_t h) {
+  h ^= h >> 30; h *= 0xbf58476d1ce4e5b9ULL;
+  h ^= h >> 27; h *= 0x94d049bb133111ebULL;
+  h ^= h >> 31;
+
+  return h;
+}
+
+uint64_t realHash(double r) {
+  if (r == 0.0) r = 0.0; // same hash for -0.0
+
+  uint64_t bits;
+
+  memcpy(&bits, &r, sizeof(bits));
+
+  return mixHash(bits);
+}
+
+uint64_t stringHash(const QString &s) {
+  // FNV-1a
+  uint64_t h = 0xcbf29ce484222325ULL;
+
+  for (const auto &c : s) {
+    h ^= c.unicode();
+    h *= 0x100000001b3ULL;
+  }
+
+  return mixHash(h);
+}
+
+template<typename T>
+int compareValues(const T &a, const T &b) {
+  return (b > a ? 1 : (b < a ? -1 : 0));
+}
+
+}
+
+//---
+
+CQChartsColumnSummary::
+CQChartsColumnSummary()
+{
+}
+
+void
+CQChartsColumnSummary::
+reset()
+{
+  *this = CQChartsColumnSummary();
+}
+
+void
+CQChartsColumnSummary::
+addReal(double r)
+{
+  if (std::isnan(r)) {
+    ++numNull_;
+    return;
+  }
+
+  type_ = Type::REAL;
+
+  if (n_ == 0) {
+    rmin_   = r;
+    rmax_   = r;
+    rfirst_ = r;
+  }
+  else {
+    addMonotonic(compareValues(rlast_, r));
+
+    rmin_ = std::min(rmin_, r);
+    rmax_ = std::max(rmax_, r);
+  }
+
+  rlast_ = r;
+
+  // Welford update
+  ++n_;
+
+  double d = r - mean_;
+
+  mean_ += d/n_;
+  m2_   += d*(r - mean_);
+
+  addHash(realHash(r));
+
+  addSample(r);
+}
+
+void
+CQChartsColumnSummary::
+addString(const QString &s)
+{
+  type_ = Type::STRING;
+
+  if (n_ == 0) {
+    smin_   = s;
+    smax_   = s;
+    sfirst_ = s;
+  }
+  else {
+    addMonotonic(compareValues(slast_, s));
+
+    smin_ = std::min(smin_, s);
+    smax_ = std::max(smax_, s);
+  }
+
+  slast_ = s;
+
+  ++n_;
+
+  addHash(stringHash(s));
+}
+
+void
+CQChartsColumnSummary::
+merge(const CQChartsColumnSummary &summary)
+{
+  if (summary.n_ == 0) {
+    numNull_ += summary.numNull_;
+    return;
+  }
+
+  if (n_ == 0) {
+    long numNull = numNull_ + summary.numNull_;
+    auto rand    = rand_;
+
+    *this = summary;
+
+    numNull_ = numNull;
+    rand_    = rand;
+
+    return;
+  }
+
+  numNull_ += summary.numNull_;
+
+  //---
+
+  // monotonic across range boundary and then merged range state
+  if (type_ == Type::REAL) {
+    addMonotonic(compareValues(rlast_, summary.rfirst_));
+
+    rmin_  = std::min(rmin_, summary.rmin_);
+    rmax_  = std::max(rmax_, summary.rmax_);
+    rlast_ = summary.rlast_;
+  }
+  else {
+    addMonotonic(compareValues(slast_, summary.sfirst_));
+
+    smin_  = std::min(smin_, summary.smin_);
+    smax_  = std::max(smax_, summary.smax_);
+    slast_ = summary.slast_;
+  }
+
+  if (summary.monotonicSet_) {
+    if (! monotonicSet_) {
+      monotonicSet_ = true;
+      increasing_   = summary.increasing_;
+    }
+    else if (increasing_ != summary.increasing_)
+      monotonic_ = false;
+  }
+
+  if (! summary.monotonic_)
+    monotonic_ = false;
+
+  //---
+
+  // merge mean and sum of squared differences (Chan et al)
+  long n = n_ + summary.n_;
+
+  double d = summary.mean_ - mean_;
+
+  mean_ += d*summary.n_/n;
+  m2_   += summary.m2_ + d*d*(double(n_)*double(summary.n_)/n);
+
+  //---
+
+  // merge unique hashes or registers
+  if (registers_.empty() && summary.registers_.empty()) {
+    for (const auto &h : summary.hashes_)
+      addHash(h);
+  }
+  else {
+    toRegisters();
+
+    if (summary.registers_.empty()) {
+      for (const auto &h : summary.hashes_)
+        addRegister(h);
+    }
+    else {
+      for (int i = 0; i < hllSize; ++i)
+        registers_[i] = std::max(registers_[i], summary.registers_[i]);
+    }
+  }
+
+  //---
+
+  // merge samples (all values if fit, otherwise random subsets in proportion to counts)
+  if (n <= sampleSize) {
+    sample_.insert(sample_.end(), summary.sample_.begin(), summary.sample_.end());
+  }
+  else if (type_ == Type::REAL) {
+    int n1 = std::min(int(std::round(double(sampleSize)*n_/n)), int(sample_.size()));
+    int n2 = std::min(sampleSize - n1, int(summary.sample_.size()));
+
+    auto sample1 = sample_;
+    auto sample2 = summary.sample_;
+
+    std::shuffle(sample1.begin(), sample1.end(), rand_);
+    std::shuffle(sample2.begin(), sample2.end(), rand_);
+
+    sample_.clear();
+
+    sample_.insert(sample_.end(), sample1.begin(), sample1.begin() + n1);
+    sample_.insert(sample_.end(), sample2.begin(), sample2.begin() + n2);
+  }
+
+  n_ = n;
+}
+
+QVariant
+CQChartsColumnSummary::
+minValue() const
+{
+  if      (type_ == Type::REAL  ) return QVariant(rmin_);
+  else if (type_ == Type::STRING) return QVariant(smin_);
+
+  return QVariant();
+}
+
+QVariant
+CQChartsColumnSummary::
+maxValue() const
+{
+  if      (type_ == Type::REAL  ) return QVariant(rmax_);
+  else if (type_ == Type::STRING) return QVariant(smax_);
+
+  return QVariant();
+}
+
+double
+CQChartsColumnSummary::
+stddev() const
+{
+  return (n_ > 0 ? std::sqrt(m2_/n_) : 0.0);
+}
+
+long
+CQChartsColumnSummary::
+numUnique() const
+{
+  if (registers_.empty())
+    return long(hashes_.size());
+
+  // HyperLogLog estimate
+  double m = hllSize;
+
+  double sum   = 0.0;
+  int    zeros = 0;
+
+  for (const auto &r : registers_) {
+    sum += std::ldexp(1.0, -r);
+
+    if (r == 0)
+      ++zeros;
+  }
+
+  double alpha = 0.7213/(1.0 + 1.079/m);
+
+  double e = alpha*m*m/sum;
+
+  // small range correction (linear counting)
+  if (e <= 2.5*m && zeros > 0)
+    e = m*std::log(m/zeros);
+
+  return long(std::round(e));
+}
+
+double
+CQChartsColumnSummary::
+median() const
+{
+  int ns = int(sample_.size());
+
+  if (ns == 0)
+    return 0.0;
+
+  auto values = sample_;
+
+  std::sort(values.begin(), values.end());
+
+  int i1 = (ns - 1)/2;
+  int i2 = ns/2;
+
+  return (values[i1] + values[i2])/2.0;
+}
+
+void
+CQChartsColumnSummary::
+addHash(uint64_t h)
+{
+  if (! registers_.empty()) {
+    addRegister(h);
+    return;
+  }
+
+  hashes_.insert(h);
+
+  if (int(hashes_.size()) > maxExactUnique)
+    toRegisters();
+}
+
+void
+CQChartsColumnSummary::
+addRegister(uint64_t h)
+{
+  int i = int(h >> (64 - hllBits));
+
+  // position of first set bit in remaining bits (marker bit limits count)
+  uint64_t w = (h << hllBits) | (uint64_t(1) << (hllBits - 1));
+
+  uint8_t rho = 1;
+
+  while (! (w & (uint64_t(1) << 63))) {
+    w <<= 1;
+
+    ++rho;
+  }
+
+  registers_[i] = std::max(registers_[i], rho);
+}
+
+void
+CQChartsColumnSummary::
+toRegisters()
+{
+  if (! registers_.empty())
+    return;
+
+  registers_.resize(hllSize, 0);
+
+  for (const auto &h : hashes_)
+    addRegister(h);
+
+  Hashes().swap(hashes_);
+}
+
+void
+CQChartsColumnSummary::
+addSample(double r)
+{
+  // reservoir sample (n_ includes new value)
+  if (int(sample_.size()) < sampleSize) {
+    sample_.push_back(r);
+    return;
+  }
+
+  std::uniform_int_distribution<long> dist(0, n_ - 1);
+
+  long j = dist(rand_);
+
+  if (j < sampleSize)
+    sample_[j] = r;
+}
+
+void
+CQChartsColumnSummary::
+addMonotonic(int cmp)
+{
+  if (cmp == 0)
+    return;
+
+  bool increasing = (cmp > 0);
+
+  if (! monotonicSet_) {
+    monotonicSet_ = true;
+    increasing_   = increasing;
+  }
+  else if (increasing != increasing_)
+    monotonic_ = false;
+}
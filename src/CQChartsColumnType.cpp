@@ -1557,7 +1557,9 @@ desc() const
 {
   return CQChartsHtml().
    h2("Polygon List").
-    p("Specifies that the column values are lists of polygon values.");
+    p("Specifies that the column values are lists of polygon values.").
+    p("Values can be strings or binary (WKB polygon or multi polygon) data. "
+      "Hex encoded WKB strings are decoded as binary data.");
 }
 
 QVariant
@@ -1573,8 +1575,22 @@ userData(CQCharts *, const QAbstractItemModel *, const CQChartsColumn &, const Q
 
   converted = true;
 
+  // binary (WKB) polygons
+  if (var.type() == QVariant::ByteArray) {
+    CQChartsPolygonList polyList;
+
+    if (polyList.fromBinary(var.toByteArray()))
+      return QVariant::fromValue<CQChartsPolygonList>(polyList);
+  }
+
   QString str = var.toString();
 
+  // hex encoded binary (WKB) polygons
+  CQChartsPolygonList binaryPolyList;
+
+  if (binaryPolyList.fromHexBinary(str))
+    return QVariant::fromValue<CQChartsPolygonList>(binaryPolyList);
+
   CQChartsPolygonList polyList(str);
 
   return QVariant::fromValue<CQChartsPolygonList>(polyList);
@@ -0,0 +1,42 @@
+#include <CQChartsColumnView.h>
+#include <CQChartsModelUtil.h>
+#include <CQPerfMonitor.h>
+
+CQChartsColumnView::
+CQChartsColumnView(CQCharts *charts, const QAbstractItemModel *model,
+                   const CQChartsColumn &column) :
+ column_(column)
+{
+  init(charts, model);
+}
+
+void
+CQChartsColumnView::
+init(CQCharts *charts, const QAbstractItemModel *model)
+{
+  CQPerfTrace trace("CQChartsColumnView::init");
+
+  int nr = model->rowCount();
+
+  values_.resize(nr);
+  valid_ .resize(nr);
+
+  numValid_ = 0;
+
+  for (int r = 0; r < nr; ++r) {
+    bool ok;
+
+    double value = CQChartsModelUtil::modelReal(charts, model, r, column_, QModelIndex(), ok);
+
+    if (ok) {
+      values_[r] = value;
+      valid_ [r] = true;
+
+      ++numValid_;
+    }
+    else {
+      values_[r] = 0.0;
+      valid_ [r] = false;
+    }
+  }
+}
@@ -1,7 +1,316 @@
 #include <CQChartsCorrelationModel.h>
 
+#include <algorithm>
+#include <future>
+#include <thread>
+#include <cmath>
+
 CQChartsCorrelationModel::
 CQChartsCorrelationModel(int numCols) :
  CQDataModel(numCols, numCols)
 {
 }
+
+void
+CQChartsCorrelationModel::
+setColumnValues(const ColumnValuesP &columnValues, const Columns &columns)
+{
+  columnValues_ = columnValues;
+  columns_      = columns;
+
+  clearCache();
+}
+
+void
+CQChartsCorrelationModel::
+setMaxPoints(int n)
+{
+  maxPoints_ = n;
+
+  clearCache();
+}
+
+void
+CQChartsCorrelationModel::
+setMaxCachePoints(int n)
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  maxCachePoints_ = n;
+
+  // evict least recently used (keep at least one entry)
+  while (numCachePoints_ > maxCachePoints_ && pointsLRU_.size() > 1) {
+    const auto &entry = pointsLRU_.back();
+
+    numCachePoints_ -= int(entry.second->size());
+
+    pointsMap_.erase(entry.first);
+    pointsLRU_.pop_back();
+  }
+}
+
+void
+CQChartsCorrelationModel::
+clearCache()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  pointsLRU_.clear();
+  pointsMap_.clear();
+
+  numCachePoints_ = 0;
+
+  ijBestFit_.clear();
+}
+
+CQChartsCorrelationModel::PointsP
+CQChartsCorrelationModel::
+points(int i, int j, int maxPoints) const
+{
+  if (maxPoints <= 0 || (maxPoints_ > 0 && maxPoints > maxPoints_))
+    maxPoints = maxPoints_;
+
+  PointsKey key(i, j, maxPoints);
+
+  {
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  auto p = pointsMap_.find(key);
+
+  if (p != pointsMap_.end()) {
+    // move to front of LRU
+    pointsLRU_.splice(pointsLRU_.begin(), pointsLRU_, (*p).second);
+
+    return (*p).second->second;
+  }
+  }
+
+  //---
+
+  // calc outside lock (other cells can be drawn in parallel)
+  auto points = std::make_shared<Points>();
+
+  calcPoints(i, j, maxPoints, *points);
+
+  //---
+
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  // another thread may have added the same points
+  auto p = pointsMap_.find(key);
+
+  if (p != pointsMap_.end()) {
+    pointsLRU_.splice(pointsLRU_.begin(), pointsLRU_, (*p).second);
+
+    return (*p).second->second;
+  }
+
+  PointsP pointsP = points;
+
+  pointsLRU_.push_front(PointsEntry(key, pointsP));
+
+  pointsMap_[key] = pointsLRU_.begin();
+
+  numCachePoints_ += int(pointsP->size());
+
+  // evict least recently used (keep new entry)
+  while (numCachePoints_ > maxCachePoints_ && pointsLRU_.size() > 1) {
+    const auto &entry = pointsLRU_.back();
+
+    numCachePoints_ -= int(entry.second->size());
+
+    pointsMap_.erase(entry.first);
+    pointsLRU_.pop_back();
+  }
+
+  return pointsP;
+}
+
+CQChartsCorrelationModel::FitDataP
+CQChartsCorrelationModel::
+bestFit(int i, int j) const
+{
+  {
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  auto pi = ijBestFit_.find(i);
+
+  if (pi != ijBestFit_.end()) {
+    auto pj = (*pi).second.find(j);
+
+    if (pj != (*pi).second.end())
+      return (*pj).second;
+  }
+  }
+
+  //---
+
+  // fit from model max points sample (fit data is small so all cells are kept)
+  auto bestFit = std::make_shared<CQChartsFitData>();
+
+  bestFit->calc(*points(i, j));
+
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  auto &bestFitP = ijBestFit_[i][j];
+
+  if (! bestFitP)
+    bestFitP = bestFit;
+
+  return bestFitP;
+}
+
+void
+CQChartsCorrelationModel::
+calcPoints(int i, int j, int maxPoints, Points &points) const
+{
+  points.clear();
+
+  if (! columnValues_)
+    return;
+
+  int nc = columns_.size();
+
+  if (i < 0 || i >= nc || j < 0 || j >= nc)
+    return;
+
+  const auto &values1 = (*columnValues_)[columns_[i]];
+  const auto &values2 = (*columnValues_)[columns_[j]];
+
+  int nv = std::min(values1.size(), values2.size());
+
+  // sample every n'th value if more than max points
+  int step = 1;
+
+  if (maxPoints > 0 && nv > maxPoints)
+    step = (nv + maxPoints - 1)/maxPoints;
+
+  points.reserve((nv + step - 1)/step);
+
+  for (int k = 0; k < nv; k += step)
+    points.push_back(CQChartsGeom::Point(values1[k], values2[k]));
+}
+
+void
+CQChartsCorrelationModel::
+calcCorrelation(const ColumnValues &columnValues, Reals &corr, int numThreads)
+{
+  int nv = columnValues.size();
+
+  corr.assign(nv*nv, 0.0);
+
+  if (nv == 0)
+    return;
+
+  int nr = columnValues[0].size();
+
+  for (const auto &values : columnValues)
+    nr = std::min(nr, int(values.size()));
+
+  //---
+
+  // calc means
+  Reals means(nv, 0.0);
+
+  for (int i = 0; i < nv; ++i) {
+    const auto &values = columnValues[i];
+
+    double sum = 0.0;
+
+    for (int r = 0; r < nr; ++r)
+      sum += values[r];
+
+    means[i] = (nr > 0 ? sum/nr : 0.0);
+  }
+
+  //---
+
+  // accumulate upper triangle of co-moment matrix for row range using blocks of
+  // centered values (contiguous per column) so each dot product is vectorizable
+  const int blockSize = 64;
+
+  auto calcCoMoments = [&](int r1, int r2, Reals &moments) {
+    moments.assign(nv*nv, 0.0);
+
+    Reals block(nv*blockSize);
+
+    for (int rb = r1; rb < r2; rb += blockSize) {
+      int nb = std::min(blockSize, r2 - rb);
+
+      for (int i = 0; i < nv; ++i) {
+        const double *values = &columnValues[i][rb];
+        double       *bi     = &block[i*blockSize];
+
+        for (int k = 0; k < nb; ++k)
+          bi[k] = values[k] - means[i];
+      }
+
+      for (int i = 0; i < nv; ++i) {
+        const double *bi = &block[i*blockSize];
+
+        double *mi = &moments[i*nv];
+
+        for (int j = i; j < nv; ++j) {
+          const double *bj = &block[j*blockSize];
+
+          double sum = 0.0;
+
+          for (int k = 0; k < nb; ++k)
+            sum += bi[k]*bj[k];
+
+          mi[j] += sum;
+        }
+      }
+    }
+  };
+
+  //---
+
+  // split rows between threads and sum thread moments
+  int nt = (numThreads > 0 ? numThreads : int(std::thread::hardware_concurrency()));
+
+  nt = std::max(std::min(nt, nr/blockSize), 1);
+
+  std::vector<Reals> threadMoments(nt);
+
+  if (nt > 1) {
+    int n = (nr + nt - 1)/nt;
+
+    std::vector<std::future<void>> futures;
+
+    for (int it = 0; it < nt; ++it) {
+      int r1 = std::min(it*n, nr);
+      int r2 = std::min(r1 + n, nr);
+
+      futures.push_back(std::async(std::launch::async, calcCoMoments, r1, r2,
+                                   std::ref(threadMoments[it])));
+    }
+
+    for (auto &future : futures)
+      future.get();
+  }
+  else
+    calcCoMoments(0, nr, threadMoments[0]);
+
+  Reals moments(nv*nv, 0.0);
+
+  for (const auto &moments1 : threadMoments)
+    for (int k = 0; k < nv*nv; ++k)
+      moments[k] += moments1[k];
+
+  //---
+
+  // normalize co-moments to correlation
+  for (int i = 0; i < nv; ++i) {
+    corr[i*nv + i] = 1.0;
+
+    for (int j = i + 1; j < nv; ++j) {
+      double d = std::sqrt(moments[i*nv + i]*moments[j*nv + j]);
+
+      double c = (d > 0.0 ? moments[i*nv + j]/d : 0.0);
+
+      corr[i*nv + j] = c;
+      corr[j*nv + i] = c;
+    }
+  }
+}
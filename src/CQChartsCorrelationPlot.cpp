@@ -1056,7 +1056,7 @@ draw(CQChartsPaintDevice *device)
     else if (type == CQChartsCorrelationPlot::OffDiagonalType::ELLIPSE) {
       const auto &rminMax = plot_->baseModel()->minMax(row_);
       const auto &cminMax = plot_->baseModel()->minMax(col_);
-      const auto &bestFit = plot_->baseModel()->bestFit(row_, col_);
+      auto bestFit = plot_->baseModel()->bestFit(row_, col_);
 
       double xdev, ydev;
 
@@ -1093,7 +1093,7 @@ draw(CQChartsPaintDevice *device)
         double px1 = CMathUtil::map(px, prect.getXMin(), prect.getXMax(), rmin, rmax);
         double px2 = CMathUtil::map(px, prect.getXMin(), prect.getXMax(), -s, s);
 
-        double py1 = bestFit.interp(px1);
+        double py1 = bestFit->interp(px1);
         double py2 = CMathUtil::map(py1, cmin, cmax, -s, s);
 
         poly.addPoint(CQChartsGeom::Point(rect().getXMid() + px2, rect().getYMid() + py2));
@@ -1106,7 +1106,13 @@ draw(CQChartsPaintDevice *device)
     else if (type == CQChartsCorrelationPlot::OffDiagonalType::POINTS) {
       const auto &rminMax = plot_->baseModel()->minMax(row_);
       const auto &cminMax = plot_->baseModel()->minMax(col_);
-      const auto &points  = plot_->baseModel()->points(row_, col_);
+
+      // sample points to cell pixel size (no more visible points than pixels)
+      auto prect = plot()->windowToPixel(rect());
+
+      int maxPoints = std::max(int(prect.getWidth()*prect.getHeight()), 1);
+
+      auto points = plot_->baseModel()->points(row_, col_, maxPoints);
 
       double rmin = rminMax.min();
       double rmax = rminMax.max();
@@ -1121,7 +1127,7 @@ draw(CQChartsPaintDevice *device)
       //---
 
       // draw row/col points
-      for (const auto &p : points) {
+      for (const auto &p : *points) {
         double x1 = rect().getXMid() + CMathUtil::map(p.x, rmin, rmax, -s, s);
         double y1 = rect().getYMid() + CMathUtil::map(p.y, cmin, cmax, -s, s);
 
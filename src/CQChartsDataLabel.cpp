@@ -5,6 +5,7 @@
 #include <CQChartsRotatedText.h>
 #include <CQChartsDrawUtil.h>
 #include <CQChartsVariant.h>
+#include <CQChartsTextCache.h>
 
 #include <CQPropertyViewModel.h>
 #include <CQPropertyViewItem.h>
@@ -115,48 +116,50 @@ draw(CQChartsPaintDevice *device, const CQChartsGeom::BBox &bbox, const QString
 
     //---
 
-    QFontMetricsF fm(device->font());
+    auto *textCache = CQChartsTextCacheInst;
 
-    double tw = fm.width(ystr);
+    auto fontData = textCache->fontData(device->font());
+
+    double tw = textCache->textWidth(device->font(), ystr);
 
     // calc text pixel position
     double px = 0.0, py = 0.0;
 
     if      (position1 == Position::TOP_INSIDE) {
       px = pbbox.getXMid() - tw/2;
-      py = pbbox.getYMin() + fm.ascent () + ym + pytp;
+      py = pbbox.getYMin() + fontData.ascent  + ym + pytp;
     }
     else if (position1 == Position::TOP_OUTSIDE) {
       px = pbbox.getXMid() - tw/2;
-      py = pbbox.getYMin() - fm.descent() - ym - pytp;
+      py = pbbox.getYMin() - fontData.descent - ym - pytp;
     }
     else if (position1 == Position::BOTTOM_INSIDE) {
       px = pbbox.getXMid() - tw/2;
-      py = pbbox.getYMax() - fm.descent() - ym - pybp;
+      py = pbbox.getYMax() - fontData.descent - ym - pybp;
     }
     else if (position1 == Position::BOTTOM_OUTSIDE) {
       px = pbbox.getXMid() - tw/2;
-      py = pbbox.getYMax() + fm.ascent () + ym + pybp;
+      py = pbbox.getYMax() + fontData.ascent  + ym + pybp;
     }
     else if (position1 == Position::LEFT_INSIDE) {
       px = pbbox.getXMin() + xm + pxlp;
-      py = pbbox.getYMid() + (fm.ascent() - fm.descent())/2;
+      py = pbbox.getYMid() + (fontData.ascent - fontData.descent)/2;
     }
     else if (position1 == Position::LEFT_OUTSIDE) {
       px = pbbox.getXMin() - tw - xm - pxlp;
-      py = pbbox.getYMid() + (fm.ascent() - fm.descent())/2;
+      py = pbbox.getYMid() + (fontData.ascent - fontData.descent)/2;
     }
     else if (position1 == Position::RIGHT_INSIDE) {
       px = pbbox.getXMax() - tw - xm - pxrp;
-      py = pbbox.getYMid() + (fm.ascent() - fm.descent())/2;
+      py = pbbox.getYMid() + (fontData.ascent - fontData.descent)/2;
     }
     else if (position1 == Position::RIGHT_OUTSIDE) {
       px = pbbox.getXMax() + xm + pxrp;
-      py = pbbox.getYMid() + (fm.ascent() - fm.descent())/2;
+      py = pbbox.getYMid() + (fontData.ascent - fontData.descent)/2;
     }
     else if (position1 == Position::CENTER) {
       px = pbbox.getXMid() - tw/2;
-      py = pbbox.getYMid() + (fm.ascent() - fm.descent())/2;
+      py = pbbox.getYMid() + (fontData.ascent - fontData.descent)/2;
     }
 
     // clip if needed
@@ -176,8 +179,8 @@ draw(CQChartsPaintDevice *device, const CQChartsGeom::BBox &bbox, const QString
     }
 
     // draw box
-    CQChartsGeom::BBox tpbbox(px      - pxlm, py - fm.ascent () - pybm,
-                              px + tw + pxrm, py + fm.descent() + pytm);
+    CQChartsGeom::BBox tpbbox(px      - pxlm, py - fontData.ascent  - pybm,
+                              px + tw + pxrm, py + fontData.descent + pytm);
 
     CQChartsBoxObj::draw(device, device->pixelToWindow(tpbbox));
 
@@ -347,51 +350,53 @@ calcRect(const CQChartsGeom::BBox &bbox, const QString &ystr, const Position &po
 
     //---
 
-    QFontMetricsF fm(font);
+    auto *textCache = CQChartsTextCacheInst;
+
+    auto fontData = textCache->fontData(font);
 
-    double tw = fm.width(ystr);
+    double tw = textCache->textWidth(font, ystr);
 
     // calc text pixel position
     double px = 0.0, py = 0.0;
 
     if      (position1 == Position::TOP_INSIDE) {
       px = pbbox.getXMid() - tw/2;
-      py = pbbox.getYMin() + fm.ascent () + ym + ytp;
+      py = pbbox.getYMin() + fontData.ascent  + ym + ytp;
     }
     else if (position1 == Position::TOP_OUTSIDE) {
       px = pbbox.getXMid() - tw/2;
-      py = pbbox.getYMin() - fm.descent() - ym - ytp;
+      py = pbbox.getYMin() - fontData.descent - ym - ytp;
     } else if (position1 == Position::BOTTOM_INSIDE) {
       px = pbbox.getXMid() - tw/2;
-      py = pbbox.getYMax() - fm.descent() - ym - ybp;
+      py = pbbox.getYMax() - fontData.descent - ym - ybp;
     }
     else if (position1 == Position::BOTTOM_OUTSIDE) {
       px = pbbox.getXMid() - tw/2;
-      py = pbbox.getYMax() + fm.ascent () + ym + ybp;
+      py = pbbox.getYMax() + fontData.ascent  + ym + ybp;
     }
     else if (position1 == Position::LEFT_INSIDE) {
       px = pbbox.getXMin() + xm + xlp;
-      py = pbbox.getYMid() + (fm.ascent() - fm.descent())/2;
+      py = pbbox.getYMid() + (fontData.ascent - fontData.descent)/2;
     }
     else if (position1 == Position::LEFT_OUTSIDE) {
       px = pbbox.getXMin() - tw - xm - xlp;
-      py = pbbox.getYMid() + (fm.ascent() - fm.descent())/2;
+      py = pbbox.getYMid() + (fontData.ascent - fontData.descent)/2;
     }
     else if (position1 == Position::RIGHT_INSIDE) {
       px = pbbox.getXMax() - tw - xm - xrp;
-      py = pbbox.getYMid() + (fm.ascent() - fm.descent())/2;
+      py = pbbox.getYMid() + (fontData.ascent - fontData.descent)/2;
     }
     else if (position1 == Position::RIGHT_OUTSIDE) {
       px = pbbox.getXMax() + xm + xrp;
-      py = pbbox.getYMid() + (fm.ascent() - fm.descent())/2;
+      py = pbbox.getYMid() + (fontData.ascent - fontData.descent)/2;
     }
     else if (position1 == Position::CENTER) {
       px = pbbox.getXMid() - tw/2;
-      py = pbbox.getYMid() + (fm.ascent() - fm.descent())/2;
+      py = pbbox.getYMid() + (fontData.ascent - fontData.descent)/2;
     }
 
-    CQChartsGeom::BBox pbbox1(px - tw/2 - xlm, py - fm.ascent () - ybm,
-                              px + tw/2 + xrm, py + fm.descent() + ytm);
+    CQChartsGeom::BBox pbbox1(px - tw/2 - xlm, py - fontData.ascent  - ybm,
+                              px + tw/2 + xrm, py + fontData.descent + ytm);
 
     wbbox = plot()->pixelToWindow(pbbox1);
   }
@@ -5,6 +5,7 @@
 #include <CQChartsUtil.h>
 #include <CQCharts.h>
 #include <CQChartsDelaunay.h>
+#include <CQChartsSweepDelaunay.h>
 #include <CQChartsPaintDevice.h>
 #include <CQChartsTip.h>
 #include <CQChartsHtml.h>
@@ -52,12 +53,16 @@ QString
 CQChartsDelaunayPlotType::
 description() const
 {
+  auto B   = [](const QString &str) { return CQChartsHtml::Str::bold(str); };
   auto IMG = [](const QString &src) { return CQChartsHtml::Str::img(src); };
 
   return CQChartsHtml().
    h2("Delaunay Plot").
     h3("Summary").
      p("Draws delaunay triangulation for a set of points.").
+    h3("Options").
+     p("The triangulation is calculated using a 3d convex hull by default or a sweep hull "
+       "algorithm (O(n log n)) if the " + B("sweepHull") + " option is enabled.").
     h3("Limitations").
      p("None.").
     h3("Example").
@@ -106,6 +111,7 @@ CQChartsDelaunayPlot::
 ~CQChartsDelaunayPlot()
 {
   delete delaunayData_;
+  delete sweepData_;
 }
 
 //---
@@ -168,6 +174,13 @@ setVoronoiPolygon(bool b)
   CQChartsUtil::testAndSet(voronoiPolygon_, b, [&]() { drawObjs(); } );
 }
 
+void
+CQChartsDelaunayPlot::
+setSweepHull(bool b)
+{
+  CQChartsUtil::testAndSet(sweepHull_, b, [&]() { updateObjs(); } );
+}
+
 //---
 
 void
@@ -192,6 +205,8 @@ addProperties()
   // delaunay
   addProp("delaunay", "delaunay", "visible", "Show delaunay connections");
 
+  addProp("delaunay", "sweepHull", "sweepHull", "Use sweep hull algorithm");
+
   addProp("delaunay/lines", "delaunayLines", "visible", "Connecting lines visible");
 
   addLineProperties("delaunay/lines/stroke", "delaunayLines", "Delaunay Stroke");
@@ -340,8 +355,15 @@ createObjs(PlotObjs &objs) const
   //---
 
   delete th->delaunayData_;
+  delete th->sweepData_;
+
+  th->delaunayData_ = nullptr;
+  th->sweepData_    = nullptr;
 
-  th->delaunayData_ = new CQChartsDelaunay;
+  if (isSweepHull())
+    th->sweepData_ = new CQChartsSweepDelaunay;
+  else
+    th->delaunayData_ = new CQChartsDelaunay;
 
   //---
 
@@ -414,25 +436,150 @@ createObjs(PlotObjs &objs) const
 
   //---
 
-  th->delaunayData_->calc();
+  th->calcGeomData();
 
   //---
 
   return true;
 }
 
+void
+CQChartsDelaunayPlot::
+calcGeomData()
+{
+  CQPerfTrace trace("CQChartsDelaunayPlot::calcGeomData");
+
+  geomData_.clear();
+
+  // get voronoi polygon from hull of voronoi points
+  auto addCell = [&](const Points &points, double value) {
+    CQChartsGrahamHull hull;
+
+    for (const auto &p : points)
+      hull.addPoint(p);
+
+    CQChartsGeom::Polygon poly;
+
+    hull.getHull(poly);
+
+    geomData_.cellPolygons.push_back(poly);
+    geomData_.cellValues  .push_back(value);
+  };
+
+  //---
+
+  if      (sweepData_) {
+    if (sweepData_->calc()) {
+      auto voronoiPoint = [&](int i) {
+        const auto &vv = sweepData_->voronoiVertex(i);
+
+        return CQChartsGeom::Point(vv.x, vv.y);
+      };
+
+      // triangles and voronoi points (triangle centers)
+      for (int t = 0; t < sweepData_->numTriangles(); ++t) {
+        for (int i = 0; i < 3; ++i) {
+          int v = sweepData_->triangleVertex(t, i);
+
+          geomData_.triangles.push_back(CQChartsGeom::Point(sweepData_->x(v), sweepData_->y(v)));
+        }
+
+        int iv = sweepData_->triangleVoronoi(t);
+
+        if (iv >= 0) {
+          geomData_.voronoiPoints.push_back(voronoiPoint(iv));
+          geomData_.voronoiRadii .push_back(sweepData_->voronoiVertex(iv).r);
+        }
+      }
+
+      // voronoi edges
+      for (int i = 0; i < sweepData_->numVoronoiEdges(); ++i) {
+        const auto &ve = sweepData_->voronoiEdge(i);
+
+        geomData_.voronoiEdges.push_back(voronoiPoint(ve.start));
+        geomData_.voronoiEdges.push_back(voronoiPoint(ve.end  ));
+      }
+
+      // voronoi polygons
+      for (int v = 0; v < sweepData_->numVertices(); ++v) {
+        Points points;
+
+        for (const auto &iv : sweepData_->voronoi(v))
+          points.push_back(voronoiPoint(iv));
+
+        addCell(points, sweepData_->value(v));
+      }
+    }
+
+    delete sweepData_;
+
+    sweepData_ = nullptr;
+  }
+  else if (delaunayData_) {
+    if (delaunayData_->calc()) {
+      // triangles (lower faces) and voronoi points (face centers)
+      for (auto pf = delaunayData_->facesBegin(); pf != delaunayData_->facesEnd(); ++pf) {
+        const auto *f = *pf;
+
+        if (f->isLower()) {
+          for (uint i = 0; i < 3; ++i) {
+            auto *v = f->vertex(i);
+
+            geomData_.triangles.push_back(CQChartsGeom::Point(v->x(), v->y()));
+          }
+        }
+
+        auto *vv = f->getVoronoi();
+
+        if (vv) {
+          geomData_.voronoiPoints.push_back(CQChartsGeom::Point(vv->x(), vv->y()));
+          geomData_.voronoiRadii .push_back(vv->z());
+        }
+      }
+
+      // voronoi edges
+      for (auto pve = delaunayData_->voronoiEdgesBegin();
+             pve != delaunayData_->voronoiEdgesEnd(); ++pve) {
+        const auto *e = *pve;
+
+        geomData_.voronoiEdges.push_back(CQChartsGeom::Point(e->start()->x(), e->start()->y()));
+        geomData_.voronoiEdges.push_back(CQChartsGeom::Point(e->end  ()->x(), e->end  ()->y()));
+      }
+
+      // voronoi polygons
+      for (auto pv = delaunayData_->verticesBegin(); pv != delaunayData_->verticesEnd(); ++pv) {
+        const auto *v1 = *pv;
+
+        Points points;
+
+        for (const auto &v2 : v1->voronoi())
+          points.push_back(CQChartsGeom::Point(v2->x(), v2->y()));
+
+        addCell(points, v1->value());
+      }
+    }
+
+    delete delaunayData_;
+
+    delaunayData_ = nullptr;
+  }
+}
+
 void
 CQChartsDelaunayPlot::
 addPointObj(double x, double y, double value, const QModelIndex &xind,
             int r, int nr, PlotObjs &objs) const
 {
-  assert(delaunayData_);
+  assert(delaunayData_ || sweepData_);
 
-  auto *th = const_cast<CQChartsDelaunayPlot *>(this);
-
-  CQChartsDelaunay::PVertex v = th->delaunayData_->addVertex(x, y);
+  if (sweepData_) {
+    sweepData_->addVertex(x, y, value);
+  }
+  else {
+    CQChartsDelaunay::PVertex v = delaunayData_->addVertex(x, y);
 
-  v->setValue(value);
+    v->setValue(value);
+  }
 
   //---
 
@@ -518,9 +665,6 @@ void
 CQChartsDelaunayPlot::
 drawDelaunay(CQChartsPaintDevice *device) const
 {
-  if (! delaunayData_)
-    return;
-
   if (isDelaunayLines()) {
     QPen pen;
 
@@ -529,18 +673,12 @@ drawDelaunay(CQChartsPaintDevice *device) const
     //---
 
     // draw delaunay triangles
-    for (auto pf = delaunayData_->facesBegin(); pf != delaunayData_->facesEnd(); ++pf) {
-      const auto *f = *pf;
-
-      if (! f->isLower()) continue;
+    const auto &triangles = geomData_.triangles;
 
-      auto *v1 = f->vertex(0);
-      auto *v2 = f->vertex(1);
-      auto *v3 = f->vertex(2);
-
-      CQChartsGeom::Point p1(v1->x(), v1->y());
-      CQChartsGeom::Point p2(v2->x(), v2->y());
-      CQChartsGeom::Point p3(v3->x(), v3->y());
+    for (std::size_t i = 0; i + 2 < triangles.size(); i += 3) {
+      const auto &p1 = triangles[i    ];
+      const auto &p2 = triangles[i + 1];
+      const auto &p3 = triangles[i + 2];
 
       QPainterPath path;
 
@@ -559,11 +697,6 @@ void
 CQChartsDelaunayPlot::
 drawVoronoi(CQChartsPaintDevice *device) const
 {
-  if (! delaunayData_)
-    return;
-
-  //---
-
   // fill voronoi polygons
   if (isVoronoiPolygon()) {
     CQChartsPenBrush penBrush;
@@ -575,25 +708,16 @@ drawVoronoi(CQChartsPaintDevice *device) const
       CQChartsPenData  (true, pc, voronoiStrokeAlpha(), voronoiStrokeWidth(), voronoiStrokeDash()),
       CQChartsBrushData(true, fc, voronoiFillAlpha(), voronoiFillPattern()));
 
-    for (auto pv = delaunayData_->verticesBegin(); pv != delaunayData_->verticesEnd(); ++pv) {
-      const auto *v1 = *pv;
+    int nc = geomData_.cellPolygons.size();
 
-      CQChartsGrahamHull hull;
-
-      for (const auto &v2 : v1->voronoi()) {
-        CQChartsGeom::Point p(v2->x(), v2->y());
-
-        hull.addPoint(p);
-      }
-
-      CQChartsGeom::Polygon poly;
-
-      hull.getHull(poly);
+    for (int i = 0; i < nc; ++i) {
+      const auto &poly = geomData_.cellPolygons[i];
 
       QBrush brush = penBrush.brush;
 
       if (valueRange_.isSet()) {
-        double v = CMathUtil::map(v1->value(), valueRange_.min(), valueRange_.max(), 0.0, 1.0);
+        double v = CMathUtil::map(geomData_.cellValues[i], valueRange_.min(), valueRange_.max(),
+                                  0.0, 1.0);
 
         QColor fc1 = interpVoronoiFillColor(ColorInd(v));
 
@@ -621,21 +745,13 @@ drawVoronoi(CQChartsPaintDevice *device) const
     CQChartsSymbol symbolType = this->voronoiSymbolType();
     CQChartsLength symbolSize = this->voronoiSymbolSize();
 
-    for (auto pf = delaunayData_->facesBegin(); pf != delaunayData_->facesEnd(); ++pf) {
-      const auto *f = *pf;
-
-      auto *v = f->getVoronoi();
-      if (! v) continue;
-
-      CQChartsGeom::Point p(v->x(), v->y());
-
+    for (const auto &p : geomData_.voronoiPoints)
       drawSymbol(device, p, symbolType, symbolSize, penBrush);
-    }
   }
 
   //---
 
-  // draw voronoi lines
+  // draw voronoi lines and circles
   if (isVoronoiLines() || isVoronoiCircles()) {
     QPen pen;
 
@@ -646,24 +762,22 @@ drawVoronoi(CQChartsPaintDevice *device) const
     device->setPen  (pen);
     device->setBrush(Qt::NoBrush);
 
-    for (auto pve = delaunayData_->voronoiEdgesBegin();
-           pve != delaunayData_->voronoiEdgesEnd(); ++pve) {
-      const auto *e = *pve;
+    if (isVoronoiLines()) {
+      const auto &edges = geomData_.voronoiEdges;
 
-      auto *v1 = e->start();
-      auto *v2 = e->end  ();
+      for (std::size_t i = 0; i + 1 < edges.size(); i += 2)
+        device->drawLine(edges[i], edges[i + 1]);
+    }
 
-      if (isVoronoiLines()) {
-        CQChartsGeom::Point p1(v1->x(), v1->y());
-        CQChartsGeom::Point p2(v2->x(), v2->y());
+    if (isVoronoiCircles()) {
+      int np = geomData_.voronoiPoints.size();
 
-        device->drawLine(p1, p2);
-      }
+      for (int i = 0; i < np; ++i) {
+        const auto &p = geomData_.voronoiPoints[i];
 
-      if (isVoronoiCircles()) {
-        double r = v1->z();
+        double r = geomData_.voronoiRadii[i];
 
-        CQChartsGeom::BBox bbox(v1->x() - r, v1->y() - r, v1->x() + r, v1->y() + r);
+        CQChartsGeom::BBox bbox(p.x - r, p.y - r, p.x + r, p.y + r);
 
         device->drawEllipse(bbox);
       }
@@ -4,8 +4,62 @@
 #include <CQChartsPaintDevice.h>
 #include <CQChartsBoxWhisker.h>
 #include <CQUtil.h>
+#include <complex>
 #include <cassert>
 
+namespace {
+
+using Complex  = std::complex<double>;
+using Complexs = std::vector<Complex>;
+
+// in place radix 2 FFT (size must be power of 2)
+void fft(Complexs &a, bool inverse)
+{
+  int n = a.size();
+
+  // bit reverse permutation
+  for (int i = 1, j = 0; i < n; ++i) {
+    int bit = n >> 1;
+
+    for ( ; j & bit; bit >>= 1)
+      j ^= bit;
+
+    j ^= bit;
+
+    if (i < j)
+      std::swap(a[i], a[j]);
+  }
+
+  for (int len = 2; len <= n; len <<= 1) {
+    double angle = 2.0*M_PI/len*(inverse ? 1 : -1);
+
+    Complex wlen(std::cos(angle), std::sin(angle));
+
+    for (int i = 0; i < n; i += len) {
+      Complex w(1.0, 0.0);
+
+      for (int j = 0; j < len/2; ++j) {
+        Complex u = a[i + j];
+        Complex v = a[i + j + len/2]*w;
+
+        a[i + j        ] = u + v;
+        a[i + j + len/2] = u - v;
+
+        w *= wlen;
+      }
+    }
+  }
+
+  if (inverse) {
+    for (auto &c : a)
+      c /= n;
+  }
+}
+
+}
+
+//---
+
 CQChartsDensity::
 CQChartsDensity()
 {
@@ -37,6 +91,8 @@ calc()
   if (nx_ < 2)
     return;
 
+  initGrid();
+
   // set num samples between end points
   double step = (xmax_ - xmin_)/(numSamples_ - 1);
 
@@ -250,19 +306,135 @@ yval(double x) const
 
 //---
 
+double
+CQChartsDensity::
+bandwidth() const
+{
+  /* If the supplied bandwidth is zero of less, the default bandwidth is used. */
+  if (smoothParameter_ <= 0)
+    return defaultBandwidth_;
+  else
+    return smoothParameter_;
+}
+
+//---
+
+void
+CQChartsDensity::
+initGrid()
+{
+  gridValues_.clear();
+
+  if (binnedThreshold_ <= 0 || nx_ < binnedThreshold_)
+    return;
+
+  double bandwidth = this->bandwidth();
+
+  if (! (bandwidth > 0.0) || ! std::isfinite(bandwidth))
+    return;
+
+  //---
+
+  // extend grid past values until summed kernel tails are negligible
+  // (calc extends the sampled range until the density is flat)
+  double s = nx_/(bandwidth*sqrt(2.0*M_PI)*1E-7);
+
+  double zmax = (s > 1.0 ? std::max(sqrt(2.0*log(s)), 5.0) : 5.0);
+
+  double gmin = xmin_ - zmax*bandwidth;
+  double gmax = xmax_ + zmax*bandwidth;
+
+  // use power of 2 grid points with at least 16 points per bandwidth
+  // (use exact evaluation if too many needed for bandwidth)
+  double ng = 16.0*(gmax - gmin)/bandwidth + 1;
+
+  if (ng > double(1<<20))
+    return;
+
+  int m = 256;
+
+  while (m < ng)
+    m <<= 1;
+
+  gridMin_  = gmin;
+  gridStep_ = (gmax - gmin)/(m - 1);
+
+  //---
+
+  // linear binning of values to grid points (padded to 2*m for circular convolution)
+  int n = 2*m;
+
+  Complexs counts(n), kernel(n);
+
+  for (int i = 0; i < nx_; ++i) {
+    double t = (xvals_[i] - gridMin_)/gridStep_;
+
+    int    it = std::min(std::max(int(t), 0), m - 2);
+    double f  = std::min(std::max(t - it, 0.0), 1.0);
+
+    counts[it    ] += 1.0 - f;
+    counts[it + 1] += f;
+  }
+
+  // kernel at grid offsets (negative offsets wrap to end)
+  int nk = std::min(int(std::ceil(zmax*bandwidth/gridStep_)), m - 1);
+
+  for (int i = 0; i <= nk; ++i) {
+    double z = i*gridStep_/bandwidth;
+
+    double k = exp(-0.5*z*z)/(bandwidth*sqrt(2.0*M_PI));
+
+    kernel[i] = k;
+
+    if (i > 0)
+      kernel[n - i] = k;
+  }
+
+  // convolve
+  fft(counts, false);
+  fft(kernel, false);
+
+  for (int i = 0; i < n; ++i)
+    counts[i] *= kernel[i];
+
+  fft(counts, true);
+
+  gridValues_.resize(m);
+
+  for (int i = 0; i < m; ++i)
+    gridValues_[i] = std::max(counts[i].real(), 0.0);
+}
+
+//---
+
 double
 CQChartsDensity::
 eval(double x) const
 {
   assert(initialized_ && calced_);
 
-  double bandwidth;
+  if (gridValues_.empty())
+    return evalExact(x);
 
-  /* If the supplied bandwidth is zero of less, the default bandwidth is used. */
-  if (smoothParameter_ <= 0)
-    bandwidth = defaultBandwidth_;
-  else
-    bandwidth = smoothParameter_;
+  // interpolate grid values
+  int m = gridValues_.size();
+
+  double t = (x - gridMin_)/gridStep_;
+
+  if (t < 0.0 || t > m - 1)
+    return 0.0;
+
+  int    it = std::min(int(t), m - 2);
+  double f  = t - it;
+
+  return (1.0 - f)*gridValues_[it] + f*gridValues_[it + 1];
+}
+
+double
+CQChartsDensity::
+evalExact(double x) const
+{
+  double bandwidth = this->bandwidth();
 
   //---
 
@@ -279,6 +451,32 @@ eval(double x) const
   return y;
 }
 
+double
+CQChartsDensity::
+binnedError(int n) const
+{
+  constCalc();
+
+  if (gridValues_.empty() || n < 2)
+    return 0.0;
+
+  double step = (xmax_ - xmin_)/(n - 1);
+
+  double maxDiff = 0.0, maxY = 0.0;
+
+  for (int i = 0; i < n; ++i) {
+    double x = xmin_ + i*step;
+
+    double y  = evalExact(x);
+    double y1 = eval(x);
+
+    maxDiff = std::max(maxDiff, std::abs(y1 - y));
+    maxY    = std::max(maxY, y);
+  }
+
+  return (maxY > 0.0 ? maxDiff/maxY : maxDiff);
+}
+
 //---
 
 void
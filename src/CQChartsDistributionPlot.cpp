@@ -6,6 +6,7 @@
 #include <CQChartsVariant.h>
 #include <CQChartsModelDetails.h>
 #include <CQChartsModelData.h>
+#include <CQChartsColumnView.h>
 #include <CQChartsDataLabel.h>
 #include <CQChartsValueSet.h>
 #include <CQCharts.h>
@@ -829,6 +830,8 @@ bucketGroupValues() const
   //---
 
   // bucket grouped sets of values
+  ColumnViewP view; // cached real values for current value column
+
   for (auto &groupValues : groupData_.groupValues) {
     int   groupInd = groupValues.first;
     auto *values   = groupValues.second;
@@ -848,7 +851,10 @@ bucketGroupValues() const
         CQChartsValueSet::Type type = values->valueSet->type();
 
         if      (type == CQChartsValueSet::Type::REAL) {
-          double r = modelReal(ind, ok);
+          if (! view || view->column() != ind.column)
+            view = columnView(ind.column);
+
+          double r = modelReal(view, ind, ok);
           if (! ok || CMathUtil::isNaN(r)) continue;
 
           if (! isIncludeOutlier()) {
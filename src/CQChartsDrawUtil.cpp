@@ -4,6 +4,7 @@
 #include <CQChartsRoundedPolygon.h>
 #include <CQChartsPaintDevice.h>
 #include <CQChartsUtil.h>
+#include <CQChartsTextCache.h>
 
 #include <CMathUtil.h>
 
@@ -150,8 +151,15 @@ drawTextInBox(CQChartsPaintDevice *device, const CQChartsGeom::BBox &rect,
     if (options.formatted) {
       auto prect = device->windowToPixel(rect);
 
-      CQChartsUtil::formatStringInRect(text, device->font(), prect, strs,
-                                       CQChartsUtil::FormatData(options.formatSeps));
+      CQChartsTextCacheInst->formatStringInRect(text, device->font(), prect, strs,
+                                                CQChartsUtil::FormatData(options.formatSeps));
+    }
+    else if (options.elided && ! options.scaled) {
+      auto prect = device->windowToPixel(rect);
+
+      double pw = prect.getWidth() - 2*options.margin;
+
+      strs << CQChartsTextCacheInst->elidedText(device->font(), text, pw);
     }
     else
       strs << text;
@@ -177,9 +185,11 @@ drawStringsInBox(CQChartsPaintDevice *device, const CQChartsGeom::BBox &rect,
 {
   auto prect = device->windowToPixel(rect);
 
-  QFontMetricsF fm(device->font());
+  auto *textCache = CQChartsTextCacheInst;
+
+  auto fontData = textCache->fontData(device->font());
 
-  double th = strs.size()*fm.height() + 2*options.margin;
+  double th = strs.size()*fontData.height + 2*options.margin;
 
   if (options.scaled) {
     // calc text scale
@@ -189,7 +199,7 @@ drawStringsInBox(CQChartsPaintDevice *device, const CQChartsGeom::BBox &rect,
       double tw = 0;
 
       for (int i = 0; i < strs.size(); ++i)
-        tw = std::max(tw, fm.width(strs[i]));
+        tw = std::max(tw, textCache->textWidth(device->font(), strs[i]));
 
       tw += 2*options.margin;
 
@@ -203,9 +213,9 @@ drawStringsInBox(CQChartsPaintDevice *device, const CQChartsGeom::BBox &rect,
     device->setFont(CQChartsUtil::scaleFontSize(
       device->font(), s, options.minScaleFontSize, options.maxScaleFontSize));
 
-    fm = QFontMetricsF(device->font());
+    fontData = textCache->fontData(device->font());
 
-    th = strs.size()*fm.height();
+    th = strs.size()*fontData.height;
   }
 
   //---
@@ -217,12 +227,12 @@ drawStringsInBox(CQChartsPaintDevice *device, const CQChartsGeom::BBox &rect,
   else if (options.align & Qt::AlignBottom)
     dy = prect.getHeight() - th;
 
-  double y = prect.getYMin() + dy + fm.ascent();
+  double y = prect.getYMin() + dy + fontData.ascent;
 
   for (int i = 0; i < strs.size(); ++i) {
     double dx = 0.0;
 
-    double tw = fm.width(strs[i]);
+    double tw = textCache->textWidth(device->font(), strs[i]);
 
     if      (options.align & Qt::AlignHCenter)
       dx = (prect.getWidth() - tw)/2;
@@ -238,7 +248,7 @@ drawStringsInBox(CQChartsPaintDevice *device, const CQChartsGeom::BBox &rect,
     else
       drawSimpleText(device, pt, strs[i]);
 
-    y += fm.height();
+    y += fontData.height;
   }
 }
 
@@ -259,12 +269,14 @@ void
 drawTextAtPoint(CQChartsPaintDevice *device, const CQChartsGeom::Point &point, const QString &text,
                 const CQChartsTextOptions &options, bool centered, double dx, double dy)
 {
-  QFontMetricsF fm(device->font());
+  auto *textCache = CQChartsTextCacheInst;
+
+  auto fontData = textCache->fontData(device->font());
 
-  double ta = fm.ascent();
-  double td = fm.descent();
+  double ta = fontData.ascent;
+  double td = fontData.descent;
 
-  auto tw = [&]() { return fm.width(text); };
+  auto tw = [&]() { return textCache->textWidth(device->font(), text); };
 
   if (CMathUtil::isZero(options.angle.value())) {
     // calc dx : point is left or hcenter of text (
@@ -321,11 +333,13 @@ void
 drawAlignedText(CQChartsPaintDevice *device, const CQChartsGeom::Point &p, const QString &text,
                 Qt::Alignment align, double dx, double dy)
 {
-  QFontMetricsF fm(device->font());
+  auto *textCache = CQChartsTextCacheInst;
 
-  double tw = fm.width(text);
-  double ta = fm.ascent ();
-  double td = fm.descent();
+  auto fontData = textCache->fontData(device->font());
+
+  double tw = textCache->textWidth(device->font(), text);
+  double ta = fontData.ascent;
+  double td = fontData.descent;
 
   double dx1 = 0.0, dy1 = 0.0;
 
@@ -349,11 +363,13 @@ CQChartsGeom::BBox
 calcAlignedTextRect(CQChartsPaintDevice *device, const QFont &font, const CQChartsGeom::Point &p,
                     const QString &text, Qt::Alignment align, double dx, double dy)
 {
-  QFontMetricsF fm(font);
+  auto *textCache = CQChartsTextCacheInst;
+
+  auto fontData = textCache->fontData(font);
 
-  double tw = fm.width(text);
-  double ta = fm.ascent ();
-  double td = fm.descent();
+  double tw = textCache->textWidth(font, text);
+  double ta = fontData.ascent;
+  double td = fontData.descent;
 
   double dx1 = 0.0, dy1 = 0.0;
 
@@ -426,9 +442,7 @@ calcTextSize(const QString &text, const QFont &font, const CQChartsTextOptions &
 
   //---
 
-  QFontMetricsF fm(font);
-
-  return CQChartsGeom::Size(fm.width(text), fm.height());
+  return CQChartsTextCacheInst->textSize(font, text);
 }
 
 //------
@@ -436,11 +450,15 @@ calcTextSize(const QString &text, const QFont &font, const CQChartsTextOptions &
 void
 drawCenteredText(CQChartsPaintDevice *device, const CQChartsGeom::Point &pos, const QString &text)
 {
-  QFontMetricsF fm(device->font());
+  auto *textCache = CQChartsTextCacheInst;
+
+  auto fontData = textCache->fontData(device->font());
+
+  double tw = textCache->textWidth(device->font(), text);
 
   auto ppos = device->windowToPixel(pos);
 
-  CQChartsGeom::Point ppos1(ppos.x - fm.width(text)/2, ppos.y + (fm.ascent() - fm.descent())/2);
+  CQChartsGeom::Point ppos1(ppos.x - tw/2, ppos.y + (fontData.ascent - fontData.descent)/2);
 
   drawSimpleText(device, device->pixelToWindow(ppos1), text);
 }
@@ -0,0 +1,1236 @@
+#include <CQChartsExprCompiler.h>
+#include <CMathUtil.h>
+
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+enum class UnaryOp {
+  MINUS,
+  PLUS,
+  NOT
+};
+
+enum class BinaryOp {
+  ADD,
+  SUB,
+  MUL,
+  DIV,
+  MOD,
+  POW,
+  LT,
+  LE,
+  GT,
+  GE,
+  EQ,
+  NE,
+  AND,
+  OR
+};
+
+enum class MathFn {
+  ABS,
+  ACOS,
+  ASIN,
+  ATAN,
+  ATAN2,
+  CEIL,
+  COS,
+  COSH,
+  DOUBLE,
+  ENTIER,
+  EXP,
+  FLOOR,
+  FMOD,
+  HYPOT,
+  INT,
+  LOG,
+  LOG10,
+  MAX,
+  MIN,
+  POW,
+  ROUND,
+  SIN,
+  SINH,
+  SQRT,
+  TAN,
+  TANH,
+  WIDE
+};
+
+struct MathFnData {
+  const char *name;
+  MathFn      fn;
+  int         minArgs;
+  int         maxArgs;
+};
+
+// tcl math functions (max args -1 for any number)
+const MathFnData mathFnDatas[] = {
+  { "abs"   , MathFn::ABS   , 1,  1 },
+  { "acos"  , MathFn::ACOS  , 1,  1 },
+  { "asin"  , MathFn::ASIN  , 1,  1 },
+  { "atan"  , MathFn::ATAN  , 1,  1 },
+  { "atan2" , MathFn::ATAN2 , 2,  2 },
+  { "ceil"  , MathFn::CEIL  , 1,  1 },
+  { "cos"   , MathFn::COS   , 1,  1 },
+  { "cosh"  , MathFn::COSH  , 1,  1 },
+  { "double", MathFn::DOUBLE, 1,  1 },
+  { "entier", MathFn::ENTIER, 1,  1 },
+  { "exp"   , MathFn::EXP   , 1,  1 },
+  { "floor" , MathFn::FLOOR , 1,  1 },
+  { "fmod"  , MathFn::FMOD  , 2,  2 },
+  { "hypot" , MathFn::HYPOT , 2,  2 },
+  { "int"   , MathFn::INT   , 1,  1 },
+  { "log"   , MathFn::LOG   , 1,  1 },
+  { "log10" , MathFn::LOG10 , 1,  1 },
+  { "max"   , MathFn::MAX   , 1, -1 },
+  { "min"   , MathFn::MIN   , 1, -1 },
+  { "pow"   , MathFn::POW   , 2,  2 },
+  { "round" , MathFn::ROUND , 1,  1 },
+  { "sin"   , MathFn::SIN   , 1,  1 },
+  { "sinh"  , MathFn::SINH  , 1,  1 },
+  { "sqrt"  , MathFn::SQRT  , 1,  1 },
+  { "tan"   , MathFn::TAN   , 1,  1 },
+  { "tanh"  , MathFn::TANH  , 1,  1 },
+  { "wide"  , MathFn::WIDE  , 1,  1 },
+  { nullptr , MathFn::ABS   , 0,  0 }
+};
+
+// integers are stored as reals so limit to exact range
+const double maxInteger = 9007199254740992.0; // 2^53
+
+//! evaluated value (integer or real like tcl)
+struct Value {
+  double r     { 0.0 };
+  bool   isInt { false };
+
+  Value() = default;
+
+  Value(double r, bool isInt) :
+   r(r), isInt(isInt) {
+  }
+};
+
+using Vector = std::vector<Value>;
+
+bool isValidInt(double r) {
+  return (std::abs(r) <= maxInteger);
+}
+
+Value intValue (double r) { return Value(r, true ); }
+Value realValue(double r) { return Value(r, false); }
+Value boolValue(bool   b) { return Value(b ? 1.0 : 0.0, true); }
+
+// convert model value to number (as tcl would interpret it)
+bool variantToValue(const QVariant &var, Value &value) {
+  switch (var.type()) {
+    case QVariant::Int:
+    case QVariant::UInt:
+    case QVariant::LongLong:
+    case QVariant::ULongLong: {
+      bool ok;
+
+      double r = var.toDouble(&ok);
+
+      if (! ok || ! isValidInt(r))
+        return false;
+
+      value = intValue(r);
+
+      return true;
+    }
+    case QVariant::Bool: {
+      value = boolValue(var.toBool());
+
+      return true;
+    }
+    case QVariant::Double: {
+      value = realValue(var.toDouble());
+
+      return true;
+    }
+    case QVariant::String: {
+      QString str = var.toString().trimmed();
+
+      if (! str.length())
+        return false;
+
+      // only plain decimal numbers (tcl octal, hex, ... use tcl)
+      int  i        = 0;
+      int  len      = str.length();
+      bool isInt    = true;
+      int  numDigit = 0;
+
+      if (str[i] == '+' || str[i] == '-')
+        ++i;
+
+      int firstDigit = i;
+
+      for ( ; i < len; ++i) {
+        QChar c = str[i];
+
+        if      (c.isDigit())
+          ++numDigit;
+        else if (c == '.' || c == 'e' || c == 'E' || c == '+' || c == '-')
+          isInt = false;
+        else
+          return false;
+      }
+
+      if (! numDigit)
+        return false;
+
+      if (isInt) {
+        if (str[firstDigit] == '0' && len - firstDigit > 1)
+          return false;
+
+        bool ok;
+
+        double r = str.toDouble(&ok);
+
+        if (! ok || ! isValidInt(r))
+          return false;
+
+        value = intValue(r);
+      }
+      else {
+        bool ok;
+
+        double r = str.toDouble(&ok);
+
+        if (! ok || ! std::isfinite(r))
+          return false;
+
+        value = realValue(r);
+      }
+
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+
+QVariant valueToVariant(const Value &value) {
+  if (value.isInt) {
+    if (value.r >= std::numeric_limits<int>::min() && value.r <= std::numeric_limits<int>::max())
+      return QVariant(int(value.r));
+
+    // large integers as (exact) real so column type is still numeric
+    return QVariant(value.r);
+  }
+
+  return QVariant(value.r);
+}
+
+//---
+
+bool unaryOp(UnaryOp op, const Value &a, Value &r) {
+  switch (op) {
+    case UnaryOp::MINUS: r = Value(-a.r, a.isInt); return true;
+    case UnaryOp::PLUS : r = a;                    return true;
+    case UnaryOp::NOT  : r = boolValue(a.r == 0.0); return true;
+    default            : return false;
+  }
+}
+
+// NaN result from non-NaN args is a tcl domain error (reported by tcl evaluation)
+bool isDomainError(double x, const Value *args, int nargs) {
+  if (! std::isnan(x))
+    return false;
+
+  for (int i = 0; i < nargs; ++i)
+    if (std::isnan(args[i].r))
+      return false;
+
+  return true;
+}
+
+bool binaryOp(BinaryOp op, const Value &a, const Value &b, Value &r) {
+  bool isInt = (a.isInt && b.isInt);
+
+  auto intResult = [&](double x) {
+    if (! isValidInt(x)) return false;
+
+    r = intValue(x);
+
+    return true;
+  };
+
+  auto realResult = [&](double x) {
+    Value args[2] = { a, b };
+
+    if (isDomainError(x, args, 2)) return false;
+
+    r = realValue(x);
+
+    return true;
+  };
+
+  switch (op) {
+    case BinaryOp::ADD:
+      if (isInt) return intResult(a.r + b.r);
+
+      return realResult(a.r + b.r);
+    case BinaryOp::SUB:
+      if (isInt) return intResult(a.r - b.r);
+
+      return realResult(a.r - b.r);
+    case BinaryOp::MUL:
+      if (isInt) return intResult(a.r*b.r);
+
+      return realResult(a.r*b.r);
+    case BinaryOp::DIV:
+      // integer divide rounds down, divide by zero is an error
+      if (b.r == 0.0) return false;
+
+      if (isInt)
+        return intResult(std::floor(a.r/b.r));
+
+      return realResult(a.r/b.r);
+    case BinaryOp::MOD: {
+      // integer only, result has sign of divisor
+      if (! isInt || b.r == 0.0) return false;
+
+      double m = std::fmod(a.r, b.r);
+
+      if (m != 0.0 && ((m < 0.0) != (b.r < 0.0)))
+        m += b.r;
+
+      return intResult(m);
+    }
+    case BinaryOp::POW:
+      if (isInt) {
+        if (b.r < 0.0) return false;
+
+        return intResult(std::pow(a.r, b.r));
+      }
+
+      return realResult(std::pow(a.r, b.r));
+    case BinaryOp::LT : r = boolValue(a.r <  b.r); return true;
+    case BinaryOp::LE : r = boolValue(a.r <= b.r); return true;
+    case BinaryOp::GT : r = boolValue(a.r >  b.r); return true;
+    case BinaryOp::GE : r = boolValue(a.r >= b.r); return true;
+    case BinaryOp::EQ : r = boolValue(a.r == b.r); return true;
+    case BinaryOp::NE : r = boolValue(a.r != b.r); return true;
+    case BinaryOp::AND: r = boolValue(a.r != 0.0 && b.r != 0.0); return true;
+    case BinaryOp::OR : r = boolValue(a.r != 0.0 || b.r != 0.0); return true;
+    default           : return false;
+  }
+}
+
+bool mathFn(MathFn fn, const Value *args, int nargs, Value &r) {
+  const Value &a = args[0];
+
+  auto realResult = [&](double x) {
+    if (isDomainError(x, args, nargs)) return false;
+
+    r = realValue(x);
+
+    return true;
+  };
+
+  // integer conversion of non-finite value is an error
+  auto intResult = [&](double x) {
+    if (! std::isfinite(x) || ! isValidInt(x)) return false;
+
+    r = intValue(x);
+
+    return true;
+  };
+
+  switch (fn) {
+    case MathFn::ABS   : r = Value(std::abs(a.r), a.isInt); return true;
+    case MathFn::ACOS  : return realResult(std::acos (a.r));
+    case MathFn::ASIN  : return realResult(std::asin (a.r));
+    case MathFn::ATAN  : return realResult(std::atan (a.r));
+    case MathFn::ATAN2 : return realResult(std::atan2(a.r, args[1].r));
+    case MathFn::CEIL  : return realResult(std::ceil (a.r));
+    case MathFn::COS   : return realResult(std::cos  (a.r));
+    case MathFn::COSH  : return realResult(std::cosh (a.r));
+    case MathFn::DOUBLE: return realResult(a.r);
+    case MathFn::ENTIER: return intResult (std::trunc(a.r));
+    case MathFn::EXP   : return realResult(std::exp  (a.r));
+    case MathFn::FLOOR : return realResult(std::floor(a.r));
+    case MathFn::FMOD  : return realResult(std::fmod (a.r, args[1].r));
+    case MathFn::HYPOT : return realResult(std::hypot(a.r, args[1].r));
+    case MathFn::INT   : return intResult (std::trunc(a.r));
+    case MathFn::LOG   : return realResult(std::log  (a.r));
+    case MathFn::LOG10 : return realResult(std::log10(a.r));
+    case MathFn::MAX   : {
+      r = a;
+
+      for (int i = 1; i < nargs; ++i)
+        if (args[i].r > r.r) r = args[i];
+
+      return true;
+    }
+    case MathFn::MIN   : {
+      r = a;
+
+      for (int i = 1; i < nargs; ++i)
+        if (args[i].r < r.r) r = args[i];
+
+      return true;
+    }
+    case MathFn::POW   : return realResult(std::pow  (a.r, args[1].r));
+    case MathFn::ROUND : return intResult (std::round(a.r));
+    case MathFn::SIN   : return realResult(std::sin  (a.r));
+    case MathFn::SINH  : return realResult(std::sinh (a.r));
+    case MathFn::SQRT  : return realResult(std::sqrt (a.r));
+    case MathFn::TAN   : return realResult(std::tan  (a.r));
+    case MathFn::TANH  : return realResult(std::tanh (a.r));
+    case MathFn::WIDE  : return intResult (std::trunc(a.r));
+    default            : return false;
+  }
+}
+
+}
+
+//------
+
+//! recursive descent parser for tcl expression subset, adds stack operations to compiler
+class CQChartsExprCompiler::Parser {
+ public:
+  using Source = CQChartsExprCompiler::Source;
+
+ public:
+  Parser(CQChartsExprCompiler *compiler, const Source &source, const QString &str) :
+   compiler_(compiler), source_(source), str_(str) {
+  }
+
+  bool parse() {
+    if (! parseTernary())
+      return false;
+
+    skipSpace();
+
+    return (pos_ >= str_.length());
+  }
+
+ private:
+  // <or> [? <ternary> : <ternary>]
+  bool parseTernary() {
+    if (! parseOr())
+      return false;
+
+    if (! skipOp("?"))
+      return true;
+
+    if (! parseTernary())
+      return false;
+
+    if (! skipOp(":"))
+      return false;
+
+    if (! parseTernary())
+      return false;
+
+    Op op; op.type = OpType::SELECT; op.nargs = 3;
+
+    compiler_->addOp(op);
+
+    return true;
+  }
+
+  bool parseOr() {
+    if (! parseAnd())
+      return false;
+
+    while (skipOp("||")) {
+      if (! parseAnd())
+        return false;
+
+      addBinaryOp(BinaryOp::OR);
+    }
+
+    return true;
+  }
+
+  bool parseAnd() {
+    if (! parseEquality())
+      return false;
+
+    while (skipOp("&&")) {
+      if (! parseEquality())
+        return false;
+
+      addBinaryOp(BinaryOp::AND);
+    }
+
+    return true;
+  }
+
+  bool parseEquality() {
+    if (! parseRelational())
+      return false;
+
+    while (true) {
+      BinaryOp op;
+
+      if      (skipOp("==")) op = BinaryOp::EQ;
+      else if (skipOp("!=")) op = BinaryOp::NE;
+      else break;
+
+      if (! parseRelational())
+        return false;
+
+      addBinaryOp(op);
+    }
+
+    return true;
+  }
+
+  bool parseRelational() {
+    if (! parseAdditive())
+      return false;
+
+    while (true) {
+      BinaryOp op;
+
+      if      (skipOp("<=")) op = BinaryOp::LE;
+      else if (skipOp(">=")) op = BinaryOp::GE;
+      else if (isOp("<<") || isOp(">>")) return false;
+      else if (skipOp("<" )) op = BinaryOp::LT;
+      else if (skipOp(">" )) op = BinaryOp::GT;
+      else break;
+
+      if (! parseAdditive())
+        return false;
+
+      addBinaryOp(op);
+    }
+
+    return true;
+  }
+
+  bool parseAdditive() {
+    if (! parseMultiplicative())
+      return false;
+
+    while (true) {
+      BinaryOp op;
+
+      if      (skipOp("+")) op = BinaryOp::ADD;
+      else if (skipOp("-")) op = BinaryOp::SUB;
+      else break;
+
+      if (! parseMultiplicative())
+        return false;
+
+      addBinaryOp(op);
+    }
+
+    return true;
+  }
+
+  bool parseMultiplicative() {
+    if (! parsePower())
+      return false;
+
+    while (true) {
+      BinaryOp op;
+
+      if      (isOp("**")) break;
+      else if (skipOp("*")) op = BinaryOp::MUL;
+      else if (skipOp("/")) op = BinaryOp::DIV;
+      else if (skipOp("%")) op = BinaryOp::MOD;
+      else break;
+
+      if (! parsePower())
+        return false;
+
+      addBinaryOp(op);
+    }
+
+    return true;
+  }
+
+  // <unary> [** <power>] (right associative)
+  bool parsePower() {
+    if (! parseUnary())
+      return false;
+
+    if (skipOp("**")) {
+      if (! parsePower())
+        return false;
+
+      addBinaryOp(BinaryOp::POW);
+    }
+
+    return true;
+  }
+
+  bool parseUnary() {
+    UnaryOp uop;
+
+    if      (skipOp("-")) uop = UnaryOp::MINUS;
+    else if (skipOp("+")) uop = UnaryOp::PLUS;
+    else if (isOp("!=")) return false;
+    else if (skipOp("!")) uop = UnaryOp::NOT;
+    else return parsePrimary();
+
+    if (! parseUnary())
+      return false;
+
+    Op op; op.type = OpType::UNARY; op.code = int(uop); op.nargs = 1;
+
+    compiler_->addOp(op);
+
+    return true;
+  }
+
+  bool parsePrimary() {
+    skipSpace();
+
+    if (pos_ >= str_.length())
+      return false;
+
+    QChar c = str_[pos_];
+
+    // ( <expr> )
+    if      (c == '(') {
+      ++pos_;
+
+      if (! parseTernary())
+        return false;
+
+      return skipOp(")");
+    }
+    // number
+    else if (c.isDigit() || (c == '.' && pos_ + 1 < str_.length() && str_[pos_ + 1].isDigit())) {
+      return parseNumber();
+    }
+    // $<name> or ${<name>}
+    else if (c == '$') {
+      ++pos_;
+
+      QString name;
+
+      if (pos_ < str_.length() && str_[pos_] == '{') {
+        int pos1 = str_.indexOf('}', pos_ + 1);
+        if (pos1 < 0) return false;
+
+        name = str_.mid(pos_ + 1, pos1 - pos_ - 1);
+
+        pos_ = pos1 + 1;
+      }
+      else
+        name = readIdentifier();
+
+      if (! name.length())
+        return false;
+
+      return addVariable(name);
+    }
+    // @r (row) or @c (column)
+    else if (c == '@') {
+      ++pos_;
+
+      QString name = readIdentifier();
+
+      Op op;
+
+      if      (name == "r") op.type = OpType::ROW;
+      else if (name == "c") op.type = OpType::CURRENT_COLUMN;
+      else return false;
+
+      compiler_->addOp(op);
+
+      return true;
+    }
+    // <fn>(<args>)
+    else if (c.isLetter() || c == '_') {
+      QString name = readIdentifier();
+
+      if (! skipOp("("))
+        return false;
+
+      return parseFunction(name);
+    }
+
+    return false;
+  }
+
+  bool parseNumber() {
+    int pos1 = pos_;
+
+    bool isInt = true;
+
+    while (pos_ < str_.length() && str_[pos_].isDigit())
+      ++pos_;
+
+    if (pos_ < str_.length() && str_[pos_] == '.') {
+      isInt = false;
+
+      ++pos_;
+
+      while (pos_ < str_.length() && str_[pos_].isDigit())
+        ++pos_;
+    }
+
+    if (pos_ < str_.length() && (str_[pos_] == 'e' || str_[pos_] == 'E')) {
+      isInt = false;
+
+      ++pos_;
+
+      if (pos_ < str_.length() && (str_[pos_] == '+' || str_[pos_] == '-'))
+        ++pos_;
+
+      if (pos_ >= str_.length() || ! str_[pos_].isDigit())
+        return false;
+
+      while (pos_ < str_.length() && str_[pos_].isDigit())
+        ++pos_;
+    }
+
+    // hex, octal, ... use tcl
+    if (pos_ < str_.length() && (str_[pos_].isLetter() || str_[pos_] == '_'))
+      return false;
+
+    QString numStr = str_.mid(pos1, pos_ - pos1);
+
+    if (isInt && numStr.length() > 1 && numStr[0] == '0')
+      return false;
+
+    bool ok;
+
+    double r = numStr.toDouble(&ok);
+
+    if (! ok || (isInt && ! isValidInt(r)))
+      return false;
+
+    Op op; op.type = OpType::NUMBER; op.value = r; op.isInt = isInt;
+
+    compiler_->addOp(op);
+
+    return true;
+  }
+
+  bool addVariable(const QString &name) {
+    Op op;
+
+    int column = source_.nameColumn(name);
+
+    if      (column >= 0) {
+      op.type   = OpType::COLUMN;
+      op.column = compiler_->columnIndex(column);
+    }
+    else if (name == "row" || name == "x") {
+      op.type = OpType::ROW;
+    }
+    else if (name == "column" || name == "col") {
+      op.type = OpType::CURRENT_COLUMN;
+    }
+    else if (name == "PI") {
+      op.type = OpType::NUMBER; op.value = M_PI;
+    }
+    else if (name == "NaN") {
+      op.type = OpType::NUMBER; op.value = CMathUtil::getNaN();
+    }
+    else
+      return false;
+
+    compiler_->addOp(op);
+
+    return true;
+  }
+
+  bool parseFunction(const QString &name) {
+    // column(<n>) : column value
+    if (name == "column" && source_.hasFunction(name)) {
+      skipSpace();
+
+      int pos1 = pos_;
+
+      while (pos_ < str_.length() && str_[pos_].isDigit())
+        ++pos_;
+
+      bool ok;
+
+      int column = str_.mid(pos1, pos_ - pos1).toInt(&ok);
+
+      if (! ok || column < 0 || column >= source_.numColumns())
+        return false;
+
+      if (! skipOp(")"))
+        return false;
+
+      Op op; op.type = OpType::COLUMN; op.column = compiler_->columnIndex(column);
+
+      compiler_->addOp(op);
+
+      return true;
+    }
+
+    //---
+
+    // source function (args can be expressions, strings or raw column values)
+    if (source_.hasFunction(name)) {
+      Op op; op.type = OpType::SOURCE_FUNCTION; op.name = name;
+
+      if (! skipOp(")")) {
+        while (true) {
+          FunctionArg arg;
+
+          QString str;
+
+          if (parseString(str)) {
+            arg.type = FunctionArg::Type::STRING;
+            arg.str  = str;
+          }
+          else {
+            int n = int(compiler_->ops_.size());
+
+            if (! parseTernary())
+              return false;
+
+            // pass single column value unconverted
+            if (int(compiler_->ops_.size()) == n + 1 &&
+                compiler_->ops_.back().type == OpType::COLUMN) {
+              arg.type   = FunctionArg::Type::COLUMN;
+              arg.column = compiler_->ops_.back().column;
+
+              compiler_->ops_.pop_back();
+
+              --compiler_->depth_;
+            }
+            else
+              ++op.nargs;
+          }
+
+          op.args.push_back(arg);
+
+          if (skipOp(")"))
+            break;
+
+          if (! skipOp(","))
+            return false;
+        }
+      }
+
+      compiler_->addOp(op);
+
+      return true;
+    }
+
+    //---
+
+    // tcl math function
+    if (source_.isCustomFunction(name))
+      return false;
+
+    const MathFnData *fnData = nullptr;
+
+    for (int i = 0; mathFnDatas[i].name; ++i) {
+      if (name == mathFnDatas[i].name) {
+        fnData = &mathFnDatas[i];
+        break;
+      }
+    }
+
+    if (! fnData)
+      return false;
+
+    int nargs = 0;
+
+    if (! skipOp(")")) {
+      while (true) {
+        if (! parseTernary())
+          return false;
+
+        ++nargs;
+
+        if (skipOp(")"))
+          break;
+
+        if (! skipOp(","))
+          return false;
+      }
+    }
+
+    if (nargs < fnData->minArgs || (fnData->maxArgs >= 0 && nargs > fnData->maxArgs))
+      return false;
+
+    Op op; op.type = OpType::FUNCTION; op.code = int(fnData->fn); op.nargs = nargs;
+
+    compiler_->addOp(op);
+
+    return true;
+  }
+
+  // "<str>" (no substitutions)
+  bool parseString(QString &str) {
+    skipSpace();
+
+    if (pos_ >= str_.length() || str_[pos_] != '"')
+      return false;
+
+    int pos1 = pos_ + 1;
+    int pos2 = pos1;
+
+    while (pos2 < str_.length() && str_[pos2] != '"') {
+      if (str_[pos2] == '$' || str_[pos2] == '[' || str_[pos2] == '\\')
+        return false;
+
+      ++pos2;
+    }
+
+    if (pos2 >= str_.length())
+      return false;
+
+    str  = str_.mid(pos1, pos2 - pos1);
+    pos_ = pos2 + 1;
+
+    skipSpace();
+
+    // must be whole argument
+    if (pos_ >= str_.length() || (str_[pos_] != ',' && str_[pos_] != ')')) {
+      pos_ = pos1 - 1;
+      return false;
+    }
+
+    return true;
+  }
+
+  void addBinaryOp(BinaryOp bop) {
+    Op op; op.type = OpType::BINARY; op.code = int(bop); op.nargs = 2;
+
+    compiler_->addOp(op);
+  }
+
+  QString readIdentifier() {
+    int pos1 = pos_;
+
+    while (pos_ < str_.length() && (str_[pos_].isLetterOrNumber() || str_[pos_] == '_'))
+      ++pos_;
+
+    return str_.mid(pos1, pos_ - pos1);
+  }
+
+  bool isOp(const char *op) {
+    skipSpace();
+
+    return str_.midRef(pos_).startsWith(QLatin1String(op));
+  }
+
+  bool skipOp(const char *op) {
+    if (! isOp(op))
+      return false;
+
+    pos_ += int(strlen(op));
+
+    return true;
+  }
+
+  void skipSpace() {
+    while (pos_ < str_.length() && str_[pos_].isSpace())
+      ++pos_;
+  }
+
+ private:
+  CQChartsExprCompiler* compiler_ { nullptr };
+  const Source&         source_;
+  QString               str_;
+  int                   pos_      { 0 };
+};
+
+//------
+
+CQChartsExprCompiler::
+CQChartsExprCompiler()
+{
+}
+
+bool
+CQChartsExprCompiler::
+compile(const QString &expr, const Source &source)
+{
+  expr_  = expr;
+  valid_ = false;
+
+  ops_    .clear();
+  columns_.clear();
+
+  depth_    = 0;
+  maxDepth_ = 0;
+
+  Parser parser(this, source, expr_);
+
+  if (! parser.parse() || depth_ != 1) {
+    ops_.clear();
+    return false;
+  }
+
+  valid_ = true;
+
+  return true;
+}
+
+void
+CQChartsExprCompiler::
+addOp(const Op &op)
+{
+  ops_.push_back(op);
+
+  switch (op.type) {
+    case OpType::NUMBER:
+    case OpType::COLUMN:
+    case OpType::ROW:
+    case OpType::CURRENT_COLUMN:
+      ++depth_;
+      break;
+    default:
+      depth_ -= op.nargs - 1;
+      break;
+  }
+
+  maxDepth_ = std::max(maxDepth_, depth_);
+}
+
+int
+CQChartsExprCompiler::
+columnIndex(int column)
+{
+  for (std::size_t i = 0; i < columns_.size(); ++i)
+    if (columns_[i] == column)
+      return int(i);
+
+  columns_.push_back(column);
+
+  return int(columns_.size() - 1);
+}
+
+bool
+CQChartsExprCompiler::
+eval(const Source &source, int row, QVariant &value) const
+{
+  Values values;
+  Bools  oks;
+
+  evalRows(source, row, row + 1, values, oks);
+
+  if (oks.empty() || ! oks[0])
+    return false;
+
+  value = values[0];
+
+  return true;
+}
+
+void
+CQChartsExprCompiler::
+evalRows(const Source &source, int row1, int row2, Values &values, Bools &oks) const
+{
+  int n = std::max(row2 - row1, 0);
+
+  values.clear(); values.resize(n);
+  oks   .clear(); oks   .resize(n, valid_);
+
+  if (! valid_ || n == 0)
+    return;
+
+  //---
+
+  // read referenced column values (raw values kept for source function args)
+  int nc = int(columns_.size());
+
+  std::vector<Vector> columnValues(nc);
+  std::vector<Values> columnVars  (nc);
+
+  for (int ic = 0; ic < nc; ++ic) {
+    auto &vars = columnVars[ic];
+
+    vars.resize(n);
+
+    for (int i = 0; i < n; ++i)
+      vars[i] = source.columnValue(row1 + i, columns_[ic]);
+  }
+
+  auto numericColumn = [&](int ic) -> const Vector & {
+    auto &cvalues = columnValues[ic];
+
+    if (cvalues.empty()) {
+      cvalues.resize(n);
+
+      const auto &vars = columnVars[ic];
+
+      for (int i = 0; i < n; ++i) {
+        if (oks[i] && ! variantToValue(vars[i], cvalues[i]))
+          oks[i] = false;
+      }
+    }
+
+    return cvalues;
+  };
+
+  //---
+
+  std::vector<Vector> stack(maxDepth_);
+
+  int sp = 0;
+
+  int currentColumn = source.currentColumn();
+
+  int nops = int(ops_.size());
+
+  for (int iop = 0; iop < nops; ++iop) {
+    const auto &op = ops_[iop];
+
+    switch (op.type) {
+      case OpType::NUMBER: {
+        stack[sp++].assign(n, Value(op.value, op.isInt));
+
+        break;
+      }
+      case OpType::COLUMN: {
+        stack[sp++] = numericColumn(op.column);
+
+        break;
+      }
+      case OpType::ROW: {
+        auto &v = stack[sp++];
+
+        v.resize(n);
+
+        for (int i = 0; i < n; ++i)
+          v[i] = intValue(row1 + i);
+
+        break;
+      }
+      case OpType::CURRENT_COLUMN: {
+        stack[sp++].assign(n, intValue(currentColumn));
+
+        break;
+      }
+      case OpType::UNARY: {
+        auto &a = stack[sp - 1];
+
+        auto uop = UnaryOp(op.code);
+
+        for (int i = 0; i < n; ++i) {
+          if (oks[i] && ! unaryOp(uop, a[i], a[i]))
+            oks[i] = false;
+        }
+
+        break;
+      }
+      case OpType::BINARY: {
+        auto &a = stack[sp - 2];
+        auto &b = stack[sp - 1];
+
+        auto bop = BinaryOp(op.code);
+
+        for (int i = 0; i < n; ++i) {
+          if (oks[i] && ! binaryOp(bop, a[i], b[i], a[i]))
+            oks[i] = false;
+        }
+
+        --sp;
+
+        break;
+      }
+      case OpType::SELECT: {
+        auto &c = stack[sp - 3];
+        auto &a = stack[sp - 2];
+        auto &b = stack[sp - 1];
+
+        for (int i = 0; i < n; ++i)
+          c[i] = (c[i].r != 0.0 ? a[i] : b[i]);
+
+        sp -= 2;
+
+        break;
+      }
+      case OpType::FUNCTION: {
+        int na = op.nargs;
+
+        auto fn = MathFn(op.code);
+
+        std::vector<Value> args(na);
+
+        auto &r = stack[sp - na];
+
+        for (int i = 0; i < n; ++i) {
+          if (! oks[i]) continue;
+
+          for (int j = 0; j < na; ++j)
+            args[j] = stack[sp - na + j][i];
+
+          if (! mathFn(fn, &args[0], na, r[i]))
+            oks[i] = false;
+        }
+
+        sp -= na - 1;
+
+        break;
+      }
+      case OpType::SOURCE_FUNCTION: {
+        int na = op.nargs;
+
+        bool isResult = (iop == nops - 1);
+
+        Vector r(n);
+
+        Values args;
+
+        for (int i = 0; i < n; ++i) {
+          if (! oks[i]) continue;
+
+          args.clear();
+
+          int is = sp - na;
+
+          for (const auto &arg : op.args) {
+            if      (arg.type == FunctionArg::Type::STRING)
+              args.push_back(QVariant(arg.str));
+            else if (arg.type == FunctionArg::Type::COLUMN)
+              args.push_back(columnVars[arg.column][i]);
+            else
+              args.push_back(valueToVariant(stack[is++][i]));
+          }
+
+          QVariant var = source.callFunction(op.name, row1 + i, args);
+
+          // final result is returned unconverted (non-numeric values as string like tcl)
+          if (isResult) {
+            if      (! var.isValid())
+              oks[i] = false;
+            else if (variantToValue(var, r[i]) && var.type() != QVariant::String)
+              values[i] = var;
+            else
+              values[i] = QVariant(var.toString());
+          }
+          else {
+            if (! variantToValue(var, r[i]))
+              oks[i] = false;
+          }
+        }
+
+        if (isResult)
+          return;
+
+        sp -= na;
+
+        stack[sp++] = std::move(r);
+
+        break;
+      }
+      default:
+        assert(false);
+        break;
+    }
+  }
+
+  assert(sp == 1);
+
+  const auto &r = stack[0];
+
+  for (int i = 0; i < n; ++i) {
+    if (oks[i])
+      values[i] = valueToVariant(r[i]);
+  }
+}
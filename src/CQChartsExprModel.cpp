@@ -1,6 +1,7 @@
 #include <CQChartsExprModel.h>
 #include <CQChartsExprModelFn.h>
 #include <CQChartsExprCmdValues.h>
+#include <CQChartsExprCompiler.h>
 #include <CQChartsExprTcl.h>
 #include <CQChartsModelData.h>
 #include <CQChartsModelDetails.h>
@@ -15,6 +16,49 @@
 #include <QColor>
 #include <iostream>
 
+//! compiled expression source for expression model values and functions
+class CQChartsExprModelSource : public CQChartsExprCompiler::Source {
+ public:
+  using Values = CQChartsExprCompiler::Values;
+
+ public:
+  CQChartsExprModelSource(const CQChartsExprModel *model) :
+   model_(model) {
+  }
+
+  int numColumns() const override { return model_->columnCount(); }
+
+  int currentColumn() const override { return model_->currentCol(); }
+
+  int nameColumn(const QString &name) const override {
+    return model_->qtcl_->nameColumn(name); }
+
+  QVariant columnValue(int row, int column) const override {
+    return model_->getCmdData(row, column); }
+
+  bool hasFunction(const QString &name) const override {
+    return (name == "column" || name == "norm" || name == "scale" ||
+            name == "bucket" || name == "color");
+  }
+
+  bool isCustomFunction(const QString &name) const override {
+    return model_->qtcl_->isExprFunction(name); }
+
+  QVariant callFunction(const QString &name, int row, const Values &values) const override {
+    model_->currentRow_ = row;
+
+    if      (name == "norm"  ) return model_->normCmd  (values);
+    else if (name == "scale" ) return model_->scaleCmd (values);
+    else if (name == "bucket") return model_->bucketCmd(values);
+    else if (name == "color" ) return model_->colorCmd (values);
+
+    return QVariant();
+  }
+
+ private:
+  const CQChartsExprModel* model_ { nullptr };
+};
+
 //------
 
 CQChartsExprModel::
@@ -359,6 +403,8 @@ assignExtraColumn(const QString &header, int column, const QString &expr)
 
   extraColumn->expr = expr;
 
+  extraColumn->compiler.reset();
+
   extraColumn->variantMap.clear();
 
   extraColumn->function = Function::ASSIGN;
@@ -484,6 +530,10 @@ initCalc()
   qtcl_->resetLastValue();
   qtcl_->resetColumns();
 
+  // column names may have changed so recompile expressions
+  for (auto &extraColumn : extraColumns_)
+    extraColumn->compiler.reset();
+
   //---
 
   // add user defined functions
@@ -520,6 +570,9 @@ calcExtraColumn(int column, int ecolumn)
   nr_ = rowCount();
   nc_ = columnCount();
 
+  // evaluate compiled expression for all rows (rows not evaluated use tcl)
+  calcCompiledExtraColumn(column, ecolumn);
+
   // ensure all values are evaluated
   int numErrors = 0;
 
@@ -907,46 +960,28 @@ calcExtraColumnValue(int row, int column, int ecolumn, bool &rc)
 
   extraColumn.evaluating = true;
 
-  QString expr = extraColumn.expr;
+  QVariant var;
 
-  expr = replaceExprColumns(expr, row, column).simplified();
+  bool evaluated = false;
 
-  QVariant var;
+  const auto *compiler = extraColumnCompiler(ecolumn);
 
-  if (evaluateExpression(expr, var)) {
-    std::string str;
+  if (compiler) {
+    CQChartsExprModelSource source(this);
 
-    if      (var.type() == QVariant::Double) {
-      double real = var.value<double>();
+    evaluated = compiler->eval(source, row, var);
+  }
 
-      bool isInt = CQBaseModel::isInteger(real);
+  if (! evaluated) {
+    QString expr = extraColumn.expr;
 
-      if      (extraColumn.typeData.type == CQBaseModelType::NONE) {
-        if (CQBaseModel::isInteger(real))
-          extraColumn.typeData.type = CQBaseModelType::INTEGER;
-        else
-          extraColumn.typeData.type = CQBaseModelType::REAL;
-      }
-      else if (extraColumn.typeData.type == CQBaseModelType::INTEGER) {
-        if (! isInt)
-          extraColumn.typeData.type = CQBaseModelType::REAL;
-      }
-      else if (extraColumn.typeData.type == CQBaseModelType::REAL) {
-      }
-    }
-    else if (var.type() == QVariant::Int) {
-      if (extraColumn.typeData.type == CQBaseModelType::NONE)
-        extraColumn.typeData.type = CQBaseModelType::INTEGER;
-    }
-    else if (var.type() == QVariant::Bool) {
-      if (extraColumn.typeData.type == CQBaseModelType::NONE)
-        extraColumn.typeData.type = CQBaseModelType::INTEGER;
-    }
-    else {
-      if (extraColumn.typeData.type == CQBaseModelType::NONE)
-        extraColumn.typeData.type = CQBaseModelType::STRING;
-    }
+    expr = replaceExprColumns(expr, row, column).simplified();
+
+    evaluated = evaluateExpression(expr, var);
   }
+
+  if (evaluated)
+    updateExtraColumnType(extraColumn, var);
   else
     rc = false;
 
@@ -967,6 +1002,121 @@ calcExtraColumnValue(int row, int column, int ecolumn, bool &rc)
   return (*p).second;
 }
 
+void
+CQChartsExprModel::
+calcCompiledExtraColumn(int column, int ecolumn)
+{
+  const auto *compiler = extraColumnCompiler(ecolumn);
+  if (! compiler) return;
+
+  CQPerfTrace trace("CQChartsExprModel::calcCompiledExtraColumn");
+
+  auto &extraColumn = this->extraColumn(ecolumn);
+
+  CQChartsExprModelSource source(this);
+
+  currentCol_ = column;
+
+  // references to this column use stored values
+  extraColumn.evaluating = true;
+
+  // evaluate blocks of rows
+  const int blockSize = 4096;
+
+  Values                      values;
+  CQChartsExprCompiler::Bools oks;
+
+  for (int r1 = 0; r1 < nr_; r1 += blockSize) {
+    int r2 = std::min(r1 + blockSize, nr_);
+
+    compiler->evalRows(source, r1, r2, values, oks);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    for (int r = r1; r < r2; ++r) {
+      if (! oks[r - r1]) continue;
+
+      const auto &var = values[r - r1];
+
+      updateExtraColumnType(extraColumn, var);
+
+      extraColumn.variantMap[r] = var;
+
+      if (extraColumn.function == Function::ADD) {
+        if (! extraColumn.values.empty())
+          extraColumn.values[r] = var;
+      }
+
+      if (isDebug())
+        std::cerr << "Set Row " << r << " Column " << column << " = " <<
+                     var.toString().toStdString() << std::endl;
+    }
+  }
+
+  extraColumn.evaluating = false;
+}
+
+const CQChartsExprCompiler *
+CQChartsExprModel::
+extraColumnCompiler(int ecolumn)
+{
+  auto &extraColumn = this->extraColumn(ecolumn);
+
+  if (! extraColumn.compiler) {
+    extraColumn.compiler = std::make_shared<CQChartsExprCompiler>();
+
+    // row dependent replacements (stringified values, row/column counts) use tcl
+    const auto &expr = extraColumn.expr;
+
+    if (! expr.contains("@#") && ! expr.contains("@n")) {
+      QString expr1 =
+        CQChartsModelUtil::replaceModelExprVars(expr, this, QModelIndex(), -1, -1).simplified();
+
+      CQChartsExprModelSource source(this);
+
+      (void) extraColumn.compiler->compile(expr1, source);
+    }
+  }
+
+  return (extraColumn.compiler->isValid() ? extraColumn.compiler.get() : nullptr);
+}
+
+void
+CQChartsExprModel::
+updateExtraColumnType(ExtraColumn &extraColumn, const QVariant &var)
+{
+  if      (var.type() == QVariant::Double) {
+    double real = var.value<double>();
+
+    bool isInt = CQBaseModel::isInteger(real);
+
+    if      (extraColumn.typeData.type == CQBaseModelType::NONE) {
+      if (CQBaseModel::isInteger(real))
+        extraColumn.typeData.type = CQBaseModelType::INTEGER;
+      else
+        extraColumn.typeData.type = CQBaseModelType::REAL;
+    }
+    else if (extraColumn.typeData.type == CQBaseModelType::INTEGER) {
+      if (! isInt)
+        extraColumn.typeData.type = CQBaseModelType::REAL;
+    }
+    else if (extraColumn.typeData.type == CQBaseModelType::REAL) {
+    }
+  }
+  else if (var.type() == QVariant::Int) {
+    if (extraColumn.typeData.type == CQBaseModelType::NONE)
+      extraColumn.typeData.type = CQBaseModelType::INTEGER;
+  }
+  else if (var.type() == QVariant::Bool) {
+    if (extraColumn.typeData.type == CQBaseModelType::NONE)
+      extraColumn.typeData.type = CQBaseModelType::INTEGER;
+  }
+  else {
+    if (extraColumn.typeData.type == CQBaseModelType::NONE)
+      extraColumn.typeData.type = CQBaseModelType::STRING;
+  }
+}
+
 bool
 CQChartsExprModel::
 setData(const QModelIndex &index, const QVariant &value, int role)
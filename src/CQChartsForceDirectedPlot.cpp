@@ -297,6 +297,48 @@ setEdgeLinesValueWidth(bool b)
   CQChartsUtil::testAndSet(edgeLinesValueWidth_, b, [&]() { drawObjs(); } );
 }
 
+bool
+CQChartsForceDirectedPlot::
+isApproximate() const
+{
+  return forceDirected_->isApproximate();
+}
+
+void
+CQChartsForceDirectedPlot::
+setApproximate(bool b)
+{
+  forceDirected_->setApproximate(b);
+}
+
+double
+CQChartsForceDirectedPlot::
+theta() const
+{
+  return forceDirected_->theta();
+}
+
+void
+CQChartsForceDirectedPlot::
+setTheta(double r)
+{
+  forceDirected_->setTheta(std::max(r, 0.0));
+}
+
+int
+CQChartsForceDirectedPlot::
+numThreads() const
+{
+  return forceDirected_->numThreads();
+}
+
+void
+CQChartsForceDirectedPlot::
+setNumThreads(int n)
+{
+  forceDirected_->setNumThreads(std::max(n, 1));
+}
+
 //---
 
 void
@@ -325,6 +367,13 @@ addProperties()
   // options
   addProp("options", "running", "", "Is running");
 
+  // repulsion
+  addProp("repulsion", "approximate", "", "Use Barnes-Hut approximation for node repulsion");
+  addProp("repulsion", "theta"      , "", "Barnes-Hut cell size to distance ratio (0 is exact)")->
+    setMinValue(0.0);
+  addProp("repulsion", "numThreads" , "", "Number of threads used for node repulsion")->
+    setMinValue(1);
+
   // node/edge
   addProp("node", "nodeRadius", "radius", "Node radius in pixels")->setMinValue(0.0);
 
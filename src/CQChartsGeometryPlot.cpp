@@ -18,6 +18,17 @@
 #include <CQPropertyViewItem.h>
 #include <CQPerfMonitor.h>
 
+#include <atomic>
+#include <future>
+#include <thread>
+
+namespace {
+
+// min number of polygon points for parallel simplify
+const int minParallelPoints = 16384;
+
+}
+
 CQChartsGeometryPlotType::
 CQChartsGeometryPlotType()
 {
@@ -58,13 +69,17 @@ description() const
     h3("Summary").
      p("Draws polygon list, polygon, rect or path shapes.").
     h3("Columns").
-     p("The shape geometry is specified in the " + B("Geometry") + " column.").
+     p("The shape geometry is specified in the " + B("Geometry") + " column "
+       "as a string or binary (WKB polygon or multi polygon) value.").
      p("The optional shape name can be specified in the " + B("Name") + " column.").
      p("The optional shape value can be specified in the " + B("Value") + " column "
        "and can be used to color the shape by enabling the " + B("colorByValue") + " option." +
        BR() + "This value can be normalized using the " + B("minValue") + " and " +
        B("maxValue") + " values.").
      p("The optional style (fill, stroke) can be specified in the " + B("Style") + " column.").
+    h3("Options").
+     p("Polygons are simplified when drawn (using " + B("simplify") + " and " +
+       B("simplifyTolerance") + ") so points smaller than a pixel are not drawn.").
     h3("Limitations").
      p("None.").
     h3("Example").
@@ -250,6 +265,22 @@ setValueStyle(const ValueStyle &valueStyle)
 
 //---
 
+void
+CQChartsGeometryPlot::
+setSimplify(bool b)
+{
+  CQChartsUtil::testAndSet(simplify_, b, [&]() { updateRangeAndObjs(); } );
+}
+
+void
+CQChartsGeometryPlot::
+setSimplifyTolerance(double r)
+{
+  CQChartsUtil::testAndSet(simplifyTolerance_, r, [&]() { drawObjs(); } );
+}
+
+//---
+
 void
 CQChartsGeometryPlot::
 addProperties()
@@ -285,6 +316,10 @@ addProperties()
   // selectable
   addProp("geometry", "geometrySelectable", "selectable", "Geometry selectable");
 
+  // simplify
+  addProp("geometry/simplify", "simplify"         , "enabled"  , "Simplify polygons when drawn");
+  addProp("geometry/simplify", "simplifyTolerance", "tolerance", "Simplify tolerance in pixels");
+
   // value balloon
   addProp("value", "valueStyle", "style", "Value Style");
 
@@ -376,9 +411,72 @@ calcRange() const
 
   visitModel(geometryPlotVisitor);
 
+  //---
+
+  // build simplified polygons
+  if (isSimplify())
+    th->calcPyramids();
+
   return geometryPlotVisitor.dataRange();
 }
 
+void
+CQChartsGeometryPlot::
+calcPyramids()
+{
+  CQPerfTrace trace("CQChartsGeometryPlot::calcPyramids");
+
+  int ng = geometries_.size();
+
+  auto calcGeometryPyramids = [&](Geometry &geometry) {
+    auto pyramids = std::make_shared<CQChartsPolygonPyramids>();
+
+    pyramids->reserve(geometry.polygons.size());
+
+    for (const auto &poly : geometry.polygons)
+      pyramids->push_back(CQChartsPolygonPyramid(poly));
+
+    geometry.pyramids = pyramids;
+  };
+
+  //---
+
+  int np = 0;
+
+  for (const auto &geometry : geometries_)
+    for (const auto &poly : geometry.polygons)
+      np += poly.size();
+
+  int nt = (np >= minParallelPoints ?
+    std::min(std::max(int(std::thread::hardware_concurrency()), 1), ng) : 1);
+
+  if (nt > 1) {
+    std::atomic<int> nextGeometry { 0 };
+
+    std::vector<std::future<void>> futures;
+
+    for (int i = 0; i < nt; ++i) {
+      futures.push_back(std::async(std::launch::async, [&]() {
+        while (true) {
+          int ig = nextGeometry++;
+
+          if (ig >= ng)
+            break;
+
+          calcGeometryPyramids(geometries_[ig]);
+        }
+      }));
+    }
+
+    for (auto &future : futures)
+      future.get();
+  }
+  else {
+    for (auto &geometry : geometries_)
+      calcGeometryPyramids(geometry);
+  }
+}
+
 void
 CQChartsGeometryPlot::
 addRow(const QAbstractItemModel *model, const ModelVisitor::VisitData &data,
@@ -474,37 +572,56 @@ addRow(const QAbstractItemModel *model, const ModelVisitor::VisitData &data,
   else {
     bool ok2;
 
-    QString geomStr = modelString(geometryInd, ok2);
+    // binary or hex encoded binary (WKB) polygons (no string decode)
+    QVariant var = modelValue(geometryInd, ok2);
 
-    CQChartsGeometryShape shape(geomStr);
+    CQChartsPolygonList polyList;
 
-    if (shape.type == CQChartsGeometryShape::Type::NONE) {
-      th->addDataError(geometryInd, "Invalid geometry '" + geomStr + "'");
-      return;
+    if ((var.type() == QVariant::ByteArray && polyList.fromBinary(var.toByteArray())) ||
+        (var.type() == QVariant::String && polyList.fromHexBinary(var.toString()))) {
+      for (const auto &poly : polyList.polygons()) {
+        if (poly.size() > 2 && poly.boundingBox().isValid())
+          geometry.polygons.push_back(poly);
+      }
+
+      if (geometry.polygons.empty()) {
+        th->addDataError(geometryInd, "Invalid binary geometry");
+        return;
+      }
     }
+    else {
+      QString geomStr = modelString(geometryInd, ok2);
+
+      CQChartsGeometryShape shape(geomStr);
 
-    if      (shape.type == CQChartsGeometryShape::Type::RECT)
-      geometry.polygons.push_back(CQChartsGeom::Polygon(shape.rect));
-    else if (shape.type == CQChartsGeometryShape::Type::POLYGON) {
-      if (shape.polygon.size() < 2) {
-        th->addDataError(geometryInd, "Too few points for polygon '" + geomStr + "'");
+      if (shape.type == CQChartsGeometryShape::Type::NONE) {
+        th->addDataError(geometryInd, "Invalid geometry '" + geomStr + "'");
         return;
       }
 
-      geometry.polygons.push_back(shape.polygon);
-    }
-    else if (shape.type == CQChartsGeometryShape::Type::POLYGON_LIST) {
-      geometry.polygons = shape.polygonList;
-    }
-    else if (shape.type == CQChartsGeometryShape::Type::PATH) {
-      auto poly = CQChartsGeom::Polygon(shape.path.qpoly());
+      if      (shape.type == CQChartsGeometryShape::Type::RECT)
+        geometry.polygons.push_back(CQChartsGeom::Polygon(shape.rect));
+      else if (shape.type == CQChartsGeometryShape::Type::POLYGON) {
+        if (shape.polygon.size() < 2) {
+          th->addDataError(geometryInd, "Too few points for polygon '" + geomStr + "'");
+          return;
+        }
 
-      geometry.polygons.push_back(poly);
-    }
+        geometry.polygons.push_back(shape.polygon);
+      }
+      else if (shape.type == CQChartsGeometryShape::Type::POLYGON_LIST) {
+        geometry.polygons = shape.polygonList;
+      }
+      else if (shape.type == CQChartsGeometryShape::Type::PATH) {
+        auto poly = CQChartsGeom::Polygon(shape.path.qpoly());
 
-    if (geometry.polygons.empty()) {
-      th->addDataError(geometryInd, "Invalid geometry '" + geomStr + "'");
-      return;
+        geometry.polygons.push_back(poly);
+      }
+
+      if (geometry.polygons.empty()) {
+        th->addDataError(geometryInd, "Invalid geometry '" + geomStr + "'");
+        return;
+      }
     }
   }
 
@@ -624,6 +741,9 @@ createObjs(PlotObjs &objs) const
     geomObj->setColor(geometry.color);
     geomObj->setStyle(geometry.style);
 
+    if (isSimplify())
+      geomObj->setPyramids(geometry.pyramids);
+
     if (geometry.value)
       geomObj->setValue(*geometry.value);
 
@@ -762,8 +882,22 @@ draw(CQChartsPaintDevice *device)
 
   CQChartsDrawUtil::setPenBrush(device, penBrush);
 
-  for (const auto &ppoly : polygons_)
-    device->drawPolygon(CQChartsGeom::Polygon(ppoly));
+  // use simplified polygons for interactive draw (points removed are less than tolerance
+  // pixel area)
+  if (device->isInteractive() && pyramids_ && pyramids_->size() == polygons_.size()) {
+    double tol = plot_->simplifyTolerance();
+
+    double areaTol = device->pixelToWindowWidth(tol)*device->pixelToWindowHeight(tol);
+
+    int np = int(polygons_.size());
+
+    for (int i = 0; i < np; ++i)
+      device->drawPolygon((*pyramids_)[i].simplified(polygons_[i], areaTol));
+  }
+  else {
+    for (const auto &ppoly : polygons_)
+      device->drawPolygon(CQChartsGeom::Polygon(ppoly));
+  }
 
   device->resetColorNames();
 }
@@ -6,6 +6,7 @@
 #include <CQChartsDrawUtil.h>
 #include <CQChartsPaintDevice.h>
 #include <CQChartsHtml.h>
+#include <CQChartsHierBuilder.h>
 
 #include <CQPropertyViewItem.h>
 #include <CQPerfMonitor.h>
@@ -670,8 +671,9 @@ loadFlat() const
 {
   class RowVisitor : public ModelVisitor {
    public:
-    RowVisitor(const CQChartsHierBubblePlot *plot) :
-     plot_(plot) {
+    RowVisitor(const CQChartsHierBubblePlot *plot, CQChartsHierBuilder &builder,
+               FlatRows &flatRows) :
+     plot_(plot), builder_(builder), flatRows_(flatRows) {
     }
 
     State visit(const QAbstractItemModel *, const VisitData &data) override {
@@ -682,6 +684,10 @@ loadFlat() const
                                       plot_->separator(), nameStrs, nameInds))
         return State::SKIP;
 
+      FlatRowData flatRow;
+
+      flatRow.ind = plot_->normalizeIndex(nameInds[0]);
+
       //---
 
       double size = 1.0;
@@ -698,108 +704,97 @@ loadFlat() const
 
       //---
 
-      auto node = plot_->addNode(nameStrs, size, nameInds[0]);
-
-      if (node && plot_->colorColumn().isValid()) {
+      if (plot_->colorColumn().isValid()) {
         CQChartsColor color;
 
         CQChartsModelIndex colorInd(data.row, plot_->colorColumn(), data.parent);
 
         if (plot_->modelIndexColor(colorInd, color))
-          node->setColor(color);
+          flatRow.color = color;
       }
 
+      //---
+
+      if (builder_.addRow(nameStrs, size) < 0)
+        return State::SKIP;
+
+      flatRows_.push_back(flatRow);
+
       return State::OK;
     }
 
    private:
     const CQChartsHierBubblePlot* plot_ { nullptr };
+    CQChartsHierBuilder&          builder_;
+    FlatRows&                     flatRows_;
   };
 
-  RowVisitor visitor(this);
+  CQChartsHierBuilder builder;
+  FlatRows            flatRows;
+
+  RowVisitor visitor(this, builder, flatRows);
 
   visitModel(visitor);
 
   //---
 
+  builder.build();
+
+  addFlatNodes(builder, flatRows, builder.root(), nodeData_.root);
+
+  //---
+
   addExtraNodes(nodeData_.root);
 }
 
-CQChartsHierBubbleNode *
+void
 CQChartsHierBubblePlot::
-addNode(const QStringList &nameStrs, double size, const QModelIndex &nameInd) const
+addFlatNodes(const CQChartsHierBuilder &builder, const FlatRows &flatRows, int ind,
+             CQChartsHierBubbleHierNode *parent) const
 {
   auto *th = const_cast<CQChartsHierBubblePlot *>(this);
 
-  //---
-
-  int depth = nameStrs.length();
-
-  th->nodeData_.maxDepth = std::max(nodeData_.maxDepth, depth + 1);
-
-  //---
-
-  auto *parent = nodeData_.root;
-
-  for (int i = 0; i < nameStrs.length() - 1; ++i) {
-    auto *child = childHierNode(parent, nameStrs[i]);
-
-    if (! child) {
-      // remove any existing leaf node (save size to use in new hier node)
-      QModelIndex nameInd1;
-      double      size1 = 0.0;
-
-      auto *node = childNode(parent, nameStrs[i]);
+  // add hier nodes (own size of hier node is added as filler node by addExtraNodes)
+  for (const auto &c : builder.hierChildren(ind)) {
+    const auto &hierNode = builder.node(c);
 
-      if (node) {
-        nameInd1 = node->ind();
-        size1    = node->size();
+    int leafRow = builder.hierLeafRow(c);
 
-        parent->removeNode(node);
+    QModelIndex ind1 = (leafRow >= 0 ? flatRows[leafRow].ind : QModelIndex());
 
-        delete node;
-      }
+    auto *child = new CQChartsHierBubbleHierNode(this, parent, builder.nodeName(c), ind1);
 
-      //---
+    child->setSize(builder.hierNodeSize(c));
 
-      child = new CQChartsHierBubbleHierNode(this, parent, nameStrs[i], nameInd1);
+    child->setDepth(hierNode.depth);
+    child->setHierInd(th->nodeData_.hierInd++);
 
-      child->setSize(size1);
+    if (! hierNode.leafRows.empty())
+      th->nodeData_.maxDepth = std::max(nodeData_.maxDepth, hierNode.depth + 1);
 
-      child->setDepth(depth);
-      child->setHierInd(th->nodeData_.hierInd++);
-    }
-
-    parent = child;
+    addFlatNodes(builder, flatRows, c, child);
   }
 
-  //---
+  // add leaf nodes (first row defines node, last valid row color is used)
+  for (const auto &c : builder.leafChildren(ind)) {
+    const auto &leafNode = builder.node(c);
 
-  QString name = nameStrs[nameStrs.length() - 1];
+    int r = leafNode.leafRows.front();
 
-  auto *node = childNode(parent, name);
+    auto *node = new CQChartsHierBubbleNode(this, parent, builder.nodeName(c),
+                                            builder.rowSize(r), flatRows[r].ind);
 
-  if (! node) {
-    // use hier node if already created
-    auto *child = childHierNode(parent, name);
+    node->setDepth(leafNode.depth);
 
-    if (child) {
-      child->setSize(size);
-      return nullptr;
+    for (const auto &r1 : leafNode.leafRows) {
+      if (flatRows[r1].color.isValid())
+        node->setColor(flatRows[r1].color);
     }
 
-    //---
-
-    QModelIndex nameInd1 = normalizeIndex(nameInd);
-
-    node = new CQChartsHierBubbleNode(this, parent, name, size, nameInd1);
-
-    node->setDepth(depth);
-
     parent->addNode(node);
-  }
 
-  return node;
+    th->nodeData_.maxDepth = std::max(nodeData_.maxDepth, leafNode.depth + 1);
+  }
 }
 
 void
@@ -839,17 +834,6 @@ childHierNode(CQChartsHierBubbleHierNode *parent, const QString &name) const
   return nullptr;
 }
 
-CQChartsHierBubbleNode *
-CQChartsHierBubblePlot::
-childNode(CQChartsHierBubbleHierNode *parent, const QString &name) const
-{
-  for (const auto &node : parent->getNodes())
-    if (node->name() == name)
-      return node;
-
-  return nullptr;
-}
-
 bool
 CQChartsHierBubblePlot::
 getValueSize(const CQChartsModelIndex &ind, double &size) const
@@ -1553,8 +1537,11 @@ CQChartsHierBubbleHierNode(const CQChartsHierBubblePlot *plot, CQChartsHierBubbl
                            const QString &name, const QModelIndex &ind) :
  CQChartsHierBubbleNode(plot, parent, name, 0.0, ind)
 {
-  if (parent_)
+  if (parent_) {
     parent_->children_.push_back(this);
+
+    parent_->invalidateHierSize();
+  }
 }
 
 CQChartsHierBubbleHierNode::
@@ -1583,19 +1570,38 @@ isHierExpanded() const
   return true;
 }
 
+void
+CQChartsHierBubbleHierNode::
+setSize(double s)
+{
+  CQChartsHierBubbleNode::setSize(s);
+
+  invalidateHierSize();
+}
+
 double
 CQChartsHierBubbleHierNode::
 hierSize() const
 {
-  double s = size();
+  return hierSize_.size([&]() {
+    double s = size();
 
-  for (auto &child : children_)
-    s += child->hierSize();
+    for (auto &child : children_)
+      s += child->hierSize();
 
-  for (auto &node : nodes_)
-    s += node->hierSize();
+    for (auto &node : nodes_)
+      s += node->hierSize();
 
-  return s;
+    return s;
+  });
+}
+
+void
+CQChartsHierBubbleHierNode::
+invalidateHierSize()
+{
+  for (auto *hier = this; hier; hier = hier->parent())
+    hier->hierSize_.invalidate();
 }
 
 void
@@ -1653,6 +1659,8 @@ CQChartsHierBubbleHierNode::
 addNode(CQChartsHierBubbleNode *node)
 {
   nodes_.push_back(node);
+
+  invalidateHierSize();
 }
 
 void
@@ -1676,6 +1684,8 @@ removeNode(CQChartsHierBubbleNode *node)
     nodes_[i - 1] = nodes_[i];
 
   nodes_.pop_back();
+
+  invalidateHierSize();
 }
 
 void
@@ -1738,6 +1748,16 @@ initRadius()
   r_ = sqrt(hierSize()/M_PI);
 }
 
+void
+CQChartsHierBubbleNode::
+setSize(double s)
+{
+  size_ = s;
+
+  if (parent_)
+    parent_->invalidateHierSize();
+}
+
 QString
 CQChartsHierBubbleNode::
 hierName() const
@@ -0,0 +1,303 @@
+#include <CQChartsHierBuilder.h>
+#include <CQPerfMonitor.h>
+
+#include <atomic>
+#include <future>
+#include <thread>
+#include <unordered_map>
+
+namespace {
+
+// min number of rows for parallel build
+const int minParallelRows = 16384;
+
+}
+
+//---
+
+CQChartsHierBuilder::
+CQChartsHierBuilder()
+{
+  numThreads_ = std::max(int(std::thread::hardware_concurrency()), 1);
+}
+
+void
+CQChartsHierBuilder::
+clear()
+{
+  names_  .clear();
+  nameIds_.clear();
+
+  rowNames_ .clear();
+  rowStarts_.clear();
+  rowSizes_ .clear();
+
+  rowStarts_.push_back(0);
+
+  nodes_.clear();
+}
+
+int
+CQChartsHierBuilder::
+addRow(const QStringList &names, double size)
+{
+  if (names.empty())
+    return -1;
+
+  for (const auto &name : names) {
+    auto p = nameIds_.find(name);
+
+    if (p == nameIds_.end()) {
+      p = nameIds_.insert(name, names_.size());
+
+      names_.push_back(name);
+    }
+
+    rowNames_.push_back(p.value());
+  }
+
+  rowStarts_.push_back(int(rowNames_.size()));
+  rowSizes_ .push_back(size);
+
+  return int(rowSizes_.size()) - 1;
+}
+
+void
+CQChartsHierBuilder::
+build()
+{
+  CQPerfTrace trace("CQChartsHierBuilder::build");
+
+  nodes_.clear();
+
+  // root node
+  nodes_.push_back(Node());
+
+  //---
+
+  // create top level nodes and assign rows to top level branches
+  Branches branches;
+
+  std::unordered_map<int,int> topBranch;
+
+  int nr = numRows();
+
+  for (int r = 0; r < nr; ++r) {
+    int depth = rowDepth(r);
+    int name  = rowNames_[rowStarts_[r]];
+
+    auto p = topBranch.find(name);
+
+    if (p == topBranch.end()) {
+      Node node;
+
+      node.name   = name;
+      node.parent = root();
+      node.depth  = 1;
+
+      int i = int(nodes_.size());
+
+      nodes_.push_back(node);
+
+      nodes_[root()].children.push_back(i);
+
+      Branch branch;
+
+      branch.node = i;
+
+      p = topBranch.insert(p, std::make_pair(name, int(branches.size())));
+
+      branches.push_back(branch);
+    }
+
+    auto &branch = branches[p->second];
+    auto &node   = nodes_[branch.node];
+
+    if (depth > 1) {
+      if (node.hierRow < 0)
+        node.hierRow = r;
+
+      branch.rows.push_back(r);
+    }
+    else
+      node.leafRows.push_back(r);
+  }
+
+  //---
+
+  // build branches (each branch only updates its own top level node)
+  int nb = int(branches.size());
+
+  int nt = (nr >= minParallelRows ? std::min(numThreads_, nb) : 1);
+
+  if (nt > 1) {
+    std::atomic<int> nextBranch { 0 };
+
+    std::vector<std::future<void>> futures;
+
+    for (int i = 0; i < nt; ++i) {
+      futures.push_back(std::async(std::launch::async, [&]() {
+        while (true) {
+          int ib = nextBranch++;
+
+          if (ib >= nb)
+            break;
+
+          buildBranch(branches[ib]);
+        }
+      }));
+    }
+
+    for (auto &future : futures)
+      future.get();
+  }
+  else {
+    for (auto &branch : branches)
+      buildBranch(branch);
+  }
+
+  //---
+
+  // append branch nodes (convert branch local ids to node ids)
+  for (auto &branch : branches) {
+    int base = int(nodes_.size());
+
+    for (auto &node : branch.nodes) {
+      node.parent = (node.parent >= 0 ? node.parent + base : branch.node);
+
+      for (auto &child : node.children)
+        child += base;
+
+      nodes_.push_back(std::move(node));
+    }
+
+    for (auto &child : nodes_[branch.node].children)
+      child += base;
+
+    branch.nodes.clear();
+  }
+}
+
+void
+CQChartsHierBuilder::
+buildBranch(Branch &branch)
+{
+  // branch local child lookup (key is local parent id and name id)
+  std::unordered_map<qint64,int> childIds;
+
+  auto childKey = [](int parent, int name) {
+    return (qint64(parent + 1) << 32) | qint64(uint(name));
+  };
+
+  auto &topNode = nodes_[branch.node];
+
+  for (const auto &r : branch.rows) {
+    int start = rowStarts_[r];
+    int depth = rowDepth(r);
+
+    int parent = -1; // top level node
+
+    for (int j = 1; j < depth; ++j) {
+      int name = rowNames_[start + j];
+
+      qint64 key = childKey(parent, name);
+
+      auto p = childIds.find(key);
+
+      if (p == childIds.end()) {
+        Node node;
+
+        node.name   = name;
+        node.parent = parent;
+        node.depth  = j + 1;
+
+        int i = int(branch.nodes.size());
+
+        branch.nodes.push_back(node);
+
+        if (parent >= 0)
+          branch.nodes[parent].children.push_back(i);
+        else
+          topNode.children.push_back(i);
+
+        p = childIds.insert(p, std::make_pair(key, i));
+      }
+
+      int i = p->second;
+
+      auto &node = branch.nodes[i];
+
+      if (j < depth - 1) {
+        if (node.hierRow < 0)
+          node.hierRow = r;
+      }
+      else
+        node.leafRows.push_back(r);
+
+      parent = i;
+    }
+  }
+}
+
+//---
+
+CQChartsHierBuilder::Rows
+CQChartsHierBuilder::
+hierChildren(int i) const
+{
+  Rows children;
+
+  for (const auto &child : nodes_[i].children)
+    if (isHier(child))
+      children.push_back(child);
+
+  // order by creation of hier node (first use as path prefix)
+  std::stable_sort(children.begin(), children.end(), [&](int c1, int c2) {
+    return nodes_[c1].hierRow < nodes_[c2].hierRow;
+  });
+
+  return children;
+}
+
+CQChartsHierBuilder::Rows
+CQChartsHierBuilder::
+leafChildren(int i) const
+{
+  Rows children;
+
+  for (const auto &child : nodes_[i].children)
+    if (! isHier(child))
+      children.push_back(child);
+
+  return children;
+}
+
+int
+CQChartsHierBuilder::
+hierLeafRow(int i) const
+{
+  const auto &node = nodes_[i];
+
+  if (! node.leafRows.empty() && node.leafRows.front() < node.hierRow)
+    return node.leafRows.front();
+
+  return -1;
+}
+
+double
+CQChartsHierBuilder::
+hierNodeSize(int i) const
+{
+  const auto &node = nodes_[i];
+
+  if (node.leafRows.empty())
+    return 0.0;
+
+  // leaf rows after hier node is created replace size, first leaf row before is kept
+  int lastRow = node.leafRows.back();
+
+  if (lastRow > node.hierRow)
+    return rowSizes_[lastRow];
+
+  return rowSizes_[node.leafRows.front()];
+}
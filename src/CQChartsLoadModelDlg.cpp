@@ -21,6 +21,8 @@
 #include <QRadioButton>
 #include <QCheckBox>
 #include <QTextBrowser>
+#include <QProgressBar>
+#include <QApplication>
 #include <QLabel>
 #include <QVBoxLayout>
 #include <QHBoxLayout>
@@ -232,6 +234,16 @@ CQChartsLoadModelDlg(CQCharts *charts) :
 
   //----
 
+  // Load Progress
+  progressBar_ = CQUtil::makeWidget<QProgressBar>("progressBar");
+
+  progressBar_->setRange(0, 100);
+  progressBar_->setVisible(false);
+
+  layout->addWidget(progressBar_);
+
+  //----
+
   // Bottom Buttons
   auto *buttons = new CQChartsDialogButtons(this);
 
@@ -770,6 +782,9 @@ bool
 CQChartsLoadModelDlg::
 applySlot()
 {
+  if (loading_)
+    return false;
+
   modelInd_ = -1;
 
   //----
@@ -849,13 +864,45 @@ loadFile(const QString &filename, CQChartsFileType type, const CQChartsInputData
 
   //loader.setQtcl(qtcl());
 
-  return loader.loadFile(filename, type, inputData, hierarchical);
+  // show load progress (cancel button stops load)
+  loader.setProgressProc([&](int percent) {
+    progressBar_->setValue(percent);
+
+    qApp->processEvents();
+
+    return ! loadCancelled_;
+  });
+
+  loading_       = true;
+  loadCancelled_ = false;
+
+  progressBar_->setValue(0);
+  progressBar_->setVisible(true);
+
+  okButton_   ->setEnabled(false);
+  applyButton_->setEnabled(false);
+
+  auto *model = loader.loadFile(filename, type, inputData, hierarchical);
+
+  okButton_   ->setEnabled(true);
+  applyButton_->setEnabled(true);
+
+  progressBar_->setVisible(false);
+
+  loading_ = false;
+
+  return model;
 }
 
 void
 CQChartsLoadModelDlg::
 cancelSlot()
 {
+  if (loading_) {
+    loadCancelled_ = true;
+    return;
+  }
+
   modelInd_ = -1;
 
   hide();
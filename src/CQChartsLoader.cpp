@@ -148,6 +148,18 @@ loadCsv(const QString &filename, const CQChartsInputData &inputData)
   if (inputData.columns.length() > 0)
     csvModel->setColumns(inputData.columns);
 
+  csvModel->setColumnar(inputData.columnar);
+
+  // filter rows while loading if possible (non-matching rows are never stored)
+  QString loadFilter;
+
+  bool isLoadFilter = this->loadFilter(inputData, loadFilter);
+
+  if (isLoadFilter)
+    csvModel->setFilter(loadFilter);
+
+  csvModel->setProgressProc(progressProc_);
+
   if (! csvModel->load(filename)) {
     delete csv;
     return nullptr;
@@ -155,7 +167,8 @@ loadCsv(const QString &filename, const CQChartsInputData &inputData)
 
   //---
 
-  setFilter(csv, inputData);
+  if (! isLoadFilter)
+    setFilter(csv, inputData);
 
   return csv;
 }
@@ -177,6 +190,8 @@ loadTsv(const QString &filename, const CQChartsInputData &inputData)
   if (inputData.columns.length() > 0)
     tsvModel->setColumns(inputData.columns);
 
+  tsvModel->setColumnar(inputData.columnar);
+
   if (! tsvModel->load(filename)) {
     delete tsv;
     return nullptr;
@@ -570,13 +585,16 @@ createCorrelationModel(QAbstractItemModel *model, bool flip)
 
   auto *columnTypeMgr = charts_->columnTypeMgr();
 
-  using ColumnValues = std::vector<CMathCorrelation::Values>;
-  using ColumnNames  = std::vector<QString>;
-  using ColumnMinMax = std::vector<CQChartsGeom::RMinMax>;
+  using ColumnValues  = CQChartsCorrelationModel::ColumnValues;
+  using ColumnValuesP = CQChartsCorrelationModel::ColumnValuesP;
+  using ColumnNames   = std::vector<QString>;
+  using ColumnMinMax  = std::vector<CQChartsGeom::RMinMax>;
+
+  ColumnValuesP columnValuesP = std::make_shared<ColumnValues>();
+  ColumnNames   columnNames;
+  ColumnMinMax  columnMinMax;
 
-  ColumnValues columnValues;
-  ColumnNames  columnNames;
-  ColumnMinMax columnMinMax;
+  auto &columnValues = *columnValuesP;
 
   using ColumnSet = std::set<CQChartsColumn>;
 
@@ -670,77 +688,37 @@ createCorrelationModel(QAbstractItemModel *model, bool flip)
 
   //---
 
-  // calc off diagonal values
-  using ColumnReal          = std::map<int,double>;
-  using ColumnColumnReal    = std::map<int,ColumnReal>;
-  using ColumnPoints        = std::map<int,CQChartsCorrelationModel::Points>;
-  using ColumnColumnPoints  = std::map<int,ColumnPoints>;
-  using DevData             = std::pair<double,double>;
-  using ColumnDevData       = std::map<int,DevData>;
-  using ColumnColumnDevData = std::map<int,ColumnDevData>;
-  using ColumnDensity       = std::map<int,CQChartsDensity *>;
-
-  ColumnReal          columnSumSq;
-  ColumnColumnReal    columnsCorr;
-  ColumnColumnPoints  columnsPoints;
-  ColumnColumnDevData columnsDevData;
-  ColumnDensity       columnDensity;
+  // calc correlation matrix (single pass over values)
+  CQChartsCorrelationModel::Reals corr;
 
-  for (int ic1 = 0; ic1 < nv; ++ic1) {
-    CQChartsColumn c1(ic1);
-
-    auto &values1 = columnValues[ic1];
+  CQChartsCorrelationModel::calcCorrelation(columnValues, corr);
 
-    for (int ic2 = ic1; ic2 < nv; ++ic2) {
-      if (ic1 != ic2) {
-        CQChartsColumn c2(ic2);
-
-        auto &values2 = columnValues[ic2];
-
-        double corr = CMathCorrelation::calc(values1, values2);
-
-        columnsCorr[ic1][ic2] = corr;
-        columnsCorr[ic2][ic1] = corr;
-
-        columnSumSq[ic1] += corr*corr;
-        columnSumSq[ic2] += corr*corr;
-
-        CQChartsCorrelationModel::Points points1, points2;
-
-        assert(values1.size() == values2.size());
-
-        int nv1 = values1.size();
-
-        for (int j = 0; j < nv1; ++j) {
-          points1.push_back(CQChartsGeom::Point(values1[j], values2[j]));
-          points2.push_back(CQChartsGeom::Point(values2[j], values1[j]));
-        }
+  //---
 
-        columnsPoints[ic1][ic2] = points1;
-        columnsPoints[ic2][ic1] = points2;
+  // calc column std dev, density and sum of squares of off diagonal values
+  using ColumnReal    = std::map<int,double>;
+  using ColumnDensity = std::map<int,CQChartsDensity *>;
 
-        double stddev1 = CMathCorrelation::stddev(values1);
-        double stddev2 = CMathCorrelation::stddev(values2);
+  ColumnReal    columnSumSq;
+  ColumnReal    columnStdDev;
+  ColumnDensity columnDensity;
 
-        columnsDevData[ic1][ic2] = DevData(stddev1, stddev2);
-        columnsDevData[ic2][ic1] = DevData(stddev2, stddev1);
-      }
-      else {
-        CQChartsCorrelationModel::Points points1;
+  for (int ic1 = 0; ic1 < nv; ++ic1) {
+    const auto &values1 = columnValues[ic1];
 
-        int nv1 = values1.size();
+    columnStdDev[ic1] = CMathCorrelation::stddev(values1);
 
-        CQChartsDensity::XVals xvals;
+    for (int ic2 = ic1 + 1; ic2 < nv; ++ic2) {
+      double corr12 = corr[ic1*nv + ic2];
 
-        for (int j = 0; j < nv1; ++j)
-          xvals.push_back(values1[j]);
+      columnSumSq[ic1] += corr12*corr12;
+      columnSumSq[ic2] += corr12*corr12;
+    }
 
-        if (! columnDensity[ic1])
-          columnDensity[ic1] = new CQChartsDensity;
+    if (! columnDensity[ic1])
+      columnDensity[ic1] = new CQChartsDensity;
 
-        columnDensity[ic1]->setXVals(xvals);
-      }
-    }
+    columnDensity[ic1]->setXVals(values1);
   }
 
   //---
@@ -768,6 +746,9 @@ createCorrelationModel(QAbstractItemModel *model, bool flip)
   // create model
   auto *correlationModel = new CQChartsCorrelationModel(nv);
 
+  // cell points are calculated from (shared) column values on demand
+  correlationModel->setColumnValues(columnValuesP, sortedColumns);
+
   auto *filterModel = new CQChartsFilterModel(charts_, correlationModel);
 
   for (int ic = 0; ic < nv; ++ic) {
@@ -812,18 +793,13 @@ createCorrelationModel(QAbstractItemModel *model, bool flip)
 
         CQChartsColumn c2(ic2);
 
-        double corr = columnsCorr[ic1s][ic2s];
-
-        CQChartsModelUtil::setModelValue(correlationModel, ic1, c2, corr);
-        CQChartsModelUtil::setModelValue(correlationModel, ic2, c1, corr);
+        double corr12 = corr[ic1s*nv + ic2s];
 
-        correlationModel->setPoints(ic1, ic2, columnsPoints[ic1s][ic2s]);
-        correlationModel->setPoints(ic2, ic1, columnsPoints[ic2s][ic1s]);
+        CQChartsModelUtil::setModelValue(correlationModel, ic1, c2, corr12);
+        CQChartsModelUtil::setModelValue(correlationModel, ic2, c1, corr12);
 
-        correlationModel->setDevData(ic1, ic2,
-          columnsDevData[ic1s][ic2s].first, columnsDevData[ic1s][ic2s].second);
-        correlationModel->setDevData(ic2, ic1,
-          columnsDevData[ic2s][ic1s].first, columnsDevData[ic2s][ic1s].second);
+        correlationModel->setDevData(ic1, ic2, columnStdDev[ic1s], columnStdDev[ic2s]);
+        correlationModel->setDevData(ic2, ic1, columnStdDev[ic2s], columnStdDev[ic1s]);
       }
       else {
         CQChartsModelUtil::setModelValue(correlationModel, ic1, c1, 1.0);
@@ -843,6 +819,47 @@ createCorrelationModel(QAbstractItemModel *model, bool flip)
   return filterModel;
 }
 
+bool
+CQChartsLoader::
+loadFilter(const CQChartsInputData &inputData, QString &filter) const
+{
+  // only simple column filters (<column>:<pattern>,...) can be applied by file load
+  if (! inputData.filter.length() ||
+      inputData.filterType != CQChartsInputData::FilterType::SIMPLE)
+    return false;
+
+  QStringList filters;
+
+  for (const auto &str : inputData.filter.split(",")) {
+    QStringList strs = str.split(':', QString::KeepEmptyParts);
+
+    if (strs.size() != 2)
+      return false;
+
+    // filter column numbers are for loaded columns, file load uses file column numbers
+    if (inputData.columns.length()) {
+      bool ok;
+
+      (void) strs[0].toInt(&ok);
+
+      if (ok)
+        return false;
+    }
+
+    // simple filter matches values containing pattern
+    QString pattern = strs[1];
+
+    if (! pattern.startsWith("*")) pattern = "*" + pattern;
+    if (! pattern.endsWith  ("*")) pattern = pattern + "*";
+
+    filters << strs[0] + ":" + pattern;
+  }
+
+  filter = filters.join(",");
+
+  return true;
+}
+
 void
 CQChartsLoader::
 setFilter(CQChartsModelFilter *model, const CQChartsInputData &inputData)
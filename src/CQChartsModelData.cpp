@@ -1,5 +1,6 @@
 #include <CQChartsModelData.h>
 #include <CQChartsModelDetails.h>
+#include <CQChartsColumnView.h>
 #include <CQChartsModelUtil.h>
 #include <CQChartsFilterModel.h>
 #include <CQChartsVarsModel.h>
@@ -247,6 +248,8 @@ modelDataChangedSlot(const QModelIndex & /*tl*/, const QModelIndex & /*br*/)
   if (details_)
     details_->reset();
 
+  resetColumnViews();
+
   emit modelChanged();
 }
 
@@ -257,6 +260,8 @@ modelLayoutChangedSlot()
   if (details_)
     details_->reset();
 
+  resetColumnViews();
+
   emit modelChanged();
 }
 
@@ -267,6 +272,8 @@ modelResetSlot()
   if (details_)
     details_->reset();
 
+  resetColumnViews();
+
   emit modelChanged();
 }
 
@@ -277,6 +284,8 @@ modelRowsInsertedSlot()
   if (details_)
     details_->reset();
 
+  resetColumnViews();
+
   emit modelChanged();
 }
 
@@ -287,6 +296,8 @@ modelRowsRemovedSlot()
   if (details_)
     details_->reset();
 
+  resetColumnViews();
+
   emit modelChanged();
 }
 
@@ -297,6 +308,8 @@ modelColumnsInsertedSlot()
   if (details_)
     details_->reset();
 
+  resetColumnViews();
+
   emit modelChanged();
 }
 
@@ -307,9 +320,42 @@ modelColumnsRemovedSlot()
   if (details_)
     details_->reset();
 
+  resetColumnViews();
+
   emit modelChanged();
 }
 
+CQChartsModelData::ColumnViewP
+CQChartsModelData::
+columnView(const CQChartsColumn &column) const
+{
+  if (! column.isValid() || ! model_.data())
+    return ColumnViewP();
+
+  std::unique_lock<std::mutex> lock(columnViewMutex_);
+
+  auto *th = const_cast<CQChartsModelData *>(this);
+
+  auto p = th->columnViews_.find(column);
+
+  if (p == th->columnViews_.end()) {
+    auto view = std::make_shared<CQChartsColumnView>(charts_, model_.data(), column);
+
+    p = th->columnViews_.insert(p, ColumnViews::value_type(column, view));
+  }
+
+  return (*p).second;
+}
+
+void
+CQChartsModelData::
+resetColumnViews()
+{
+  std::unique_lock<std::mutex> lock(columnViewMutex_);
+
+  columnViews_.clear();
+}
+
 CQChartsModelData::ModelP
 CQChartsModelData::
 currentModel() const
@@ -898,8 +944,9 @@ getPropertyNameData(IdModelNames &names) const
     summaryModel = qobject_cast<CQSummaryModel *>(model.data());
 
   if (summaryModel)
-    names["summary"][summaryModel] << "mode" << "maxRows" << "sortColumn" << "sortRole" <<
-                                      "sortOrder" << "pageSize" << "currentPage";
+    names["summary"][summaryModel] << "mode" << "maxRows" << "randomSeed" << "groupColumn" <<
+                                      "sortColumn" << "sortRole" << "sortOrder" <<
+                                      "pageSize" << "currentPage";
 
   //---
 
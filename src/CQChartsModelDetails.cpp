@@ -5,12 +5,390 @@
 #include <CQChartsModelVisitor.h>
 #include <CQChartsModelUtil.h>
 #include <CQChartsValueSet.h>
+#include <CQChartsColumnSummary.h>
 #include <CQChartsVariant.h>
 #include <CQCharts.h>
 #include <CQPerfMonitor.h>
 #include <CMathCorrelation.h>
 
 #include <QAbstractItemModel>
+#include <thread>
+
+namespace {
+
+// call function for each index [0, n) in separate threads
+template<typename FUNCTION>
+void execThreads(int n, FUNCTION f) {
+  if (n <= 1) {
+    if (n == 1) f(0);
+    return;
+  }
+
+  std::vector<std::future<void>> futures;
+
+  for (int i = 0; i < n; ++i)
+    futures.push_back(std::async(std::launch::async, f, i));
+
+  for (auto &future : futures)
+    future.get();
+}
+
+}
+
+//---
+
+// TODO: replace monotonic with sorted and sort dir
+// auto update sorted when model sorted
+
+//! visitor to calc column details from row values
+class CQChartsModelColumnDetails::DetailVisitor : public CQChartsModelVisitor {
+ public:
+  DetailVisitor(CQChartsModelColumnDetails *details) :
+   details_(details) {
+    charts_ = details_->details()->charts();
+
+    auto *columnTypeMgr = charts_->columnTypeMgr();
+
+    const auto *columnType = columnTypeMgr->getType(details_->type());
+
+    if (columnType) {
+      min_ = columnType->minValue(details->nameValues()); // type custom min value
+      max_ = columnType->maxValue(details->nameValues()); // type custom max value
+
+      visitMin_ = ! min_.isValid();
+      visitMax_ = ! max_.isValid();
+    }
+
+    monotonicSet_ = false;
+    monotonic_    = true;
+    increasing_   = true;
+  }
+
+  // visit row
+  State visit(const QAbstractItemModel *model, const VisitData &data) override {
+    bool ok;
+
+    QVariant var = CQChartsModelUtil::modelValue(
+      charts_, model, data.row, details_->column(), data.parent, ok);
+    if (! ok) return State::SKIP;
+
+    return addVariant(var);
+  }
+
+  // add row value
+  State addVariant(const QVariant &var) {
+    bool ok;
+
+    details_->addValue(var);
+
+    if      (details_->type() == CQBaseModelType::INTEGER) {
+      long i = CQChartsVariant::toInt(var, ok);
+      if (! ok) return State::SKIP;
+
+      if (! details_->checkRow(int(i)))
+        return State::SKIP;
+
+      details_->addInt((int) i);
+
+      addInt(i);
+    }
+    else if (details_->type() == CQBaseModelType::REAL) {
+      double r = CQChartsVariant::toReal(var, ok);
+      if (! ok) return State::SKIP;
+
+      if (! details_->checkRow(r))
+        return State::SKIP;
+
+      details_->addReal(r);
+
+      addReal(r);
+    }
+    else if (details_->type() == CQBaseModelType::STRING) {
+      QString s;
+
+      ok = CQChartsVariant::toString(var, s);
+      if (! ok) return State::SKIP;
+
+      if (! details_->checkRow(s))
+        return State::SKIP;
+
+      details_->addString(s);
+
+      addString(s);
+    }
+    else if (details_->type() == CQBaseModelType::TIME) {
+      double t = CQChartsVariant::toReal(var, ok);
+      if (! ok) return State::SKIP;
+
+      if (! details_->checkRow(t))
+        return State::SKIP;
+
+      details_->addTime(t);
+
+      addReal(t);
+    }
+    else if (details_->type() == CQBaseModelType::COLOR) {
+      CQChartsColor color;
+
+      if (! details_->columnColor(var, color))
+        return State::SKIP;
+
+      if (! details_->checkRow(QVariant::fromValue<CQChartsColor>(color)))
+        return State::SKIP;
+
+      details_->addColor(color);
+
+      addColor(color);
+    }
+    else if (details_->type() == CQBaseModelType::SYMBOL_SIZE) {
+      double r = CQChartsVariant::toReal(var, ok);
+      if (! ok) return State::SKIP;
+
+      if (! details_->checkRow(r))
+        return State::SKIP;
+
+      details_->addReal(r);
+
+      addReal(r);
+    }
+    else if (details_->type() == CQBaseModelType::FONT_SIZE) {
+      double r = CQChartsVariant::toReal(var, ok);
+      if (! ok) return State::SKIP;
+
+      if (! details_->checkRow(r))
+        return State::SKIP;
+
+      details_->addReal(r);
+
+      addReal(r);
+    }
+    else {
+      QString s;
+
+      ok = CQChartsVariant::toString(var, s);
+      if (! ok) return State::SKIP;
+
+      if (! details_->checkRow(s))
+        return State::SKIP;
+
+      details_->addString(s);
+
+      addString(s);
+    }
+
+    return State::OK;
+  }
+
+  void addInt(long i) {
+    // if no type defined min, update min value
+    if (visitMin_) {
+      bool ok1;
+
+      long imin = CQChartsVariant::toInt(min_, ok1);
+
+      imin = (! ok1 ? i : std::min(imin, i));
+
+      min_ = QVariant(int(imin));
+    }
+
+    // if no type defined max, update max value
+    if (visitMax_) {
+      bool ok1;
+
+      long imax = CQChartsVariant::toInt(max_, ok1);
+
+      imax = (! ok1 ? i : std::max(imax, i));
+
+      max_ = QVariant(int(imax));
+    }
+
+    if (lastValue1_.isValid() && lastValue2_.isValid()) {
+      bool ok1, ok2;
+
+      long i1 = CQChartsVariant::toInt(lastValue1_, ok1);
+      long i2 = CQChartsVariant::toInt(lastValue2_, ok2);
+
+      if (! monotonicSet_) {
+        if (i1 != i2) {
+          increasing_   = (i2 > i1);
+          monotonicSet_ = true;
+        }
+      }
+      else {
+        if (monotonic_) {
+          if (increasing_) {
+            if (i2 < i1)
+              monotonic_ = false;
+          }
+          else {
+            if (i2 > i1)
+              monotonic_ = false;
+          }
+        }
+      }
+    }
+
+    lastValue1_ = lastValue2_;
+    lastValue2_ = int(i);
+  }
+
+  void addReal(double r) {
+    // if no type defined min, update min value
+    if (visitMin_) {
+      bool ok1;
+
+      double rmin = CQChartsVariant::toReal(min_, ok1);
+
+      rmin = (! ok1 ? r : std::min(rmin, r));
+
+      min_ = QVariant(rmin);
+    }
+
+    // if no type defined max, update max value
+    if (visitMax_) {
+      bool ok1;
+
+      double rmax = CQChartsVariant::toReal(max_, ok1);
+
+      rmax = (! ok1 ? r : std::max(rmax, r));
+
+      max_ = QVariant(rmax);
+    }
+
+    if (lastValue1_.isValid() && lastValue2_.isValid()) {
+      bool ok1, ok2;
+
+      double r1 = CQChartsVariant::toReal(lastValue1_, ok1);
+      double r2 = CQChartsVariant::toReal(lastValue2_, ok2);
+
+      if (! monotonicSet_) {
+        if (r1 != r2) {
+          increasing_   = (r2 > r1);
+          monotonicSet_ = true;
+        }
+      }
+      else {
+        if (monotonic_) {
+          if (increasing_) {
+            if (r2 < r1)
+              monotonic_ = false;
+          }
+          else {
+            if (r2 > r1)
+              monotonic_ = false;
+          }
+        }
+      }
+    }
+
+    lastValue1_ = lastValue2_;
+    lastValue2_ = r;
+  }
+
+  void addString(const QString &s) {
+    // if no type defined min, update min value
+    if (visitMin_) {
+      bool ok1;
+
+      QString smin = CQChartsVariant::toString(min_, ok1);
+
+      smin = (! ok1 ? s : std::min(smin, s));
+
+      min_ = QVariant(smin);
+    }
+
+    // if no type defined max, update max value
+    if (visitMax_) {
+      bool ok1;
+
+      QString smax = CQChartsVariant::toString(max_, ok1);
+
+      smax = (! ok1 ? s : std::max(smax, s));
+
+      max_ = QVariant(smax);
+    }
+
+    if (lastValue1_.isValid() && lastValue2_.isValid()) {
+      bool ok1, ok2;
+
+      QString s1 = CQChartsVariant::toString(lastValue1_, ok1);
+      QString s2 = CQChartsVariant::toString(lastValue2_, ok2);
+
+      if (! monotonicSet_) {
+        if (s1 != s2) {
+          increasing_   = (s2 > s1);
+          monotonicSet_ = true;
+        }
+      }
+      else {
+        if (monotonic_) {
+          if (increasing_) {
+            if (s2 < s1)
+              monotonic_ = false;
+          }
+          else {
+            if (s2 > s1)
+              monotonic_ = false;
+          }
+        }
+      }
+    }
+
+    lastValue1_ = lastValue2_;
+    lastValue2_ = s;
+  }
+
+  void addColor(const CQChartsColor &c) {
+    // if no type defined min, update min value
+    if (visitMin_) {
+      CQChartsColor cmin;
+
+      if (details_->columnColor(min_, cmin))
+        cmin = std::min(cmin, c);
+      else
+        cmin = c;
+
+      min_ = QVariant::fromValue<CQChartsColor>(cmin);
+    }
+
+    // if no type defined max, update max value
+    if (visitMax_) {
+      CQChartsColor cmax;
+
+      if (details_->columnColor(max_, cmax))
+        cmax = std::max(cmax, c);
+      else
+        cmax = c;
+
+      max_ = QVariant::fromValue<CQChartsColor>(cmax);
+    }
+
+    lastValue1_ = lastValue2_;
+    lastValue2_ = QVariant::fromValue<CQChartsColor>(c);
+  }
+
+  QVariant minValue() const { return min_; }
+  QVariant maxValue() const { return max_; }
+
+  bool isMonotonic () const { return monotonicSet_ && monotonic_; }
+  bool isIncreasing() const { return increasing_; }
+
+ private:
+  CQChartsModelColumnDetails* details_      { nullptr };
+  CQCharts*                   charts_       { nullptr };
+  QVariant                    min_;
+  QVariant                    max_;
+  bool                        visitMin_     { true };
+  bool                        visitMax_     { true };
+  QVariant                    lastValue1_;
+  QVariant                    lastValue2_;
+  bool                        monotonicSet_ { false };
+  bool                        monotonic_    { true };
+  bool                        increasing_   { true };
+};
+
+
+//------
 
 CQChartsModelDetails::
 CQChartsModelDetails(CQChartsModelData *data) :
@@ -53,6 +431,170 @@ isHierarchical() const
   return hierarchical_;
 }
 
+void
+CQChartsModelDetails::
+initColumnData() const
+{
+  CQPerfTrace trace("CQChartsModelDetails::initColumnData");
+
+  auto *charts = this->charts();
+  auto *model  = this->model();
+
+  if (! charts || ! model)
+    return;
+
+  int nc = numColumns();
+
+  //---
+
+  using DetailsList = std::vector<CQChartsModelColumnDetails *>;
+  using Summaries   = std::vector<CQChartsColumnSummary>;
+  using Locks       = std::vector<std::unique_lock<std::mutex>>;
+
+  auto *th = const_cast<CQChartsModelDetails *>(this);
+
+  // get columns without summary (locked until calculated)
+  DetailsList detailsList;
+  Locks       locks;
+
+  for (int c = 0; c < nc; ++c) {
+    auto *details = th->columnDetails(CQChartsColumn(c));
+    if (! details) continue;
+
+    std::unique_lock<std::mutex> lock(details->mutex_);
+
+    if (details->summaryInitialized_)
+      continue;
+
+    if (! details->typeInitialized_ && ! details->calcType())
+      continue;
+
+    // columns which need model mapping disabled use their own traversal
+    if (details->isUnmappedType())
+      continue;
+
+    detailsList.push_back(details);
+    locks      .push_back(std::move(lock));
+  }
+
+  int nd = detailsList.size();
+
+  if (nd == 0)
+    return;
+
+  //---
+
+  Summaries summaries(nd);
+
+  if (isHierarchical()) {
+    // visit hierarchical model once for all columns
+    class MultiVisitor : public CQChartsModelVisitor {
+     public:
+      MultiVisitor(CQCharts *charts, const DetailsList &detailsList, Summaries &summaries) :
+       charts_(charts), detailsList_(detailsList), summaries_(summaries) {
+      }
+
+      State visit(const QAbstractItemModel *model, const VisitData &data) override {
+        for (std::size_t i = 0; i < detailsList_.size(); ++i) {
+          bool ok;
+
+          QVariant var = CQChartsModelUtil::modelValue(
+            charts_, model, data.row, detailsList_[i]->column(), data.parent, ok);
+          if (! ok) continue;
+
+          detailsList_[i]->addSummaryValue(summaries_[i], var);
+        }
+
+        return State::OK;
+      }
+
+     private:
+      CQCharts*          charts_ { nullptr };
+      const DetailsList& detailsList_;
+      Summaries&         summaries_;
+    };
+
+    MultiVisitor visitor(charts, detailsList, summaries);
+
+    CQChartsModelVisit::exec(charts, model, visitor);
+  }
+  else {
+    // process flat model rows in blocks, model values are read on this thread (model and
+    // proxy models are not thread safe), block row ranges are then added to partial
+    // summaries in threads which are merged in row order
+    struct BlockValue {
+      QVariant var;
+      bool     ok { false };
+    };
+
+    using BlockValues = std::vector<BlockValue>;
+
+    int numRows = model->rowCount();
+
+    int numThreads = std::max(int(std::thread::hardware_concurrency()), 1);
+
+    int blockSize = std::max(std::min(numRows, (1<<20)/nd), 1);
+
+    BlockValues blockValues;
+
+    auto *columnTypeMgr = charts->columnTypeMgr();
+
+    columnTypeMgr->startCache(model);
+
+    for (int r1 = 0; r1 < numRows; r1 += blockSize) {
+      int nr = std::min(blockSize, numRows - r1);
+
+      // read block values (row major)
+      blockValues.resize(nr*nd);
+
+      QModelIndex parent;
+
+      for (int i = 0; i < nr; ++i) {
+        for (int j = 0; j < nd; ++j) {
+          auto &value = blockValues[i*nd + j];
+
+          value.var = CQChartsModelUtil::modelValue(
+            charts, model, r1 + i, detailsList[j]->column(), parent, value.ok);
+        }
+      }
+
+      // calc partial summaries for row ranges
+      int nt = (nr >= 2*numThreads ? numThreads : 1);
+      int dr = (nr + nt - 1)/nt;
+
+      std::vector<Summaries> partials(nt, Summaries(nd));
+
+      execThreads(nt, [&](int t) {
+        int i1 = t*dr;
+        int i2 = std::min(i1 + dr, nr);
+
+        for (int i = i1; i < i2; ++i) {
+          for (int j = 0; j < nd; ++j) {
+            const auto &value = blockValues[i*nd + j];
+
+            if (value.ok)
+              detailsList[j]->addSummaryValue(partials[t][j], value.var);
+          }
+        }
+      });
+
+      for (const auto &partial : partials) {
+        for (int j = 0; j < nd; ++j)
+          summaries[j].merge(partial[j]);
+      }
+    }
+
+    columnTypeMgr->endCache(model);
+  }
+
+  //---
+
+  for (int i = 0; i < nd; ++i) {
+    detailsList[i]->summary_            = std::move(summaries[i]);
+    detailsList[i]->summaryInitialized_ = true;
+  }
+}
+
 const CQChartsModelColumnDetails *
 CQChartsModelDetails::
 columnDetails(const CQChartsColumn &c) const
@@ -1069,6 +1611,105 @@ map(const QVariant &var) const
   return 0;
 }
 
+const CQChartsColumnSummary *
+CQChartsModelColumnDetails::
+summary() const
+{
+  if (! summaryInitialized_) {
+    // color and symbol columns need unmapped values so have no summary
+    if (isUnmappedType())
+      return nullptr;
+
+    details_->initColumnData();
+  }
+
+  return (summaryInitialized_ ? &summary_ : nullptr);
+}
+
+QVariant
+CQChartsModelColumnDetails::
+summaryMinValue() const
+{
+  const auto *summary = this->summary();
+  if (! summary) return minValue();
+
+  // type custom min value
+  const auto *columnType = this->columnType();
+
+  if (columnType) {
+    auto var = columnType->minValue(nameValues());
+
+    if (var.isValid())
+      return var;
+  }
+
+  if (summary->count() == 0)
+    return QVariant();
+
+  if (type() == CQBaseModelType::INTEGER)
+    return QVariant(int(summary->minValue().toDouble()));
+
+  return summary->minValue();
+}
+
+QVariant
+CQChartsModelColumnDetails::
+summaryMaxValue() const
+{
+  const auto *summary = this->summary();
+  if (! summary) return maxValue();
+
+  // type custom max value
+  const auto *columnType = this->columnType();
+
+  if (columnType) {
+    auto var = columnType->maxValue(nameValues());
+
+    if (var.isValid())
+      return var;
+  }
+
+  if (summary->count() == 0)
+    return QVariant();
+
+  if (type() == CQBaseModelType::INTEGER)
+    return QVariant(int(summary->maxValue().toDouble()));
+
+  return summary->maxValue();
+}
+
+void
+CQChartsModelColumnDetails::
+addSummaryValue(CQChartsColumnSummary &summary, const QVariant &var) const
+{
+  // same conversions as detail visitor
+  bool ok;
+
+  if      (type() == CQBaseModelType::INTEGER) {
+    long i = CQChartsVariant::toInt(var, ok);
+    if (! ok) return;
+
+    summary.addReal(double(i));
+  }
+  else if (type() == CQBaseModelType::REAL        ||
+           type() == CQBaseModelType::TIME        ||
+           type() == CQBaseModelType::SYMBOL_SIZE ||
+           type() == CQBaseModelType::FONT_SIZE) {
+    double r = CQChartsVariant::toReal(var, ok);
+    if (! ok) return;
+
+    summary.addReal(r);
+  }
+  else {
+    QString s;
+
+    ok = CQChartsVariant::toString(var, s);
+    if (! ok) return;
+
+    summary.addString(s);
+  }
+}
+
 void
 CQChartsModelColumnDetails::
 initCache() const
@@ -1106,367 +1747,12 @@ initData()
 
   CQChartsModelFilter *modelFilter = nullptr;
 
-  if      (type() == CQBaseModelType::COLOR ||
-           type() == CQBaseModelType::SYMBOL) {
+  if (isUnmappedType()) {
     modelFilter = qobject_cast<CQChartsModelFilter *>(model);
 
     if (modelFilter)
       modelFilter->setMapping(false);
   }
-  else if (type() == CQBaseModelType::SYMBOL_SIZE ||
-           type() == CQBaseModelType::FONT_SIZE) {
-    if (baseType() == CQBaseModelType::REAL ||
-        baseType() == CQBaseModelType::INTEGER) {
-      modelFilter = qobject_cast<CQChartsModelFilter *>(model);
-
-      if (modelFilter)
-        modelFilter->setMapping(false);
-    }
-  }
-
-  //---
-
-  // TODO: replace monotonic with sorted and sort dir
-  // auto update sorted when model sorted
-
-  class DetailVisitor : public CQChartsModelVisitor {
-   public:
-    DetailVisitor(CQChartsModelColumnDetails *details) :
-     details_(details) {
-      charts_ = details_->details()->charts();
-
-      auto *columnTypeMgr = charts_->columnTypeMgr();
-
-      const auto *columnType = columnTypeMgr->getType(details_->type());
-
-      if (columnType) {
-        min_ = columnType->minValue(details->nameValues()); // type custom min value
-        max_ = columnType->maxValue(details->nameValues()); // type custom max value
-
-        visitMin_ = ! min_.isValid();
-        visitMax_ = ! max_.isValid();
-      }
-
-      monotonicSet_ = false;
-      monotonic_    = true;
-      increasing_   = true;
-    }
-
-    // visit row
-    State visit(const QAbstractItemModel *model, const VisitData &data) override {
-      bool ok;
-
-      QVariant var = CQChartsModelUtil::modelValue(
-        charts_, model, data.row, details_->column(), data.parent, ok);
-      if (! ok) return State::SKIP;
-
-      details_->addValue(var);
-
-      if      (details_->type() == CQBaseModelType::INTEGER) {
-        long i = CQChartsVariant::toInt(var, ok);
-        if (! ok) return State::SKIP;
-
-        if (! details_->checkRow(int(i)))
-          return State::SKIP;
-
-        details_->addInt((int) i);
-
-        addInt(i);
-      }
-      else if (details_->type() == CQBaseModelType::REAL) {
-        double r = CQChartsVariant::toReal(var, ok);
-        if (! ok) return State::SKIP;
-
-        if (! details_->checkRow(r))
-          return State::SKIP;
-
-        details_->addReal(r);
-
-        addReal(r);
-      }
-      else if (details_->type() == CQBaseModelType::STRING) {
-        QString s;
-
-        ok = CQChartsVariant::toString(var, s);
-        if (! ok) return State::SKIP;
-
-        if (! details_->checkRow(s))
-          return State::SKIP;
-
-        details_->addString(s);
-
-        addString(s);
-      }
-      else if (details_->type() == CQBaseModelType::TIME) {
-        double t = CQChartsVariant::toReal(var, ok);
-        if (! ok) return State::SKIP;
-
-        if (! details_->checkRow(t))
-          return State::SKIP;
-
-        details_->addTime(t);
-
-        addReal(t);
-      }
-      else if (details_->type() == CQBaseModelType::COLOR) {
-        CQChartsColor color;
-
-        if (! details_->columnColor(var, color))
-          return State::SKIP;
-
-        if (! details_->checkRow(QVariant::fromValue<CQChartsColor>(color)))
-          return State::SKIP;
-
-        details_->addColor(color);
-
-        addColor(color);
-      }
-      else if (details_->type() == CQBaseModelType::SYMBOL_SIZE) {
-        double r = CQChartsVariant::toReal(var, ok);
-        if (! ok) return State::SKIP;
-
-        if (! details_->checkRow(r))
-          return State::SKIP;
-
-        details_->addReal(r);
-
-        addReal(r);
-      }
-      else if (details_->type() == CQBaseModelType::FONT_SIZE) {
-        double r = CQChartsVariant::toReal(var, ok);
-        if (! ok) return State::SKIP;
-
-        if (! details_->checkRow(r))
-          return State::SKIP;
-
-        details_->addReal(r);
-
-        addReal(r);
-      }
-      else {
-        QString s;
-
-        ok = CQChartsVariant::toString(var, s);
-        if (! ok) return State::SKIP;
-
-        if (! details_->checkRow(s))
-          return State::SKIP;
-
-        details_->addString(s);
-
-        addString(s);
-      }
-
-      return State::OK;
-    }
-
-    void addInt(long i) {
-      // if no type defined min, update min value
-      if (visitMin_) {
-        bool ok1;
-
-        long imin = CQChartsVariant::toInt(min_, ok1);
-
-        imin = (! ok1 ? i : std::min(imin, i));
-
-        min_ = QVariant(int(imin));
-      }
-
-      // if no type defined max, update max value
-      if (visitMax_) {
-        bool ok1;
-
-        long imax = CQChartsVariant::toInt(max_, ok1);
-
-        imax = (! ok1 ? i : std::max(imax, i));
-
-        max_ = QVariant(int(imax));
-      }
-
-      if (lastValue1_.isValid() && lastValue2_.isValid()) {
-        bool ok1, ok2;
-
-        long i1 = CQChartsVariant::toInt(lastValue1_, ok1);
-        long i2 = CQChartsVariant::toInt(lastValue2_, ok2);
-
-        if (! monotonicSet_) {
-          if (i1 != i2) {
-            increasing_   = (i2 > i1);
-            monotonicSet_ = true;
-          }
-        }
-        else {
-          if (monotonic_) {
-            if (increasing_) {
-              if (i2 < i1)
-                monotonic_ = false;
-            }
-            else {
-              if (i2 > i1)
-                monotonic_ = false;
-            }
-          }
-        }
-      }
-
-      lastValue1_ = lastValue2_;
-      lastValue2_ = int(i);
-    }
-
-    void addReal(double r) {
-      // if no type defined min, update min value
-      if (visitMin_) {
-        bool ok1;
-
-        double rmin = CQChartsVariant::toReal(min_, ok1);
-
-        rmin = (! ok1 ? r : std::min(rmin, r));
-
-        min_ = QVariant(rmin);
-      }
-
-      // if no type defined max, update max value
-      if (visitMax_) {
-        bool ok1;
-
-        double rmax = CQChartsVariant::toReal(max_, ok1);
-
-        rmax = (! ok1 ? r : std::max(rmax, r));
-
-        max_ = QVariant(rmax);
-      }
-
-      if (lastValue1_.isValid() && lastValue2_.isValid()) {
-        bool ok1, ok2;
-
-        double r1 = CQChartsVariant::toReal(lastValue1_, ok1);
-        double r2 = CQChartsVariant::toReal(lastValue2_, ok2);
-
-        if (! monotonicSet_) {
-          if (r1 != r2) {
-            increasing_   = (r2 > r1);
-            monotonicSet_ = true;
-          }
-        }
-        else {
-          if (monotonic_) {
-            if (increasing_) {
-              if (r2 < r1)
-                monotonic_ = false;
-            }
-            else {
-              if (r2 > r1)
-                monotonic_ = false;
-            }
-          }
-        }
-      }
-
-      lastValue1_ = lastValue2_;
-      lastValue2_ = r;
-    }
-
-    void addString(const QString &s) {
-      // if no type defined min, update min value
-      if (visitMin_) {
-        bool ok1;
-
-        QString smin = CQChartsVariant::toString(min_, ok1);
-
-        smin = (! ok1 ? s : std::min(smin, s));
-
-        min_ = QVariant(smin);
-      }
-
-      // if no type defined max, update max value
-      if (visitMax_) {
-        bool ok1;
-
-        QString smax = CQChartsVariant::toString(max_, ok1);
-
-        smax = (! ok1 ? s : std::max(smax, s));
-
-        max_ = QVariant(smax);
-      }
-
-      if (lastValue1_.isValid() && lastValue2_.isValid()) {
-        bool ok1, ok2;
-
-        QString s1 = CQChartsVariant::toString(lastValue1_, ok1);
-        QString s2 = CQChartsVariant::toString(lastValue2_, ok2);
-
-        if (! monotonicSet_) {
-          if (s1 != s2) {
-            increasing_   = (s2 > s1);
-            monotonicSet_ = true;
-          }
-        }
-        else {
-          if (monotonic_) {
-            if (increasing_) {
-              if (s2 < s1)
-                monotonic_ = false;
-            }
-            else {
-              if (s2 > s1)
-                monotonic_ = false;
-            }
-          }
-        }
-      }
-
-      lastValue1_ = lastValue2_;
-      lastValue2_ = s;
-    }
-
-    void addColor(const CQChartsColor &c) {
-      // if no type defined min, update min value
-      if (visitMin_) {
-        CQChartsColor cmin;
-
-        if (details_->columnColor(min_, cmin))
-          cmin = std::min(cmin, c);
-        else
-          cmin = c;
-
-        min_ = QVariant::fromValue<CQChartsColor>(cmin);
-      }
-
-      // if no type defined max, update max value
-      if (visitMax_) {
-        CQChartsColor cmax;
-
-        if (details_->columnColor(max_, cmax))
-          cmax = std::max(cmax, c);
-        else
-          cmax = c;
-
-        max_ = QVariant::fromValue<CQChartsColor>(cmax);
-      }
-
-      lastValue1_ = lastValue2_;
-      lastValue2_ = QVariant::fromValue<CQChartsColor>(c);
-    }
-
-    QVariant minValue() const { return min_; }
-    QVariant maxValue() const { return max_; }
-
-    bool isMonotonic () const { return monotonicSet_ && monotonic_; }
-    bool isIncreasing() const { return increasing_; }
-
-   private:
-    CQChartsModelColumnDetails* details_      { nullptr };
-    CQCharts*                   charts_       { nullptr };
-    QVariant                    min_;
-    QVariant                    max_;
-    bool                        visitMin_     { true };
-    bool                        visitMax_     { true };
-    QVariant                    lastValue1_;
-    QVariant                    lastValue2_;
-    bool                        monotonicSet_ { false };
-    bool                        monotonic_    { true };
-    bool                        increasing_   { true };
-  };
 
   //---
 
@@ -1479,20 +1765,44 @@ initData()
 
   //---
 
-  minValue_   = detailVisitor.minValue();
-  maxValue_   = detailVisitor.maxValue();
-  numRows_    = detailVisitor.numRows();
-  monotonic_  = detailVisitor.isMonotonic();
-  increasing_ = detailVisitor.isIncreasing();
+  setVisitorData(detailVisitor, detailVisitor.numRows());
 
   if (modelFilter)
     modelFilter->setMapping(true);
 
-  //---
+  return true;
+}
 
-  initialized_ = true;
+bool
+CQChartsModelColumnDetails::
+isUnmappedType() const
+{
+  // color and symbol values (and numeric sizes) need unmapped model values
+  if      (type() == CQBaseModelType::COLOR ||
+           type() == CQBaseModelType::SYMBOL) {
+    return true;
+  }
+  else if (type() == CQBaseModelType::SYMBOL_SIZE ||
+           type() == CQBaseModelType::FONT_SIZE) {
+    if (baseType() == CQBaseModelType::REAL ||
+        baseType() == CQBaseModelType::INTEGER)
+      return true;
+  }
 
-  return true;
+  return false;
+}
+
+void
+CQChartsModelColumnDetails::
+setVisitorData(const DetailVisitor &visitor, int numRows)
+{
+  minValue_   = visitor.minValue();
+  maxValue_   = visitor.maxValue();
+  numRows_    = numRows;
+  monotonic_  = visitor.isMonotonic();
+  increasing_ = visitor.isIncreasing();
+
+  initialized_ = true;
 }
 
 void
@@ -155,6 +155,9 @@ updateSlot()
   int  nr     = details_->numRows       ();
   bool isHier = details_->isHierarchical();
 
+  // calc all column summaries in single model traversal
+  details_->initColumnData();
+
   //---
 
   detailsTable_->clear();
@@ -197,20 +200,52 @@ updateSlot()
                            QString &monoStr, QString &uniqueStr, QString &nullStr) {
     const auto *columnDetails = details_->columnDetails(CQChartsColumn(c));
 
-    nameStr   = columnDetails->headerName();
-    typeStr   = columnDetails->typeName();
-    minStr    = columnDetails->dataName(columnDetails->minValue   ()).toString();
-    maxStr    = columnDetails->dataName(columnDetails->maxValue   ()).toString();
-    meanStr   = columnDetails->dataName(columnDetails->meanValue  ()).toString();
-    stdDevStr = columnDetails->dataName(columnDetails->stdDevValue()).toString();
+    nameStr = columnDetails->headerName();
+    typeStr = columnDetails->typeName();
+
+    // use single pass summary if available (approximate unique count for large data)
+    const auto *summary = columnDetails->summary();
+
+    if (summary) {
+      minStr = columnDetails->dataName(columnDetails->summaryMinValue()).toString();
+      maxStr = columnDetails->dataName(columnDetails->summaryMaxValue()).toString();
 
-    if (columnDetails->isMonotonic())
-      monoStr = (columnDetails->isIncreasing() ? "Increasing" : "Decreasing");
-    else
-      monoStr = "";
+      auto type = columnDetails->type();
 
-    uniqueStr = QString("%1").arg(columnDetails->numUnique());
-    nullStr   = QString("%1").arg(columnDetails->numNull());
+      if (summary->type() == CQChartsColumnSummary::Type::REAL &&
+          (type == CQBaseModelType::INTEGER || type == CQBaseModelType::REAL ||
+           type == CQBaseModelType::TIME)) {
+        meanStr   = columnDetails->dataName(summary->mean  ()).toString();
+        stdDevStr = columnDetails->dataName(summary->stddev()).toString();
+      }
+      else {
+        meanStr   = "";
+        stdDevStr = "";
+      }
+
+      if (summary->isMonotonic())
+        monoStr = (summary->isIncreasing() ? "Increasing" : "Decreasing");
+      else
+        monoStr = "";
+
+      uniqueStr = QString("%1%2").arg(summary->isUniqueExact() ? "" : "~").
+                                  arg(summary->numUnique());
+      nullStr   = QString("%1").arg(summary->numNull());
+    }
+    else {
+      minStr    = columnDetails->dataName(columnDetails->minValue   ()).toString();
+      maxStr    = columnDetails->dataName(columnDetails->maxValue   ()).toString();
+      meanStr   = columnDetails->dataName(columnDetails->meanValue  ()).toString();
+      stdDevStr = columnDetails->dataName(columnDetails->stdDevValue()).toString();
+
+      if (columnDetails->isMonotonic())
+        monoStr = (columnDetails->isIncreasing() ? "Increasing" : "Decreasing");
+      else
+        monoStr = "";
+
+      uniqueStr = QString("%1").arg(columnDetails->numUnique());
+      nullStr   = QString("%1").arg(columnDetails->numNull());
+    }
   };
 
   auto addWidgetItem = [&](const QString &name, int r, int c) {
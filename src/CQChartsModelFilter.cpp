@@ -2,13 +2,134 @@
 #include <CQChartsModelExprMatch.h>
 #include <CQChartsModelVisitor.h>
 #include <CQChartsModelUtil.h>
+#include <CQChartsExprCompiler.h>
+#include <CQChartsExprTcl.h>
 #include <CQChartsVariant.h>
 #include <CQCharts.h>
 
 #include <CQDataModel.h>
+#include <CQPerfMonitor.h>
 #include <QItemSelectionModel>
+#include <thread>
 #include <cassert>
 
+namespace {
+
+// min number of rows for parallel evaluation
+const int minParallelRows = 16384;
+
+// evaluate rows [row1, row2) in parallel chunks
+template<typename FUNC>
+void parallelRows(int row1, int row2, const FUNC &func) {
+  int n = row2 - row1;
+
+  int nt = (n >= minParallelRows ? int(std::thread::hardware_concurrency()) : 1);
+
+  if (nt <= 1) {
+    func(row1, row2);
+    return;
+  }
+
+  int chunkSize = (n + nt - 1)/nt;
+
+  std::vector<std::future<void>> futures;
+
+  for (int r1 = row1; r1 < row2; r1 += chunkSize)
+    futures.push_back(std::async(std::launch::async, func, r1, std::min(r1 + chunkSize, row2)));
+
+  for (auto &future : futures)
+    future.get();
+}
+
+// get column strings for rows [row1, row2)
+void columnStrings(QAbstractItemModel *model, int column, int row1, int row2,
+                   std::vector<QString> &strs) {
+  strs.resize(row2 - row1);
+
+  for (int r = row1; r < row2; ++r) {
+    QVariant var = model->data(model->index(r, column, QModelIndex()));
+
+    bool ok;
+
+    strs[r - row1] = CQChartsVariant::toString(var, ok);
+  }
+}
+
+}
+
+//------
+
+//! compiled filter expression source (referenced columns read before evaluation)
+class CQChartsModelFilterSource : public CQChartsExprCompiler::Source {
+ public:
+  using Values = CQChartsExprCompiler::Values;
+
+ public:
+  CQChartsModelFilterSource(QAbstractItemModel *model, const CQChartsExprTcl *qtcl,
+                            int column) :
+   model_(model), qtcl_(qtcl), column_(column) {
+  }
+
+  int numColumns() const override { return model_->columnCount(); }
+
+  int currentColumn() const override { return column_; }
+
+  int nameColumn(const QString &name) const override { return qtcl_->nameColumn(name); }
+
+  QVariant columnValue(int row, int column) const override {
+    auto p = columnValues_.find(column);
+
+    if (p != columnValues_.end())
+      return (*p).second[row - row1_];
+
+    return modelValue(row, column);
+  }
+
+  bool hasFunction(const QString &name) const override { return (name == "column"); }
+
+  bool isCustomFunction(const QString &name) const override {
+    return qtcl_->isExprFunction(name); }
+
+  // read column values for rows [row1, row2) (model is not accessed from threads)
+  void readColumns(const CQChartsExprCompiler::Columns &columns, int row1, int row2) {
+    row1_ = row1;
+
+    columnValues_.clear();
+
+    for (const auto &column : columns) {
+      auto &values = columnValues_[column];
+
+      values.resize(row2 - row1);
+
+      for (int r = row1; r < row2; ++r)
+        values[r - row1] = modelValue(r, column);
+    }
+  }
+
+ private:
+  QVariant modelValue(int row, int column) const {
+    QModelIndex ind = model_->index(row, column, QModelIndex());
+
+    QVariant var = model_->data(ind, Qt::EditRole);
+
+    if (! var.isValid())
+      var = model_->data(ind, Qt::DisplayRole);
+
+    return var;
+  }
+
+ private:
+  using ColumnValues = std::map<int,Values>;
+
+  QAbstractItemModel*    model_  { nullptr };
+  const CQChartsExprTcl* qtcl_   { nullptr };
+  int                    column_ { 0 };
+  int                    row1_   { 0 };
+  ColumnValues           columnValues_;
+};
+
+//------
+
 CQChartsModelFilter::
 CQChartsModelFilter(CQCharts *charts) :
  charts_(charts)
@@ -20,6 +141,8 @@ CQChartsModelFilter(CQCharts *charts) :
   resetFilterData();
 
   setSortRole(Qt::EditRole);
+
+  sortRanks_.setCmpFn(&CQChartsVariant::cmp);
 }
 
 CQChartsModelFilter::
@@ -140,6 +263,30 @@ setFilterCombine(const Combine &c)
   initFilter();
 }
 
+void
+CQChartsModelFilter::
+setFilterKeyColumn(int column)
+{
+  if (column == filterKeyColumn())
+    return;
+
+  bool recalc = rowMatchesValid_;
+
+  rowMatches_.clear();
+
+  rowMatchesValid_ = false;
+
+  QSortFilterProxyModel::setFilterKeyColumn(column);
+
+  // row matches and compiled expressions use key column
+  if (recalc) {
+    for (auto &filterData : filterDatas_)
+      compileFilterData(filterData);
+
+    calcRowMatches();
+  }
+}
+
 QString
 CQChartsModelFilter::
 filterDetails() const
@@ -178,6 +325,13 @@ filterAcceptsRow(int row, const QModelIndex &parent) const
   auto *model = sourceModel();
   assert(model);
 
+  // use precalculated top level row matches (key column can be changed through base class)
+  if (rowMatchesValid_ && ! parent.isValid() && row >= 0 && row < int(rowMatches_.size()) &&
+      int(rowMatches_.size()) == model->rowCount() && rowMatchesColumn_ == keyColumn())
+    return rowMatches_[row];
+
+  //---
+
   class RowVisitor : public CQChartsModelVisitor {
    public:
     RowVisitor(const CQChartsModelFilter *filter, int column) :
@@ -214,12 +368,7 @@ filterAcceptsRow(int row, const QModelIndex &parent) const
   };
 
   // visit single row
-  int column = filterKeyColumn();
-
-  if (column < 0)
-    column = 0;
-
-  RowVisitor visitor(this, column);
+  RowVisitor visitor(this, keyColumn());
 
   (void) CQModelVisit::exec(model, parent, row, visitor);
 
@@ -381,8 +530,9 @@ initFilterData(CQChartsModelFilterData &filterData)
     QString filter;
     int     column = -1;
 
+    // row matches are recalculated by initFilter
     if (CQChartsModelUtil::decodeModelFilterStr(model, filterData.filter(), filter, column))
-      setFilterKeyColumn(column);
+      QSortFilterProxyModel::setFilterKeyColumn(column);
 
     if (filterData.isRegExp())
       filterData.setRegExp(CQChartsRegExp(filter, QRegExp::PatternSyntax::RegExp));
@@ -445,6 +595,11 @@ initFilter()
 
   exprMatch()->initColumns();
 
+  for (auto &filterData : filterDatas_)
+    compileFilterData(filterData);
+
+  calcRowMatches();
+
   //---
 
   invalidateFilter();
@@ -453,10 +608,336 @@ initFilter()
   //expandMatches();
 }
 
+void
+CQChartsModelFilter::
+compileFilterData(CQChartsModelFilterData &filterData)
+{
+  filterData.setCompiler(CQChartsModelFilterData::CompilerP());
+
+  if (! filterData.isExpr() || ! filterData.filterExpr().length())
+    return;
+
+  // row dependent replacements (stringified values, row/column counts) use tcl
+  const auto &expr = filterData.filterExpr();
+
+  if (expr.contains("@#") || expr.contains("@n"))
+    return;
+
+  auto *model = this->sourceModel();
+  assert(model);
+
+  QString expr1 =
+    CQChartsModelUtil::replaceModelExprVars(expr, model, QModelIndex(), -1, -1).simplified();
+
+  CQChartsModelFilterSource source(model, exprMatch()->qtcl(), keyColumn());
+
+  auto compiler = std::make_shared<CQChartsExprCompiler>();
+
+  if (compiler->compile(expr1, source))
+    filterData.setCompiler(compiler);
+}
+
+void
+CQChartsModelFilter::
+calcRowMatches()
+{
+  rowMatches_.clear();
+
+  rowMatchesValid_ = false;
+
+  if (allFiltersEmpty())
+    return;
+
+  // only flat models (hierarchical models use row visitor)
+  auto *model = this->sourceModel();
+
+  if (! model || CQChartsModelUtil::isHierarchical(model))
+    return;
+
+  CQPerfTrace trace("CQChartsModelFilter::calcRowMatches");
+
+  calcRowMatches(0, model->rowCount(), rowMatches_);
+
+  rowMatchesValid_  = true;
+  rowMatchesColumn_ = keyColumn();
+}
+
+void
+CQChartsModelFilter::
+calcRowMatches(int row1, int row2, RowMatches &matches) const
+{
+  bool isAnd = (filterCombine_ == Combine::AND);
+
+  matches.clear();
+  matches.resize(row2 - row1, isAnd ? 1 : 0);
+
+  RowMatches filterMatches;
+
+  for (const auto &filterData : filterDatas_) {
+    calcFilterRowMatches(filterData, row1, row2, filterMatches);
+
+    for (int r = row1; r < row2; ++r) {
+      if (isAnd)
+        matches[r - row1] &= filterMatches[r - row1];
+      else
+        matches[r - row1] |= filterMatches[r - row1];
+    }
+  }
+}
+
+void
+CQChartsModelFilter::
+calcFilterRowMatches(const CQChartsModelFilterData &filterData, int row1, int row2,
+                     RowMatches &matches) const
+{
+  auto *model = sourceModel();
+  assert(model);
+
+  int n = row2 - row1;
+
+  matches.clear();
+
+  // filter in/out selected items
+  if      (filterData.isSelected()) {
+    if (filterData.filterRows().empty()) {
+      matches.resize(n, ! filterData.isInvert());
+      return;
+    }
+
+    matches.resize(n, filterData.isInvert());
+
+    for (const auto &ind : filterData.filterRows()) {
+      int r = ind.row();
+
+      if (! ind.parent().isValid() && r >= row1 && r < row2)
+        matches[r - row1] = ! filterData.isInvert();
+    }
+  }
+  // filter string matches regexp
+  else if (filterData.isRegExp() || filterData.isWildcard()) {
+    matches.resize(n);
+
+    std::vector<QString> strs;
+
+    columnStrings(model, keyColumn(), row1, row2, strs);
+
+    parallelRows(row1, row2, [&](int r1, int r2) {
+      CQChartsRegExp regexp = filterData.regexp(); // regexp not shared between threads
+
+      for (int r = r1; r < r2; ++r)
+        matches[r - row1] = regexp.match(strs[r - row1]);
+    });
+  }
+  // filter string matches one of list of strings
+  else if (filterData.isSimple()) {
+    matches.resize(n, 1);
+
+    std::vector<QString> strs;
+
+    for (const auto &columnFilter : filterData.columnFilterMap()) {
+      columnStrings(model, columnFilter.first, row1, row2, strs);
+
+      parallelRows(row1, row2, [&](int r1, int r2) {
+        CQChartsRegExp regexp = columnFilter.second;
+
+        for (int r = r1; r < r2; ++r) {
+          if (matches[r - row1] && ! regexp.match(strs[r - row1]))
+            matches[r - row1] = 0;
+        }
+      });
+    }
+  }
+  // filter by expression
+  else if (filterData.isExpr()) {
+    matches.resize(n, 1);
+
+    // empty expression matches all
+    if (! filterData.filterExpr().length())
+      return;
+
+    int column = keyColumn();
+
+    RowMatches evaluated(n, 0);
+
+    const auto *compiler = filterData.compiler().get();
+
+    if (compiler) {
+      CQChartsModelFilterSource source(model, exprMatch()->qtcl(), column);
+
+      source.readColumns(compiler->columns(), row1, row2);
+
+      // evaluate blocks of rows
+      const int blockSize = 4096;
+
+      parallelRows(row1, row2, [&](int r1, int r2) {
+        CQChartsExprCompiler::Values values;
+        CQChartsExprCompiler::Bools  oks;
+
+        for (int rb1 = r1; rb1 < r2; rb1 += blockSize) {
+          int rb2 = std::min(rb1 + blockSize, r2);
+
+          compiler->evalRows(source, rb1, rb2, values, oks);
+
+          for (int r = rb1; r < rb2; ++r) {
+            if (! oks[r - rb1]) continue;
+
+            matches  [r - row1] = values[r - rb1].toBool();
+            evaluated[r - row1] = 1;
+          }
+        }
+      });
+    }
+
+    // evaluate remaining rows using tcl
+    for (int r = row1; r < row2; ++r) {
+      if (evaluated[r - row1]) continue;
+
+      bool ok;
+
+      matches[r - row1] =
+        exprMatch()->match(filterData.filterExpr(), model->index(r, column, QModelIndex()), ok);
+    }
+  }
+  else {
+    assert(false);
+
+    matches.resize(n, 1);
+  }
+}
+
+int
+CQChartsModelFilter::
+keyColumn() const
+{
+  int column = filterKeyColumn();
+
+  if (column < 0)
+    column = 0;
+
+  return column;
+}
+
+void
+CQChartsModelFilter::
+setSourceModel(QAbstractItemModel *model)
+{
+  auto *oldModel = sourceModel();
+
+  if (oldModel) {
+    disconnect(oldModel, SIGNAL(dataChanged(const QModelIndex &, const QModelIndex &)),
+               this, SLOT(sourceDataChangedSlot(const QModelIndex &, const QModelIndex &)));
+    disconnect(oldModel, SIGNAL(rowsInserted(const QModelIndex &, int, int)),
+               this, SLOT(sourceRowsChangedSlot()));
+    disconnect(oldModel, SIGNAL(rowsRemoved(const QModelIndex &, int, int)),
+               this, SLOT(sourceRowsChangedSlot()));
+    disconnect(oldModel, SIGNAL(modelReset()), this, SLOT(sourceRowsChangedSlot()));
+  }
+
+  QSortFilterProxyModel::setSourceModel(model);
+
+  sortRanks_.reset();
+
+  if (model) {
+    connect(model, SIGNAL(dataChanged(const QModelIndex &, const QModelIndex &)),
+            this, SLOT(sourceDataChangedSlot(const QModelIndex &, const QModelIndex &)));
+    connect(model, SIGNAL(rowsInserted(const QModelIndex &, int, int)),
+            this, SLOT(sourceRowsChangedSlot()));
+    connect(model, SIGNAL(rowsRemoved(const QModelIndex &, int, int)),
+            this, SLOT(sourceRowsChangedSlot()));
+    connect(model, SIGNAL(modelReset()), this, SLOT(sourceRowsChangedSlot()));
+  }
+
+  rowMatches_.clear();
+
+  rowMatchesValid_ = false;
+}
+
+void
+CQChartsModelFilter::
+sourceDataChangedSlot(const QModelIndex &from, const QModelIndex &to)
+{
+  // proxy has already resorted using previous sort ranks
+  if (sortRanks_.isValid()) {
+    bool sortChanged = false;
+
+    for (const auto &column : sortRanks_.columns()) {
+      if (column >= from.column() && column <= to.column())
+        sortChanged = true;
+    }
+
+    if (sortChanged) {
+      sortRanks_.recalc(sourceModel());
+
+      invalidate();
+    }
+  }
+
+  //---
+
+  if (! rowMatchesValid_ || from.parent().isValid())
+    return;
+
+  auto *model = sourceModel();
+
+  if (int(rowMatches_.size()) != model->rowCount() || rowMatchesColumn_ != keyColumn()) {
+    calcRowMatches();
+    return;
+  }
+
+  // only update changed rows
+  int row1 = std::max(from.row(), 0);
+  int row2 = std::min(to.row() + 1, int(rowMatches_.size()));
+
+  if (row1 >= row2)
+    return;
+
+  RowMatches matches;
+
+  calcRowMatches(row1, row2, matches);
+
+  bool changed = false;
+
+  for (int r = row1; r < row2; ++r) {
+    if (matches[r - row1] != rowMatches_[r]) {
+      rowMatches_[r] = matches[r - row1];
+
+      changed = true;
+    }
+  }
+
+  // proxy has already handled change using previous matches
+  if (changed)
+    invalidateFilter();
+}
+
+void
+CQChartsModelFilter::
+sourceRowsChangedSlot()
+{
+  if (rowMatchesValid_)
+    calcRowMatches();
+
+  if (sortRanks_.isValid()) {
+    sortRanks_.recalc(sourceModel());
+
+    invalidate();
+  }
+}
+
 bool
 CQChartsModelFilter::
 lessThan(const QModelIndex &lhs, const QModelIndex &rhs) const
 {
+  // use precalculated sort ranks
+  bool ok;
+
+  bool rc = sortRanks_.lessThan(lhs, rhs, ok);
+
+  if (ok)
+    return rc;
+
+  //---
+
   QVariant ldata = sourceModel()->data(lhs, Qt::EditRole);
 
   if (! ldata.isValid())
@@ -597,6 +1078,20 @@ void
 CQChartsModelFilter::
 sort(int column, Qt::SortOrder order)
 {
+  std::vector<int> columns;
+
+  if (column >= 0)
+    columns.push_back(column);
+
+  sortColumns(columns, order);
+}
+
+void
+CQChartsModelFilter::
+sortColumns(const std::vector<int> &columns, Qt::SortOrder order)
+{
+  int column = (! columns.empty() ? columns[0] : -1);
+
   int nc = columnCount();
 
   for (int c = 0; c < nc; ++c)
@@ -604,5 +1099,21 @@ sort(int column, Qt::SortOrder order)
 
   setHeaderData(column, Qt::Horizontal, order, int(CQBaseModelRole::SortOrder));
 
+  //---
+
+  // calc key ranks of source rows (proxy sort compares ranks)
+  auto *model = sourceModel();
+
+  if (model && column >= 0 && ! CQChartsModelUtil::isHierarchical(model)) {
+    CQPerfTrace trace("CQChartsModelFilter::sortColumns");
+
+    sortRanks_.setCaseSensitivity(sortCaseSensitivity());
+    sortRanks_.setLocaleAware    (isSortLocaleAware());
+
+    sortRanks_.calc(model, columns, sortRole());
+  }
+  else
+    sortRanks_.reset();
+
   QSortFilterProxyModel::sort(column, order);
 }
@@ -16,6 +16,7 @@
 #include <CQDataModel.h>
 #include <CQPivotModel.h>
 #include <CQHierSepModel.h>
+#include <CQSummaryModel.h>
 #include <CQModelUtil.h>
 
 #include <CQPerfMonitor.h>
@@ -955,6 +956,25 @@ getHierSepModel(QAbstractItemModel *model)
 
 }
 
+CQSummaryModel *
+getSummaryModel(QAbstractItemModel *model)
+{
+  // search proxy model chain
+  while (model) {
+    auto *summaryModel = qobject_cast<CQSummaryModel *>(model);
+
+    if (summaryModel)
+      return summaryModel;
+
+    auto *proxyModel = qobject_cast<QAbstractProxyModel *>(model);
+    if (! proxyModel) break;
+
+    model = proxyModel->sourceModel();
+  }
+
+  return nullptr;
+}
+
 QSortFilterProxyModel *
 getSortFilterProxyModel(QAbstractItemModel *model)
 {
@@ -1262,7 +1282,7 @@ QVariant modelValue(CQCharts *charts, const QAbstractItemModel *model, int row,
     else {
       qtcl->setRow(row);
 
-      ok = qtcl->evaluateExpression(column.expr(), var, showError);
+      ok = qtcl->evaluateCompiledExpression(column.expr(), var, showError);
     }
 
     return var;
@@ -1,6 +1,9 @@
 #include <CQChartsPaintDevice.h>
+#include <CQChartsPlotObj.h>
 #include <QBuffer>
 
+#include <algorithm>
+
 CQChartsGeom::BBox
 CQChartsPaintDevice::
 windowToPixel(const CQChartsGeom::BBox &r) const
@@ -1000,6 +1003,592 @@ setContext(const std::string &context)
 
 //---
 
+namespace {
+
+// number of values per base64 buffer chunk
+const int bufferChunkSize = 16384;
+
+// number of strings per string table chunk
+const int stringChunkSize = 1024;
+
+template<typename T>
+void writeBase64(std::ostream &os, const std::vector<T> &values) {
+  QByteArray ba(reinterpret_cast<const char *>(values.data()), int(values.size()*sizeof(T)));
+
+#if Q_BYTE_ORDER == Q_BIG_ENDIAN
+  // javascript typed arrays are read as little endian
+  for (int i = 0; i < ba.size(); i += int(sizeof(T)))
+    std::reverse(ba.data() + i, ba.data() + i + sizeof(T));
+#endif
+
+  os << ba.toBase64().constData();
+}
+
+void writeString(std::ostream &os, const QString &str) {
+  os << "\"";
+
+  for (const auto &c : str.toStdString()) {
+    if      (c == '\\') os << "\\\\";
+    else if (c == '"' ) os << "\\\"";
+    else if (c == '\n') os << "\\n";
+    else if (c == '\r') os << "\\r";
+    else if (c == '<' ) os << "\\x3c"; // no close script tag
+    else                os << c;
+  }
+
+  os << "\"";
+}
+
+}
+
+CQChartsScriptBufferPainter::
+CQChartsScriptBufferPainter(CQChartsPlot *plot, std::ostream &os) :
+ CQChartsScriptPainter(plot, os)
+{
+}
+
+void
+CQChartsScriptBufferPainter::
+setOrigin(const CQChartsGeom::Point &p)
+{
+  origin_ = p;
+
+  // full precision as coords are relative to origin
+  auto precision = os_->precision(17);
+
+  *os_ << "  this.buffers.ox = " << origin_.x << ";\n";
+  *os_ << "  this.buffers.oy = " << origin_.y << ";\n";
+
+  os_->precision(precision);
+}
+
+void
+CQChartsScriptBufferPainter::
+save()
+{
+  dataStack_.push_back(data_);
+
+  addCmd(Cmd::SAVE);
+}
+
+void
+CQChartsScriptBufferPainter::
+restore()
+{
+  assert(! dataStack_.empty());
+
+  data_ = dataStack_.back();
+
+  dataStack_.pop_back();
+
+  styleValid_ = false;
+
+  addCmd(Cmd::RESTORE);
+}
+
+void
+CQChartsScriptBufferPainter::
+setClipPath(const QPainterPath &, Qt::ClipOperation)
+{
+}
+
+void
+CQChartsScriptBufferPainter::
+setClipRect(const CQChartsGeom::BBox &bbox, Qt::ClipOperation)
+{
+  int offset = coordPos();
+
+  addBBox(bbox);
+
+  addCmd(Cmd::CLIP_RECT, offset);
+}
+
+void
+CQChartsScriptBufferPainter::
+setPen(const QPen &pen)
+{
+  data_.pen = pen;
+
+  styleValid_ = false;
+}
+
+void
+CQChartsScriptBufferPainter::
+setBrush(const QBrush &brush)
+{
+  data_.brush = brush;
+
+  styleValid_ = false;
+}
+
+void
+CQChartsScriptBufferPainter::
+fillPath(const QPainterPath &path, const QBrush &brush)
+{
+  setBrush(brush);
+
+  int offset = coordPos();
+
+  addPathParts(path);
+
+  addCmd(Cmd::FILL_PATH, offset, path.elementCount());
+}
+
+void
+CQChartsScriptBufferPainter::
+strokePath(const QPainterPath &path, const QPen &pen)
+{
+  setPen(pen);
+
+  int offset = coordPos();
+
+  addPathParts(path);
+
+  addCmd(Cmd::STROKE_PATH, offset, path.elementCount());
+}
+
+void
+CQChartsScriptBufferPainter::
+drawPath(const QPainterPath &path)
+{
+  int offset = coordPos();
+
+  addPathParts(path);
+
+  addCmd(Cmd::PATH, offset, path.elementCount());
+}
+
+void
+CQChartsScriptBufferPainter::
+addPathParts(const QPainterPath &path)
+{
+  // element type and point for each element (curve data elements follow curve)
+  int n = path.elementCount();
+
+  for (int i = 0; i < n; ++i) {
+    const QPainterPath::Element &e = path.elementAt(i);
+
+    addCoord(int(e.type));
+    addPoint(CQChartsGeom::Point(e.x, e.y));
+  }
+}
+
+void
+CQChartsScriptBufferPainter::
+fillRect(const CQChartsGeom::BBox &bbox, const QBrush &brush)
+{
+  setBrush(brush);
+
+  int offset = coordPos();
+
+  addBBox(bbox);
+
+  addCmd(Cmd::FILL_RECT, offset);
+}
+
+void
+CQChartsScriptBufferPainter::
+drawRect(const CQChartsGeom::BBox &bbox)
+{
+  int offset = coordPos();
+
+  addBBox(bbox);
+
+  addCmd(Cmd::RECT, offset);
+}
+
+void
+CQChartsScriptBufferPainter::
+drawEllipse(const CQChartsGeom::BBox &bbox, const CQChartsAngle &)
+{
+  int offset = coordPos();
+
+  addBBox(bbox);
+
+  addCmd(Cmd::ELLIPSE, offset);
+}
+
+void
+CQChartsScriptBufferPainter::
+drawPolygon(const CQChartsGeom::Polygon &poly)
+{
+  int offset = coordPos();
+
+  int np = poly.size();
+
+  for (int i = 0; i < np; ++i)
+    addPoint(poly.point(i));
+
+  addCmd(Cmd::POLYGON, offset, np);
+}
+
+void
+CQChartsScriptBufferPainter::
+drawPolyline(const CQChartsGeom::Polygon &poly)
+{
+  int offset = coordPos();
+
+  int np = poly.size();
+
+  for (int i = 0; i < np; ++i)
+    addPoint(poly.point(i));
+
+  addCmd(Cmd::POLYLINE, offset, np);
+}
+
+void
+CQChartsScriptBufferPainter::
+drawLine(const CQChartsGeom::Point &p1, const CQChartsGeom::Point &p2)
+{
+  int offset = coordPos();
+
+  addPoint(p1);
+  addPoint(p2);
+
+  addCmd(Cmd::LINE, offset);
+}
+
+void
+CQChartsScriptBufferPainter::
+drawPoint(const CQChartsGeom::Point &p)
+{
+  int offset = coordPos();
+
+  addPoint(p);
+
+  addCmd(Cmd::POINT, offset);
+}
+
+void
+CQChartsScriptBufferPainter::
+drawText(const CQChartsGeom::Point &p, const QString &text)
+{
+  int offset = coordPos();
+
+  addPoint(p);
+
+  addCmd(Cmd::TEXT, offset, addString(text));
+}
+
+void
+CQChartsScriptBufferPainter::
+drawTransformedText(const CQChartsGeom::Point &p, const QString &text)
+{
+  CQChartsGeom::Point pt(p.x + data_.transformPoint.x, p.y + data_.transformPoint.y);
+
+  int offset = coordPos();
+
+  addPoint(pt);
+  addCoord(CMathUtil::Deg2Rad(data_.transformAngle));
+
+  addCmd(Cmd::ROTATED_TEXT, offset, addString(text));
+}
+
+void
+CQChartsScriptBufferPainter::
+drawImage(const CQChartsGeom::Point &p, const QImage &image)
+{
+  // writes image into ba in PNG format
+  QByteArray ba;
+  QBuffer qbuffer(&ba);
+  qbuffer.open(QIODevice::WriteOnly);
+  image.save(&qbuffer, "PNG");
+
+  QString imageData = QString("data:image/png;base64,") + ba.toBase64().constData();
+
+  int offset = coordPos();
+
+  addPoint(p);
+
+  addCmd(Cmd::IMAGE, offset, addString(imageData));
+}
+
+void
+CQChartsScriptBufferPainter::
+setFont(const QFont &f)
+{
+  if (! data_.hasFont || f.pointSizeF() != data_.font.pointSizeF()) {
+    int offset = coordPos();
+
+    addCoord(f.pointSizeF());
+
+    addCmd(Cmd::FONT, offset);
+  }
+
+  data_.font    = f;
+  data_.hasFont = true;
+}
+
+void
+CQChartsScriptBufferPainter::
+setRange(const CQChartsGeom::BBox &bbox)
+{
+  int offset = coordPos();
+
+  addBBox(bbox);
+
+  addCmd(Cmd::RANGE, offset);
+
+  rangeOffset_ = offset;
+}
+
+//---
+
+void
+CQChartsScriptBufferPainter::
+startObj()
+{
+  objCmdStart_ = numCmds_;
+}
+
+void
+CQChartsScriptBufferPainter::
+endObj(const CQChartsPlotObj *obj)
+{
+  // add inside shape
+  int offset = coordPos();
+
+  Shape shape = Shape::RECT;
+  int   n     = 0;
+
+  if      (obj->isPolygon()) {
+    auto poly = obj->polygon();
+
+    n = poly.size();
+
+    for (int i = 0; i < n; ++i)
+      addPoint(poly.point(i));
+
+    shape = (obj->isSolid() ? Shape::POLYGON : Shape::POLYLINE);
+  }
+  else if (obj->isCircle()) {
+    addPoint(obj->rect().getCenter());
+    addCoord(obj->radius());
+
+    shape = Shape::CIRCLE;
+  }
+  else if (obj->isArc()) {
+    CQChartsArcData arc = obj->arcData();
+
+    addPoint(arc.center());
+    addCoord(arc.innerRadius());
+    addCoord(arc.outerRadius());
+    addCoord(arc.angle1().value());
+    addCoord(arc.angle2().value());
+
+    shape = Shape::ARC;
+  }
+  else
+    addBBox(obj->rect());
+
+  //---
+
+  // add object (command range, shape, solid, id, tip and plot range)
+  objs_.push_back(uint(objCmdStart_));
+  objs_.push_back(uint(numCmds_));
+  objs_.push_back(uint(shape));
+  objs_.push_back(uint(offset));
+  objs_.push_back(uint(n));
+  objs_.push_back(obj->isSolid() ? 1 : 0);
+  objs_.push_back(uint(addString(obj->id())));
+  objs_.push_back(uint(addString(obj->tipId())));
+  objs_.push_back(uint(rangeOffset_));
+
+  if (int(objs_.size()) >= bufferChunkSize)
+    flushObjs();
+
+  objCmdStart_ = numCmds_;
+}
+
+void
+CQChartsScriptBufferPainter::
+flush()
+{
+  flushCoords ();
+  flushCmds   ();
+  flushObjs   ();
+  flushStrings();
+  flushStyles ();
+}
+
+//---
+
+void
+CQChartsScriptBufferPainter::
+addCmd(const Cmd &cmd, int offset, int n)
+{
+  cmds_.push_back(uint(cmd));
+  cmds_.push_back(uint(styleInd()));
+  cmds_.push_back(uint(offset));
+  cmds_.push_back(uint(n));
+
+  ++numCmds_;
+
+  if (int(cmds_.size()) >= bufferChunkSize)
+    flushCmds();
+}
+
+void
+CQChartsScriptBufferPainter::
+addCoord(double r)
+{
+  coords_.push_back(float(r));
+
+  if (int(coords_.size()) >= bufferChunkSize)
+    flushCoords();
+}
+
+void
+CQChartsScriptBufferPainter::
+addPoint(const CQChartsGeom::Point &p)
+{
+  // store relative to origin for float precision
+  addCoord(p.x - origin_.x);
+  addCoord(p.y - origin_.y);
+}
+
+void
+CQChartsScriptBufferPainter::
+addBBox(const CQChartsGeom::BBox &bbox)
+{
+  addPoint(bbox.getLL());
+  addPoint(bbox.getUR());
+}
+
+int
+CQChartsScriptBufferPainter::
+addString(const QString &str)
+{
+  strings_.push_back(str);
+
+  if (int(strings_.size()) >= stringChunkSize)
+    flushStrings();
+
+  return numStrings_++;
+}
+
+int
+CQChartsScriptBufferPainter::
+styleInd()
+{
+  if (styleValid_)
+    return styleInd_;
+
+  // palette entry is stroke color, fill color and line width
+  auto encodeColor = [](const QColor &c) {
+    return "\"" + CQChartsUtil::encodeScriptColor(c) + "\"";
+  };
+
+  QString strokeColor = (data_.pen.style() == Qt::NoPen ?
+    QString("\"#00000000\"") : encodeColor(data_.pen.color()));
+  QString fillColor = (data_.brush.style() == Qt::NoBrush ?
+    QString("\"#00000000\"") : encodeColor(data_.brush.color()));
+
+  QString style = QString("[%1, %2, %3]").arg(strokeColor).arg(fillColor).
+                    arg(data_.pen.widthF());
+
+  auto p = styles_.find(style);
+
+  if (p == styles_.end()) {
+    p = styles_.insert(style, styles_.size());
+
+    styleStrs_.push_back(style);
+  }
+
+  styleInd_   = p.value();
+  styleValid_ = true;
+
+  return styleInd_;
+}
+
+void
+CQChartsScriptBufferPainter::
+flushCoords()
+{
+  if (coords_.empty())
+    return;
+
+  *os_ << "  this.buffers.addCoords(\""; writeBase64(*os_, coords_); *os_ << "\");\n";
+
+  coordBase_ += int(coords_.size());
+
+  coords_.clear();
+}
+
+void
+CQChartsScriptBufferPainter::
+flushCmds()
+{
+  if (cmds_.empty())
+    return;
+
+  *os_ << "  this.buffers.addCmds(\""; writeBase64(*os_, cmds_); *os_ << "\");\n";
+
+  cmds_.clear();
+}
+
+void
+CQChartsScriptBufferPainter::
+flushObjs()
+{
+  if (objs_.empty())
+    return;
+
+  *os_ << "  this.buffers.addObjs(\""; writeBase64(*os_, objs_); *os_ << "\");\n";
+
+  objs_.clear();
+}
+
+void
+CQChartsScriptBufferPainter::
+flushStrings()
+{
+  if (strings_.empty())
+    return;
+
+  *os_ << "  this.buffers.addStrings([";
+
+  int i = 0;
+
+  for (const auto &str : strings_) {
+    if (i > 0) *os_ << ", ";
+
+    writeString(*os_, str);
+
+    ++i;
+  }
+
+  *os_ << "]);\n";
+
+  strings_.clear();
+}
+
+void
+CQChartsScriptBufferPainter::
+flushStyles()
+{
+  if (styleStrs_.empty())
+    return;
+
+  *os_ << "  this.buffers.addStyles([";
+
+  int i = 0;
+
+  for (const auto &style : styleStrs_) {
+    if (i > 0) *os_ << ", ";
+
+    *os_ << style.toStdString();
+
+    ++i;
+  }
+
+  *os_ << "]);\n";
+
+  styleStrs_.clear();
+}
+
+//---
+
 CQChartsSVGPainter::
 CQChartsSVGPainter(CQChartsView *view, std::ostream &os) :
  CQChartsHtmlPainter(view, os)
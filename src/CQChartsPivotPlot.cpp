@@ -281,6 +281,8 @@ updatePivot()
     pivotModel()->setValueType(CQPivotModel::ValueType::SUM);
   else if (valueType() == ValueType::MEAN)
     pivotModel()->setValueType(CQPivotModel::ValueType::MEAN);
+  else if (valueType() == ValueType::MEDIAN)
+    pivotModel()->setValueType(CQPivotModel::ValueType::MEDIAN);
   else if (valueType() == ValueType::MIN)
     pivotModel()->setValueType(CQPivotModel::ValueType::MIN);
   else if (valueType() == ValueType::MAX)
@@ -514,6 +516,8 @@ createObjs(PlotObjs &objs) const
         yAxis->setDefLabel("Maximum");
       else if (valueType() == ValueType::MEAN)
         yAxis->setDefLabel("Mean");
+      else if (valueType() == ValueType::MEDIAN)
+        yAxis->setDefLabel("Median");
     }
     else {
       yAxis->setValueType     (CQChartsAxisValueType::Type::INTEGER, /*notify*/false);
@@ -1064,6 +1068,7 @@ valueTypeName(const ValueType &valueType) const
     case ValueType::COUNT_UNIQUE: return "Count Unique";
     case ValueType::SUM         : return "Sum";
     case ValueType::MEAN        : return "Mean";
+    case ValueType::MEDIAN      : return "Median";
     case ValueType::MIN         : return "Min";
     case ValueType::MAX         : return "Max";
     default                     : assert(false); return "";
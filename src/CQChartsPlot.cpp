@@ -12,6 +12,7 @@
 #include <CQChartsDisplayRange.h>
 #include <CQChartsModelExprMatch.h>
 #include <CQChartsModelData.h>
+#include <CQChartsColumnView.h>
 #include <CQChartsModelDetails.h>
 #include <CQChartsPlotParameter.h>
 #include <CQChartsColumnType.h>
@@ -21,6 +22,7 @@
 #include <CQChartsTip.h>
 #include <CQChartsPaintDevice.h>
 #include <CQChartsDrawUtil.h>
+#include <CQChartsSymbolCache.h>
 #include <CQChartsHtml.h>
 #include <CQChartsEnv.h>
 #include <CQCharts.h>
@@ -28,6 +30,7 @@
 
 #include <CQPropertyViewModel.h>
 #include <CQPropertyViewItem.h>
+#include <CQSummaryModel.h>
 #include <CQColors.h>
 #include <CQColorsTheme.h>
 #include <CQColorsPalette.h>
@@ -36,7 +39,6 @@
 #include <CQTclUtil.h>
 
 #include <CMathUtil.h>
-#include <CMathRound.h>
 
 #include <QApplication>
 #include <QItemSelectionModel>
@@ -70,6 +72,10 @@ CQChartsPlot(CQChartsView *view, CQChartsPlotType *type, const ModelP &model) :
 
   bufferSymbols_ = CQChartsEnv::getInt("CQ_CHARTS_BUFFER_SYMBOLS", bufferSymbols_);
 
+  symbolCache_ = new CQChartsSymbolCache;
+
+  cullDrawObjs_ = CQChartsEnv::getBool("CQ_CHARTS_CULL_DRAW_OBJS", cullDrawObjs_);
+
   displayRange_ = new CQChartsDisplayRange();
 
   displayRange_->setPixelAdjust(0.0);
@@ -173,6 +179,8 @@ CQChartsPlot::
 
   delete editHandles_;
 
+  delete symbolCache_;
+
   delete animateData_.timer;
   delete updateData_.timer;
 }
@@ -401,17 +409,52 @@ void
 CQChartsPlot::
 selectionSlot(QItemSelectionModel *sm)
 {
-  QModelIndexList indices = sm->selectedIndexes();
-  if (indices.empty()) return;
+  QItemSelection selection = sm->selection();
+  if (selection.empty()) return;
+
+  //---
 
-  CQChartsPlotObj::Indices selectIndices;
+  // mark objects with matching indices using row to object index
+  if (! rowObjIndex_.valid || rowObjIndex_.numObjs != int(plotObjs_.size()))
+    initRowObjIndex();
 
-  for (int i = 0; i < indices.size(); ++i) {
-    const QModelIndex &ind = indices[i];
+  std::vector<bool> objSelected(plotObjs_.size(), false);
 
+  // matching indices per object (for objects which select an item subset)
+  std::map<int,CQChartsPlotObj::Indices> objSelectInds;
+
+  auto selectIndexObjs = [&](const QModelIndex &ind) {
     QModelIndex ind1 = normalizeIndex(ind);
 
-    selectIndices.insert(ind1);
+    auto pp = rowObjIndex_.parentRows.find(ind1.parent());
+    if (pp == rowObjIndex_.parentRows.end()) return;
+
+    const auto &parentRows = (*pp).second;
+
+    int row = ind1.row();
+
+    if (row < 0 || row >= int(parentRows.rowStart.size()) - 1)
+      return;
+
+    for (int i = parentRows.rowStart[row]; i < parentRows.rowStart[row + 1]; ++i) {
+      const auto &entry = parentRows.entries[i];
+
+      if (entry.column == ind1.column()) {
+        objSelected[entry.obj] = true;
+
+        objSelectInds[entry.obj].insert(ind1);
+      }
+    }
+  };
+
+  for (const auto &range : selection) {
+    const auto *model = range.model();
+    if (! model) continue;
+
+    for (int r = range.top(); r <= range.bottom(); ++r) {
+      for (int c = range.left(); c <= range.right(); ++c)
+        selectIndexObjs(model->index(r, c, range.parent()));
+    }
   }
 
   //---
@@ -422,22 +465,13 @@ selectionSlot(QItemSelectionModel *sm)
   deselectAllObjs();
 
   // select objects with matching indices
-  for (auto &plotObj : plotObjects()) {
-    CQChartsPlotObj::Indices indices;
-
-    plotObj->getSelectIndices(indices);
-
-    bool found = false;
+  for (int i = 0; i < int(objSelected.size()); ++i) {
+    if (! objSelected[i])
+      continue;
 
-    for (const auto &ind : indices) {
-      if (selectIndices.find(ind) != selectIndices.end()) {
-        found = true;
-        break;
-      }
-    }
+    plotObjs_[i]->setSelectIndices(objSelectInds[i]);
 
-    if (found)
-      plotObj->setSelected(true);
+    plotObjs_[i]->setSelected(true);
   }
 
   endSelection();
@@ -769,6 +803,9 @@ writeScript(CQChartsScriptPainter *device) const
 
   std::ostream &os = device->os();
 
+  // compact writes plot objects as typed array buffers drawn by generic renderer
+  bool compact = view()->isScriptCompact();
+
   //---
 
   os << "function Charts_" << plotId << "() {\n";
@@ -781,56 +818,106 @@ writeScript(CQChartsScriptPainter *device) const
   os << "\n";
   os << "Charts_" << plotId << ".prototype.init = function() {\n";
 
-  int imajor = 0;
+  if (compact) {
+    os << "  this.buffers = new ChartsObjBuffers();\n";
+    os << "  this.initBuffers();\n";
+    os << "  this.buffers.finish();\n";
+  }
+  else {
+    int imajor = 0;
 
-  for (const auto &plotObj : plotObjects()) {
-    if (! plotObj->isVisible()) continue;
+    for (const auto &plotObj : plotObjects()) {
+      if (! plotObj->isVisible()) continue;
 
-    if (plotObj->detailHint() == CQChartsPlotObj::DetailHint::MAJOR) {
-      QString     objId  = QString("obj_") + plotId.c_str() + "_" + plotObj->id();
-      std::string objStr = device->encodeObjId(objId).toStdString();
+      if (plotObj->detailHint() == CQChartsPlotObj::DetailHint::MAJOR) {
+        QString     objId  = QString("obj_") + plotId.c_str() + "_" + plotObj->id();
+        std::string objStr = device->encodeObjId(objId).toStdString();
 
-      if (imajor > 0)
-        os << "\n";
+        if (imajor > 0)
+          os << "\n";
 
-      os << "  this." << objStr << " = new Charts_" << objStr << "(this);\n";
-      os << "  this.objs.push(this." << objStr << ");\n";
-      os << "  this." << objStr << ".init();\n";
+        os << "  this." << objStr << " = new Charts_" << objStr << "(this);\n";
+        os << "  this.objs.push(this." << objStr << ");\n";
+        os << "  this." << objStr << ".init();\n";
 
-      ++imajor;
+        ++imajor;
+      }
     }
-  }
 
-  os << "  this.objs.reverse();\n"; // reverse order for tooltip
+    os << "  this.objs.reverse();\n"; // reverse order for tooltip
+  }
 
   os << "}\n";
 
   //---
 
-  os << "\n";
-  os << "Charts_" << plotId << ".prototype.eventMouseDown = function(e) {\n";
-  os << "  if (! this.visible) return;\n";
-  os << "  var rect = charts.canvas.getBoundingClientRect();\n";
-  os << "  var mouseX = e.clientX - rect.left;\n";
-  os << "  var mouseY = e.clientY - rect.top;\n";
-  os << "  this.objs.forEach(obj => obj.eventMouseDown(mouseX, mouseY));\n";
-  os << "}\n";
-  os << "\n";
-  os << "Charts_" << plotId << ".prototype.eventMouseMove = function(e) {\n";
-  os << "  if (! this.visible) return;\n";
-  os << "  var rect = charts.canvas.getBoundingClientRect();\n";
-  os << "  var mouseX = e.clientX - rect.left;\n";
-  os << "  var mouseY = e.clientY - rect.top;\n";
-  os << "  this.objs.forEach(obj => obj.eventMouseMove(mouseX, mouseY));\n";
-  os << "}\n";
-  os << "\n";
-  os << "Charts_" << plotId << ".prototype.eventMouseUp = function(e) {\n";
-  os << "  if (! this.visible) return;\n";
-  os << "  var rect = charts.canvas.getBoundingClientRect();\n";
-  os << "  var mouseX = e.clientX - rect.left;\n";
-  os << "  var mouseY = e.clientY - rect.top;\n";
-  os << "  this.objs.forEach(obj => obj.eventMouseUp(mouseX, mouseY));\n";
-  os << "}\n";
+  if (compact) {
+    os << "\n";
+    os << "Charts_" << plotId << ".prototype.eventMouseDown = function(e) {\n";
+    os << "  if (! this.visible) return;\n";
+    os << "  var rect = charts.canvas.getBoundingClientRect();\n";
+    os << "  var mouseX = e.clientX - rect.left;\n";
+    os << "  var mouseY = e.clientY - rect.top;\n";
+    os << "  this.initRange();\n";
+    os << "  var io = this.buffers.insideObj(mouseX, mouseY);\n";
+    os << "  if (io >= 0) {\n";
+
+    if (view()->scriptSelectProc().length())
+      os << "    " << view()->scriptSelectProc().toStdString() << "(this.buffers.objId(io));\n";
+    else
+      os << "    charts.log(this.buffers.objTip(io));\n";
+
+    os << "  }\n";
+    os << "}\n";
+    os << "\n";
+    os << "Charts_" << plotId << ".prototype.eventMouseMove = function(e) {\n";
+    os << "  if (! this.visible) return;\n";
+    os << "  var rect = charts.canvas.getBoundingClientRect();\n";
+    os << "  var mouseX = e.clientX - rect.left;\n";
+    os << "  var mouseY = e.clientY - rect.top;\n";
+    os << "  this.initRange();\n";
+    os << "  var io = this.buffers.insideObj(mouseX, mouseY);\n";
+    os << "  if (io >= 0) {\n";
+    os << "    if (! charts.mouseTipObj) {\n";
+    os << "      charts.mouseTipObj = this;\n";
+    os << "      showTooltip(mouseX, mouseY, this.buffers.objTip(io));\n";
+    os << "    }\n";
+    os << "  }\n";
+    os << "  if (io != this.buffers.insideInd) {\n";
+    os << "    this.buffers.insideInd = io;\n";
+    os << "    charts.update();\n";
+    os << "  }\n";
+    os << "}\n";
+    os << "\n";
+    os << "Charts_" << plotId << ".prototype.eventMouseUp = function(e) {\n";
+    os << "}\n";
+  }
+  else {
+    os << "\n";
+    os << "Charts_" << plotId << ".prototype.eventMouseDown = function(e) {\n";
+    os << "  if (! this.visible) return;\n";
+    os << "  var rect = charts.canvas.getBoundingClientRect();\n";
+    os << "  var mouseX = e.clientX - rect.left;\n";
+    os << "  var mouseY = e.clientY - rect.top;\n";
+    os << "  this.objs.forEach(obj => obj.eventMouseDown(mouseX, mouseY));\n";
+    os << "}\n";
+    os << "\n";
+    os << "Charts_" << plotId << ".prototype.eventMouseMove = function(e) {\n";
+    os << "  if (! this.visible) return;\n";
+    os << "  var rect = charts.canvas.getBoundingClientRect();\n";
+    os << "  var mouseX = e.clientX - rect.left;\n";
+    os << "  var mouseY = e.clientY - rect.top;\n";
+    os << "  this.objs.forEach(obj => obj.eventMouseMove(mouseX, mouseY));\n";
+    os << "}\n";
+    os << "\n";
+    os << "Charts_" << plotId << ".prototype.eventMouseUp = function(e) {\n";
+    os << "  if (! this.visible) return;\n";
+    os << "  var rect = charts.canvas.getBoundingClientRect();\n";
+    os << "  var mouseX = e.clientX - rect.left;\n";
+    os << "  var mouseY = e.clientY - rect.top;\n";
+    os << "  this.objs.forEach(obj => obj.eventMouseUp(mouseX, mouseY));\n";
+    os << "}\n";
+  }
 
   //---
 
@@ -915,97 +1002,99 @@ writeScript(CQChartsScriptPainter *device) const
   //---
 
   // plot object procs
-  for (const auto &plotObj : plotObjects()) {
-    if (! plotObj->isVisible()) continue;
+  if (! compact) {
+    for (const auto &plotObj : plotObjects()) {
+      if (! plotObj->isVisible()) continue;
 
-    if (plotObj->detailHint() == CQChartsPlotObj::DetailHint::MAJOR) {
-      QString     objId  = QString("obj_") + plotId.c_str() + "_" + plotObj->id();
-      std::string objStr = device->encodeObjId(objId).toStdString();
+      if (plotObj->detailHint() == CQChartsPlotObj::DetailHint::MAJOR) {
+        QString     objId  = QString("obj_") + plotId.c_str() + "_" + plotObj->id();
+        std::string objStr = device->encodeObjId(objId).toStdString();
 
-      os << "\n";
-      os << "function Charts_" << objStr << "(plot) {\n";
-      os << "  this.plot = plot;\n";
-      os << "}\n";
+        os << "\n";
+        os << "function Charts_" << objStr << "(plot) {\n";
+        os << "  this.plot = plot;\n";
+        os << "}\n";
 
-      os << "\n";
-      os << "Charts_" << objStr << ".prototype.init = function() {\n";
-      plotObj->writeScriptData(device);
-      os << "}\n";
+        os << "\n";
+        os << "Charts_" << objStr << ".prototype.init = function() {\n";
+        plotObj->writeScriptData(device);
+        os << "}\n";
 
-      //---
+        //---
 
-      os << "\n";
-      os << "Charts_" << objStr << ".prototype.eventMouseDown = function(mouseX, mouseY) {\n";
-      os << "  this.plot.initRange();\n";
-      os << "  if (this.inside(mouseX, mouseY)) {\n";
+        os << "\n";
+        os << "Charts_" << objStr << ".prototype.eventMouseDown = function(mouseX, mouseY) {\n";
+        os << "  this.plot.initRange();\n";
+        os << "  if (this.inside(mouseX, mouseY)) {\n";
 
-      if (view()->scriptSelectProc().length())
-        os << "    " << view()->scriptSelectProc().toStdString() << "(this.id);\n";
-      else
-        os << "    charts.log(this.tipId);\n";
-
-      os << "  }\n";
-      os << "}\n";
-
-      os << "\n";
-      os << "Charts_" << objStr << ".prototype.eventMouseMove = function(mouseX, mouseY) {\n";
-      os << "  this.plot.initRange();\n";
-      os << "  var isInside = this.inside(mouseX, mouseY);\n";
-      os << "  if (isInside) {\n";
-      os << "    if (! charts.mouseTipObj) {\n";
-      os << "      charts.mouseTipObj = this;\n";
-      os << "      showTooltip(mouseX, mouseY, this.tipId);\n";
-      os << "    }\n";
-      os << "  }\n";
-      os << "  if (isInside != this.isInside) {\n";
-      os << "    this.isInside = isInside;\n";
-      os << "\n";
-      os << "    if (this.isInside) {\n";
-      plotObj->writeScriptInsideColor(device, /*isSave*/true);
-      os << "    }\n";
-      os << "    else {\n";
-      plotObj->writeScriptInsideColor(device, /*isSave*/false);
-      os << "    }\n";
-      os << "    charts.update();\n";
-      os << "  }\n";
-      os << "}\n";
-
-      os << "\n";
-      os << "Charts_" << objStr << ".prototype.eventMouseUp = function(mouseX, mouseY) {\n";
-      os << "}\n";
+        if (view()->scriptSelectProc().length())
+          os << "    " << view()->scriptSelectProc().toStdString() << "(this.id);\n";
+        else
+          os << "    charts.log(this.tipId);\n";
 
-      //---
+        os << "  }\n";
+        os << "}\n";
 
-      os << "\n";
-      os << "Charts_" << objStr << ".prototype.inside = function(px, py) {\n";
+        os << "\n";
+        os << "Charts_" << objStr << ".prototype.eventMouseMove = function(mouseX, mouseY) {\n";
+        os << "  this.plot.initRange();\n";
+        os << "  var isInside = this.inside(mouseX, mouseY);\n";
+        os << "  if (isInside) {\n";
+        os << "    if (! charts.mouseTipObj) {\n";
+        os << "      charts.mouseTipObj = this;\n";
+        os << "      showTooltip(mouseX, mouseY, this.tipId);\n";
+        os << "    }\n";
+        os << "  }\n";
+        os << "  if (isInside != this.isInside) {\n";
+        os << "    this.isInside = isInside;\n";
+        os << "\n";
+        os << "    if (this.isInside) {\n";
+        plotObj->writeScriptInsideColor(device, /*isSave*/true);
+        os << "    }\n";
+        os << "    else {\n";
+        plotObj->writeScriptInsideColor(device, /*isSave*/false);
+        os << "    }\n";
+        os << "    charts.update();\n";
+        os << "  }\n";
+        os << "}\n";
 
-      if      (plotObj->isPolygon()) {
-        if (plotObj->isSolid())
-          os << "  return charts.pointInsidePoly(px, py, this.poly);\n";
-        else
-          os << "  return charts.pointInsidePolyline(px, py, this.poly);\n";
-      }
-      else if (plotObj->isCircle()) {
-        os << "  return charts.pointInsideCircle(px, py, this.xc, this.yc, this.radius);\n";
-      }
-      else if (plotObj->isArc()) {
-        os << "  return charts.pointInsideArc(px, py, this.arc);\n";
-      }
-      else {
-        os << "  return charts.pointInsideRect(px, py, this.xmin, this.ymin, "
-              "this.xmax, this.ymax);\n";
-      }
+        os << "\n";
+        os << "Charts_" << objStr << ".prototype.eventMouseUp = function(mouseX, mouseY) {\n";
+        os << "}\n";
 
-      os << "}\n";
+        //---
 
-      os << "\n";
-      os << "Charts_" << objStr << ".prototype.draw = function() {\n";
+        os << "\n";
+        os << "Charts_" << objStr << ".prototype.inside = function(px, py) {\n";
 
-      plotObj->drawBg(device);
-      plotObj->draw  (device);
-      plotObj->drawFg(device);
+        if      (plotObj->isPolygon()) {
+          if (plotObj->isSolid())
+            os << "  return charts.pointInsidePoly(px, py, this.poly);\n";
+          else
+            os << "  return charts.pointInsidePolyline(px, py, this.poly);\n";
+        }
+        else if (plotObj->isCircle()) {
+          os << "  return charts.pointInsideCircle(px, py, this.xc, this.yc, this.radius);\n";
+        }
+        else if (plotObj->isArc()) {
+          os << "  return charts.pointInsideArc(px, py, this.arc);\n";
+        }
+        else {
+          os << "  return charts.pointInsideRect(px, py, this.xmin, this.ymin, "
+                "this.xmax, this.ymax);\n";
+        }
+
+        os << "}\n";
+
+        os << "\n";
+        os << "Charts_" << objStr << ".prototype.draw = function() {\n";
 
-      os << "}\n";
+        plotObj->drawBg(device);
+        plotObj->draw  (device);
+        plotObj->drawFg(device);
+
+        os << "}\n";
+      }
     }
   }
 
@@ -1017,28 +1106,39 @@ writeScript(CQChartsScriptPainter *device) const
   os << "\n";
   os << "Charts_" << plotId << ".prototype.drawObjs = function() {\n";
 
-  for (const auto &plotObj : plotObjects()) {
-    if (! plotObj->isVisible()) continue;
+  if (compact) {
+    os << "  this.buffers.draw();\n";
+  }
+  else {
+    for (const auto &plotObj : plotObjects()) {
+      if (! plotObj->isVisible()) continue;
 
-    if (plotObj->detailHint() == CQChartsPlotObj::DetailHint::MAJOR) {
-      QString     objId  = QString("obj_") + plotId.c_str() + "_" + plotObj->id();
-      std::string objStr = device->encodeObjId(objId).toStdString();
+      if (plotObj->detailHint() == CQChartsPlotObj::DetailHint::MAJOR) {
+        QString     objId  = QString("obj_") + plotId.c_str() + "_" + plotObj->id();
+        std::string objStr = device->encodeObjId(objId).toStdString();
 
-      os << "  this." << objStr << ".draw();\n";
-    }
-    else {
-      plotObj->drawBg(device);
-      plotObj->draw  (device);
-      plotObj->drawFg(device);
+        os << "  this." << objStr << ".draw();\n";
+      }
+      else {
+        plotObj->drawBg(device);
+        plotObj->draw  (device);
+        plotObj->drawFg(device);
+      }
     }
-  }
 
-  drawDeviceParts(device);
+    drawDeviceParts(device);
+  }
 
   os << "}\n";
 
   //---
 
+  // plot object buffers proc
+  if (compact)
+    writeScriptBuffers(device);
+
+  //---
+
   // draw annotations proc
   if (hasGroupedAnnotations(CQChartsLayer::Type::ANNOTATION)) {
     os << "\n";
@@ -1108,12 +1208,60 @@ writeScript(CQChartsScriptPainter *device) const
 
 void
 CQChartsPlot::
-writeScriptRange(CQChartsScriptPainter *device) const
+writeScriptBuffers(CQChartsScriptPainter *device) const
 {
+  std::string plotId = "plot_" + this->id().toStdString();
+
   std::ostream &os = device->os();
 
+  os << "\n";
+  os << "Charts_" << plotId << ".prototype.initBuffers = function() {\n";
+
+  // draw all objects (and device parts) into buffers (major objects are added to
+  // object buffer for highlight and tooltip)
+  CQChartsScriptBufferPainter bufferDevice(const_cast<CQChartsPlot *>(this), os);
+
+  bufferDevice.setOrigin(calcPlotRect().getLL());
+
+  for (const auto &plotObj : plotObjects()) {
+    if (! plotObj->isVisible()) continue;
+
+    bool major = (plotObj->detailHint() == CQChartsPlotObj::DetailHint::MAJOR);
+
+    if (major)
+      bufferDevice.startObj();
+
+    plotObj->drawBg(&bufferDevice);
+    plotObj->draw  (&bufferDevice);
+    plotObj->drawFg(&bufferDevice);
+
+    if (major)
+      bufferDevice.endObj(plotObj);
+  }
+
+  drawDeviceParts(&bufferDevice);
+
+  bufferDevice.flush();
+
+  os << "}\n";
+}
+
+void
+CQChartsPlot::
+writeScriptRange(CQChartsScriptPainter *device) const
+{
   auto prect = calcPlotRect();
 
+  // buffered objects record range change as command
+  auto *bufferDevice = dynamic_cast<CQChartsScriptBufferPainter *>(device);
+
+  if (bufferDevice) {
+    bufferDevice->setRange(prect);
+    return;
+  }
+
+  std::ostream &os = device->os();
+
   os << "\n";
   os << "  charts.xmin = " << prect.getXMin() << ";\n";
   os << "  charts.ymin = " << prect.getYMin() << ";\n";
@@ -1737,6 +1885,29 @@ setShowBoxes(bool b)
   CQChartsUtil::testAndSet(showBoxes_, b, [&]() { invalidateOverlay(); } );
 }
 
+void
+CQChartsPlot::
+setBufferSymbols(bool b)
+{
+  CQChartsUtil::testAndSet(bufferSymbols_, b, [&]() {
+    symbolCache_->clear(); drawObjs();
+  } );
+}
+
+int
+CQChartsPlot::
+symbolCacheHits() const
+{
+  return symbolCache_->numHits();
+}
+
+int
+CQChartsPlot::
+symbolCacheMisses() const
+{
+  return symbolCache_->numMisses();
+}
+
 void
 CQChartsPlot::
 setViewBBox(const CQChartsGeom::BBox &bbox)
@@ -2596,6 +2767,10 @@ addBaseProperties()
   if (CQChartsEnv::getBool("CQ_CHARTS_DEBUG")) {
     addProp("debug", "showBoxes"  , "", "Show object bounding boxes");
     addProp("debug", "followMouse", "", "Enable mouse tracking");
+
+    addProp("debug", "bufferSymbols"    , "", "Draw symbols using cached images");
+    addProp("debug", "symbolCacheHits"  , "", "Number of symbol image cache hits");
+    addProp("debug", "symbolCacheMisses", "", "Number of symbol image cache misses");
   }
 
   //------
@@ -4679,6 +4854,9 @@ createObjs()
 
   //---
 
+  // plot objects changing so object tree is out of date until rebuilt
+  objTreeData_.tree->invalidateObjects();
+
   PlotObjs objs;
 
   if (! createObjs(objs))
@@ -4691,6 +4869,10 @@ createObjs()
 
   applyVisibleFilter();
 
+  //---
+
+  initRowObjIndex();
+
   return true;
 }
 
@@ -4783,6 +4965,9 @@ clearPlotObjects()
 {
   CQPerfTrace trace("CQChartsPlot::clearPlotObjects");
 
+  // stop draw using object tree before objects are deleted
+  objTreeData_.tree->invalidateObjects();
+
   objTreeData_.tree->clearObjects();
 
   PlotObjs plotObjs;
@@ -4799,6 +4984,82 @@ clearPlotObjects()
 
   insideObjs_    .clear();
   sizeInsideObjs_.clear();
+
+  rowObjIndex_ = RowObjIndex();
+}
+
+void
+CQChartsPlot::
+initRowObjIndex()
+{
+  CQPerfTrace trace("CQChartsPlot::initRowObjIndex");
+
+  rowObjIndex_ = RowObjIndex();
+
+  // get (row, column, object) for each object select index by parent
+  struct RowEntry {
+    int row;
+    int column;
+    int obj;
+  };
+
+  using RowEntries = std::vector<RowEntry>;
+
+  std::map<QModelIndex,RowEntries> parentEntries;
+
+  int numObjs = plotObjs_.size();
+
+  for (int i = 0; i < numObjs; ++i) {
+    if (isInterrupt())
+      return;
+
+    CQChartsPlotObj::Indices inds;
+
+    plotObjs_[i]->getSelectIndices(inds);
+
+    for (const auto &ind : inds) {
+      if (ind.isValid())
+        parentEntries[ind.parent()].push_back(RowEntry { ind.row(), ind.column(), i });
+    }
+  }
+
+  //---
+
+  // store entries sorted by row (counting sort)
+  for (const auto &pe : parentEntries) {
+    const auto &entries = pe.second;
+
+    int maxRow = 0;
+
+    for (const auto &entry : entries)
+      maxRow = std::max(maxRow, entry.row);
+
+    auto &parentRows = rowObjIndex_.parentRows[pe.first];
+
+    auto &rowStart = parentRows.rowStart;
+
+    rowStart.resize(maxRow + 2, 0);
+
+    for (const auto &entry : entries)
+      ++rowStart[entry.row + 1];
+
+    for (int r = 0; r <= maxRow; ++r)
+      rowStart[r + 1] += rowStart[r];
+
+    RowObjIndex::RowStart pos(rowStart.begin(), rowStart.end() - 1);
+
+    parentRows.entries.resize(entries.size());
+
+    for (const auto &entry : entries) {
+      auto &entry1 = parentRows.entries[pos[entry.row]++];
+
+      entry1.column = entry.column;
+      entry1.obj    = entry.obj;
+    }
+  }
+
+  rowObjIndex_.numObjs = numObjs;
+  rowObjIndex_.valid   = true;
 }
 
 CQChartsGeom::BBox
@@ -5305,6 +5566,17 @@ objectsSelectPress(const CQChartsGeom::Point &w, SelMod selMod)
 
   //---
 
+  // save initial selected state
+  ObjsSelected initSelected;
+
+  for (const auto &objSelected : objsSelected)
+    initSelected[objSelected.first] = objSelected.first->isSelected();
+
+  if (selectObj)
+    initSelected[selectObj] = selectObj->isSelected();
+
+  //---
+
   // change selection depending on selection modifier
   if (selectObj) {
     if      (selMod == SelMod::TOGGLE)
@@ -5333,6 +5605,8 @@ objectsSelectPress(const CQChartsGeom::Point &w, SelMod selMod)
   //---
 
   // select objects and track if selection changed
+  //  compare against initial state as selecting a detail object can change the
+  //  selected state of its parent object
   bool changed = false;
 
   auto setObjSelected = [&](CQChartsObj *obj, bool selected) {
@@ -5342,7 +5616,7 @@ objectsSelectPress(const CQChartsGeom::Point &w, SelMod selMod)
   };
 
   for (const auto &objSelected : objsSelected) {
-    if (objSelected.first->isSelected() == objSelected.second)
+    if (initSelected[objSelected.first] == objSelected.second)
       continue;
 
     if (! objSelected.second)
@@ -5350,7 +5624,7 @@ objectsSelectPress(const CQChartsGeom::Point &w, SelMod selMod)
   }
 
   for (const auto &objSelected : objsSelected) {
-    if (objSelected.first->isSelected() == objSelected.second)
+    if (initSelected[objSelected.first] == objSelected.second)
       continue;
 
     if (objSelected.second)
@@ -6359,6 +6633,14 @@ rectSelect(const CQChartsGeom::BBox &r, SelMod selMod)
       setObjSelected(objSelected.first, objSelected.second);
   }
 
+  // reset pending select rect (objects not changed)
+  for (auto &obj : objs) {
+    auto *plotObj = dynamic_cast<CQChartsPlotObj *>(obj);
+
+    if (plotObj)
+      plotObj->setSelectRect(CQChartsGeom::BBox(), false);
+  }
+
   //----
 
   // update selection if changed
@@ -7258,11 +7540,35 @@ tipText(const CQChartsGeom::Point &p, QString &tip) const
     if (numObjs > 1)
       tip += QString("<br><font color=\"blue\">&nbsp;&nbsp;%1 of %2</font>").
                arg(objNum + 1).arg(numObjs);
+
+    // report sample size if plot uses random or stratified sample of rows
+    QString sampleText = this->sampleText();
+
+    if (sampleText.length())
+      tip += QString("<br><font color=\"blue\">&nbsp;&nbsp;%1</font>").arg(sampleText);
   }
 
   return tip.length();
 }
 
+QString
+CQChartsPlot::
+sampleText() const
+{
+  auto *summaryModel = CQChartsModelUtil::getSummaryModel(model().data());
+
+  if (! summaryModel || ! (summaryModel->isRandomMode() || summaryModel->isStratifiedMode()))
+    return "";
+
+  double f = summaryModel->sampleFraction();
+
+  if (f >= 1.0)
+    return "";
+
+  return QString("Sample %1 of %2 rows (%3%)").arg(summaryModel->rowCount()).
+           arg(summaryModel->sourceRowCount()).arg(100.0*f, 0, 'g', 3);
+}
+
 void
 CQChartsPlot::
 addTipColumns(CQChartsTableTip &tableTip, const QModelIndex &ind) const
@@ -7322,6 +7628,15 @@ void
 CQChartsPlot::
 plotObjsAtPoint(const CQChartsGeom::Point &p, PlotObjs &plotObjs) const
 {
+  // use detail object for objects containing multiple items
+  auto addPlotObjs = [&](const CQChartsGeom::Point &p1, const PlotObjs &plotObjs1) {
+    for (const auto &plotObj : plotObjs1) {
+      auto *detailObj = plotObj->detailObjAt(p1);
+
+      plotObjs.push_back(detailObj ? detailObj : plotObj);
+    }
+  };
+
   if (isOverlay()) {
     processOverlayPlots([&](const CQChartsPlot *plot) {
       auto p1 = p;
@@ -7329,11 +7644,19 @@ plotObjsAtPoint(const CQChartsGeom::Point &p, PlotObjs &plotObjs) const
       if (plot != this)
         p1 = plot->pixelToWindow(windowToPixel(p));
 
-      plot->objTreeData_.tree->objectsAtPoint(p1, plotObjs);
+      PlotObjs plotObjs1;
+
+      plot->objTreeData_.tree->objectsAtPoint(p1, plotObjs1);
+
+      addPlotObjs(p1, plotObjs1);
     });
   }
   else {
-    objTreeData_.tree->objectsAtPoint(p, plotObjs);
+    PlotObjs plotObjs1;
+
+    objTreeData_.tree->objectsAtPoint(p, plotObjs1);
+
+    addPlotObjs(p, plotObjs1);
   }
 }
 
@@ -7367,8 +7690,12 @@ objsIntersectRect(const CQChartsGeom::BBox &r, Objs &objs, bool inside, bool sel
       plot->objTreeData_.tree->objectsIntersectRect(r1, plotObjs, inside);
 
       for (const auto &plotObj : plotObjs) {
-        if (select && ! plotObj->canSelect())
-          continue;
+        if (select) {
+          if (! plotObj->canSelect())
+            continue;
+
+          plotObj->setSelectRect(r1, inside);
+        }
 
         objs.push_back(plotObj);
       }
@@ -7380,8 +7707,12 @@ objsIntersectRect(const CQChartsGeom::BBox &r, Objs &objs, bool inside, bool sel
     objTreeData_.tree->objectsIntersectRect(r, plotObjs, inside);
 
     for (const auto &plotObj : plotObjs) {
-      if (select && ! plotObj->canSelect())
-        continue;
+      if (select) {
+        if (! plotObj->canSelect())
+          continue;
+
+        plotObj->setSelectRect(r, inside);
+      }
 
       objs.push_back(plotObj);
     }
@@ -8600,7 +8931,15 @@ execDrawObjs(CQChartsPaintDevice *device, const CQChartsLayer::Type &layerType)
 
   auto bbox = displayRangeBBox();
 
-  for (const auto &plotObj : plotObjects()) {
+  // get objects touching display range from object tree if available
+  // (otherwise process all objects)
+  PlotObjs cullObjs;
+
+  bool culled = (canCullDrawObjs() && objTreeData_.tree->objectsToDraw(bbox, cullObjs));
+
+  const auto &drawObjs = (culled ? cullObjs : plotObjects());
+
+  for (const auto &plotObj : drawObjs) {
     if (! plotObj->isVisible())
       continue;
 
@@ -10148,7 +10487,7 @@ drawSymbol(CQChartsPaintDevice *device, const CQChartsGeom::Point &p, const CQCh
 {
   CQChartsDrawUtil::setPenBrush(device, penBrush);
 
-  CQChartsDrawUtil::drawSymbol(device, symbol, p, size);
+  drawSymbol(device, p, symbol, size);
 }
 
 void
@@ -10159,12 +10498,15 @@ drawSymbol(CQChartsPaintDevice *device, const CQChartsGeom::Point &p, const CQCh
   if (bufferSymbols_) {
     auto *painter = dynamic_cast<CQChartsViewPlotPainter *>(device);
 
-    if (painter) {
+    // gradient/pattern pens and brushes can't be cached
+    if (painter && CQChartsSymbolCache::isCacheable(painter->painter()->pen(),
+                                                    painter->painter()->brush())) {
+      // symbol images are cached by pixel size
       double sx, sy;
 
-      plotSymbolSize(size, sx, sy);
+      pixelSymbolSize(size, sx, sy);
 
-      drawBufferedSymbol(painter->painter(), p, symbol, std::min(sx, sy));
+      drawBufferedSymbol(device, painter->painter(), p, symbol, std::min(sx, sy));
     }
     else {
       CQChartsDrawUtil::drawSymbol(device, symbol, p, size);
@@ -10177,64 +10519,13 @@ drawSymbol(CQChartsPaintDevice *device, const CQChartsGeom::Point &p, const CQCh
 
 void
 CQChartsPlot::
-drawBufferedSymbol(QPainter *painter, const CQChartsGeom::Point &p,
+drawBufferedSymbol(CQChartsPaintDevice *device, QPainter *painter, const CQChartsGeom::Point &p,
                    const CQChartsSymbol &symbol, double size) const
 {
-  auto cmpPen = [](const QPen &pen1, const QPen &pen2) {
-    if (pen1.style () != pen2.style ()) return false;
-    if (pen1.color () != pen2.color ()) return false;
-    if (pen1.widthF() != pen2.widthF()) return false;
-    return true;
-  };
-
-  auto cmpBrush = [](const QBrush &brush1, const QBrush &brush2) {
-    if (brush1.style () != brush2.style ()) return false;
-    if (brush1.color () != brush2.color ()) return false;
-    return true;
-  };
-
-  struct ImageBuffer {
-    CQChartsSymbol symbol;
-    double         size { 0.0 };
-    int            isize { 0 };
-    QPen           pen;
-    QBrush         brush;
-    QImage         image;
-  };
-
-  static ImageBuffer imageBuffer;
-
-  if (symbol != imageBuffer.symbol ||
-      size   != imageBuffer.size   ||
-      ! cmpPen  (painter->pen  (), imageBuffer.pen  ) ||
-      ! cmpBrush(painter->brush(), imageBuffer.brush)) {
-    imageBuffer.symbol = symbol;
-    imageBuffer.size   = size;
-    imageBuffer.isize  = CMathRound::RoundUp(2*(size + std::max(painter->pen().widthF(), 1.0)));
-    imageBuffer.pen    = painter->pen  ();
-    imageBuffer.brush  = painter->brush();
-    imageBuffer.image  = CQChartsUtil::initImage(QSize(imageBuffer.isize, imageBuffer.isize));
+  // symbol images are drawn in pixels
+  auto pp = device->windowToPixel(p);
 
-    imageBuffer.image.fill(QColor(0,0,0,0));
-
-    QPainter ipainter(&imageBuffer.image);
-
-    ipainter.setRenderHints(QPainter::Antialiasing);
-
-    ipainter.setPen  (imageBuffer.pen  );
-    ipainter.setBrush(imageBuffer.brush);
-
-    CQChartsPixelPainter device(&ipainter);
-
-    CQChartsGeom::Point spos (size, size);
-    CQChartsLength      ssize(size, CQChartsUnits::PIXEL);
-
-    CQChartsDrawUtil::drawSymbol(&device, symbol, spos, ssize);
-  }
-
-  double is = imageBuffer.isize/2.0;
-
-  painter->drawImage(int(p.x - is), int(p.y - is), imageBuffer.image);
+  symbolCache_->drawSymbol(painter, pp, symbol, size);
 }
 
 CQChartsTextOptions
@@ -10487,6 +10778,24 @@ CQChartsPlot::ColorInd
 CQChartsPlot::
 calcColorInd(const CQChartsPlotObj *obj, const CQChartsKeyColorBox *keyBox,
              const ColorInd &is, const ColorInd &ig, const ColorInd &iv) const
+{
+  return calcColorIndI(obj, keyBox, is, ig, iv, nullptr);
+}
+
+CQChartsPlot::ColorInd
+CQChartsPlot::
+calcColorInd(const CQChartsPlotObj *obj, const CQChartsKeyColorBox *keyBox,
+             const ColorInd &is, const ColorInd &ig, const ColorInd &iv,
+             const CQChartsGeom::Point &p) const
+{
+  return calcColorIndI(obj, keyBox, is, ig, iv, &p);
+}
+
+CQChartsPlot::ColorInd
+CQChartsPlot::
+calcColorIndI(const CQChartsPlotObj *obj, const CQChartsKeyColorBox *keyBox,
+              const ColorInd &is, const ColorInd &ig, const ColorInd &iv,
+              const CQChartsGeom::Point *p) const
 {
   ColorInd colorInd;
 
@@ -10511,7 +10820,9 @@ calcColorInd(const CQChartsPlotObj *obj, const CQChartsKeyColorBox *keyBox,
 
     double x = 0.0;
 
-    if      (obj)
+    if      (p)
+      x = (relative ? CMathUtil::map(p->x, dataRange_.xmin(), dataRange_.xmax(), 0.0, 1.0) : p->x);
+    else if (obj)
       x = obj->xColorValue(relative);
     else if (keyBox)
       x = keyBox->xColorValue(relative);
@@ -10532,7 +10843,9 @@ calcColorInd(const CQChartsPlotObj *obj, const CQChartsKeyColorBox *keyBox,
 
     double y = 0.0;
 
-    if      (obj)
+    if      (p)
+      y = (relative ? CMathUtil::map(p->y, dataRange_.ymin(), dataRange_.ymax(), 0.0, 1.0) : p->y);
+    else if (obj)
       y = obj->yColorValue(relative);
     else if (keyBox)
       y = keyBox->yColorValue(relative);
@@ -10955,11 +11268,47 @@ modelMappedReal(int row, const CQChartsColumn &column, const QModelIndex &parent
 bool
 CQChartsPlot::
 modelMappedReal(const CQChartsModelIndex &ind, double &r, bool log, double def) const
+{
+  // no view reads value from model
+  return modelMappedReal(ColumnViewP(), ind, r, log, def);
+}
+
+CQChartsPlot::ColumnViewP
+CQChartsPlot::
+columnView(const CQChartsColumn &column) const
+{
+  // only plain data columns of flat model data can be cached
+  if (column.type() != CQChartsColumn::Type::DATA &&
+      column.type() != CQChartsColumn::Type::EXPR)
+    return ColumnViewP();
+
+  auto *modelData = getModelData();
+
+  if (! modelData || modelData->model().data() != model().data())
+    return ColumnViewP();
+
+  return modelData->columnView(column);
+}
+
+double
+CQChartsPlot::
+modelReal(const ColumnViewP &view, const CQChartsModelIndex &ind, bool &ok) const
+{
+  if (view && ! ind.parent.isValid() && ind.row < view->numRows())
+    return view->value(ind.row, ok);
+
+  return modelReal(ind, ok);
+}
+
+bool
+CQChartsPlot::
+modelMappedReal(const ColumnViewP &view, const CQChartsModelIndex &ind,
+                double &r, bool log, double def) const
 {
   bool ok = false;
 
   if (ind.isValid()) {
-    r = modelReal(ind, ok);
+    r = modelReal(view, ind, ok);
 
     if (! ok)
       r = def;
@@ -11692,8 +12041,13 @@ addSelectIndex(const QModelIndex &ind)
   if (! ind1.isValid())
     return;
 
-  // add to map ordered by parent, column, row
-  selIndexColumnRows_[ind1.parent()][ind1.column()].insert(ind1.row());
+  // add to row set ordered by parent, column
+  auto &rows = selIndexColumnRows_[ind1.parent()][ind1.column()];
+
+  if (ind1.row() >= int(rows.size()))
+    rows.resize(ind1.row() + 1, false);
+
+  rows[ind1.row()] = true;
 }
 
 void
@@ -11708,46 +12062,61 @@ endSelectIndex()
   // build new selection
   QItemSelection optItemSelection;
 
-  // build row range per index column
+  // build row ranges per index column (merge adjacent columns with same row ranges)
+  using RowRange  = std::pair<int,int>;
+  using RowRanges = std::vector<RowRange>;
+
   for (const auto &p : selIndexColumnRows_) {
     const QModelIndex &parent     = p.first;
     const ColumnRows  &columnRows = p.second;
 
-    // build row range per column
+    // build row ranges per column
+    std::vector<std::pair<int,RowRanges>> columnRanges;
+
     for (const auto &p1 : columnRows) {
       int         ic   = p1.first;
       const Rows &rows = p1.second;
 
-      CQChartsColumn column(ic);
+      RowRanges rowRanges;
 
-      int startRow = -1;
-      int endRow   = -1;
+      int nr = rows.size();
 
-      for (const auto &row : rows) {
-        if      (startRow < 0) {
-          startRow = row;
-          endRow   = row;
-        }
-        else if (row == endRow + 1) {
-          endRow = row;
-        }
-        else {
-          QModelIndex ind1 = modelIndex(startRow, column, parent);
-          QModelIndex ind2 = modelIndex(endRow  , column, parent);
+      for (int r = 0; r < nr; ++r) {
+        if (! rows[r]) continue;
 
-          optItemSelection.select(ind1, ind2);
+        int r1 = r;
 
-          startRow = row;
-          endRow   = row;
-        }
+        while (r + 1 < nr && rows[r + 1])
+          ++r;
+
+        rowRanges.push_back(RowRange(r1, r));
       }
 
-      if (startRow >= 0) {
-        QModelIndex ind1 = modelIndex(startRow, column, parent);
-        QModelIndex ind2 = modelIndex(endRow  , column, parent);
+      if (! rowRanges.empty())
+        columnRanges.push_back(std::pair<int,RowRanges>(ic, rowRanges));
+    }
+
+    // select row ranges for each run of adjacent columns with same ranges
+    int nc = columnRanges.size();
+
+    for (int i = 0; i < nc; ) {
+      int j = i;
+
+      while (j + 1 < nc && columnRanges[j + 1].first == columnRanges[j].first + 1 &&
+             columnRanges[j + 1].second == columnRanges[i].second)
+        ++j;
+
+      CQChartsColumn column1(columnRanges[i].first);
+      CQChartsColumn column2(columnRanges[j].first);
+
+      for (const auto &rowRange : columnRanges[i].second) {
+        QModelIndex ind1 = modelIndex(rowRange.first , column1, parent);
+        QModelIndex ind2 = modelIndex(rowRange.second, column2, parent);
 
         optItemSelection.select(ind1, ind2);
       }
+
+      i = j + 1;
     }
   }
 
@@ -4,6 +4,16 @@
 #include <CQPerfMonitor.h>
 #include <QPainter>
 #include <future>
+#include <thread>
+#include <algorithm>
+
+namespace {
+
+int numTreeThreads() {
+  return std::max(int(std::thread::hardware_concurrency()), 1);
+}
+
+}
 
 CQChartsPlotObjTree::
 CQChartsPlotObjTree(CQChartsPlot *plot, bool wait) :
@@ -14,6 +24,13 @@ CQChartsPlotObjTree(CQChartsPlot *plot, bool wait) :
 CQChartsPlotObjTree::
 ~CQChartsPlotObjTree()
 {
+  // stop and wait for build thread (don't notify plot)
+  if (plotObjTreeFuture_.valid()) {
+    interrupt_.store(true);
+
+    delete plotObjTreeFuture_.get();
+  }
+
   delete plotObjTree_;
 }
 
@@ -58,19 +75,42 @@ addObjectsThread()
     const auto &range = plot_->dataRange();
 
     if (range.isSet()) {
-      CQChartsGeom::BBox bbox(range.xmin(), range.ymin(), range.xmax(), range.ymax());
-
-      plotObjTree = new PlotObjTree(bbox);
+      // add all objects (visible or not) with their draw order so a draw can
+      // process only the objects touching the display rect (queries check visible)
+      int ind = 0;
 
       for (const auto &obj : plotObjs) {
         if (interrupt_.load())
           break;
 
-        if (! obj->isVisible())
-          continue;
+        DrawObj drawObj;
+
+        drawObj.obj  = obj;
+        drawObj.ind  = ind++;
+        drawObj.bbox = obj->rect();
 
-        if (obj->rect().isSet())
-          plotObjTree->add(obj);
+        if (drawObj.bbox.isSet())
+          drawObjs_.push_back(drawObj);
+        else
+          noRectDrawObjs_.push_back(drawObj);
+      }
+
+      // bulk load tree after array is complete (tree stores pointers)
+      if (! interrupt_.load()) {
+        PlotObjTree::Datas treeObjs;
+
+        treeObjs.reserve(drawObjs_.size());
+
+        for (auto &drawObj : drawObjs_)
+          treeObjs.push_back(&drawObj);
+
+        plotObjTree = new PlotObjTree;
+
+        plotObjTree->setNumThreads(numTreeThreads());
+
+        plotObjTree->build(treeObjs);
+
+        valid_.store(! interrupt_.load());
       }
     }
   }
@@ -84,11 +124,16 @@ void
 CQChartsPlotObjTree::
 clearObjects()
 {
+  invalidateObjects();
+
   interruptTree();
 
   delete plotObjTree_;
 
   plotObjTree_ = nullptr;
+
+  drawObjs_      .clear();
+  noRectDrawObjs_.clear();
 }
 
 void
@@ -128,9 +173,11 @@ objectsAtPoint(const CQChartsGeom::Point &p, Objs &objs) const
 
   PlotObjTree::DataList dataList;
 
-  static_cast<PlotObjTree *>(plotObjTree_)->dataAtPoint(p.x, p.y, dataList);
+  plotObjTree_->dataAtPoint(p.x, p.y, dataList);
+
+  for (const auto &drawObj : dataList) {
+    auto *obj = drawObj->obj;
 
-  for (const auto &obj : dataList) {
     if (! obj->isVisible())
       continue;
 
@@ -145,14 +192,14 @@ objectsIntersectRect(const CQChartsGeom::BBox &r, Objs &objs, bool inside) const
 {
   if (! waitTree()) return;
 
+  // get touching objects and let object check inside (object may contain multiple items)
   PlotObjTree::DataList dataList;
 
-  if (inside)
-    static_cast<PlotObjTree *>(plotObjTree_)->dataInsideRect(r, dataList);
-  else
-    static_cast<PlotObjTree *>(plotObjTree_)->dataTouchingRect(r, dataList);
+  plotObjTree_->dataTouchingRect(r, dataList);
+
+  for (const auto &drawObj : dataList) {
+    auto *obj = drawObj->obj;
 
-  for (const auto &obj : dataList) {
     if (! obj->isVisible())
       continue;
 
@@ -190,6 +237,47 @@ objectNearest(const CQChartsGeom::Point &p, double searchX, double searchY,
   return obj;
 }
 
+bool
+CQChartsPlotObjTree::
+objectsToDraw(const CQChartsGeom::BBox &r, Objs &objs) const
+{
+  // don't wait for tree to be built (caller draws all objects)
+  if (isBusy())
+    return false;
+
+  (void) waitTree();
+
+  // fail if plot objects have changed since tree was built
+  if (! valid_.load() || ! plotObjTree_ || interrupt_.load())
+    return false;
+
+  //---
+
+  PlotObjTree::DataList dataList;
+
+  plotObjTree_->dataTouchingRect(r, dataList);
+
+  std::vector<const DrawObj *> drawObjs;
+
+  drawObjs.reserve(dataList.size() + noRectDrawObjs_.size());
+
+  for (const auto &drawObj : dataList)
+    drawObjs.push_back(drawObj);
+
+  for (const auto &drawObj : noRectDrawObjs_)
+    drawObjs.push_back(&drawObj);
+
+  // restore draw order
+  std::sort(drawObjs.begin(), drawObjs.end(), [](const DrawObj *lhs, const DrawObj *rhs) {
+    return lhs->ind < rhs->ind;
+  });
+
+  for (const auto &drawObj : drawObjs)
+    objs.push_back(drawObj->obj);
+
+  return true;
+}
+
 CQChartsGeom::BBox
 CQChartsPlotObjTree::
 findEmptyBBox(double w, double h) const
@@ -197,9 +285,68 @@ findEmptyBBox(double w, double h) const
   if (! waitTree())
     return CQChartsGeom::BBox();
 
-  auto rect = plotObjTree_->fitRect(w, h);
+  const auto &range = plot_->dataRange();
+
+  CQChartsGeom::BBox bbox(range.xmin(), range.ymin(), range.xmax(), range.ymax());
+
+  double bw = bbox.getWidth ();
+  double bh = bbox.getHeight();
+
+  if (w <= 0.0 || h <= 0.0 || w > bw || h > bh)
+    return bbox;
+
+  //---
+
+  // check grid of candidate rects (half size steps) and use one which overlaps
+  // the least area of visible objects
+  int nx = std::min(int((bw - w)/(w/2.0)) + 1, 32);
+  int ny = std::min(int((bh - h)/(h/2.0)) + 1, 32);
+
+  double dx = (nx > 1 ? (bw - w)/(nx - 1) : 0.0);
+  double dy = (ny > 1 ? (bh - h)/(ny - 1) : 0.0);
+
+  CQChartsGeom::BBox minRect;
+  double             minArea { 0.0 };
+
+  PlotObjTree::DataList dataList;
+
+  for (int iy = 0; iy < ny; ++iy) {
+    double y1 = (ny > 1 ? bbox.getYMin() + iy*dy : bbox.getYMid() - h/2.0);
+
+    for (int ix = 0; ix < nx; ++ix) {
+      double x1 = (nx > 1 ? bbox.getXMin() + ix*dx : bbox.getXMid() - w/2.0);
+
+      CQChartsGeom::BBox rect(x1, y1, x1 + w, y1 + h);
+
+      plotObjTree_->dataTouchingRect(rect, dataList);
+
+      double area = 0.0;
+
+      for (const auto &drawObj : dataList) {
+        if (! drawObj->obj->isVisible())
+          continue;
+
+        const auto &r = drawObj->bbox;
+
+        double xo = std::max(0.0,
+          std::min(rect.getXMax(), r.getXMax()) - std::max(rect.getXMin(), r.getXMin()));
+        double yo = std::max(0.0,
+          std::min(rect.getYMax(), r.getYMax()) - std::max(rect.getYMin(), r.getYMin()));
+
+        area += xo*yo;
+      }
+
+      if (! minRect.isSet() || area < minArea) {
+        minRect = rect;
+        minArea = area;
+
+        if (minArea <= 0.0)
+          return minRect;
+      }
+    }
+  }
 
-  return rect;
+  return minRect;
 }
 
 void
@@ -0,0 +1,243 @@
+#include <CQChartsPolygonDecimator.h>
+#include <CMathUtil.h>
+#include <cmath>
+
+CQChartsPolygonDecimator::
+CQChartsPolygonDecimator(int maxLevels) :
+ maxLevels_(std::max(maxLevels, 1))
+{
+}
+
+void
+CQChartsPolygonDecimator::
+clear()
+{
+  levels_.clear();
+
+  numPoints_  = -1;
+  increasing_ = false;
+}
+
+const CQChartsPolygonDecimator::Polygon &
+CQChartsPolygonDecimator::
+decimate(const Polygon &poly, double scale, double offset)
+{
+  if (poly.size() != numPoints_)
+    initPoly(poly);
+
+  if (poly.size() < minPoints_ || scale == 0.0 || ! std::isfinite(scale) ||
+      ! std::isfinite(offset))
+    return poly;
+
+  // only fraction of offset changes pixel column grouping
+  double offset1 = offset - std::floor(offset);
+
+  auto offsetMatch = [&](double o1, double o2) {
+    double d = std::abs(o1 - o2);
+
+    return (d < 1E-3 || d > 1.0 - 1E-3);
+  };
+
+  ++age_;
+
+  // find cached level
+  for (auto &level : levels_) {
+    if (std::abs(level.scale - scale) <= 1E-9*std::abs(scale) &&
+        offsetMatch(level.offset, offset1)) {
+      level.age = age_;
+
+      return (level.full ? poly : level.poly);
+    }
+  }
+
+  //---
+
+  // add new level (replace least recently used)
+  Level *level = nullptr;
+
+  if (int(levels_.size()) < maxLevels_) {
+    levels_.emplace_back();
+
+    level = &levels_.back();
+  }
+  else {
+    for (auto &level1 : levels_) {
+      if (! level || level1.age < level->age)
+        level = &level1;
+    }
+  }
+
+  level->scale  = scale;
+  level->offset = offset1;
+  level->age    = age_;
+
+  calcLevel(poly, *level);
+
+  return (level->full ? poly : level->poly);
+}
+
+void
+CQChartsPolygonDecimator::
+initPoly(const Polygon &poly)
+{
+  levels_.clear();
+
+  numPoints_ = poly.size();
+
+  increasing_ = true;
+
+  for (int i = 0; i < numPoints_; ++i) {
+    double x = poly.qpoint(i).x();
+
+    if (CMathUtil::isNaN(x) || (i > 0 && x < poly.qpoint(i - 1).x())) {
+      increasing_ = false;
+      break;
+    }
+  }
+}
+
+void
+CQChartsPolygonDecimator::
+calcLevel(const Polygon &poly, Level &level) const
+{
+  int np = poly.size();
+
+  Bools keep(np, false);
+
+  //---
+
+  // current column data (first, last, min y and max y point indices)
+  bool   colSet { false };
+  double col    { 0.0 };
+  int    iFirst { 0 }, iLast { 0 }, iMin { 0 }, iMax { 0 };
+
+  auto flushColumn = [&]() {
+    if (! colSet) return;
+
+    keep[iFirst] = true;
+    keep[iLast ] = true;
+    keep[iMin  ] = true;
+    keep[iMax  ] = true;
+
+    colSet = false;
+  };
+
+  auto isBad = [](double r) {
+    return (CMathUtil::isNaN(r) || CMathUtil::isInf(r));
+  };
+
+  //---
+
+  // process runs of monotonic x (run end point starts next run)
+  int dir = 0;
+
+  for (int i = 0; i < np; ++i) {
+    const auto &p = poly.qpoint(i);
+
+    // always keep bad values (line breaks)
+    if (isBad(p.x()) || isBad(p.y())) {
+      flushColumn();
+
+      keep[i] = true;
+
+      dir = 0;
+
+      continue;
+    }
+
+    // check for change of x direction
+    if (i > 0) {
+      double dx = p.x() - poly.qpoint(i - 1).x();
+
+      int dir1 = (dx > 0 ? 1 : (dx < 0 ? -1 : 0));
+
+      if (dir1 != 0) {
+        if (dir != 0 && dir1 != dir) {
+          // end run at previous point
+          flushColumn();
+
+          keep[i - 1] = true;
+        }
+
+        dir = dir1;
+      }
+    }
+
+    //---
+
+    double col1 = std::floor(level.scale*p.x() + level.offset);
+
+    if (! colSet || col1 != col) {
+      flushColumn();
+
+      colSet = true;
+      col    = col1;
+      iFirst = i;
+      iMin   = i;
+      iMax   = i;
+    }
+    else {
+      if (p.y() < poly.qpoint(iMin).y()) iMin = i;
+      if (p.y() > poly.qpoint(iMax).y()) iMax = i;
+    }
+
+    iLast = i;
+  }
+
+  flushColumn();
+
+  //---
+
+  int nk = 0;
+
+  for (int i = 0; i < np; ++i)
+    if (keep[i]) ++nk;
+
+  // use full polygon if not worth decimating
+  level.full = (2*nk > np);
+
+  level.poly = Polygon();
+
+  if (level.full)
+    return;
+
+  for (int i = 0; i < np; ++i) {
+    if (keep[i])
+      level.poly.addPoint(poly.qpoint(i));
+  }
+}
+
+void
+CQChartsPolygonDecimator::
+xRange(const Polygon &poly, double xmin, double xmax, int &i1, int &i2) const
+{
+  int np = poly.size();
+
+  i1 = 0;
+  i2 = np - 1;
+
+  if (! increasing_ || np < 2)
+    return;
+
+  // first point >= xmin (include previous point for line to edge)
+  int l = 0, h = np;
+
+  while (l < h) {
+    int m = (l + h)/2;
+
+    if (poly.qpoint(m).x() < xmin) l = m + 1; else h = m;
+  }
+
+  i1 = std::max(l - 1, 0);
+
+  // first point > xmax (include it for line to edge)
+  l = i1; h = np;
+
+  while (l < h) {
+    int m = (l + h)/2;
+
+    if (poly.qpoint(m).x() <= xmax) l = m + 1; else h = m;
+  }
+
+  i2 = std::min(l, np - 1);
+}
@@ -1,6 +1,70 @@
 #include <CQChartsPolygonList.h>
 #include <CQPropertyView.h>
 
+#include <QDataStream>
+#include <cctype>
+
+namespace {
+
+// WKB geometry types
+const quint32 wkbPolygon      = 3;
+const quint32 wkbMultiPolygon = 6;
+
+bool readWKBPolygon(QDataStream &ds, CQChartsGeom::Polygons &polygons, bool multi) {
+  quint8 byteOrder;
+
+  ds >> byteOrder;
+
+  ds.setByteOrder(byteOrder ? QDataStream::LittleEndian : QDataStream::BigEndian);
+
+  quint32 type;
+
+  ds >> type;
+
+  if      (type == wkbMultiPolygon && ! multi) {
+    quint32 np;
+
+    ds >> np;
+
+    for (quint32 i = 0; i < np; ++i) {
+      if (! readWKBPolygon(ds, polygons, /*multi*/true))
+        return false;
+    }
+  }
+  else if (type == wkbPolygon) {
+    quint32 nr;
+
+    ds >> nr;
+
+    for (quint32 i = 0; i < nr; ++i) {
+      quint32 n;
+
+      ds >> n;
+
+      if (ds.status() != QDataStream::Ok || ds.device()->bytesAvailable() < qint64(n)*16)
+        return false;
+
+      QPolygonF qpoly(int(n));
+
+      for (quint32 j = 0; j < n; ++j) {
+        double x, y;
+
+        ds >> x >> y;
+
+        qpoly[j] = QPointF(x, y);
+      }
+
+      polygons.push_back(CQChartsGeom::Polygon(qpoly));
+    }
+  }
+  else
+    return false;
+
+  return (ds.status() == QDataStream::Ok);
+}
+
+}
+
 CQUTIL_DEF_META_TYPE(CQChartsPolygonList, toString, fromString)
 
 int CQChartsPolygonList::metaTypeId;
@@ -13,3 +77,39 @@ registerMetaType()
 
   CQPropertyViewMgrInst->setUserName("CQChartsPolygonList", "polygon_list");
 }
+
+bool
+CQChartsPolygonList::
+fromBinary(const QByteArray &ba)
+{
+  QDataStream ds(ba);
+
+  ds.setFloatingPointPrecision(QDataStream::DoublePrecision);
+
+  Polygons polygons;
+
+  if (! readWKBPolygon(ds, polygons, /*multi*/false) || ! ds.atEnd())
+    return false;
+
+  polygons_ = polygons;
+
+  return true;
+}
+
+bool
+CQChartsPolygonList::
+fromHexBinary(const QString &str)
+{
+  // at least byte order, type and count bytes, starting with byte order (0 or 1)
+  int len = str.length();
+
+  if (len < 18 || (len & 1) || str[0] != '0' || (str[1] != '0' && str[1] != '1'))
+    return false;
+
+  for (int i = 0; i < len; ++i) {
+    if (! isxdigit(str[i].toLatin1()))
+      return false;
+  }
+
+  return fromBinary(QByteArray::fromHex(str.toLatin1()));
+}
@@ -0,0 +1,154 @@
+#include <CQChartsPolygonPyramid.h>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+
+void
+CQChartsPolygonPyramid::
+init(const Polygon &poly, int minPoints)
+{
+  levels_.clear();
+
+  int n = poly.size();
+
+  minPoints = std::max(minPoints, 3);
+
+  if (n/2 < minPoints)
+    return;
+
+  //---
+
+  std::vector<double> areas;
+
+  calcPointAreas(poly, areas);
+
+  std::vector<double> sortedAreas = areas;
+
+  std::sort(sortedAreas.begin(), sortedAreas.end(), std::greater<double>());
+
+  //---
+
+  // each level keeps points with effective area larger than area of first removed point
+  int lastSize = n;
+
+  for (int k = n/2; k >= minPoints; k /= 2) {
+    double maxArea = sortedAreas[k];
+
+    Level level;
+
+    level.maxArea = maxArea;
+
+    for (int i = 0; i < n; ++i) {
+      if (areas[i] > maxArea)
+        level.poly.addPoint(poly.qpoint(i));
+    }
+
+    int size = level.poly.size();
+
+    if (size < 3)
+      break;
+
+    if (size == lastSize)
+      continue;
+
+    levels_.push_back(level);
+
+    lastSize = size;
+  }
+}
+
+const CQChartsPolygonPyramid::Polygon &
+CQChartsPolygonPyramid::
+simplified(const Polygon &poly, double areaTol) const
+{
+  for (int i = int(levels_.size()) - 1; i >= 0; --i) {
+    if (levels_[i].maxArea <= areaTol)
+      return levels_[i].poly;
+  }
+
+  return poly;
+}
+
+void
+CQChartsPolygonPyramid::
+calcPointAreas(const Polygon &poly, std::vector<double> &areas)
+{
+  int n = poly.size();
+
+  double maxArea = std::numeric_limits<double>::max();
+
+  areas.clear();
+  areas.resize(n, maxArea);
+
+  if (n <= 3)
+    return;
+
+  //---
+
+  // closed ring of remaining points
+  std::vector<int> prev(n), next(n);
+
+  for (int i = 0; i < n; ++i) {
+    prev[i] = (i > 0     ? i - 1 : n - 1);
+    next[i] = (i < n - 1 ? i + 1 : 0    );
+  }
+
+  auto triangleArea = [&](int i) {
+    const auto &p1 = poly.qpoint(prev[i]);
+    const auto &p2 = poly.qpoint(i);
+    const auto &p3 = poly.qpoint(next[i]);
+
+    return std::abs((p2.x() - p1.x())*(p3.y() - p1.y()) -
+                    (p3.x() - p1.x())*(p2.y() - p1.y()))/2.0;
+  };
+
+  //---
+
+  // remove point with smallest triangle area until three points remain
+  using AreaInd = std::pair<double,int>;
+  using AreaQ   = std::priority_queue<AreaInd, std::vector<AreaInd>, std::greater<AreaInd>>;
+
+  std::vector<double> pointArea(n);
+  std::vector<bool>   removed  (n, false);
+
+  AreaQ areaQ;
+
+  for (int i = 0; i < n; ++i) {
+    pointArea[i] = triangleArea(i);
+
+    areaQ.push(AreaInd(pointArea[i], i));
+  }
+
+  double lastArea  = 0.0;
+  int    remaining = n;
+
+  while (remaining > 3 && ! areaQ.empty()) {
+    auto ai = areaQ.top(); areaQ.pop();
+
+    int i = ai.second;
+
+    // skip removed or outdated entries
+    if (removed[i] || ai.first != pointArea[i])
+      continue;
+
+    // effective area never less than area of previously removed point
+    lastArea = std::max(lastArea, ai.first);
+
+    areas  [i] = lastArea;
+    removed[i] = true;
+
+    --remaining;
+
+    int i1 = prev[i];
+    int i2 = next[i];
+
+    next[i1] = i2;
+    prev[i2] = i1;
+
+    pointArea[i1] = triangleArea(i1); areaQ.push(AreaInd(pointArea[i1], i1));
+    pointArea[i2] = triangleArea(i2); areaQ.push(AreaInd(pointArea[i2], i2));
+  }
+}
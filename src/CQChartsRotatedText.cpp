@@ -2,6 +2,7 @@
 #include <CQChartsTextOptions.h>
 #include <CQChartsPaintDevice.h>
 #include <CQChartsUtil.h>
+#include <CQChartsTextCache.h>
 
 #include <cmath>
 
@@ -18,10 +19,12 @@ drawInBox(CQChartsPaintDevice *device, const CQChartsGeom::BBox &rect, const QSt
 
   //---
 
-  QFontMetricsF fm(device->font());
+  auto *textCache = CQChartsTextCacheInst;
 
-  double th = fm.height();
-  double tw = fm.width(text);
+  auto fontData = textCache->fontData(device->font());
+
+  double th = fontData.height;
+  double tw = textCache->textWidth(device->font(), text);
 
   //---
 
@@ -33,8 +36,8 @@ drawInBox(CQChartsPaintDevice *device, const CQChartsGeom::BBox &rect, const QSt
 
   //---
 
-  double ax = -s*fm.descent();
-  double ay =  c*fm.descent();
+  double ax = -s*fontData.descent;
+  double ay =  c*fontData.descent;
 
   //---
 
@@ -62,10 +65,10 @@ drawInBox(CQChartsPaintDevice *device, const CQChartsGeom::BBox &rect, const QSt
 
     //--
 
-    fm = QFontMetricsF(device->font());
+    fontData = textCache->fontData(device->font());
 
-    th = fm.height();
-    tw = fm.width(text);
+    th = fontData.height;
+    tw = textCache->textWidth(device->font(), text);
 
     dx = -tw/2.0;
     dy =  th/2.0;
@@ -73,8 +76,8 @@ drawInBox(CQChartsPaintDevice *device, const CQChartsGeom::BBox &rect, const QSt
     tx = c*dx - s*dy;
     ty = s*dx + c*dy;
 
-    ax = -s*fm.descent();
-    ay =  c*fm.descent();
+    ax = -s*fontData.descent;
+    ay =  c*fontData.descent;
   }
 
   //---
@@ -110,10 +113,12 @@ void
 draw(CQChartsPaintDevice *device, const CQChartsGeom::Point &p, const QString &text,
      const CQChartsTextOptions &options, bool alignBBox)
 {
-  QFontMetricsF fm(device->font());
+  auto *textCache = CQChartsTextCacheInst;
+
+  auto fontData = textCache->fontData(device->font());
 
-  double th = fm.height();
-  double tw = fm.width(text);
+  double th = fontData.height;
+  double tw = textCache->textWidth(device->font(), text);
 
   double a1 = CMathUtil::Deg2Rad(options.angle.value());
 
@@ -162,8 +167,8 @@ draw(CQChartsPaintDevice *device, const CQChartsGeom::Point &p, const QString &t
 
   //---
 
-  double ax = -s*fm.descent();
-  double ay =  c*fm.descent();
+  double ax = -s*fontData.descent;
+  double ay =  c*fontData.descent;
 
   //---
 
@@ -263,7 +268,9 @@ calcBBoxData(double x, double y, const QString &text, const QFont &font,
              const CQChartsTextOptions &options, const CQChartsGeom::Margin &border,
              CQChartsGeom::BBox &bbox, Points &points, bool alignBBox)
 {
-  QFontMetricsF fm(font);
+  auto *textCache = CQChartsTextCacheInst;
+
+  auto fontData = textCache->fontData(font);
 
   //------
 
@@ -272,8 +279,8 @@ calcBBoxData(double x, double y, const QString &text, const QFont &font,
   double ytm = border.top   ();
   double ybm = border.bottom();
 
-  double th = fm.height()    + xlm + xrm;
-  double tw = fm.width(text) + ybm + ytm;
+  double th = fontData.height                  + xlm + xrm;
+  double tw = textCache->textWidth(font, text) + ybm + ytm;
 
   double a1 = CMathUtil::Deg2Rad(options.angle.value());
 
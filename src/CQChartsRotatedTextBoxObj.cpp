@@ -2,6 +2,7 @@
 #include <CQChartsView.h>
 #include <CQChartsPlot.h>
 #include <CQChartsRotatedText.h>
+#include <CQChartsTextCache.h>
 
 CQChartsRotatedTextBoxObj::
 CQChartsRotatedTextBoxObj(CQChartsPlot *plot) :
@@ -18,9 +19,11 @@ draw(CQChartsPaintDevice *device, const CQChartsGeom::Point &center,
 
   setPainterFont(device, textFont());
 
-  QFontMetricsF fm(device->font());
+  auto *textCache = CQChartsTextCacheInst;
 
-  double tw = fm.width(text);
+  auto fontData = textCache->fontData(device->font());
+
+  double tw = textCache->textWidth(device->font(), text);
 
   // external margin
   double xlm = lengthPixelWidth (margin().left  ());
@@ -29,7 +32,7 @@ draw(CQChartsPaintDevice *device, const CQChartsGeom::Point &center,
   double ybm = lengthPixelHeight(margin().bottom());
 
   double tw1 = tw + xlm + xrm;
-  double th1 = fm.height() + ybm + ytm;
+  double th1 = fontData.height + ybm + ytm;
 
   auto pcenter = device->windowToPixel(center);
 
@@ -113,9 +116,11 @@ bbox(const CQChartsGeom::Point &center, const QString &text,
 {
   QFont font = calcFont(textFont());
 
-  QFontMetricsF fm(font);
+  auto *textCache = CQChartsTextCacheInst;
+
+  auto fontData = textCache->fontData(font);
 
-  double tw = fm.width(text);
+  double tw = textCache->textWidth(font, text);
 
   // external margin
   double xlm = lengthPixelWidth (margin().left  ());
@@ -124,7 +129,7 @@ bbox(const CQChartsGeom::Point &center, const QString &text,
   double ybm = lengthPixelHeight(margin().bottom());
 
   double tw1 = tw + xlm + xrm;
-  double th1 = fm.height() + ybm + ytm;
+  double th1 = fontData.height + ybm + ytm;
 
   double cx = center.x;
   double cy = center.y - th1/2;
@@ -230,6 +230,15 @@ setPlotType(PlotType type)
 
 //---
 
+void
+CQChartsScatterPlot::
+setPointBatchSize(int n)
+{
+  CQChartsUtil::testAndSet(pointBatchSize_, n, [&]() { updateObjs(); } );
+}
+
+//---
+
 void
 CQChartsScatterPlot::
 setSymbolMapKey(bool b)
@@ -392,7 +401,13 @@ void
 CQChartsScatterPlot::
 setDensityMap(bool b)
 {
-  CQChartsUtil::testAndSet(densityMapData_.visible, b, [&]() { drawObjs(); } );
+  CQChartsUtil::testAndSet(densityMapData_.visible, b, [&]() {
+    // density grids are calculated with objects
+    if (b && groupNameDensityGrid_.empty())
+      updateObjs();
+    else
+      drawObjs();
+  } );
 }
 
 void
@@ -490,7 +505,9 @@ addProperties()
   addProp("columns", "labelColumn", "label", "Label column");
 
   // options
-  addProp("options", "plotType", "plotType", "Plot type");
+  addProp("options", "plotType"      , "plotType"      , "Plot type");
+  addProp("options", "pointBatchSize", "pointBatchSize",
+          "Min number of set points to draw as single object (0 to disable)");
 
   //---
 
@@ -613,6 +630,9 @@ calcRange() const
     RowVisitor(const CQChartsScatterPlot *plot) :
      plot_(plot) {
       hasGroups_ = (plot_->numGroups() > 1);
+
+      xView_ = plot_->columnView(plot_->xColumn());
+      yView_ = plot_->columnView(plot_->yColumn());
     }
 
     State visit(const QAbstractItemModel *, const VisitData &data) override {
@@ -635,10 +655,10 @@ calcRange() const
 
         if      (plot_->xColumnType() == ColumnType::REAL ||
                  plot_->xColumnType() == ColumnType::INTEGER) {
-          okx = plot_->modelMappedReal(xModelInd, x, plot_->isLogX(), data.row);
+          okx = plot_->modelMappedReal(xView_, xModelInd, x, plot_->isLogX(), data.row);
         }
         else if (plot_->xColumnType() == ColumnType::TIME) {
-          x = plot_->modelReal(xModelInd, okx);
+          x = plot_->modelReal(xView_, xModelInd, okx);
         }
         else {
           x = uniqueId(data, plot_->xColumn()); ++uniqueX_;
@@ -648,10 +668,10 @@ calcRange() const
 
         if      (plot_->yColumnType() == ColumnType::REAL ||
                  plot_->yColumnType() == ColumnType::INTEGER) {
-          oky = plot_->modelMappedReal(yModelInd, y, plot_->isLogY(), data.row);
+          oky = plot_->modelMappedReal(yView_, yModelInd, y, plot_->isLogY(), data.row);
         }
         else if (plot_->yColumnType() == ColumnType::TIME) {
-          y = plot_->modelReal(yModelInd, oky);
+          y = plot_->modelReal(yView_, yModelInd, oky);
         }
         else {
           y = uniqueId(data, plot_->yColumn()); ++uniqueY_;
@@ -703,6 +723,8 @@ calcRange() const
    private:
     const CQChartsScatterPlot* plot_      { nullptr };
     int                        hasGroups_ { false };
+    ColumnViewP                xView_;
+    ColumnViewP                yView_;
     CQChartsGeom::Range        range_;
     CQChartsModelDetails*      details_   { nullptr };
     int                        uniqueX_   { 0 };
@@ -899,9 +921,10 @@ void
 CQChartsScatterPlot::
 clearPlotObjects()
 {
-  groupNameValues_  .clear();
-  groupNameGridData_.clear();
-  groupNameHexData_ .clear();
+  groupNameValues_     .clear();
+  groupNameGridData_   .clear();
+  groupNameHexData_    .clear();
+  groupNameDensityGrid_.clear();
 
   CQChartsPlot::clearPlotObjects();
 }
@@ -929,6 +952,21 @@ createObjs(PlotObjs &objs) const
   th->hexMap_.clear();
   th->hexMapMaxN_ = 0;
 
+  // values moved to point batches must be reloaded
+  auto hasBatchedValues = [&]() {
+    for (const auto &groupNameValue : groupNameValues_) {
+      for (const auto &nameValue : groupNameValue.second) {
+        if (nameValue.second.batched)
+          return true;
+      }
+    }
+
+    return false;
+  };
+
+  if (hasBatchedValues())
+    th->groupNameValues_.clear();
+
   if (groupNameValues_.empty())
     addNameValues();
 
@@ -950,6 +988,13 @@ createObjs(PlotObjs &objs) const
 
   //---
 
+  th->groupNameDensityGrid_.clear();
+
+  if (isDensityMap())
+    calcDensityMap();
+
+  //---
+
   addPointObjects(objs);
   addGridObjects (objs);
   addHexObjects  (objs);
@@ -1036,6 +1081,12 @@ addPointObjects(PlotObjs &objs) const
 
     //---
 
+    // per point data which needs individual point objects
+    bool pointData = (labelColumn().isValid() || imageColumn().isValid() ||
+                      symbolTypeColumn().isValid() || fontSizeColumn().isValid());
+
+    //---
+
     int is = 0;
     int ns = nameValues.size();
 
@@ -1049,11 +1100,61 @@ addPointObjects(PlotObjs &objs) const
 
       //---
 
-    //const QString &name   = nameValue.first;
+      const QString &name   = nameValue.first;
       const Values  &values = nameValue.second.values;
 
       int nv = values.size();
 
+      //---
+
+      // add large sets as single point batch object (batch holds the only copy of the
+      // point data, so set values are released except the first (used for key color))
+      if (! pointData && pointBatchSize() > 0 && nv >= pointBatchSize()) {
+        ColorInd is1(is, ns);
+        ColorInd ig1(ig, ng);
+
+        auto *batchObj = new CQChartsScatterPointBatchObj(this, groupInd, name, is1, ig1);
+
+        if (nameColumn().isValid())
+          batchObj->setPointName(name);
+
+        for (int iv = 0; iv < nv; ++iv) {
+          if (isInterrupt())
+            break;
+
+          const ValueData &valuePoint = values[iv];
+
+          // get optional symbol size
+          CQChartsLength symbolSize(CQChartsUnits::NONE, 0.0);
+
+          if (symbolSizeColumn().isValid()) {
+            if (! columnSymbolSize(valuePoint.row, valuePoint.ind.parent(), symbolSize))
+              symbolSize = CQChartsLength(CQChartsUnits::NONE, 0.0);
+          }
+
+          batchObj->addPoint(valuePoint.p, valuePoint.ind, symbolSize, valuePoint.color);
+        }
+
+        batchObj->endPoints();
+
+        objs.push_back(batchObj);
+
+        if (! isInterrupt()) {
+          auto &valuesData = const_cast<ValuesData &>(nameValue.second);
+
+          Values values1 { values[0] };
+
+          valuesData.values .swap(values1);
+          valuesData.batched = true;
+        }
+
+        ++is;
+
+        continue;
+      }
+
+      //---
+
       for (int iv = 0; iv < nv; ++iv) {
         if (isInterrupt())
           break;
@@ -1393,6 +1494,8 @@ addNameValues() const
    public:
     RowVisitor(const CQChartsScatterPlot *plot) :
      plot_(plot) {
+      xView_ = plot_->columnView(plot_->xColumn());
+      yView_ = plot_->columnView(plot_->yColumn());
     }
 
     State visit(const QAbstractItemModel *, const VisitData &data) override {
@@ -1415,10 +1518,10 @@ addNameValues() const
 
       if      (plot_->xColumnType() == ColumnType::REAL ||
                plot_->xColumnType() == ColumnType::INTEGER) {
-        okx = plot_->modelMappedReal(xModelInd, x, plot_->isLogX(), data.row);
+        okx = plot_->modelMappedReal(xView_, xModelInd, x, plot_->isLogX(), data.row);
       }
       else if (plot_->xColumnType() == ColumnType::TIME) {
-        x = plot_->modelReal(xModelInd, okx);
+        x = plot_->modelReal(xView_, xModelInd, okx);
       }
       else {
         x = uniqueId(data, plot_->xColumn());
@@ -1428,10 +1531,10 @@ addNameValues() const
 
       if      (plot_->yColumnType() == ColumnType::REAL ||
                plot_->yColumnType() == ColumnType::INTEGER) {
-        oky = plot_->modelMappedReal(yModelInd, y, plot_->isLogY(), data.row);
+        oky = plot_->modelMappedReal(yView_, yModelInd, y, plot_->isLogY(), data.row);
       }
       else if (plot_->yColumnType() == ColumnType::TIME) {
-        y = plot_->modelReal(yModelInd, oky);
+        y = plot_->modelReal(yView_, yModelInd, oky);
       }
       else {
         y = uniqueId(data, plot_->yColumn());
@@ -1510,6 +1613,8 @@ addNameValues() const
 
    private:
     const CQChartsScatterPlot* plot_    { nullptr };
+    ColumnViewP                xView_;
+    ColumnViewP                yView_;
     CQChartsModelDetails*      details_ { nullptr };
   };
 
@@ -1518,6 +1623,41 @@ addNameValues() const
   visitModel(visitor);
 }
 
+void
+CQChartsScatterPlot::
+calcDensityMap() const
+{
+  CQPerfTrace trace("CQChartsScatterPlot::calcDensityMap");
+
+  auto *th = const_cast<CQChartsScatterPlot *>(this);
+
+  CQChartsBivariateDensity::Values points;
+
+  for (const auto &groupNameValue : groupNameValues_) {
+    if (isInterrupt())
+      return;
+
+    int               groupInd   = groupNameValue.first;
+    const NameValues &nameValues = groupNameValue.second;
+
+    for (const auto &nameValue : nameValues) {
+      if (isInterrupt())
+        return;
+
+      const ValuesData &values = nameValue.second;
+
+      points.clear();
+
+      for (const auto &v : values.values)
+        points.push_back(v.p);
+
+      auto &grid = th->groupNameDensityGrid_[groupInd][nameValue.first];
+
+      CQChartsBivariateDensity::calcGrid(points, values.xrange, values.yrange, grid);
+    }
+  }
+}
+
 void
 CQChartsScatterPlot::
 addNameValue(int groupInd, const QString &name, const Point &p, int row,
@@ -1965,6 +2105,26 @@ execDrawForeground(CQChartsPaintDevice *device) const
     drawSymbolMapKey(device);
 }
 
+void
+CQChartsScatterPlot::
+getGroupPoints(int groupInd, Points &points) const
+{
+  auto p = groupPoints_.find(groupInd);
+
+  if (p != groupPoints_.end())
+    points = (*p).second;
+
+  // batched points are only stored in batch object
+  for (const auto &plotObj : plotObjects()) {
+    const auto *batchObj = dynamic_cast<CQChartsScatterPointBatchObj *>(plotObj);
+
+    if (batchObj && batchObj->groupInd() == groupInd) {
+      for (int i = 0; i < batchObj->numPoints(); ++i)
+        points.push_back(batchObj->point(i));
+    }
+  }
+}
+
 void
 CQChartsScatterPlot::
 initGroupBestFit(int groupInd) const
@@ -1975,11 +2135,11 @@ initGroupBestFit(int groupInd) const
   auto &fitData = th->groupFitData_[groupInd];
 
   if (! fitData.isFitted()) {
-    auto p = groupPoints_.find(groupInd);
+    Points points;
 
-    if (p != groupPoints_.end()) {
-      const Points &points = (*p).second;
+    getGroupPoints(groupInd, points);
 
+    if (! points.empty()) {
       if (! isBestFitOutliers()) {
         initGroupStats(groupInd);
 
@@ -2020,11 +2180,11 @@ initGroupStats(int groupInd) const
   StatData &statData = th->groupStatData_[groupInd];
 
   if (! statData.xstat.set || ! statData.ystat.set) {
-    auto p = groupPoints_.find(groupInd);
+    Points points;
 
-    if (p != groupPoints_.end()) {
-      const Points &points = (*p).second;
+    getGroupPoints(groupInd, points);
 
+    if (! points.empty()) {
       std::vector<double> x, y;
 
       for (std::size_t i = 0; i < points.size(); ++i) {
@@ -2193,9 +2353,9 @@ drawHull(CQChartsPaintDevice *device) const
 
       auto *hull = (*ph).second;
 
-      const Points &points = th->groupPoints_[groupInd];
+      Points points;
 
-      std::vector<double> x, y;
+      getGroupPoints(groupInd, points);
 
       for (const auto &p : points) {
         if (isInterrupt())
@@ -2238,12 +2398,16 @@ drawXRug(CQChartsPaintDevice *device) const
     if (isInterrupt())
       return;
 
-    auto *pointObj = dynamic_cast<CQChartsScatterPointObj *>(plotObj);
-    auto *cellObj  = dynamic_cast<CQChartsScatterCellObj  *>(plotObj);
+    auto *pointObj = dynamic_cast<CQChartsScatterPointObj      *>(plotObj);
+    auto *batchObj = dynamic_cast<CQChartsScatterPointBatchObj *>(plotObj);
+    auto *cellObj  = dynamic_cast<CQChartsScatterCellObj       *>(plotObj);
 
     if (pointObj)
       pointObj->drawDir(device, CQChartsScatterPointObj::Dir::X, xRugSide() == YSide::TOP);
 
+    if (batchObj)
+      batchObj->drawRug(device, CQChartsScatterPointObj::Dir::X, xRugSide() == YSide::TOP);
+
     if (cellObj)
       cellObj->drawRugSymbol(device, CQChartsScatterCellObj::Dir::X, xRugSide() == YSide::TOP);
   }
@@ -2257,12 +2421,16 @@ drawYRug(CQChartsPaintDevice *device) const
     if (isInterrupt())
       return;
 
-    auto *pointObj = dynamic_cast<CQChartsScatterPointObj *>(plotObj);
-    auto *cellObj  = dynamic_cast<CQChartsScatterCellObj  *>(plotObj);
+    auto *pointObj = dynamic_cast<CQChartsScatterPointObj      *>(plotObj);
+    auto *batchObj = dynamic_cast<CQChartsScatterPointBatchObj *>(plotObj);
+    auto *cellObj  = dynamic_cast<CQChartsScatterCellObj       *>(plotObj);
 
     if (pointObj)
       pointObj->drawDir(device, CQChartsScatterPointObj::Dir::Y, yRugSide() == XSide::RIGHT);
 
+    if (batchObj)
+      batchObj->drawRug(device, CQChartsScatterPointObj::Dir::Y, yRugSide() == XSide::RIGHT);
+
     if (cellObj)
       cellObj->drawRugSymbol(device, CQChartsScatterCellObj::Dir::Y, yRugSide() == XSide::RIGHT);
   }
@@ -2458,34 +2626,20 @@ drawDensityMap(CQChartsPaintDevice *device) const
 
   //---
 
+  // draw cached density grids (calculated with objects)
   CQChartsBivariateDensity density;
 
-  CQChartsBivariateDensity::Data data;
-
-  data.gridSize = densityMapGridSize();
-  data.delta    = densityMapDelta();
-
-  for (const auto &groupNameValue : groupNameValues_) {
+  for (const auto &groupNameGrid : groupNameDensityGrid_) {
     if (isInterrupt())
       return;
 
-    const NameValues &nameValues = groupNameValue.second;
+    const NameDensityGrid &nameGrids = groupNameGrid.second;
 
-    for (const auto &nameValue : nameValues) {
+    for (const auto &nameGrid : nameGrids) {
       if (isInterrupt())
         return;
 
-      const ValuesData &values = nameValue.second;
-
-      data.values.clear();
-
-      for (const auto &v : values.values)
-        data.values.push_back(v.p);
-
-      data.xrange = values.xrange;
-      data.yrange = values.yrange;
-
-      density.draw(this, device, data);
+      density.draw(this, device, nameGrid.second, densityMapGridSize(), densityMapDelta());
     }
   }
 
@@ -2697,13 +2851,21 @@ initWhiskerData() const
         if (isInterrupt())
           return;
 
-        const auto *pointObj = dynamic_cast<CQChartsScatterPointObj *>(plotObj);
+        const auto *pointObj = dynamic_cast<CQChartsScatterPointObj      *>(plotObj);
+        const auto *batchObj = dynamic_cast<CQChartsScatterPointBatchObj *>(plotObj);
 
         if (pointObj && pointObj->groupInd() == groupInd) {
           auto *whiskerData1 = const_cast<CQChartsXYBoxWhisker *>(whiskerData);
 
           whiskerData1->xWhisker.addValue(pointObj->point().x);
         }
+
+        if (batchObj && batchObj->groupInd() == groupInd) {
+          auto *whiskerData1 = const_cast<CQChartsXYBoxWhisker *>(whiskerData);
+
+          for (int i = 0; i < batchObj->numPoints(); ++i)
+            whiskerData1->xWhisker.addValue(batchObj->point(i).x);
+        }
       }
     }
 
@@ -2712,13 +2874,21 @@ initWhiskerData() const
         if (isInterrupt())
           return;
 
-        const auto *pointObj = dynamic_cast<CQChartsScatterPointObj *>(plotObj);
+        const auto *pointObj = dynamic_cast<CQChartsScatterPointObj      *>(plotObj);
+        const auto *batchObj = dynamic_cast<CQChartsScatterPointBatchObj *>(plotObj);
 
         if (pointObj && pointObj->groupInd() == groupInd) {
           auto *whiskerData1 = const_cast<CQChartsXYBoxWhisker *>(whiskerData);
 
           whiskerData1->yWhisker.addValue(pointObj->point().y);
         }
+
+        if (batchObj && batchObj->groupInd() == groupInd) {
+          auto *whiskerData1 = const_cast<CQChartsXYBoxWhisker *>(whiskerData);
+
+          for (int i = 0; i < batchObj->numPoints(); ++i)
+            whiskerData1->yWhisker.addValue(batchObj->point(i).y);
+        }
       }
     }
   }
@@ -2981,15 +3151,21 @@ calcTipId() const
   // get values for name (grouped id identical names)
   CQChartsScatterPlot::ValueData valuePoint;
 
-  auto pg = plot_->groupNameValues().find(groupInd_);
-  assert(pg != plot_->groupNameValues().end());
+  if (batch_) {
+    valuePoint.color = batch_->pointColor(batchInd_);
+  }
+  else {
+    auto pg = plot_->groupNameValues().find(groupInd_);
+    assert(pg != plot_->groupNameValues().end());
 
-  auto p = (*pg).second.find(name_);
+    auto p = (*pg).second.find(name_);
 
-  if (p != (*pg).second.end()) {
-    const auto &values = (*p).second.values;
+    if (p != (*pg).second.end()) {
+      const auto &values = (*p).second.values;
 
-    valuePoint = values[iv_.i];
+      if (iv_.i < int(values.size()))
+        valuePoint = values[iv_.i];
+    }
   }
 
   //---
@@ -3265,6 +3441,935 @@ yColorValue(bool relative) const
     return pos_.y;
 }
 
+//---
+
+bool
+CQChartsScatterPointObj::
+isSelected() const
+{
+  if (batch_)
+    return batch_->isPointSelected(batchInd_);
+
+  return CQChartsPlotObj::isSelected();
+}
+
+void
+CQChartsScatterPointObj::
+setSelected(bool b)
+{
+  if (batch_)
+    const_cast<CQChartsScatterPointBatchObj *>(batch_)->setPointSelected(batchInd_, b);
+  else
+    CQChartsPlotObj::setSelected(b);
+}
+
+//------
+
+CQChartsScatterPointBatchObj::
+CQChartsScatterPointBatchObj(const CQChartsScatterPlot *plot, int groupInd, const QString &name,
+                             const ColorInd &is, const ColorInd &ig) :
+ CQChartsPlotObj(const_cast<CQChartsScatterPlot *>(plot), CQChartsGeom::BBox(), is, ig),
+ plot_(plot), groupInd_(groupInd), name_(name)
+{
+  setDetailHint(DetailHint::MAJOR);
+}
+
+CQChartsScatterPointBatchObj::
+~CQChartsScatterPointBatchObj()
+{
+  for (auto &pointObj : pointObjs_)
+    delete pointObj.second;
+}
+
+void
+CQChartsScatterPointBatchObj::
+addPoint(const Point &p, const QModelIndex &ind, const CQChartsLength &symbolSize,
+         const CQChartsColor &color)
+{
+  int i = numPoints();
+
+  xs_  .push_back(p.x);
+  ys_  .push_back(p.y);
+  inds_.push_back(ind);
+
+  // symbol size (only stored if any point has size)
+  if (symbolSize.isValid()) {
+    if (sizes_.empty()) {
+      sizes_    .resize(i, -1.0);
+      sizeUnits_.resize(i, CQChartsUnits::NONE);
+    }
+
+    sizes_    .push_back(symbolSize.value());
+    sizeUnits_.push_back(symbolSize.units());
+
+    auto pm = maxSizes_.find(symbolSize.units());
+
+    if (pm == maxSizes_.end())
+      maxSizes_[symbolSize.units()] = symbolSize.value();
+    else
+      (*pm).second = std::max((*pm).second, symbolSize.value());
+  }
+  else {
+    if (! sizes_.empty()) {
+      sizes_    .push_back(-1.0);
+      sizeUnits_.push_back(CQChartsUnits::NONE);
+    }
+
+    defaultSize_ = true;
+  }
+
+  // color (only stored if any point has color)
+  if (color.isValid()) {
+    if (colorInds_.empty())
+      colorInds_.resize(i, -1);
+
+    auto pc = colorMap_.find(color);
+
+    if (pc == colorMap_.end()) {
+      pc = colorMap_.insert(pc, ColorMap::value_type(color, int(colors_.size())));
+
+      colors_.push_back(color);
+    }
+
+    colorInds_.push_back((*pc).second);
+  }
+  else if (! colorInds_.empty())
+    colorInds_.push_back(-1);
+}
+
+void
+CQChartsScatterPointBatchObj::
+endPoints()
+{
+  colorMap_.clear();
+
+  // bbox of points and symbols
+  double sx, sy;
+
+  maxSymbolSize(/*pixel*/false, sx, sy);
+
+  CQChartsGeom::BBox bbox;
+
+  int n = numPoints();
+
+  for (int i = 0; i < n; ++i)
+    bbox += Point(xs_[i], ys_[i]);
+
+  if (bbox.isSet())
+    bbox = CQChartsGeom::BBox(bbox.getXMin() - sx, bbox.getYMin() - sy,
+                              bbox.getXMax() + sx, bbox.getYMax() + sy);
+
+  setRect(bbox);
+}
+
+CQChartsLength
+CQChartsScatterPointBatchObj::
+pointSymbolSize(int i) const
+{
+  if (! sizes_.empty() && sizes_[i] >= 0.0)
+    return CQChartsLength(sizes_[i], sizeUnits_[i]);
+
+  return plot_->symbolSize();
+}
+
+CQChartsColor
+CQChartsScatterPointBatchObj::
+pointColor(int i) const
+{
+  if (! colorInds_.empty() && colorInds_[i] >= 0)
+    return colors_[colorInds_[i]];
+
+  return CQChartsColor();
+}
+
+QModelIndex
+CQChartsScatterPointBatchObj::
+pointModelInd(int i) const
+{
+  if (i < 0 || i >= numPoints()) return QModelIndex();
+
+  return inds_[i];
+}
+
+//---
+
+QString
+CQChartsScatterPointBatchObj::
+calcId() const
+{
+  return QString("%1:%2:%3").arg(typeName()).arg(is_.i).arg(ig_.i);
+}
+
+QString
+CQChartsScatterPointBatchObj::
+calcTipId() const
+{
+  CQChartsTableTip tableTip;
+
+  if (name_.length())
+    tableTip.addBoldLine(name_);
+
+  if (ig_.n > 1)
+    tableTip.addTableRow("Group", plot_->groupIndName(groupInd_));
+
+  tableTip.addTableRow("Points", numPoints());
+
+  return tableTip.str();
+}
+
+//---
+
+void
+CQChartsScatterPointBatchObj::
+initGrid() const
+{
+  if (grid_.valid)
+    return;
+
+  grid_.valid = true;
+
+  int n = numPoints();
+
+  for (int i = 0; i < n; ++i)
+    grid_.bbox += Point(xs_[i], ys_[i]);
+
+  // aim for a few points per cell
+  int nc = std::max(int(std::sqrt(n/4.0)), 1);
+
+  grid_.nx = std::min(nc, 1024);
+  grid_.ny = grid_.nx;
+
+  auto cellInd = [&](int i) {
+    int ix = 0, iy = 0;
+
+    if (grid_.bbox.getWidth() > 0.0)
+      ix = int((xs_[i] - grid_.bbox.getXMin())*grid_.nx/grid_.bbox.getWidth());
+
+    if (grid_.bbox.getHeight() > 0.0)
+      iy = int((ys_[i] - grid_.bbox.getYMin())*grid_.ny/grid_.bbox.getHeight());
+
+    ix = std::min(std::max(ix, 0), grid_.nx - 1);
+    iy = std::min(std::max(iy, 0), grid_.ny - 1);
+
+    return iy*grid_.nx + ix;
+  };
+
+  // count points per cell and convert to cell start indices
+  grid_.starts.clear();
+  grid_.starts.resize(grid_.nx*grid_.ny + 1, 0);
+
+  for (int i = 0; i < n; ++i)
+    ++grid_.starts[cellInd(i) + 1];
+
+  for (int c = 0; c < grid_.nx*grid_.ny; ++c)
+    grid_.starts[c + 1] += grid_.starts[c];
+
+  // fill point indices for each cell
+  Ints pos(grid_.starts.begin(), grid_.starts.end() - 1);
+
+  grid_.inds.resize(n);
+
+  for (int i = 0; i < n; ++i)
+    grid_.inds[pos[cellInd(i)]++] = i;
+}
+
+void
+CQChartsScatterPointBatchObj::
+gridPoints(const CQChartsGeom::BBox &r, const PointFn &fn) const
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  initGrid();
+
+  if (! grid_.bbox.isSet() || ! r.overlaps(grid_.bbox))
+    return;
+
+  auto xcell = [&](double x) {
+    int ix = 0;
+
+    if (grid_.bbox.getWidth() > 0.0)
+      ix = int((x - grid_.bbox.getXMin())*grid_.nx/grid_.bbox.getWidth());
+
+    return std::min(std::max(ix, 0), grid_.nx - 1);
+  };
+
+  auto ycell = [&](double y) {
+    int iy = 0;
+
+    if (grid_.bbox.getHeight() > 0.0)
+      iy = int((y - grid_.bbox.getYMin())*grid_.ny/grid_.bbox.getHeight());
+
+    return std::min(std::max(iy, 0), grid_.ny - 1);
+  };
+
+  int ix1 = xcell(r.getXMin()), ix2 = xcell(r.getXMax());
+  int iy1 = ycell(r.getYMin()), iy2 = ycell(r.getYMax());
+
+  for (int iy = iy1; iy <= iy2; ++iy) {
+    for (int ix = ix1; ix <= ix2; ++ix) {
+      int c = iy*grid_.nx + ix;
+
+      for (int j = grid_.starts[c]; j < grid_.starts[c + 1]; ++j)
+        fn(grid_.inds[j]);
+    }
+  }
+}
+
+void
+CQChartsScatterPointBatchObj::
+maxSymbolSize(bool pixel, double &sx, double &sy) const
+{
+  // max symbol size of all size units (points can have different units)
+  sx = 0.0;
+  sy = 0.0;
+
+  auto addSize = [&](const CQChartsLength &size) {
+    double sx1, sy1;
+
+    if (pixel)
+      plot_->pixelSymbolSize(size, sx1, sy1);
+    else
+      plot_->plotSymbolSize(size, sx1, sy1);
+
+    sx = std::max(sx, std::abs(sx1));
+    sy = std::max(sy, std::abs(sy1));
+  };
+
+  if (defaultSize_)
+    addSize(plot_->symbolSize());
+
+  for (const auto &pm : maxSizes_)
+    addSize(CQChartsLength(pm.second, pm.first));
+}
+
+void
+CQChartsScatterPointBatchObj::
+symbolWindowSize(double &dx, double &dy) const
+{
+  // max symbol size in window units
+  double sx, sy;
+
+  maxSymbolSize(/*pixel*/true, sx, sy);
+
+  dx = std::abs(plot_->pixelToWindowWidth (sx));
+  dy = std::abs(plot_->pixelToWindowHeight(sy));
+}
+
+int
+CQChartsScatterPointBatchObj::
+pointAt(const Point &p) const
+{
+  if (! isVisible())
+    return -1;
+
+  double dx, dy;
+
+  symbolWindowSize(dx, dy);
+
+  CQChartsGeom::BBox bbox(p.x - dx, p.y - dy, p.x + dx, p.y + dy);
+
+  auto pp = plot_->windowToPixel(p);
+
+  // find nearest point whose symbol contains point
+  int    ind = -1;
+  double d   = 0.0;
+
+  gridPoints(bbox, [&](int i) {
+    double sx, sy;
+
+    plot_->pixelSymbolSize(pointSymbolSize(i), sx, sy);
+
+    auto p1 = plot_->windowToPixel(Point(xs_[i], ys_[i]));
+
+    CQChartsGeom::BBox pbbox(p1.x - sx, p1.y - sy, p1.x + sx, p1.y + sy);
+
+    if (! pbbox.inside(pp))
+      return;
+
+    double d1 = std::hypot(p1.x - pp.x, p1.y - pp.y);
+
+    if (ind < 0 || d1 < d) {
+      ind = i;
+      d   = d1;
+    }
+  });
+
+  return ind;
+}
+
+bool
+CQChartsScatterPointBatchObj::
+pointInRect(int i, const CQChartsGeom::BBox &r, bool inside) const
+{
+  double sx, sy;
+
+  plot_->plotSymbolSize(pointSymbolSize(i), sx, sy);
+
+  CQChartsGeom::BBox pbbox(xs_[i] - sx, ys_[i] - sy, xs_[i] + sx, ys_[i] + sy);
+
+  if (inside)
+    return r.inside(pbbox);
+  else
+    return r.overlaps(pbbox);
+}
+
+bool
+CQChartsScatterPointBatchObj::
+inside(const Point &p) const
+{
+  return (pointAt(p) >= 0);
+}
+
+bool
+CQChartsScatterPointBatchObj::
+rectIntersect(const CQChartsGeom::BBox &r, bool inside) const
+{
+  if (! isVisible())
+    return false;
+
+  double dx, dy;
+
+  symbolWindowSize(dx, dy);
+
+  CQChartsGeom::BBox r1(r.getXMin() - dx, r.getYMin() - dy, r.getXMax() + dx, r.getYMax() + dy);
+
+  bool found = false;
+
+  gridPoints(r1, [&](int i) {
+    if (! found && pointInRect(i, r, inside))
+      found = true;
+  });
+
+  return found;
+}
+
+CQChartsPlotObj *
+CQChartsScatterPointBatchObj::
+detailObjAt(const Point &p) const
+{
+  int i = pointAt(p);
+
+  return (i >= 0 ? pointObj(i) : nullptr);
+}
+
+CQChartsScatterPointObj *
+CQChartsScatterPointBatchObj::
+pointObj(int i) const
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  auto p = pointObjs_.find(i);
+
+  if (p == pointObjs_.end()) {
+    auto pos        = this->point(i);
+    auto symbolSize = pointSymbolSize(i);
+
+    double sx, sy;
+
+    plot_->plotSymbolSize(symbolSize, sx, sy);
+
+    CQChartsGeom::BBox bbox(pos.x - sx, pos.y - sy, pos.x + sx, pos.y + sy);
+
+    auto *pointObj =
+      new CQChartsScatterPointObj(plot_, groupInd_, bbox, pos, is_, ig_, ColorInd(i, numPoints()));
+
+    pointObj->setModelInd(pointModelInd(i));
+
+    if (! sizes_.empty() && sizes_[i] >= 0.0)
+      pointObj->setSymbolSize(symbolSize);
+
+    auto color = pointColor(i);
+
+    if (color.isValid())
+      pointObj->setColor(color);
+
+    if (pointName_.length())
+      pointObj->setName(pointName_);
+
+    pointObj->setBatch(this, i);
+
+    p = pointObjs_.insert(p, PointObjs::value_type(i, pointObj));
+  }
+
+  return (*p).second;
+}
+
+//---
+
+void
+CQChartsScatterPointBatchObj::
+setSelectRect(const CQChartsGeom::BBox &r, bool inside)
+{
+  selectRect_   = r;
+  selectInside_ = inside;
+
+  selectInds_.clear();
+}
+
+void
+CQChartsScatterPointBatchObj::
+setSelectIndices(const Indices &inds)
+{
+  selectInds_ = inds;
+
+  selectRect_ = CQChartsGeom::BBox();
+}
+
+void
+CQChartsScatterPointBatchObj::
+subsetPoints(const PointFn &fn) const
+{
+  // points in pending select rect
+  if      (selectRect_.isSet()) {
+    double dx, dy;
+
+    symbolWindowSize(dx, dy);
+
+    CQChartsGeom::BBox r1(selectRect_.getXMin() - dx, selectRect_.getYMin() - dy,
+                          selectRect_.getXMax() + dx, selectRect_.getYMax() + dy);
+
+    gridPoints(r1, [&](int i) {
+      if (pointInRect(i, selectRect_, selectInside_))
+        fn(i);
+    });
+  }
+  // points with pending select model indices
+  else if (! selectInds_.empty()) {
+    int n = numPoints();
+
+    for (int i = 0; i < n; ++i) {
+      Indices inds;
+
+      addPointSelectIndices(i, inds);
+
+      for (const auto &ind : inds) {
+        if (selectInds_.find(ind) != selectInds_.end()) {
+          fn(i);
+          break;
+        }
+      }
+    }
+  }
+}
+
+bool
+CQChartsScatterPointBatchObj::
+isSelected() const
+{
+  if (! selectRect_.isSet() && selectInds_.empty())
+    return (numSelected_ > 0);
+
+  // subset is selected if all its points are selected
+  bool allSelected = true;
+  bool anyPoints   = false;
+
+  subsetPoints([&](int i) {
+    anyPoints = true;
+
+    if (! isPointSelected(i))
+      allSelected = false;
+  });
+
+  return (anyPoints && allSelected);
+}
+
+void
+CQChartsScatterPointBatchObj::
+setSelected(bool b)
+{
+  // change selection of pending subset points
+  if (selectRect_.isSet() || ! selectInds_.empty()) {
+    subsetPoints([&](int i) { setPointSelected(i, b); });
+  }
+  // change selection of all points
+  else if (b) {
+    int n = numPoints();
+
+    for (int i = 0; i < n; ++i)
+      setPointSelected(i, true);
+  }
+  else {
+    selected_.clear();
+
+    numSelected_ = 0;
+  }
+
+  selectRect_ = CQChartsGeom::BBox();
+
+  selectInds_.clear();
+
+  dataInvalidate();
+}
+
+void
+CQChartsScatterPointBatchObj::
+setPointSelected(int i, bool b)
+{
+  if (selected_.empty()) {
+    if (! b) return;
+
+    selected_.resize(numPoints(), false);
+  }
+
+  if (selected_[i] == b)
+    return;
+
+  selected_[i] = b;
+
+  numSelected_ += (b ? 1 : -1);
+}
+
+bool
+CQChartsScatterPointBatchObj::
+isInside() const
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  for (const auto &pointObj : pointObjs_) {
+    if (pointObj.second->isInside())
+      return true;
+  }
+
+  return false;
+}
+
+void
+CQChartsScatterPointBatchObj::
+setInside(bool b)
+{
+  CQChartsPlotObj::setInside(b);
+
+  if (! b) {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    for (auto &pointObj : pointObjs_)
+      pointObj.second->setInside(false);
+  }
+}
+
+void
+CQChartsScatterPointBatchObj::
+getSelectIndices(Indices &inds) const
+{
+  // indices of all points (for model to plot selection lookup)
+  int n = numPoints();
+
+  for (int i = 0; i < n; ++i)
+    addPointSelectIndices(i, inds);
+}
+
+void
+CQChartsScatterPointBatchObj::
+addSelectIndices()
+{
+  // only add indices of selected points
+  if (! numSelected_)
+    return;
+
+  Indices inds;
+
+  int n = numPoints();
+
+  for (int i = 0; i < n; ++i) {
+    if (selected_[i])
+      addPointSelectIndices(i, inds);
+  }
+
+  for (const auto &ind : inds)
+    plot()->addSelectIndex(ind);
+}
+
+void
+CQChartsScatterPointBatchObj::
+addPointSelectIndices(int i, Indices &inds) const
+{
+  auto ind = pointModelInd(i);
+  if (! ind.isValid()) return;
+
+  auto addColumnPointIndex = [&](const CQChartsColumn &column) {
+    if (column.isValid())
+      addSelectIndex(inds, ind.row(), column, ind.parent());
+  };
+
+  addColumnPointIndex(plot_->xColumn());
+  addColumnPointIndex(plot_->yColumn());
+
+  addColumnPointIndex(plot_->symbolSizeColumn());
+  addColumnPointIndex(plot_->colorColumn     ());
+}
+
+//---
+
+void
+CQChartsScatterPointBatchObj::
+draw(CQChartsPaintDevice *device)
+{
+  auto *view = plot_->view();
+
+  bool updateState  = device->isInteractive();
+  bool bufferLayers = view->isBufferLayers();
+
+  bool selectLayer = (bufferLayers && view->drawLayerType() == CQChartsLayer::Type::SELECTION);
+  bool overLayer   = (bufferLayers && view->drawLayerType() == CQChartsLayer::Type::MOUSE_OVER);
+
+  //---
+
+  // draw points (point objects are drawn separately)
+  // (mouse over layer only draws inside point objects)
+  if (! overLayer) {
+    const auto *dataLabel = plot_->dataLabel();
+
+    bool drawLabels = (dataLabel->isVisible() && pointName_.length());
+
+    auto symbolType = plot_->symbolType();
+
+    // only draw points in display range
+    double dx, dy;
+
+    symbolWindowSize(dx, dy);
+
+    auto dbbox = plot_->displayRangeBBox();
+
+    CQChartsGeom::BBox dbbox1(dbbox.getXMin() - dx, dbbox.getYMin() - dy,
+                              dbbox.getXMax() + dx, dbbox.getYMax() + dy);
+
+    std::set<int> objInds;
+
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+
+      for (const auto &pointObj : pointObjs_)
+        objInds.insert(pointObj.first);
+    }
+
+    //---
+
+    device->setColorNames();
+
+    // only update pen and brush when point color or state changes
+    CQChartsPenBrush penBrush;
+
+    ColorInd lastColorInd;
+    int      lastColor    { -2 };
+    bool     lastSelected { false };
+    bool     penBrushSet  { false };
+
+    int n = numPoints();
+
+    for (int i = 0; i < n; ++i) {
+      bool pointSelected = isPointSelected(i);
+
+      if (selectLayer && ! pointSelected)
+        continue;
+
+      if (! objInds.empty() && objInds.find(i) != objInds.end())
+        continue;
+
+      Point p(xs_[i], ys_[i]);
+
+      if (! dbbox1.inside(p))
+        continue;
+
+      //---
+
+      bool selected = (updateState && pointSelected && (! bufferLayers || selectLayer));
+
+      auto ic = pointColorInd(i);
+      int  ci = (! colorInds_.empty() ? colorInds_[i] : -1);
+
+      if (! penBrushSet || ! (ic == lastColorInd) || ci != lastColor || selected != lastSelected) {
+        calcPointPenBrush(i, penBrush, selected);
+
+        CQChartsDrawUtil::setPenBrush(device, penBrush);
+
+        lastColorInd = ic;
+        lastColor    = ci;
+        lastSelected = selected;
+        penBrushSet  = true;
+      }
+
+      auto symbolSize = pointSymbolSize(i);
+
+      plot_->drawSymbol(device, p, symbolType, symbolSize);
+
+      //---
+
+      // draw label (set name)
+      if (drawLabels) {
+        QPen tpen;
+
+        QColor tc = dataLabel->interpTextColor(ic);
+
+        plot_->setPen(tpen, true, tc, dataLabel->textAlpha());
+
+        double sx, sy;
+
+        plot_->pixelSymbolSize(symbolSize, sx, sy);
+
+        auto ps = plot_->windowToPixel(p);
+
+        CQChartsGeom::BBox ptbbox(ps.x - sx, ps.y - sy, ps.x + sx, ps.y + sy);
+
+        dataLabel->draw(device, plot_->pixelToWindow(ptbbox), pointName_,
+                        dataLabel->position(), tpen);
+
+        penBrushSet = false;
+      }
+    }
+
+    device->resetColorNames();
+  }
+
+  //---
+
+  // draw on demand point objects (using their selected/inside state)
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  for (const auto &po : pointObjs_) {
+    auto *pointObj = po.second;
+
+    if (selectLayer && ! pointObj->isSelected())
+      continue;
+
+    if (overLayer && ! pointObj->isInside())
+      continue;
+
+    pointObj->drawDir(device, Dir::XY);
+  }
+}
+
+void
+CQChartsScatterPointBatchObj::
+drawRug(CQChartsPaintDevice *device, const Dir &dir, bool flip) const
+{
+  bool selectState = (device->isInteractive() && ! plot_->view()->isBufferLayers());
+
+  // get symbol type and size
+  auto symbolType = plot_->rugSymbolType();
+  auto symbolSize = plot_->rugSymbolSize();
+
+  if (symbolType == CQChartsSymbol::Type::NONE)
+    symbolType = (dir == Dir::X ? CQChartsSymbol::Type::VLINE : CQChartsSymbol::Type::HLINE);
+
+  double sx, sy;
+
+  plot_->pixelSymbolSize(symbolSize, sx, sy);
+
+  auto pbbox = plot_->calcDataPixelRect();
+
+  //---
+
+  device->setColorNames();
+
+  CQChartsPenBrush penBrush;
+
+  ColorInd lastColorInd;
+  int      lastColor    { -2 };
+  bool     lastSelected { false };
+  bool     penBrushSet  { false };
+
+  int n = numPoints();
+
+  for (int i = 0; i < n; ++i) {
+    bool selected = (selectState && isPointSelected(i));
+
+    auto ic = pointColorInd(i);
+    int  ci = (! colorInds_.empty() ? colorInds_[i] : -1);
+
+    if (! penBrushSet || ! (ic == lastColorInd) || ci != lastColor || selected != lastSelected) {
+      calcPointPenBrush(i, penBrush, selected);
+
+      CQChartsDrawUtil::setPenBrush(device, penBrush);
+
+      lastColorInd = ic;
+      lastColor    = ci;
+      lastSelected = selected;
+      penBrushSet  = true;
+    }
+
+    //---
+
+    // move point to rug side
+    auto ps = plot_->windowToPixel(Point(xs_[i], ys_[i]));
+
+    if (dir == Dir::X) {
+      if (! flip)
+        ps.setY(pbbox.getYMax() + sy);
+      else
+        ps.setY(pbbox.getYMin() - sy);
+    }
+    else {
+      if (! flip)
+        ps.setX(pbbox.getXMin() - sx);
+      else
+        ps.setX(pbbox.getXMax() + sx);
+    }
+
+    plot_->drawSymbol(device, plot_->pixelToWindow(ps), symbolType, symbolSize);
+  }
+
+  device->resetColorNames();
+}
+
+CQChartsPlotObj::ColorInd
+CQChartsScatterPointBatchObj::
+pointColorInd(int i) const
+{
+  // x/y color values use point position
+  return plot_->calcColorInd(this, nullptr, is_, ig_, ColorInd(i, numPoints()), point(i));
+}
+
+void
+CQChartsScatterPointBatchObj::
+calcPointPenBrush(int i, CQChartsPenBrush &penBrush, bool selected) const
+{
+  auto ic = pointColorInd(i);
+
+  plot_->setSymbolPenBrush(penBrush, ic);
+
+  // override symbol fill color for custom color
+  auto color = pointColor(i);
+
+  if (color.isValid()) {
+    QColor c = plot_->interpColor(color, ic);
+
+    c.setAlphaF(plot_->symbolFillAlpha().value());
+
+    penBrush.brush.setColor(c);
+  }
+
+  if (selected)
+    plot_->view()->updateSelectedObjPenBrushState(ic, penBrush, CQChartsPlot::DrawType::SYMBOL);
+}
+
+double
+CQChartsScatterPointBatchObj::
+xColorValue(bool relative) const
+{
+  double x = rect().getXMid();
+
+  const auto &dataRange = plot_->dataRange();
+
+  if (relative)
+    return CMathUtil::map(x, dataRange.xmin(), dataRange.xmax(), 0.0, 1.0);
+  else
+    return x;
+}
+
+double
+CQChartsScatterPointBatchObj::
+yColorValue(bool relative) const
+{
+  double y = rect().getYMid();
+
+  const auto &dataRange = plot_->dataRange();
+
+  if (relative)
+    return CMathUtil::map(y, dataRange.ymin(), dataRange.ymax(), 0.0, 1.0);
+  else
+    return y;
+}
+
 //------
 
 CQChartsScatterCellObj::
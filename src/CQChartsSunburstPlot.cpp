@@ -6,6 +6,7 @@
 #include <CQChartsTip.h>
 #include <CQChartsPaintDevice.h>
 #include <CQChartsHtml.h>
+#include <CQChartsHierBuilder.h>
 
 #include <CQPropertyViewItem.h>
 #include <CQPerfMonitor.h>
@@ -620,8 +621,9 @@ loadFlat(CQChartsSunburstHierNode *root) const
 {
   class RowVisitor : public ModelVisitor {
    public:
-    RowVisitor(const CQChartsSunburstPlot *plot, CQChartsSunburstHierNode *root) :
-     plot_(plot), root_(root) {
+    RowVisitor(const CQChartsSunburstPlot *plot, CQChartsHierBuilder &builder,
+               FlatRows &flatRows) :
+     plot_(plot), builder_(builder), flatRows_(flatRows) {
     }
 
     State visit(const QAbstractItemModel *, const VisitData &data) override {
@@ -632,151 +634,130 @@ loadFlat(CQChartsSunburstHierNode *root) const
                                       plot_->separator(), nameStrs, nameInds))
         return State::SKIP;
 
-      QModelIndex nameInd1 = plot_->normalizeIndex(nameInds[0]);
+      // multiple roots need hier name
+      if (plot_->isMultiRoot() && nameStrs.length() < 2)
+        return State::SKIP;
+
+      FlatRowData flatRow;
+
+      flatRow.nameInd = plot_->normalizeIndex(nameInds[0]);
+      flatRow.ind     = flatRow.nameInd;
 
       //---
 
       double size = 1.0;
 
-      QModelIndex valueInd;
-
       if (plot_->valueColumn().isValid()) {
         CQChartsModelIndex valueModelInd(data.row, plot_->valueColumn(), data.parent);
 
-        valueInd = plot_->modelIndex(valueModelInd);
+        QModelIndex valueInd = plot_->modelIndex(valueModelInd);
 
         if (! plot_->getValueSize(valueModelInd, size))
           return State::SKIP;
 
         if (size == 0.0)
           return State::SKIP;
+
+        if (valueInd.isValid())
+          flatRow.ind = plot_->normalizeIndex(valueInd);
       }
 
       //---
 
-      auto node = plot_->addNode(root_, nameStrs, size, nameInd1, valueInd);
-
-      if (node && plot_->colorColumn().isValid()) {
+      if (plot_->colorColumn().isValid()) {
         CQChartsColor color;
 
         CQChartsModelIndex colorInd(data.row, plot_->colorColumn(), data.parent);
 
         if (plot_->modelIndexColor(colorInd, color))
-          node->setColor(color);
+          flatRow.color = color;
       }
 
-      return State::OK;
-    }
+      //---
+
+      if (builder_.addRow(nameStrs, size) < 0)
+        return State::SKIP;
 
-  private:
-    State addDataError(const CQChartsModelIndex &ind, const QString &msg) const {
-      const_cast<CQChartsSunburstPlot *>(plot_)->addDataError(ind, msg);
-      return State::SKIP;
+      flatRows_.push_back(flatRow);
+
+      return State::OK;
     }
 
    private:
     const CQChartsSunburstPlot *plot_ { nullptr };
-    CQChartsSunburstHierNode   *root_ { nullptr };
+    CQChartsHierBuilder        &builder_;
+    FlatRows                   &flatRows_;
   };
 
-  RowVisitor visitor(this, root);
+  CQChartsHierBuilder builder;
+  FlatRows            flatRows;
+
+  RowVisitor visitor(this, builder, flatRows);
 
   visitModel(visitor);
 
   //---
 
-  for (auto &root : roots_)
-    addExtraNodes(root);
-}
+  builder.build();
 
-CQChartsSunburstNode *
-CQChartsSunburstPlot::
-addNode(CQChartsSunburstHierNode *root, const QStringList &nameStrs, double size,
-        const QModelIndex &nameInd, const QModelIndex &valueInd) const
-{
-  auto *parent = root;
-
-  for (int i = 0; i < nameStrs.length() - 1; ++i) {
-    CQChartsSunburstHierNode *child = nullptr;
-
-    if (i == 0 && isMultiRoot()) {
-      auto *root = rootNode(nameStrs[i]);
-
-      if (! root) {
-        auto *th = const_cast<CQChartsSunburstPlot *>(this);
+  if (! root) {
+    // top level hier nodes are roots
+    auto *th = const_cast<CQChartsSunburstPlot *>(this);
 
-        root = th->createRootNode(nameStrs[i]);
+    for (const auto &c : builder.hierChildren(builder.root())) {
+      auto *root1 = th->createRootNode(builder.nodeName(c));
 
-        root->setInd(nameInd);
-      }
+      root1->setInd(flatRows[builder.node(c).hierRow].nameInd);
 
-      child = root;
+      addFlatNodes(builder, flatRows, c, root1);
     }
-    else {
-      child = childHierNode(parent, nameStrs[i]);
-
-      if (! child) {
-        // remove any existing leaf node (save size to use in new hier node)
-        QModelIndex nameInd1;
-        double      size1 = 0.0;
-
-        auto *node = childNode(parent, nameStrs[i]);
-
-        if (node) {
-          nameInd1 = node->ind();
-          size1    = node->size();
+  }
+  else
+    addFlatNodes(builder, flatRows, builder.root(), root);
 
-          parent->removeNode(node);
+  //---
 
-          delete node;
-        }
+  for (auto &root : roots_)
+    addExtraNodes(root);
+}
 
-        //---
+void
+CQChartsSunburstPlot::
+addFlatNodes(const CQChartsHierBuilder &builder, const FlatRows &flatRows, int ind,
+             CQChartsSunburstHierNode *parent) const
+{
+  // add hier nodes (own size of hier node is added as filler node by addExtraNodes)
+  for (const auto &c : builder.hierChildren(ind)) {
+    auto *child = new CQChartsSunburstHierNode(this, parent, builder.nodeName(c));
 
-        child = new CQChartsSunburstHierNode(this, parent, nameStrs[i]);
+    child->setSize(builder.hierNodeSize(c));
 
-        child->setSize(size1);
+    int leafRow = builder.hierLeafRow(c);
 
-        child->setInd(nameInd1);
-      }
-    }
+    if (leafRow >= 0)
+      child->setInd(flatRows[leafRow].ind);
 
-    parent = child;
+    addFlatNodes(builder, flatRows, c, child);
   }
 
-  //---
+  // add leaf nodes (first row defines node, last valid row color is used)
+  for (const auto &c : builder.leafChildren(ind)) {
+    const auto &leafNode = builder.node(c);
 
-  QString name = nameStrs[nameStrs.length() - 1];
+    int r = leafNode.leafRows.front();
 
-  auto *node = childNode(parent, name);
+    auto *node = new CQChartsSunburstNode(this, parent, builder.nodeName(c));
 
-  if (! node) {
-    // use hier node if already created
-    auto *child = childHierNode(parent, name);
+    node->setSize(builder.rowSize(r));
+    node->setInd (flatRows[r].ind);
 
-    if (child) {
-      child->setSize(size);
-      return nullptr;
+    for (const auto &r1 : leafNode.leafRows) {
+      if (flatRows[r1].color.isValid())
+        node->setColor(flatRows[r1].color);
     }
 
-    //---
-
-    node = new CQChartsSunburstNode(this, parent, name);
-
-    node->setSize(size);
-
-    if (valueInd.isValid()) {
-      QModelIndex valueInd1 = normalizeIndex(valueInd);
-
-      node->setInd(valueInd1);
-    }
-    else
-      node->setInd(nameInd);
-
     parent->addNode(node);
   }
-
-  return node;
 }
 
 void
@@ -851,19 +832,6 @@ childHierNode(CQChartsSunburstHierNode *parent, const QString &name) const
   return nullptr;
 }
 
-CQChartsSunburstNode *
-CQChartsSunburstPlot::
-childNode(CQChartsSunburstHierNode *parent, const QString &name) const
-{
-  assert(parent);
-
-  for (const auto &node : parent->getNodes())
-    if (node->name() == name)
-      return node;
-
-  return nullptr;
-}
-
 bool
 CQChartsSunburstPlot::
 getValueSize(const CQChartsModelIndex &ind, double &size) const
@@ -1416,8 +1384,11 @@ CQChartsSunburstHierNode(const CQChartsSunburstPlot *plot, CQChartsSunburstHierN
                          const QString &name) :
  CQChartsSunburstNode(plot, parent, name)
 {
-  if (parent_)
+  if (parent_) {
     parent_->children_.push_back(this);
+
+    parent_->invalidateHierSize();
+  }
 }
 
 CQChartsSunburstHierNode::
@@ -1446,19 +1417,38 @@ isHierExpanded() const
   return true;
 }
 
+void
+CQChartsSunburstHierNode::
+setSize(double s)
+{
+  CQChartsSunburstNode::setSize(s);
+
+  invalidateHierSize();
+}
+
 double
 CQChartsSunburstHierNode::
 hierSize() const
 {
-  double s = size();
+  return hierSize_.size([&]() {
+    double s = size();
 
-  for (const auto &child : children_)
-    s += child->hierSize();
+    for (auto &child : children_)
+      s += child->hierSize();
 
-  for (const auto &node : nodes_)
-    s += node->hierSize();
+    for (auto &node : nodes_)
+      s += node->hierSize();
 
-  return s;
+    return s;
+  });
+}
+
+void
+CQChartsSunburstHierNode::
+invalidateHierSize()
+{
+  for (auto *hier = this; hier; hier = hier->parent())
+    hier->hierSize_.invalidate();
 }
 
 int
@@ -1576,6 +1566,8 @@ CQChartsSunburstHierNode::
 addNode(CQChartsSunburstNode *node)
 {
   nodes_.push_back(node);
+
+  invalidateHierSize();
 }
 
 void
@@ -1599,6 +1591,8 @@ removeNode(CQChartsSunburstNode *node)
     nodes_[i - 1] = nodes_[i];
 
   nodes_.pop_back();
+
+  invalidateHierSize();
 }
 
 QColor
@@ -1631,6 +1625,16 @@ CQChartsSunburstNode(const CQChartsSunburstPlot *plot, CQChartsSunburstHierNode
 {
 }
 
+void
+CQChartsSunburstNode::
+setSize(double size)
+{
+  size_ = size;
+
+  if (parent_)
+    parent_->invalidateHierSize();
+}
+
 QString
 CQChartsSunburstNode::
 hierName(const QChar &separator) const
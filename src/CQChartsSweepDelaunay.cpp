@@ -0,0 +1,626 @@
+// Sweep hull delaunay triangulation based on a port of delaunator
+// (https://github.com/mapbox/delaunator):
+//
+// ISC License
+//
+// Copyright (c) 2017, Mapbox
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose
+// with or without fee is hereby granted, provided that the above copyright notice
+// and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND ISC DISCLAIMS ALL WARRANTIES WITH REGARD TO
+// THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL ISC BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR
+// CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA
+// OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+// ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <CQChartsSweepDelaunay.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+double dist2(double ax, double ay, double bx, double by) {
+  double dx = ax - bx;
+  double dy = ay - by;
+
+  return dx*dx + dy*dy;
+}
+
+// square of circumradius of triangle (infinite if degenerate)
+double circumRadius2(double ax, double ay, double bx, double by, double cx, double cy) {
+  double dx = bx - ax, dy = by - ay;
+  double ex = cx - ax, ey = cy - ay;
+
+  double bl = dx*dx + dy*dy;
+  double cl = ex*ex + ey*ey;
+  double d  = dx*ey - dy*ex;
+
+  if (d == 0.0)
+    return std::numeric_limits<double>::max();
+
+  double x = (ey*bl - dy*cl)*0.5/d;
+  double y = (dx*cl - ex*bl)*0.5/d;
+
+  return x*x + y*y;
+}
+
+void circumCenter(double ax, double ay, double bx, double by, double cx, double cy,
+                  double &x, double &y) {
+  double dx = bx - ax, dy = by - ay;
+  double ex = cx - ax, ey = cy - ay;
+
+  double bl = dx*dx + dy*dy;
+  double cl = ex*ex + ey*ey;
+  double d  = dx*ey - dy*ex;
+
+  x = ax + (ey*bl - dy*cl)*0.5/d;
+  y = ay + (dx*cl - ex*bl)*0.5/d;
+}
+
+// is p inside circumcircle of a, b, c
+bool inCircle(double ax, double ay, double bx, double by, double cx, double cy,
+              double px, double py) {
+  double dx = ax - px, dy = ay - py;
+  double ex = bx - px, ey = by - py;
+  double fx = cx - px, fy = cy - py;
+
+  double ap = dx*dx + dy*dy;
+  double bp = ex*ex + ey*ey;
+  double cp = fx*fx + fy*fy;
+
+  return (dx*(ey*cp - bp*fy) - dy*(ex*cp - bp*fx) + ap*(ex*fy - ey*fx) < 0.0);
+}
+
+// monotonic angle (0-1) of vector
+double pseudoAngle(double dx, double dy) {
+  double p = dx/(std::abs(dx) + std::abs(dy));
+
+  return (dy > 0.0 ? 3.0 - p : 1.0 + p)/4.0;
+}
+
+// is (p, q, r) clockwise
+bool isOrient(double px, double py, double qx, double qy, double rx, double ry) {
+  return ((qy - py)*(rx - qx) - (qx - px)*(ry - qy) < 0.0);
+}
+
+// is (x, y) left of line (x1, y1) -> (x2, y2)
+bool isLeft(double x, double y, double x1, double y1, double x2, double y2) {
+  double area2 = (x1 - x)*(y2 - y) - (x2 - x)*(y1 - y);
+
+  return (area2 > 0);
+}
+
+}
+
+//---
+
+int
+CQChartsSweepDelaunay::
+addVertex(double x, double y, double value)
+{
+  coords_.push_back(x);
+  coords_.push_back(y);
+
+  values_.push_back(value);
+
+  return numVertices() - 1;
+}
+
+void
+CQChartsSweepDelaunay::
+clearVertices()
+{
+  coords_.clear();
+  values_.clear();
+
+  reset();
+}
+
+void
+CQChartsSweepDelaunay::
+reset()
+{
+  triangles_.clear();
+  halfEdges_.clear();
+
+  hullPrev_ .clear();
+  hullNext_ .clear();
+  hullTri_  .clear();
+  hullHash_ .clear();
+  edgeStack_.clear();
+
+  hullStart_ = -1;
+
+  triangleVoronoi_.clear();
+  voronoiVertices_.clear();
+  voronoiEdges_   .clear();
+  vertexVoronoi_  .clear();
+}
+
+bool
+CQChartsSweepDelaunay::
+calc()
+{
+  reset();
+
+  if (! triangulate())
+    return false;
+
+  calcVoronoi();
+
+  return true;
+}
+
+bool
+CQChartsSweepDelaunay::
+triangulate()
+{
+  int n = numVertices();
+
+  if (n < 3)
+    return false;
+
+  //---
+
+  // get center of bounding box
+  double xmin = std::numeric_limits<double>::max(), xmax = -xmin;
+  double ymin = xmin                              , ymax = -ymin;
+
+  for (int i = 0; i < n; ++i) {
+    xmin = std::min(xmin, x(i)); xmax = std::max(xmax, x(i));
+    ymin = std::min(ymin, y(i)); ymax = std::max(ymax, y(i));
+  }
+
+  double bcx = (xmin + xmax)/2.0;
+  double bcy = (ymin + ymax)/2.0;
+
+  //---
+
+  // seed triangle: point closest to center, closest point to that and point
+  // making smallest circumcircle
+  double maxD = std::numeric_limits<double>::max();
+
+  int i0 = -1, i1 = -1, i2 = -1;
+
+  double minD = maxD;
+
+  for (int i = 0; i < n; ++i) {
+    double d = dist2(bcx, bcy, x(i), y(i));
+
+    if (d < minD) { i0 = i; minD = d; }
+  }
+
+  minD = maxD;
+
+  for (int i = 0; i < n; ++i) {
+    if (i == i0) continue;
+
+    double d = dist2(x(i0), y(i0), x(i), y(i));
+
+    if (d < minD && d > 0.0) { i1 = i; minD = d; }
+  }
+
+  if (i1 < 0)
+    return false;
+
+  double minR = maxD;
+
+  for (int i = 0; i < n; ++i) {
+    if (i == i0 || i == i1) continue;
+
+    double r = circumRadius2(x(i0), y(i0), x(i1), y(i1), x(i), y(i));
+
+    if (r < minR) { i2 = i; minR = r; }
+  }
+
+  // all points collinear
+  if (i2 < 0 || minR == maxD)
+    return false;
+
+  if (isOrient(x(i0), y(i0), x(i1), y(i1), x(i2), y(i2)))
+    std::swap(i1, i2);
+
+  circumCenter(x(i0), y(i0), x(i1), y(i1), x(i2), y(i2), cx_, cy_);
+
+  //---
+
+  // sort points by distance from seed triangle circumcenter
+  Reals dists(n);
+
+  for (int i = 0; i < n; ++i)
+    dists[i] = dist2(x(i), y(i), cx_, cy_);
+
+  Inds ids(n);
+
+  for (int i = 0; i < n; ++i)
+    ids[i] = i;
+
+  std::sort(ids.begin(), ids.end(), [&](int i, int j) { return dists[i] < dists[j]; });
+
+  //---
+
+  // initialize hull
+  int hashSize = std::max(int(std::ceil(std::sqrt(n))), 1);
+
+  hullPrev_.assign(n, -1);
+  hullNext_.assign(n, -1);
+  hullTri_ .assign(n, -1);
+  hullHash_.assign(hashSize, -1);
+
+  hullStart_ = i0;
+
+  hullNext_[i0] = hullPrev_[i2] = i1;
+  hullNext_[i1] = hullPrev_[i0] = i2;
+  hullNext_[i2] = hullPrev_[i1] = i0;
+
+  hullTri_[i0] = 0;
+  hullTri_[i1] = 1;
+  hullTri_[i2] = 2;
+
+  hullHash_[hashKey(x(i0), y(i0))] = i0;
+  hullHash_[hashKey(x(i1), y(i1))] = i1;
+  hullHash_[hashKey(x(i2), y(i2))] = i2;
+
+  int maxTriangles = std::max(2*n - 5, 1);
+
+  triangles_.reserve(3*maxTriangles);
+  halfEdges_.reserve(3*maxTriangles);
+
+  addTriangle(i0, i1, i2, -1, -1, -1);
+
+  //---
+
+  // add points to hull
+  double eps = std::numeric_limits<double>::epsilon();
+
+  double xp = 0.0, yp = 0.0;
+
+  for (int k = 0; k < n; ++k) {
+    int i = ids[k];
+
+    double xi = x(i), yi = y(i);
+
+    // skip near duplicate points
+    if (k > 0 && std::abs(xi - xp) <= eps && std::abs(yi - yp) <= eps)
+      continue;
+
+    xp = xi; yp = yi;
+
+    // skip seed triangle points
+    if (i == i0 || i == i1 || i == i2)
+      continue;
+
+    // find visible edge on hull using hash
+    int start = 0;
+
+    int key = hashKey(xi, yi);
+
+    for (int j = 0; j < hashSize; ++j) {
+      start = hullHash_[(key + j) % hashSize];
+
+      if (start != -1 && start != hullNext_[start])
+        break;
+    }
+
+    start = hullPrev_[start];
+
+    int e = start;
+    int q = hullNext_[e];
+
+    while (! isOrient(xi, yi, x(e), y(e), x(q), y(q))) {
+      e = q;
+
+      if (e == start) {
+        e = -1;
+        break;
+      }
+
+      q = hullNext_[e];
+    }
+
+    // likely near duplicate point
+    if (e == -1)
+      continue;
+
+    // add first triangle from point
+    int t = addTriangle(e, i, hullNext_[e], -1, -1, hullTri_[e]);
+
+    hullTri_[i] = legalize(t + 2);
+    hullTri_[e] = t;
+
+    // walk forward through hull adding triangles and flipping
+    int nn = hullNext_[e];
+
+    q = hullNext_[nn];
+
+    while (isOrient(xi, yi, x(nn), y(nn), x(q), y(q))) {
+      t = addTriangle(nn, i, q, hullTri_[i], -1, hullTri_[nn]);
+
+      hullTri_[i] = legalize(t + 2);
+
+      hullNext_[nn] = nn; // mark as removed
+
+      nn = q;
+      q  = hullNext_[nn];
+    }
+
+    // walk backward from other side
+    if (e == start) {
+      q = hullPrev_[e];
+
+      while (isOrient(xi, yi, x(q), y(q), x(e), y(e))) {
+        t = addTriangle(q, i, e, -1, hullTri_[e], hullTri_[q]);
+
+        legalize(t + 2);
+
+        hullTri_[q] = t;
+
+        hullNext_[e] = e; // mark as removed
+
+        e = q;
+        q = hullPrev_[e];
+      }
+    }
+
+    // update hull indices
+    hullStart_ = hullPrev_[i] = e;
+
+    hullNext_[e ] = hullPrev_[nn] = i;
+    hullNext_[i ] = nn;
+
+    // save new edges in hash
+    hullHash_[hashKey(xi  , yi  )] = i;
+    hullHash_[hashKey(x(e), y(e))] = e;
+  }
+
+  return true;
+}
+
+int
+CQChartsSweepDelaunay::
+addTriangle(int i0, int i1, int i2, int a, int b, int c)
+{
+  int t = int(triangles_.size());
+
+  triangles_.push_back(i0);
+  triangles_.push_back(i1);
+  triangles_.push_back(i2);
+
+  halfEdges_.push_back(-1);
+  halfEdges_.push_back(-1);
+  halfEdges_.push_back(-1);
+
+  link(t    , a);
+  link(t + 1, b);
+  link(t + 2, c);
+
+  return t;
+}
+
+void
+CQChartsSweepDelaunay::
+link(int a, int b)
+{
+  halfEdges_[a] = b;
+
+  if (b != -1)
+    halfEdges_[b] = a;
+}
+
+// flip triangle edges until all are locally delaunay (returns last half edge)
+int
+CQChartsSweepDelaunay::
+legalize(int a)
+{
+  int ar = 0;
+
+  edgeStack_.clear();
+
+  while (true) {
+    int b = halfEdges_[a];
+
+    int a0 = a - a % 3;
+
+    ar = a0 + (a + 2) % 3;
+
+    // hull edge
+    if (b == -1) {
+      if (edgeStack_.empty())
+        break;
+
+      a = edgeStack_.back(); edgeStack_.pop_back();
+
+      continue;
+    }
+
+    int b0 = b - b % 3;
+    int al = a0 + (a + 1) % 3;
+    int bl = b0 + (b + 2) % 3;
+
+    int p0 = triangles_[ar];
+    int pr = triangles_[a ];
+    int pl = triangles_[al];
+    int p1 = triangles_[bl];
+
+    bool illegal = inCircle(x(p0), y(p0), x(pr), y(pr), x(pl), y(pl), x(p1), y(p1));
+
+    if (illegal) {
+      // flip edge
+      triangles_[a] = p1;
+      triangles_[b] = p0;
+
+      int hbl = halfEdges_[bl];
+
+      // edge swapped on other side of hull (rare), fix hull triangle reference
+      if (hbl == -1) {
+        int e = hullStart_;
+
+        do {
+          if (hullTri_[e] == bl) {
+            hullTri_[e] = a;
+            break;
+          }
+
+          e = hullPrev_[e];
+        } while (e != hullStart_);
+      }
+
+      link(a , hbl);
+      link(b , halfEdges_[ar]);
+      link(ar, bl);
+
+      int br = b0 + (b + 1) % 3;
+
+      edgeStack_.push_back(br);
+    }
+    else {
+      if (edgeStack_.empty())
+        break;
+
+      a = edgeStack_.back(); edgeStack_.pop_back();
+    }
+  }
+
+  return ar;
+}
+
+int
+CQChartsSweepDelaunay::
+hashKey(double x, double y) const
+{
+  int hashSize = int(hullHash_.size());
+
+  int key = int(std::floor(pseudoAngle(x - cx_, y - cy_)*hashSize));
+
+  return (key % hashSize + hashSize) % hashSize;
+}
+
+//---
+
+void
+CQChartsSweepDelaunay::
+calcVoronoi()
+{
+  int nt = numTriangles();
+
+  triangleVoronoi_.assign(nt, -1);
+
+  vertexVoronoi_.resize(numVertices());
+
+  // get center of circle for each triangle
+  for (int t = 0; t < nt; ++t) {
+    double xc, yc, r;
+
+    if (! triangleCenter(t, xc, yc, r))
+      continue;
+
+    int iv = numVoronoiVertices();
+
+    voronoiVertices_.push_back(VoronoiVertex(xc, yc, r));
+
+    triangleVoronoi_[t] = iv;
+
+    for (int i = 0; i < 3; ++i)
+      vertexVoronoi_[triangleVertex(t, i)].push_back(iv);
+  }
+
+  //---
+
+  // connect center to center of triangle on other side of each edge
+  for (int t = 0; t < nt; ++t) {
+    int iv = triangleVoronoi_[t];
+    if (iv < 0) continue;
+
+    for (int i = 0; i < 3; ++i) {
+      int e  = 3*t + i;
+      int oe = halfEdges_[e];
+
+      int iv1 = (oe >= 0 ? triangleVoronoi_[oe/3] : -1);
+
+      if (iv1 < 0) {
+        iv1 = numVoronoiVertices();
+
+        voronoiVertices_.push_back(calcEdgePoint(t, voronoiVertices_[iv], e));
+      }
+
+      voronoiEdges_.push_back(VoronoiEdge(iv, iv1));
+    }
+  }
+}
+
+bool
+CQChartsSweepDelaunay::
+triangleCenter(int t, double &xc, double &yc, double &r) const
+{
+  int i1 = triangleVertex(t, 0);
+  int i2 = triangleVertex(t, 1);
+  int i3 = triangleVertex(t, 2);
+
+  double A = x(i2) - x(i1);
+  double B = y(i2) - y(i1);
+  double C = x(i3) - x(i1);
+  double D = y(i3) - y(i1);
+
+  double E = A*(x(i1) + x(i2)) + B*(y(i1) + y(i2));
+  double F = C*(x(i1) + x(i3)) + D*(y(i1) + y(i3));
+
+  double G = 2*(A*(y(i3) - y(i2)) - B*(x(i3) - x(i2)));
+
+  // degenerate (collinear) if twice area is tiny relative to square of triangle extent
+  double xmin = std::min({x(i1), x(i2), x(i3)}), xmax = std::max({x(i1), x(i2), x(i3)});
+  double ymin = std::min({y(i1), y(i2), y(i3)}), ymax = std::max({y(i1), y(i2), y(i3)});
+
+  double s = std::max(xmax - xmin, ymax - ymin);
+
+  if (std::abs(G) <= 1E-12*s*s) return false;
+
+  xc = (D*E - B*F)/G;
+  yc = (A*F - C*E)/G;
+
+  r = std::hypot(x(i1) - xc, y(i1) - yc);
+
+  return true;
+}
+
+// extend line from center through edge mid point away from triangle
+CQChartsSweepDelaunay::VoronoiVertex
+CQChartsSweepDelaunay::
+calcEdgePoint(int t, const VoronoiVertex &v, int e) const
+{
+  int i1 = triangleVertex(t, 0);
+  int i2 = triangleVertex(t, 1);
+  int i3 = triangleVertex(t, 2);
+
+  double fx = (x(i1) + x(i2) + x(i3))/3;
+  double fy = (y(i1) + y(i2) + y(i3))/3;
+
+  int ie1 = triangles_[e];
+  int ie2 = triangles_[3*t + (e + 1) % 3];
+
+  double x1 = x(ie1), y1 = y(ie1);
+  double x2 = x(ie2), y2 = y(ie2);
+
+  double xe = (x1 + x2)/2, ye = (y1 + y2)/2;
+
+  double dx = xe - v.x;
+  double dy = ye - v.y;
+
+  double xe1 = v.x + 100*dx, ye1 = v.y + 100*dy;
+  double xe2 = v.x - 100*dx, ye2 = v.y - 100*dy;
+
+  bool l2 = isLeft(xe1, ye1, x1, y1, x2, y2);
+  bool l3 = isLeft(xe2, ye2, x1, y1, x2, y2);
+  bool l4 = isLeft(fx , fy , x1, y1, x2, y2);
+
+  if      (l2 != l4)
+    return VoronoiVertex(xe1, ye1, 0);
+  else if (l3 != l4)
+    return VoronoiVertex(xe2, ye2, 0);
+  else
+    return VoronoiVertex(xe , ye , 0);
+}
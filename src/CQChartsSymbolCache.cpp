@@ -0,0 +1,192 @@
+#include <CQChartsSymbolCache.h>
+#include <CQChartsDrawUtil.h>
+#include <CQChartsPaintDevice.h>
+#include <CQChartsLength.h>
+#include <CQChartsUtil.h>
+#include <CMathRound.h>
+#include <QPainter>
+#include <algorithm>
+
+CQChartsSymbolCache::
+CQChartsSymbolCache(int maxImages) :
+ maxImages_(maxImages)
+{
+}
+
+void
+CQChartsSymbolCache::
+setMaxImages(int n)
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  maxImages_ = std::max(n, 1);
+
+  evict();
+}
+
+int
+CQChartsSymbolCache::
+numImages() const
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  return int(entryMap_.size());
+}
+
+void
+CQChartsSymbolCache::
+clear()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  entries_ .clear();
+  entryMap_.clear();
+
+  numHits_   = 0;
+  numMisses_ = 0;
+}
+
+bool
+CQChartsSymbolCache::
+isCacheable(const QPen &pen, const QBrush &brush)
+{
+  // pen stroke must be solid color (custom dashes are keyed)
+  if (pen.style() != Qt::NoPen) {
+    if (pen.brush().style() != Qt::SolidPattern || ! pen.brush().transform().isIdentity())
+      return false;
+  }
+
+  // brush must be none or solid color (patterns, gradients and textures are positional)
+  if (brush.style() != Qt::NoBrush) {
+    if (brush.style() != Qt::SolidPattern || ! brush.transform().isIdentity())
+      return false;
+  }
+
+  return true;
+}
+
+void
+CQChartsSymbolCache::
+drawSymbol(QPainter *painter, const CQChartsGeom::Point &p,
+           const CQChartsSymbol &symbol, double size)
+{
+  const auto &pen   = painter->pen  ();
+  const auto &brush = painter->brush();
+
+  Key key;
+
+  key.symbol   = symbol.type();
+  key.size     = size;
+  key.penStyle = pen.style();
+  key.penColor = pen.color().rgba();
+  key.penWidth = pen.widthF();
+
+  if (pen.style() != Qt::NoPen && pen.style() != Qt::SolidLine) {
+    key.penDashes = pen.dashPattern();
+    key.penOffset = pen.dashOffset();
+  }
+
+  key.penCap      = pen.capStyle();
+  key.penJoin     = pen.joinStyle();
+  key.penMiter    = pen.miterLimit();
+  key.penCosmetic = pen.isCosmetic();
+  key.brushStyle  = brush.style();
+  key.brushColor  = brush.color().rgba();
+  key.dpr         = (painter->device() ? painter->device()->devicePixelRatioF() : 1.0);
+
+  QImage image = getImage(key, symbol, pen, brush);
+
+  // image size is in device pixels
+  double is = image.width()/(2.0*key.dpr);
+
+  painter->drawImage(QPointF(p.x - is, p.y - is), image);
+}
+
+QImage
+CQChartsSymbolCache::
+getImage(const Key &key, const CQChartsSymbol &symbol, const QPen &pen, const QBrush &brush)
+{
+  {
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  auto p = entryMap_.find(key);
+
+  if (p != entryMap_.end()) {
+    ++numHits_;
+
+    // move to front (most recently used)
+    entries_.splice(entries_.begin(), entries_, (*p).second);
+
+    return (*p).second->image;
+  }
+
+  ++numMisses_;
+  }
+
+  //---
+
+  // render outside lock (QImage is implicitly shared so copies are cheap)
+  QImage image = createImage(key, symbol, pen, brush);
+
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  if (entryMap_.find(key) == entryMap_.end()) {
+    entries_.push_front(Entry());
+
+    entries_.front().key   = key;
+    entries_.front().image = image;
+
+    entryMap_[key] = entries_.begin();
+
+    evict();
+  }
+
+  return image;
+}
+
+QImage
+CQChartsSymbolCache::
+createImage(const Key &key, const CQChartsSymbol &symbol,
+            const QPen &pen, const QBrush &brush) const
+{
+  double size = key.size;
+
+  int isize = CMathRound::RoundUp(2*(size + std::max(key.penWidth, 1.0))*key.dpr);
+
+  auto image = CQChartsUtil::initImage(QSize(isize, isize));
+
+  image.setDevicePixelRatio(key.dpr);
+
+  image.fill(QColor(0, 0, 0, 0));
+
+  QPainter ipainter(&image);
+
+  ipainter.setRenderHints(QPainter::Antialiasing);
+
+  ipainter.setPen  (pen  );
+  ipainter.setBrush(brush);
+
+  CQChartsPixelPainter device(&ipainter);
+
+  double c = isize/(2.0*key.dpr);
+
+  CQChartsGeom::Point spos (c, c);
+  CQChartsLength      ssize(size, CQChartsUnits::PIXEL);
+
+  CQChartsDrawUtil::drawSymbol(&device, symbol, spos, ssize);
+
+  return image;
+}
+
+void
+CQChartsSymbolCache::
+evict()
+{
+  while (int(entryMap_.size()) > maxImages_) {
+    auto &entry = entries_.back();
+
+    entryMap_.erase(entry.key);
+
+    entries_.pop_back();
+  }
+}
@@ -9,6 +9,7 @@
 #include <CQCharts.h>
 #include <CQChartsTable.h>
 #include <CQChartsPaintDevice.h>
+#include <CQChartsTextCache.h>
 #include <CQChartsHtml.h>
 #include <CQChartsWidgetUtil.h>
 
@@ -556,7 +557,7 @@ calcTableSize() const
 
   //th->tabbedFont_ = th->tableData_.font;
 
-  QFontMetricsF fm(th->tableData_.font);
+  auto *textCache = CQChartsTextCacheInst;
 
   th->tableData_.nc = columns_.count();
 
@@ -569,7 +570,7 @@ calcTableSize() const
                                 th->tableData_.maxDepth);
   }
 
-  th->tableData_.prh = fm.height() + 2*tableData_.pmargin;
+  th->tableData_.prh = textCache->fontData(tableData_.font).height + 2*tableData_.pmargin;
 
   // calc column widths
   if (isRowColumn()) {
@@ -577,7 +578,7 @@ calcTableSize() const
 
     const int power = CMathRound::RoundUp(log10(tableData_.nr));
 
-    data.pwidth  = power*fm.width("X") + 2*tableData_.pmargin;
+    data.pwidth  = power*textCache->textWidth(tableData_.font, "X") + 2*tableData_.pmargin;
     data.numeric = false;
   }
 
@@ -600,7 +601,7 @@ calcTableSize() const
 
     if (! ok) continue;
 
-    double cw = fm.width(str) + 2*tableData_.pmargin;
+    double cw = textCache->textWidth(tableData_.font, str) + 2*tableData_.pmargin;
 
     if (i == 0)
       cw += tableData_.maxDepth*indent();
@@ -680,7 +681,7 @@ calcTableSize() const
    private:
     const CQChartsTablePlot* plot_   { nullptr };
     TableData&               tableData_;
-    QFontMetricsF            fm_;
+    QFontMetricsF            fm_; // not text cache as all cell values would flush it
     bool                     expanded_ { true };
     std::vector<int>         expandStack_;
   };
@@ -1670,12 +1671,13 @@ CQChartsTablePlot::
 modeName(const Mode &mode) const
 {
   switch (mode) {
-    case Mode::NORMAL: return "Normal";
-    case Mode::RANDOM: return "Random";
-    case Mode::SORTED: return "Sorted";
-    case Mode::PAGED : return "Paged";
-    case Mode::ROWS  : return "Rows";
-    default          : assert(false); return "";
+    case Mode::NORMAL    : return "Normal";
+    case Mode::RANDOM    : return "Random";
+    case Mode::SORTED    : return "Sorted";
+    case Mode::PAGED     : return "Paged";
+    case Mode::ROWS      : return "Rows";
+    case Mode::STRATIFIED: return "Stratified";
+    default              : assert(false); return "";
   };
 }
 
@@ -1789,7 +1791,8 @@ draw(CQChartsPaintDevice *device)
 
   CQChartsTextOptions textOptions;
 
-  textOptions.align = headerObjData_.align;
+  textOptions.align  = headerObjData_.align;
+  textOptions.elided = true;
 
   rect_ = headerObjData_.rect.translated(plot_->scrollX(), -plot_->scrollY());
 
@@ -1970,7 +1973,8 @@ draw(CQChartsPaintDevice *device)
 
   CQChartsTextOptions textOptions;
 
-  textOptions.align = cellObjData_.align;
+  textOptions.align  = cellObjData_.align;
+  textOptions.elided = true;
 
   rect_ = cellObjData_.rect.translated(plot_->scrollX(), -plot_->scrollY());
 
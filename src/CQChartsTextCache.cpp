@@ -0,0 +1,244 @@
+#include <CQChartsTextCache.h>
+#include <QFontMetricsF>
+#include <algorithm>
+
+namespace {
+
+// don't cache very long strings (unlikely to be reused)
+const int maxCacheTextLen = 1024;
+
+}
+
+//---
+
+CQChartsTextCache *
+CQChartsTextCache::
+instance()
+{
+  static CQChartsTextCache inst;
+
+  return &inst;
+}
+
+CQChartsTextCache::
+CQChartsTextCache(int maxEntries) :
+ maxEntries_(maxEntries)
+{
+}
+
+void
+CQChartsTextCache::
+setMaxEntries(int n)
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  maxEntries_ = std::max(n, 1);
+
+  evict();
+}
+
+int
+CQChartsTextCache::
+numEntries() const
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  return int(entryMap_.size());
+}
+
+void
+CQChartsTextCache::
+clear()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  entries_ .clear();
+  entryMap_.clear();
+
+  numHits_   = 0;
+  numMisses_ = 0;
+}
+
+//---
+
+CQChartsTextCache::FontData
+CQChartsTextCache::
+fontData(const QFont &font)
+{
+  Key key;
+
+  key.type = Type::FONT;
+  key.font = font;
+
+  Value value;
+
+  if (! findValue(key, value)) {
+    QFontMetricsF fm(font);
+
+    value.fontData.ascent  = fm.ascent ();
+    value.fontData.descent = fm.descent();
+    value.fontData.height  = fm.height ();
+
+    addValue(key, value);
+  }
+
+  return value.fontData;
+}
+
+double
+CQChartsTextCache::
+textWidth(const QFont &font, const QString &text)
+{
+  if (text.length() > maxCacheTextLen) {
+    QFontMetricsF fm(font);
+
+    return fm.width(text);
+  }
+
+  Key key;
+
+  key.type = Type::WIDTH;
+  key.font = font;
+  key.text = text;
+
+  Value value;
+
+  if (! findValue(key, value)) {
+    QFontMetricsF fm(font);
+
+    value.width = fm.width(text);
+
+    addValue(key, value);
+  }
+
+  return value.width;
+}
+
+CQChartsGeom::Size
+CQChartsTextCache::
+textSize(const QFont &font, const QString &text)
+{
+  return CQChartsGeom::Size(textWidth(font, text), fontData(font).height);
+}
+
+bool
+CQChartsTextCache::
+formatStringInRect(const QString &str, const QFont &font, const CQChartsGeom::BBox &rect,
+                   QStringList &strs, const CQChartsUtil::FormatData &formatData)
+{
+  if (str.length() > maxCacheTextLen)
+    return CQChartsUtil::formatStringInRect(str, font, rect, strs, formatData);
+
+  // layout only depends on rect size
+  Key key;
+
+  key.type   = Type::FORMAT;
+  key.font   = font;
+  key.text   = str;
+  key.width  = rect.getWidth ();
+  key.height = rect.getHeight();
+  key.seps   = formatData.seps;
+
+  Value value;
+
+  if (! findValue(key, value)) {
+    value.formatted =
+      CQChartsUtil::formatStringInRect(str, font, rect, value.strs, formatData);
+
+    addValue(key, value);
+  }
+
+  strs += value.strs;
+
+  return value.formatted;
+}
+
+QString
+CQChartsTextCache::
+elidedText(const QFont &font, const QString &text, double width, Qt::TextElideMode mode)
+{
+  if (text.length() > maxCacheTextLen) {
+    QFontMetricsF fm(font);
+
+    return fm.elidedText(text, mode, width);
+  }
+
+  Key key;
+
+  key.type  = Type::ELIDE;
+  key.font  = font;
+  key.text  = text;
+  key.width = width;
+  key.mode  = int(mode);
+
+  Value value;
+
+  if (! findValue(key, value)) {
+    QFontMetricsF fm(font);
+
+    value.elided = fm.elidedText(text, mode, width);
+
+    addValue(key, value);
+  }
+
+  return value.elided;
+}
+
+//---
+
+bool
+CQChartsTextCache::
+findValue(const Key &key, Value &value)
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  auto p = entryMap_.find(key);
+
+  if (p == entryMap_.end()) {
+    ++numMisses_;
+
+    return false;
+  }
+
+  ++numHits_;
+
+  // move to front (most recently used)
+  entries_.splice(entries_.begin(), entries_, (*p).second);
+
+  value = (*p).second->value;
+
+  return true;
+}
+
+void
+CQChartsTextCache::
+addValue(const Key &key, const Value &value)
+{
+  // measure outside lock so another thread may have added same key
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  if (entryMap_.find(key) != entryMap_.end())
+    return;
+
+  entries_.push_front(Entry());
+
+  entries_.front().key   = key;
+  entries_.front().value = value;
+
+  entryMap_[key] = entries_.begin();
+
+  evict();
+}
+
+void
+CQChartsTextCache::
+evict()
+{
+  while (int(entryMap_.size()) > maxEntries_) {
+    auto &entry = entries_.back();
+
+    entryMap_.erase(entry.key);
+
+    entries_.pop_back();
+  }
+}
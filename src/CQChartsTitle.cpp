@@ -218,11 +218,28 @@ setAbsolutePlotRectangle(const CQChartsGeom::BBox &bbox)
   setAbsoluteRectangle(CQChartsRect(plot_->windowToView(bbox), CQChartsUnits::VIEW));
 }
 
+QString
+CQChartsTitle::
+calcText() const
+{
+  QString sampleText = plot_->sampleText();
+
+  if (! sampleText.length())
+    return textStr();
+
+  if (! textStr().length())
+    return sampleText;
+
+  return QString("%1 (%2)").arg(textStr()).arg(sampleText);
+}
+
 CQChartsGeom::Size
 CQChartsTitle::
 calcSize()
 {
-  if (textStr().length()) {
+  QString text = calcText();
+
+  if (text.length()) {
     // get font
     QFont font = view()->plotFont(plot(), textFont());
 
@@ -231,7 +248,7 @@ calcSize()
 
     textOptions.html = isTextHtml();
 
-    auto psize = CQChartsDrawUtil::calcTextSize(textStr(), font, textOptions);
+    auto psize = CQChartsDrawUtil::calcTextSize(text, font, textOptions);
 
     // convert to window size
     auto wsize = plot_->pixelToWindowSize(psize);
@@ -371,7 +388,7 @@ isDrawn() const
   if (! isVisible())
     return false;
 
-  if (! textStr().length())
+  if (! calcText().length())
     return false;
 
   return true;
@@ -481,7 +498,7 @@ draw(CQChartsPaintDevice *device)
   // draw text
   device->setRenderHints(QPainter::Antialiasing);
 
-  CQChartsDrawUtil::drawTextInBox(device, tbbox, textStr(), textOptions);
+  CQChartsDrawUtil::drawTextInBox(device, tbbox, calcText(), textOptions);
 
   //---
 
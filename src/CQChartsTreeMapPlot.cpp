@@ -6,6 +6,8 @@
 #include <CQChartsDrawUtil.h>
 #include <CQChartsPaintDevice.h>
 #include <CQChartsHtml.h>
+#include <CQChartsTextCache.h>
+#include <CQChartsHierBuilder.h>
 
 #include <CQPropertyViewItem.h>
 #include <CQPerfMonitor.h>
@@ -170,15 +172,13 @@ calcTitleHeight() const
 {
   QFont font = view()->plotFont(this, headerTextFont());
 
-  QFontMetricsF fm(font);
-
   if (titleHeight().isSet()) {
     double hh = lengthPixelHeight(*titleHeight().value());
 
     return std::max(hh, 4.0);
   }
 
-  return fm.height() + 4.0;
+  return CQChartsTextCacheInst->fontData(font).height + 4.0;
 }
 
 //----
@@ -830,8 +830,9 @@ loadFlat() const
 {
   class RowVisitor : public ModelVisitor {
    public:
-    RowVisitor(const CQChartsTreeMapPlot *plot) :
-     plot_(plot) {
+    RowVisitor(const CQChartsTreeMapPlot *plot, CQChartsHierBuilder &builder,
+               FlatRows &flatRows) :
+     plot_(plot), builder_(builder), flatRows_(flatRows) {
     }
 
     State visit(const QAbstractItemModel *, const VisitData &data) override {
@@ -843,27 +844,26 @@ loadFlat() const
                                       plot_->separator(), nameStrs, nameInds))
         return State::SKIP;
 
-      QString     name;
-      QModelIndex nameInd;
+      FlatRowData flatRow;
 
       if (plot_->idColumn().isValid()) {
         CQChartsModelIndex idModelInd(data.row, plot_->idColumn(), data.parent);
 
         bool ok;
 
-        name = plot_->modelString(idModelInd, ok);
+        flatRow.name = plot_->modelString(idModelInd, ok);
 
         if (! ok)
-          name = nameStrs.back();
+          flatRow.name = nameStrs.back();
 
-        nameInd = plot_->modelIndex(idModelInd);
+        flatRow.ind = plot_->modelIndex(idModelInd);
       }
       else {
-        name    = nameStrs.back();
-        nameInd = nameInds[0];
+        flatRow.name = nameStrs.back();
+        flatRow.ind  = nameInds[0];
       }
 
-      QModelIndex nameInd1 = plot_->normalizeIndex(nameInd);
+      flatRow.ind = plot_->normalizeIndex(flatRow.ind);
 
       //---
 
@@ -881,107 +881,99 @@ loadFlat() const
 
       //---
 
-      auto *node = plot_->flatAddNode(nameStrs, size, nameInd1, name);
-
-      if (node && plot_->colorColumn().isValid()) {
+      if (plot_->colorColumn().isValid()) {
         CQChartsColor color;
 
         CQChartsModelIndex colorInd(data.row, plot_->colorColumn(), data.parent);
 
         if (plot_->modelIndexColor(colorInd, color))
-          node->setColor(color);
+          flatRow.color = color;
       }
 
+      //---
+
+      if (builder_.addRow(nameStrs, size) < 0)
+        return State::SKIP;
+
+      flatRows_.push_back(flatRow);
+
       return State::OK;
     }
 
    private:
     const CQChartsTreeMapPlot* plot_ { nullptr };
+    CQChartsHierBuilder&       builder_;
+    FlatRows&                  flatRows_;
   };
 
-  RowVisitor visitor(this);
+  CQChartsHierBuilder builder;
+  FlatRows            flatRows;
+
+  RowVisitor visitor(this, builder, flatRows);
 
   visitModel(visitor);
 
   //---
 
+  builder.build();
+
+  addFlatNodes(builder, flatRows, builder.root(), root());
+
+  //---
+
   addExtraNodes(root());
 }
 
-CQChartsTreeMapNode *
+void
 CQChartsTreeMapPlot::
-flatAddNode(const QStringList &nameStrs, double size,
-            const QModelIndex &nameInd, const QString &name) const
+addFlatNodes(const CQChartsHierBuilder &builder, const FlatRows &flatRows, int ind,
+             CQChartsTreeMapHierNode *parent) const
 {
   auto *th = const_cast<CQChartsTreeMapPlot *>(this);
 
-  //---
-
-  int depth = nameStrs.length();
-
-  th->maxDepth_ = std::max(maxDepth_, depth + 1);
-
-  //---
-
-  auto *parent = root();
-
-  for (int j = 0; j < nameStrs.length() - 1; ++j) {
-    auto *child = childHierNode(parent, nameStrs[j]);
-
-    if (! child) {
-      // remove any existing leaf node (save size to use in new hier node)
-      QModelIndex nameInd1 = nameInd;
-      double      size1    = 0.0;
+  // add hier nodes (own size of hier node is added as filler node by addExtraNodes)
+  for (const auto &c : builder.hierChildren(ind)) {
+    const auto &hierNode = builder.node(c);
 
-      auto *node = childNode(parent, nameStrs[j]);
+    int indRow = builder.hierLeafRow(c);
 
-      if (node) {
-        nameInd1 = node->ind();
-        size1    = node->size();
+    if (indRow < 0)
+      indRow = hierNode.hierRow;
 
-        parent->removeNode(node);
+    auto *child = new CQChartsTreeMapHierNode(this, parent, builder.nodeName(c),
+                                              flatRows[indRow].ind);
 
-        delete node;
-      }
-
-      //---
+    child->setSize(builder.hierNodeSize(c));
 
-      child = new CQChartsTreeMapHierNode(this, parent, nameStrs[j], nameInd1);
+    child->setDepth(hierNode.depth);
+    child->setHierInd(th->hierInd_++);
 
-      child->setSize(size1);
-
-      child->setDepth(j + 1);
-      child->setHierInd(th->hierInd_++);
-    }
+    if (! hierNode.leafRows.empty())
+      th->maxDepth_ = std::max(maxDepth_, hierNode.depth + 1);
 
-    parent = child;
+    addFlatNodes(builder, flatRows, c, child);
   }
 
-  //---
+  // add leaf nodes (first row defines node, last valid row color is used)
+  for (const auto &c : builder.leafChildren(ind)) {
+    const auto &leafNode = builder.node(c);
 
-  QString nodeName = nameStrs.back();
+    int r = leafNode.leafRows.front();
 
-  auto *node = childNode(parent, nodeName);
+    auto *node = new CQChartsTreeMapNode(this, parent, flatRows[r].name,
+                                         builder.rowSize(r), flatRows[r].ind);
 
-  if (! node) {
-    // use hier node if already created
-    auto *child = childHierNode(parent, nodeName);
+    node->setDepth(leafNode.depth);
 
-    if (child) {
-      child->setSize(size);
-      return nullptr;
+    for (const auto &r1 : leafNode.leafRows) {
+      if (flatRows[r1].color.isValid())
+        node->setColor(flatRows[r1].color);
     }
 
-    //---
-
-    node = new CQChartsTreeMapNode(this, parent, name, size, nameInd);
-
-    node->setDepth(depth);
-
     parent->addNode(node);
-  }
 
-  return node;
+    th->maxDepth_ = std::max(maxDepth_, leafNode.depth + 1);
+  }
 }
 
 void
@@ -1025,17 +1017,6 @@ childHierNode(CQChartsTreeMapHierNode *parent, const QString &name) const
   return nullptr;
 }
 
-CQChartsTreeMapNode *
-CQChartsTreeMapPlot::
-childNode(CQChartsTreeMapHierNode *parent, const QString &name) const
-{
-  for (const auto &node : parent->getNodes())
-    if (node->name() == name)
-      return node;
-
-  return nullptr;
-}
-
 bool
 CQChartsTreeMapPlot::
 getValueSize(const CQChartsModelIndex &ind, double &size) const
@@ -1370,10 +1351,10 @@ draw(CQChartsPaintDevice *device)
   bool visible = true;
 
   if (visible) {
-    QFontMetricsF fm(device->font());
+    auto *textCache = CQChartsTextCacheInst;
 
-    double minTextWidth  = fm.width("X") + 4;
-    double minTextHeight = fm.height() + 4;
+    double minTextWidth  = textCache->textWidth(device->font(), "X") + 4;
+    double minTextHeight = textCache->fontData(device->font()).height + 4;
 
     visible = (pbbox.getWidth() >= minTextWidth && pbbox.getHeight() >= minTextHeight);
   }
@@ -1676,10 +1657,10 @@ drawText(CQChartsPaintDevice *device, const CQChartsGeom::BBox &bbox)
   //---
 
   // check if text visible
-  QFontMetricsF fm(device->font());
+  auto *textCache = CQChartsTextCacheInst;
 
-  double minTextWidth  = fm.width("X") + 4;
-  double minTextHeight = fm.height() + 4;
+  double minTextWidth  = textCache->textWidth(device->font(), "X") + 4;
+  double minTextHeight = textCache->fontData(device->font()).height + 4;
 
   bool visible = (bbox.getWidth() >= minTextWidth && bbox.getHeight() >= minTextHeight);
 
@@ -1723,7 +1704,7 @@ drawText(CQChartsPaintDevice *device, const CQChartsGeom::BBox &bbox)
         CQChartsDrawUtil::drawStringsInBox(device, bbox1, strs, textOptions);
 
 #if 0
-      double th = fm.height();
+      double th = textCache->fontData(device->font()).height;
 
       auto pc = ibbox.getCenter();
 
@@ -1858,19 +1839,38 @@ isHierExpanded() const
   return true;
 }
 
+void
+CQChartsTreeMapHierNode::
+setSize(double s)
+{
+  CQChartsTreeMapNode::setSize(s);
+
+  invalidateHierSize();
+}
+
 double
 CQChartsTreeMapHierNode::
 hierSize() const
 {
-  double s = size();
+  return hierSize_.size([&]() {
+    double s = size();
 
-  for (auto &child : children_)
-    s += child->hierSize();
+    for (auto &child : children_)
+      s += child->hierSize();
 
-  for (auto &node : nodes_)
-    s += node->hierSize();
+    for (auto &node : nodes_)
+      s += node->hierSize();
 
-  return s;
+    return s;
+  });
+}
+
+void
+CQChartsTreeMapHierNode::
+invalidateHierSize()
+{
+  for (auto *hier = this; hier; hier = hier->parent())
+    hier->hierSize_.invalidate();
 }
 
 void
@@ -1878,6 +1878,8 @@ CQChartsTreeMapHierNode::
 addChild(CQChartsTreeMapHierNode *child)
 {
   children_.push_back(child);
+
+  invalidateHierSize();
 }
 
 void
@@ -1902,6 +1904,8 @@ removeChild(CQChartsTreeMapHierNode *child)
     children_[i - 1] = children_[i];
 
   children_.pop_back();
+
+  invalidateHierSize();
 }
 
 void
@@ -2057,6 +2061,8 @@ CQChartsTreeMapHierNode::
 addNode(CQChartsTreeMapNode *node)
 {
   nodes_.push_back(node);
+
+  invalidateHierSize();
 }
 
 void
@@ -2080,6 +2086,8 @@ removeNode(CQChartsTreeMapNode *node)
     nodes_[i - 1] = nodes_[i];
 
   nodes_.pop_back();
+
+  invalidateHierSize();
 }
 
 QColor
@@ -2112,6 +2120,16 @@ CQChartsTreeMapNode(const CQChartsTreeMapPlot *plot, CQChartsTreeMapHierNode *pa
 {
 }
 
+void
+CQChartsTreeMapNode::
+setSize(double s)
+{
+  size_ = s;
+
+  if (parent_)
+    parent_->invalidateHierSize();
+}
+
 QString
 CQChartsTreeMapNode::
 hierName(QChar sep) const
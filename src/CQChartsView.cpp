@@ -39,6 +39,8 @@
 #include <CQPerfMonitor.h>
 
 #include <QSvgGenerator>
+#include <QBuffer>
+#include <QFile>
 #include <QFileDialog>
 #include <QRubberBand>
 #include <QMouseEvent>
@@ -52,6 +54,7 @@
 #include <svg/info_svg.h>
 
 #include <fstream>
+#include <thread>
 
 namespace {
   CQChartsSelMod modifiersToSelMod(Qt::KeyboardModifiers modifiers) {
@@ -3337,15 +3340,7 @@ doResize(int w, int h)
 
   //---
 
-  prect_ = CQChartsGeom::BBox(0, 0, w, h);
-
-  if (prect().getHeight() > 0)
-    aspect_ = (1.0*prect().getWidth())/prect().getHeight();
-  else
-    aspect_ = 1.0;
-
-  displayRange_->setPixelRange(prect_.getXMin(), prect_.getYMin(),
-                               prect_.getXMax(), prect_.getYMax());
+  setPixelSize(w, h);
 
   //---
 
@@ -3361,6 +3356,21 @@ doResize(int w, int h)
   }
 }
 
+void
+CQChartsView::
+setPixelSize(int w, int h)
+{
+  prect_ = CQChartsGeom::BBox(0, 0, w, h);
+
+  if (prect().getHeight() > 0)
+    aspect_ = (1.0*prect().getWidth())/prect().getHeight();
+  else
+    aspect_ = 1.0;
+
+  displayRange_->setPixelRange(prect_.getXMin(), prect_.getYMin(),
+                               prect_.getXMax(), prect_.getYMax());
+}
+
 void
 CQChartsView::
 hbarScrollSlot(int pos)
@@ -3448,7 +3458,7 @@ drawPlots(QPainter *painter)
   if (! hasPlots && ! hasAnnotations && ! isPreview()) {
     showNoData(true);
 
-    auto *painter1 = objectsBuffer_->beginPaint(painter, rect());
+    auto *painter1 = objectsBuffer_->beginPaint(painter, prect().qrect());
 
     if (painter1) {
       auto *th = const_cast<CQChartsView *>(this);
@@ -3483,7 +3493,7 @@ drawPlots(QPainter *painter)
 
   // draw annotations and key
   if (hasAnnotations || hasPlots) {
-    auto *painter1 = objectsBuffer_->beginPaint(painter, rect());
+    auto *painter1 = objectsBuffer_->beginPaint(painter, prect().qrect());
 
     if (painter1) {
       auto *th = const_cast<CQChartsView *>(this);
@@ -3510,7 +3520,7 @@ drawPlots(QPainter *painter)
 
   // draw overlay (annotations and key)
   if (hasPlots || hasAnnotations) {
-    auto *painter1 = overlayBuffer_->beginPaint(painter, rect());
+    auto *painter1 = overlayBuffer_->beginPaint(painter, prect().qrect());
 
     if (painter1) {
       auto *th = const_cast<CQChartsView *>(this);
@@ -5384,6 +5394,352 @@ printSVG(const QString &filename, CQChartsPlot *plot)
   return rc;
 }
 
+QImage
+CQChartsView::
+renderImage(const QSize &size, double dpi, CQChartsPlot *plot)
+{
+  CQPerfTrace trace("CQChartsView::renderImage");
+
+  auto size1 = renderSize(size);
+
+  auto state = beginRender(size1);
+
+  syncRender();
+
+  auto image = paintImage(size1, dpi, plot);
+
+  endRender(state);
+
+  return image;
+}
+
+bool
+CQChartsView::
+renderSVG(QIODevice *device, const QSize &size, double dpi, CQChartsPlot *plot)
+{
+  CQPerfTrace trace("CQChartsView::renderSVG");
+
+  auto size1 = renderSize(size);
+
+  auto state = beginRender(size1);
+
+  syncRender();
+
+  bool rc = paintSVG(device, size1, dpi, plot);
+
+  endRender(state);
+
+  return rc;
+}
+
+bool
+CQChartsView::
+renderFile(const QString &filename, const QSize &size, double dpi, CQChartsPlot *plot)
+{
+  if (filename.endsWith(".svg", Qt::CaseInsensitive)) {
+    QFile file(filename);
+
+    if (! file.open(QIODevice::WriteOnly))
+      return false;
+
+    return renderSVG(&file, size, dpi, plot);
+  }
+  else {
+    auto image = renderImage(size, dpi, plot);
+
+    return image.save(filename);
+  }
+}
+
+bool
+CQChartsView::
+renderData(QByteArray &data, const QString &format, const QSize &size,
+           double dpi, CQChartsPlot *plot)
+{
+  QBuffer buffer(&data);
+
+  if (! buffer.open(QIODevice::WriteOnly))
+    return false;
+
+  if (format.toLower() == "svg")
+    return renderSVG(&buffer, size, dpi, plot);
+
+  auto image = renderImage(size, dpi, plot);
+
+  return image.save(&buffer, format.toUpper().toLatin1().constData());
+}
+
+bool
+CQChartsView::
+renderFiles(const RenderDatas &renderDatas, int numThreads)
+{
+  CQPerfTrace trace("CQChartsView::renderFiles");
+
+  if (numThreads <= 0)
+    numThreads = std::max(int(std::thread::hardware_concurrency()), 1);
+
+  using Futures = std::vector<std::future<bool>>;
+
+  bool rc = true;
+
+  Futures futures;
+
+  auto waitFuture = [&](Futures::iterator p) {
+    if (! p->get())
+      rc = false;
+
+    return futures.erase(p);
+  };
+
+  //---
+
+  // each round renders distinct views (a view can only be sized for one render at a time)
+  std::vector<bool> done(renderDatas.size(), false);
+
+  std::size_t numDone = 0;
+
+  while (numDone < renderDatas.size()) {
+    using Inds   = std::vector<std::size_t>;
+    using Views  = std::set<CQChartsView *>;
+    using States = std::vector<RenderState>;
+
+    Inds  inds;
+    Views views;
+
+    for (std::size_t i = 0; i < renderDatas.size(); ++i) {
+      if (done[i]) continue;
+
+      auto *view = renderDatas[i].view;
+
+      if (! view) {
+        done[i] = true;
+
+        ++numDone;
+
+        rc = false;
+
+        continue;
+      }
+
+      if (views.find(view) != views.end())
+        continue;
+
+      views.insert(view);
+
+      inds.push_back(i);
+    }
+
+    //---
+
+    // resize all views (starts plot range and object calc threads)
+    States states;
+
+    for (const auto &i : inds) {
+      const auto &renderData = renderDatas[i];
+
+      auto size = renderData.view->renderSize(renderData.size);
+
+      states.push_back(renderData.view->beginRender(size));
+    }
+
+    //---
+
+    // wait for plot calc of all views
+    for (const auto &i : inds)
+      renderDatas[i].view->syncRender();
+
+    //---
+
+    // paint and write each view (images are painted and saved in background)
+    for (const auto &i : inds) {
+      const auto &renderData = renderDatas[i];
+
+      auto *view = renderData.view;
+
+      auto size = view->renderSize(renderData.size);
+
+      if (renderData.filename.endsWith(".svg", Qt::CaseInsensitive)) {
+        QFile file(renderData.filename);
+
+        if (! file.open(QIODevice::WriteOnly) ||
+            ! view->paintSVG(&file, size, renderData.dpi, renderData.plot))
+          rc = false;
+      }
+      else {
+        while (int(futures.size()) >= numThreads)
+          (void) waitFuture(futures.begin());
+
+        futures.push_back(std::async(std::launch::async, [view, size, renderData]() {
+          auto image = view->paintImage(size, renderData.dpi, renderData.plot);
+
+          return image.save(renderData.filename);
+        }));
+      }
+    }
+
+    // views must not be restored until painted
+    while (! futures.empty())
+      (void) waitFuture(futures.begin());
+
+    for (std::size_t j = 0; j < inds.size(); ++j) {
+      renderDatas[inds[j]].view->endRender(states[j]);
+
+      done[inds[j]] = true;
+
+      ++numDone;
+    }
+  }
+
+  return rc;
+}
+
+QSize
+CQChartsView::
+renderSize(const QSize &size) const
+{
+  // use current size for unset width or height
+  int w = (size.width () > 0 ? size.width () : int(prect().getWidth ()));
+  int h = (size.height() > 0 ? size.height() : int(prect().getHeight()));
+
+  return QSize(std::min(w, 16384), std::min(h, 16384));
+}
+
+CQChartsView::RenderState
+CQChartsView::
+beginRender(const QSize &size)
+{
+  RenderState state;
+
+  state.size         = QSize(int(prect().getWidth()), int(prect().getHeight()));
+  state.bufferLayers = bufferLayers_;
+
+  // draw directly to output device (layer buffers are sized for widget)
+  bufferLayers_ = false;
+
+  if (size != state.size) {
+    // save data ranges (equal scale plots recalc range for new aspect)
+    for (const auto &plot : plots()) {
+      if (! plot->isVisible())
+        continue;
+
+      RenderPlotRange plotRange;
+
+      plotRange.plot  = plot;
+      plotRange.range = plot->dataRange();
+
+      state.plotRanges.push_back(plotRange);
+    }
+
+    doResize(size.width(), size.height());
+  }
+
+  return state;
+}
+
+void
+CQChartsView::
+syncRender()
+{
+  for (const auto &plot : plots()) {
+    if (! plot->isVisible())
+      continue;
+
+    plot->syncAll();
+  }
+}
+
+void
+CQChartsView::
+endRender(const RenderState &state)
+{
+  bufferLayers_ = state.bufferLayers;
+
+  // restore pixel size and saved data ranges (plot ranges and objects are not recalculated)
+  if (state.size != QSize(int(prect().getWidth()), int(prect().getHeight()))) {
+    lockPainter(true);
+
+    for (const auto &plotRange : state.plotRanges)
+      plotRange.plot->preResize();
+
+    setPixelSize(state.size.width(), state.size.height());
+
+    lockPainter(false);
+
+    for (const auto &plotRange : state.plotRanges)
+      plotRange.plot->setDataRange(plotRange.range, /*update*/false);
+
+    for (const auto &plotRange : state.plotRanges) {
+      auto *plot = plotRange.plot;
+
+      if (plot->isOverlay() && ! plot->isFirstPlot())
+        continue;
+
+      plot->applyDataRange();
+
+      plot->updateKeyPosition(/*force*/true);
+    }
+  }
+
+  updatePlots();
+}
+
+QImage
+CQChartsView::
+paintImage(const QSize &size, double dpi, CQChartsPlot *plot)
+{
+  QImage image = CQChartsUtil::initImage(size);
+
+  // image dpi is used to size fonts
+  if (dpi > 0.0) {
+    int dpm = qRound(dpi/0.0254);
+
+    image.setDotsPerMeterX(dpm);
+    image.setDotsPerMeterY(dpm);
+  }
+
+  QPainter painter;
+
+  if (! painter.begin(&image))
+    return QImage();
+
+  paint(&painter, plot);
+
+  painter.end();
+
+  if (plot) {
+    auto pixelRect = plot->calcPlotPixelRect();
+
+    image = image.copy(pixelRect.qrecti());
+  }
+
+  return image;
+}
+
+bool
+CQChartsView::
+paintSVG(QIODevice *device, const QSize &size, double dpi, CQChartsPlot *plot)
+{
+  QSvgGenerator generator;
+
+  generator.setOutputDevice(device);
+  generator.setSize(size);
+  generator.setViewBox(QRect(QPoint(0, 0), size));
+
+  if (dpi > 0.0)
+    generator.setResolution(qRound(dpi));
+
+  QPainter painter;
+
+  if (! painter.begin(&generator))
+    return false;
+
+  paint(&painter, plot);
+
+  painter.end();
+
+  return true;
+}
+
 bool
 CQChartsView::
 writeSVG(const QString &filename, CQChartsPlot *plot)
@@ -5666,6 +6022,10 @@ writeScript(const QString &filename, CQChartsPlot *plot)
 
   CQChartsJS::writeInsideProcs(os);
 
+  // generic plot object buffer procs
+  if (isScriptCompact())
+    CQChartsJS::writeBufferProcs(os);
+
   //---
 
   // draw background proc
@@ -11,6 +11,7 @@
 #include <CQChartsDataLabel.h>
 #include <CQChartsDrawUtil.h>
 #include <CQChartsGrahamHull.h>
+#include <CQChartsPolygonDecimator.h>
 #include <CQChartsTip.h>
 #include <CQChartsHtml.h>
 #include <CQChartsVariant.h>
@@ -394,6 +395,56 @@ setRoundedLines(bool b)
   CQChartsUtil::testAndSet(roundedLines_, b, [&]() { drawObjs(); } );
 }
 
+void
+CQChartsXYPlot::
+setDecimateLines(bool b)
+{
+  CQChartsUtil::testAndSet(decimateLines_, b, [&]() { drawObjs(); } );
+}
+
+int
+CQChartsXYPlot::
+numDecimatedPoints() const
+{
+  int n = 0;
+
+  for (const auto &plotObj : plotObjects()) {
+    auto *polylineObj = dynamic_cast<CQChartsXYPolylineObj *>(plotObj);
+    auto *polygonObj  = dynamic_cast<CQChartsXYPolygonObj  *>(plotObj);
+
+    if      (polylineObj)
+      n += polylineObj->numDrawPoints();
+    else if (polygonObj)
+      n += polygonObj->numDrawPoints();
+  }
+
+  return n;
+}
+
+const CQChartsGeom::Polygon &
+CQChartsXYPlot::
+decimatedPolygon(CQChartsPaintDevice *device, CQChartsPolygonDecimator *decimator,
+                 const CQChartsGeom::BBox &bbox, const CQChartsGeom::Polygon &poly) const
+{
+  // script and svg output keep all points
+  if (! isDecimateLines() ||
+      device->type() == CQChartsPaintDevice::Type::SCRIPT ||
+      device->type() == CQChartsPaintDevice::Type::SVG)
+    return poly;
+
+  if (! bbox.isSet() || bbox.getWidth() <= 0.0)
+    return poly;
+
+  // calc pixel mapping for x (px = scale*x + offset)
+  double px1 = device->windowToPixel(CQChartsGeom::Point(bbox.getXMin(), 0.0)).x;
+  double px2 = device->windowToPixel(CQChartsGeom::Point(bbox.getXMax(), 0.0)).x;
+
+  double scale  = (px2 - px1)/bbox.getWidth();
+  double offset = px1 - scale*bbox.getXMin();
+
+  return decimator->decimate(poly, scale, offset);
+}
+
 //---
 
 void
@@ -479,6 +530,8 @@ addProperties()
   addProp("lines", "lines"          , "visible"   , "Lines visible");
   addProp("lines", "linesSelectable", "selectable", "Lines selectable");
   addProp("lines", "roundedLines"   , "rounded"   , "Smooth lines");
+  addProp("lines", "decimateLines"  , "decimate"  , "Decimate lines to pixel resolution");
+  addProp("lines", "decimatedPoints", ""          , "Number of drawn line points");
 
   addLineProperties("lines/stroke", "lines", "Lines");
 
@@ -654,6 +707,8 @@ calcRange() const
 
       if (plot_->isColumnSeries())
         plot_->headerSeriesData(sx_);
+
+      plot_->initColumnViews(views_);
     }
 
     State visit(const QAbstractItemModel *, const VisitData &data) override {
@@ -671,7 +726,7 @@ calcRange() const
       // get x and y values
       double x; std::vector<double> y; QModelIndex rowInd;
 
-      if (! plot_->rowData(data, x, y, rowInd, plot_->isSkipBad()))
+      if (! plot_->rowData(data, views_, x, y, rowInd, plot_->isSkipBad()))
         return State::SKIP;
 
       int ny = y.size();
@@ -723,6 +778,7 @@ calcRange() const
     Reals                 sum_;
     Reals                 lastSum_;
     std::vector<double>   sx_;
+    XYColumnViews         views_;
   };
 
   RowVisitor visitor(this);
@@ -1000,6 +1056,8 @@ createGroupSetIndPoly(GroupSetIndPoly &groupSetIndPoly) const
 
       if (plot_->isColumnSeries())
         plot_->headerSeriesData(sx_);
+
+      plot_->initColumnViews(views_);
     }
 
     State visit(const QAbstractItemModel *, const VisitData &data) override {
@@ -1018,7 +1076,7 @@ createGroupSetIndPoly(GroupSetIndPoly &groupSetIndPoly) const
       // get x and y values
       double x; std::vector<double> y; QModelIndex rowInd;
 
-      if (! plot_->rowData(data, x, y, rowInd, plot_->isSkipBad()))
+      if (! plot_->rowData(data, views_, x, y, rowInd, plot_->isSkipBad()))
         return State::SKIP;
 
       int ny = y.size();
@@ -1109,6 +1167,7 @@ createGroupSetIndPoly(GroupSetIndPoly &groupSetIndPoly) const
     const CQChartsXYPlot* plot_ { nullptr };
     int                   ns_;
     std::vector<double>   sx_;
+    XYColumnViews         views_;
     GroupSetIndPoly       groupSetPoly_;
   };
 
@@ -1448,6 +1507,10 @@ addLines(int groupInd, const SetIndPoly &setPoly, const ColorInd &ig, PlotObjs &
 
   const auto &dataRange = this->dataRange();
 
+  // cached column views for vector values
+  auto vectorXView = (isVectors() ? columnView(vectorXColumn()) : ColumnViewP());
+  auto vectorYView = (isVectors() ? columnView(vectorYColumn()) : ColumnViewP());
+
   // convert lines into set polygon and set poly lines (more than one if NaNs)
   int ns = numSets();
 
@@ -1696,7 +1759,7 @@ addLines(int groupInd, const SetIndPoly &setPoly, const ColorInd &ig, PlotObjs &
 
             CQChartsModelIndex vectorXInd(ip, vectorXColumn(), parent);
 
-            vx = modelReal(vectorXInd, ok);
+            vx = modelReal(vectorXView, vectorXInd, ok);
 
             if (! ok)
               th->addDataError(vectorXInd, "Invalid Vector X");
@@ -1707,7 +1770,7 @@ addLines(int groupInd, const SetIndPoly &setPoly, const ColorInd &ig, PlotObjs &
 
             CQChartsModelIndex vectorYInd(ip, vectorYColumn(), parent);
 
-            vy = modelReal(vectorYInd, ok);
+            vy = modelReal(vectorYView, vectorYInd, ok);
 
             if (! ok)
               th->addDataError(vectorYInd, "Invalid Vector Y");
@@ -1864,8 +1927,8 @@ headerSeriesData(std::vector<double> &x) const
 
 bool
 CQChartsXYPlot::
-rowData(const ModelVisitor::VisitData &data, double &x, std::vector<double> &y,
-        QModelIndex &ind, bool skipBad) const
+rowData(const ModelVisitor::VisitData &data, const XYColumnViews &views,
+        double &x, std::vector<double> &y, QModelIndex &ind, bool skipBad) const
 {
   auto *th = const_cast<CQChartsXYPlot *>(this);
 
@@ -1876,7 +1939,7 @@ rowData(const ModelVisitor::VisitData &data, double &x, std::vector<double> &y,
 
   ind = modelIndex(xModelInd);
 
-  bool ok1 = modelMappedReal(xModelInd, x, isLogX(), data.row);
+  bool ok1 = modelMappedReal(views.x, xModelInd, x, isLogX(), data.row);
 
   if (! ok1) {
     th->addDataError(xModelInd, "Invalid X Value");
@@ -1898,7 +1961,9 @@ rowData(const ModelVisitor::VisitData &data, double &x, std::vector<double> &y,
 
     double y1;
 
-    bool ok3 = modelMappedReal(yModelInd, y1, isLogY(), data.row);
+    auto yView = (i < int(views.y.size()) ? views.y[i] : ColumnViewP());
+
+    bool ok3 = modelMappedReal(yView, yModelInd, y1, isLogY(), data.row);
 
     if (! ok3) {
       y1 = CMathUtil::getNaN();
@@ -1918,6 +1983,20 @@ rowData(const ModelVisitor::VisitData &data, double &x, std::vector<double> &y,
   return (ok1 && ok2);
 }
 
+void
+CQChartsXYPlot::
+initColumnViews(XYColumnViews &views) const
+{
+  views.x = columnView(xColumn());
+
+  views.y.clear();
+
+  int nc = yColumns().count();
+
+  for (int i = 0; i < nc; ++i)
+    views.y.push_back(columnView(yColumns().getColumn(i)));
+}
+
 int
 CQChartsXYPlot::
 numSets() const
@@ -3212,6 +3291,7 @@ CQChartsXYPolylineObj::
 {
   delete smooth_;
   delete hull_;
+  delete decimator_;
 }
 
 QString
@@ -3481,10 +3561,24 @@ draw(CQChartsPaintDevice *device)
 
       CQChartsDrawUtil::setPenBrush(device, penBrush);
 
-      int np = poly_.size();
+      // decimate to pixel columns and only draw lines touching visible x range
+      if (! decimator_)
+        decimator_ = new CQChartsPolygonDecimator;
+
+      const auto &poly = plot()->decimatedPolygon(device, decimator_, rect(), poly_);
 
-      for (int i = 1; i < np; ++i)
-        device->drawLine(poly_.point(i - 1), poly_.point(i));
+      int i1 = 0, i2 = poly.size() - 1;
+
+      if (device->isInteractive()) {
+        auto dataRange = plot()->displayRangeBBox();
+
+        decimator_->xRange(poly, dataRange.getXMin(), dataRange.getXMax(), i1, i2);
+      }
+
+      numDrawPoints_ = std::max(i2 - i1 + 1, 0);
+
+      for (int i = i1 + 1; i <= i2; ++i)
+        device->drawLine(poly.point(i - 1), poly.point(i));
 
       device->resetColorNames();
     }
@@ -3585,6 +3679,7 @@ CQChartsXYPolygonObj::
 ~CQChartsXYPolygonObj()
 {
   delete smooth_;
+  delete decimator_;
 }
 
 QString
@@ -3715,7 +3810,15 @@ draw(CQChartsPaintDevice *device)
 
     CQChartsDrawUtil::setPenBrush(device, penBrush);
 
-    device->drawPolygon(poly_);
+    // decimate to pixel columns
+    if (! decimator_)
+      decimator_ = new CQChartsPolygonDecimator;
+
+    const auto &poly = plot()->decimatedPolygon(device, decimator_, rect(), poly_);
+
+    numDrawPoints_ = poly.size();
+
+    device->drawPolygon(poly);
 
     device->resetColorNames();
   }
@@ -1,7 +1,11 @@
 #include <CQCsvModel.h>
-#include <CCsv.h>
+#include <CQCsvParser.h>
 
+#include <QFile>
+
+#include <future>
 #include <iostream>
+#include <thread>
 
 CQCsvModel::
 CQCsvModel()
@@ -22,126 +26,435 @@ load(const QString &filename)
 
   //---
 
-  // parse file into array of fields
-  CCsv csv(filename_.toStdString());
-
-  csv.setCommentHeader  (isCommentHeader());
-  csv.setFirstLineHeader(isFirstLineHeader());
-  csv.setSeparator      (separator().toLatin1());
+  // memory map file (read into memory if map not supported)
+  QFile file(filename_);
 
-  if (! csv.load())
+  if (! file.open(QIODevice::ReadOnly))
     return false;
 
+  qint64 len = file.size();
+
+  const char *data = nullptr;
+
+  QByteArray bytes;
+
+  if (len > 0) {
+    data = reinterpret_cast<const char *>(file.map(0, len));
+
+    if (! data) {
+      bytes = file.readAll();
+
+      data = bytes.constData();
+      len  = bytes.size();
+    }
+  }
+
   //---
 
-  // get header data and rows from csv
-  const CCsv::Fields &header = csv.header();
-  const CCsv::Data   &data   = csv.data();
+  CQCsvParser parser(data, len);
+
+  parser.setSeparator(separator().toLatin1());
+
+  // when not filtering only lines up to max rows are needed
+  int maxLines = -1;
+
+  if (maxRows_ > 0 && ! hasFilter())
+    maxLines = maxRows_ + (isFirstLineHeader() ? 1 : 0);
+
+  parser.findLines(maxLines);
+
+  int nl = parser.numLines();
 
   //---
 
-  int numColumns = 0;
+  CQCsvParser::Fields fields;
 
-  // add header to model
-  if (! header.empty()) {
-    int i = 0;
+  // check if comment line is meta data start/end
+  auto isMetaStart = [&](const QString &text) { return (text.trimmed() == "META_DATA"    ); };
+  auto isMetaEnd   = [&](const QString &text) { return (text.trimmed() == "END_META_DATA"); };
 
-    for (const auto &f : header) {
-      if (i == 0 && isFirstColumnHeader()) {
-        //vheader_.push_back(f.c_str());
+  // find header lines (comment header or first line) and start of data
+  Cells header;
+
+  int  firstDataLine    = nl;
+  bool inMeta           = false;
+  bool commentHeaderSet = false;
+
+  for (int i = 0; i < nl; ++i) {
+    auto type = parser.lineType(i);
+
+    if      (type == CQCsvParser::LineType::COMMENT) {
+      QString text = parser.commentText(i);
+
+      if      (inMeta) {
+        if (isMetaEnd(text))
+          inMeta = false;
       }
-      else
-        hheader_.push_back(f.c_str());
+      else if (isMetaStart(text)) {
+        inMeta = true;
+      }
+      else if (isCommentHeader() && ! commentHeaderSet) {
+        QByteArray textBytes = text.toUtf8();
+
+        CQCsvParser::splitFields(textBytes.constData(), 0, textBytes.size(),
+                                 parser.separator(), fields);
+
+        for (const auto &f : fields)
+          header.push_back(CQCsvParser::fieldString(textBytes.constData(), f));
 
-      ++i;
+        commentHeaderSet = true;
+      }
     }
+    else if (type == CQCsvParser::LineType::DATA) {
+      if (isFirstLineHeader()) {
+        parser.lineFields(i, fields);
+
+        for (const auto &f : fields)
+          header.push_back(parser.fieldString(f));
 
-    numColumns = std::max(numColumns, int(hheader_.size()));
+        firstDataLine = i + 1;
+      }
+      else
+        firstDataLine = i;
+
+      break;
+    }
   }
 
   //---
 
-  // expand horizontal header to max number of columns
-  for (const auto &fields : data) {
-    int numFields = fields.size();
+  // add header to model
+  int fieldOffset = (isFirstColumnHeader() ? 1 : 0);
+
+  for (std::size_t i = fieldOffset; i < header.size(); ++i)
+    hheader_.push_back(header[i]);
+
+  //---
+
+  // init filter for full header (filter columns are file columns)
+  if (hasFilter())
+    initFilter();
+
+  //---
+
+  // if columns specified only read specified columns (in specified order)
+  using ColumnInds = std::vector<int>;
+
+  ColumnInds columnInds;
 
-    if (isFirstColumnHeader())
-      --numFields;
+  if (columns_.length()) {
+    Cells hheader;
 
-    numColumns = std::max(numColumns, numFields);
+    for (const auto &name : columns_) {
+      int ind = -1;
+
+      for (std::size_t c = 0; c < hheader_.size(); ++c) {
+        if (hheader_[c] == name) {
+          ind = int(c);
+          break;
+        }
+      }
+
+      // if name not found, try and convert column name to number
+      if (ind == -1) {
+        bool ok;
+
+        int ind1 = name.toInt(&ok);
+
+        if (ok && ind1 >= 0)
+          ind = ind1;
+      }
+
+      if (ind == -1) {
+        std::cerr << "Invalid column name '" << name.toStdString() << "'\n";
+        continue;
+      }
+
+      columnInds.push_back(ind);
+
+      hheader.push_back(ind < int(hheader_.size()) ? hheader_[ind] : QVariant(""));
+    }
+
+    hheader_ = hheader;
   }
 
-  while (int(hheader_.size()) < numColumns)
-    hheader_.push_back("");
+  bool filterColumns = ! columnInds.empty();
 
   //---
 
-  // add fields to model
-  int nr = 0;
+  // parse data lines in blocks (lines of each block split between threads)
+  using Ints = std::vector<int>;
 
-  for (const auto &fields : data) {
-    // get row vertical header and cells
-    Cells   cells;
-    QString vheader;
+  struct RowsData {
+    Data         rows;               //!< accepted rows
+    ColumnStores stores;             //!< accepted rows typed column values (columnar)
+    int          numRows      { 0 }; //!< number of accepted rows (columnar)
+    Cells        vheader;            //!< accepted rows vertical header
+    Ints         commentLines;       //!< comment line numbers
+    int          numFields    { 0 }; //!< max number of fields
+  };
 
-    int i = 0;
+  int numThreads = std::max(int(std::thread::hardware_concurrency()), 1);
 
-    for (const auto &f : fields) {
-      if (i == 0 && isFirstColumnHeader())
-        vheader = f.c_str();
-      else
-        cells.push_back(f.c_str());
+  // rows are parsed directly into typed column storage when columnar
+  bool columnar = isColumnar();
+
+  bool filterRows = (hasFilter() && ! filterDatas_.empty());
+
+  auto parseLines = [&](int l1, int l2, RowsData &rowsData) {
+    CQCsvParser::Fields fields;
+
+    for (int i = l1; i < l2; ++i) {
+      auto type = parser.lineType(i);
+
+      if (type == CQCsvParser::LineType::COMMENT) {
+        rowsData.commentLines.push_back(i);
+        continue;
+      }
+
+      if (type != CQCsvParser::LineType::DATA)
+        continue;
+
+      parser.lineFields(i, fields);
+
+      int numFields = int(fields.size()) - fieldOffset;
+
+      rowsData.numFields = std::max(rowsData.numFields, numFields);
+
+      // skip row if not accepted by filter (only filter fields are converted)
+      if (filterRows) {
+        bool accept = true;
+
+        for (const auto &filterData : filterDatas_) {
+          if (! filterData.valid)
+            continue;
+
+          int ind = filterData.column + fieldOffset;
+
+          QString field = (ind < int(fields.size()) ? parser.fieldString(fields[ind]) : "");
+
+          if (! filterData.regexp.exactMatch(field)) {
+            accept = false;
+            break;
+          }
+        }
+
+        if (! accept)
+          continue;
+      }
+
+      // add row vertical header
+      if (isFirstColumnHeader())
+        rowsData.vheader.push_back(! fields.empty() ? parser.fieldString(fields[0]) : QString());
+
+      // add fields to block column stores (only specified columns)
+      if (columnar) {
+        int nc = (filterColumns ? int(columnInds.size()) : std::max(numFields, 0));
 
-      ++i;
+        while (int(rowsData.stores.size()) < nc) {
+          rowsData.stores.push_back(ColumnStore());
+
+          rowsData.stores.back().nulls.resize(rowsData.numRows, ColumnStore::NULL_INVALID);
+        }
+
+        int nc1 = rowsData.stores.size();
+
+        for (int c = 0; c < nc1; ++c) {
+          int ind = (filterColumns ? columnInds[c] : c) + fieldOffset;
+
+          if (ind < int(fields.size()))
+            appendStoreString(rowsData.stores[c], parser.fieldString(fields[ind]));
+          else
+            appendStoreNull(rowsData.stores[c], ColumnStore::NULL_INVALID);
+        }
+
+        ++rowsData.numRows;
+
+        continue;
+      }
+
+      // add row cells (only specified columns)
+      Cells cells;
+
+      if (filterColumns) {
+        cells.resize(columnInds.size());
+
+        for (std::size_t c = 0; c < columnInds.size(); ++c) {
+          int ind = columnInds[c] + fieldOffset;
+
+          if (ind < int(fields.size()))
+            cells[c] = parser.fieldString(fields[ind]);
+        }
+      }
+      else {
+        cells.reserve(std::max(numFields, 0));
+
+        for (std::size_t c = fieldOffset; c < fields.size(); ++c)
+          cells.push_back(parser.fieldString(fields[c]));
+      }
+
+      rowsData.rows.push_back(std::move(cells));
     }
+  };
 
-    //---
+  Ints commentLines;
 
-    // skip row if not accepted by model
-    if (! acceptsRow(cells))
-      continue;
+  for (int i = 0; i < firstDataLine && i < nl; ++i) {
+    if (parser.lineType(i) == CQCsvParser::LineType::COMMENT)
+      commentLines.push_back(i);
+  }
+
+  int numColumns = int(hheader_.size());
+
+  int blockSize = std::max(numThreads*16384, 1);
+
+  if (columnar)
+    initColumnarLoad(numColumns);
+
+  for (int l1 = firstDataLine; l1 < nl; l1 += blockSize) {
+    int l2 = std::min(l1 + blockSize, nl);
+
+    int nt = std::min(numThreads, std::max((l2 - l1)/1024, 1));
+
+    std::vector<RowsData> rowsDatas(nt);
+
+    if (nt > 1) {
+      int d = (l2 - l1 + nt - 1)/nt;
+
+      std::vector<std::future<void>> futures;
+
+      for (int it = 0; it < nt; ++it) {
+        int i1 = l1 + it*d;
+        int i2 = std::min(i1 + d, l2);
+
+        futures.push_back(std::async(std::launch::async, [&, i1, i2, it]() {
+          parseLines(i1, i2, rowsDatas[it]);
+        }));
+      }
+
+      for (auto &future : futures)
+        future.get();
+    }
+    else
+      parseLines(l1, l2, rowsDatas[0]);
 
     //---
 
-    // add row vertical header and cells to model
-    if (isFirstColumnHeader())
-      vheader_.push_back(vheader);
+    // add rows in line order (stop if hit maximum rows)
+    bool done = false;
+
+    for (auto &rowsData : rowsDatas) {
+      if (! filterColumns)
+        numColumns = std::max(numColumns, rowsData.numFields);
+
+      commentLines.insert(commentLines.end(),
+                          rowsData.commentLines.begin(), rowsData.commentLines.end());
+
+      if (done)
+        continue;
+
+      int nr = (columnar ? rowsData.numRows : int(rowsData.rows.size()));
 
-    data_.push_back(cells);
+      if (maxRows_ > 0)
+        nr = std::min(nr, maxRows_ - rowCount());
+
+      // concatenate block column stores or add block rows
+      if (columnar) {
+        appendColumnarStores(rowsData.stores, nr);
+
+        ColumnStores().swap(rowsData.stores);
+      }
+      else {
+        for (int r = 0; r < nr; ++r)
+          data_.push_back(std::move(rowsData.rows[r]));
+      }
+
+      if (isFirstColumnHeader()) {
+        for (int r = 0; r < nr; ++r)
+          vheader_.push_back(rowsData.vheader[r]);
+      }
+
+      if (maxRows_ > 0 && rowCount() >= maxRows_)
+        done = true;
+    }
 
     //---
 
-    // stop if hit maximum rows
-    ++nr;
+    // report progress (cancel load if requested)
+    if (progressProc_ && ! progressProc_(int(100.0*l2/nl))) {
+      data_        .clear();
+      columnStores_.clear();
+      hheader_     .clear();
+      vheader_     .clear();
+
+      numRows_ = 0;
+      packed_  = false;
 
-    if (maxRows_ > 0 && nr >= maxRows_)
+      return false;
+    }
+
+    if (done)
       break;
   }
 
   //---
 
+  // expand horizontal header to max number of columns
+  while (int(hheader_.size()) < numColumns)
+    hheader_.push_back("");
+
   // expand vertical header to number of rows
-  int numRows = data_.size();
+  int numRows = rowCount();
 
   while (int(vheader_.size()) < numRows)
     vheader_.push_back("");
 
   //---
 
-  // if columns specified filter and reorder data by columns
-  if (columns_.length())
-    applyFilterColumns(columns_);
+  // clear column types
+  resetColumnTypes();
 
   //---
 
-  // clear column types
-  resetColumnTypes();
+  // get meta data fields
+  using MetaFields = std::vector<std::string>;
+  using MetaData   = std::vector<MetaFields>;
+
+  MetaData meta;
+
+  inMeta = false;
+
+  for (const auto &i : commentLines) {
+    QString text = parser.commentText(i);
+
+    if (! inMeta) {
+      if (isMetaStart(text))
+        inMeta = true;
+
+      continue;
+    }
+
+    if (isMetaEnd(text)) {
+      inMeta = false;
+      continue;
+    }
+
+    QByteArray textBytes = text.toUtf8();
+
+    CQCsvParser::splitFields(textBytes.constData(), 0, textBytes.size(),
+                             parser.separator(), fields);
+
+    MetaFields metaFields;
+
+    for (const auto &f : fields)
+      metaFields.push_back(CQCsvParser::fieldString(textBytes.constData(), f).toStdString());
+
+    meta.push_back(metaFields);
+  }
 
   //---
 
   // process meta data
-  const CCsv::Data &meta = csv.meta();
-
   if (! meta.empty()) {
     for (const auto &fields : meta) {
       int numFields = fields.size();
@@ -251,6 +564,12 @@ load(const QString &filename)
     }
   }
 
+  //---
+
+  // apply column types to typed column storage
+  if (columnar)
+    finishColumnarLoad();
+
   return true;
 }
 
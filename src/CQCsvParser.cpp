@@ -0,0 +1,292 @@
+#include <CQCsvParser.h>
+
+#include <algorithm>
+#include <future>
+#include <thread>
+
+CQCsvParser::
+CQCsvParser(const char *data, qint64 len) :
+ data_(data), len_(len)
+{
+  numThreads_ = std::max(int(std::thread::hardware_concurrency()), 1);
+}
+
+void
+CQCsvParser::
+findLines(int maxDataLines)
+{
+  lineStarts_.clear();
+
+  end_ = len_;
+
+  if (len_ <= 0)
+    return;
+
+  // parallel scan only worthwhile for large data and needs to scan whole file
+  if (maxDataLines > 0 || numThreads_ <= 1 || len_ < (1<<20))
+    findLinesSequential(maxDataLines);
+  else
+    findLinesParallel();
+}
+
+void
+CQCsvParser::
+findLinesSequential(int maxDataLines)
+{
+  bool   inQuote      = false;
+  qint64 start        = 0;
+  int    numDataLines = 0;
+
+  for (qint64 i = 0; i < len_; ++i) {
+    char c = data_[i];
+
+    if      (c == '"')
+      inQuote = ! inQuote;
+    else if (c == '\n' && ! inQuote) {
+      lineStarts_.push_back(start);
+
+      if (maxDataLines > 0 && calcLineType(start, i) == LineType::DATA) {
+        ++numDataLines;
+
+        if (numDataLines >= maxDataLines) {
+          end_ = i;
+          return;
+        }
+      }
+
+      start = i + 1;
+    }
+  }
+
+  if (start < len_)
+    lineStarts_.push_back(start);
+}
+
+void
+CQCsvParser::
+findLinesParallel()
+{
+  // newline positions for chunk with even and odd number of preceding quotes
+  struct ChunkData {
+    int      numQuotes { 0 };
+    LinePoss newLines[2];
+  };
+
+  int nc = numThreads_;
+
+  qint64 chunkSize = (len_ + nc - 1)/nc;
+
+  std::vector<ChunkData> chunks(nc);
+
+  auto scanChunk = [&](int ic) {
+    auto &chunk = chunks[ic];
+
+    qint64 i1 = ic*chunkSize;
+    qint64 i2 = std::min(i1 + chunkSize, len_);
+
+    int parity = 0;
+
+    for (qint64 i = i1; i < i2; ++i) {
+      char c = data_[i];
+
+      if      (c == '"') {
+        parity ^= 1;
+
+        ++chunk.numQuotes;
+      }
+      else if (c == '\n')
+        chunk.newLines[parity].push_back(i);
+    }
+  };
+
+  std::vector<std::future<void>> futures;
+
+  for (int ic = 0; ic < nc; ++ic)
+    futures.push_back(std::async(std::launch::async, scanChunk, ic));
+
+  for (auto &future : futures)
+    future.get();
+
+  //---
+
+  // newlines outside quotes end lines
+  lineStarts_.push_back(0);
+
+  int parity = 0;
+
+  for (const auto &chunk : chunks) {
+    for (const auto &pos : chunk.newLines[parity])
+      lineStarts_.push_back(pos + 1);
+
+    parity ^= (chunk.numQuotes & 1);
+  }
+
+  if (lineStarts_.back() >= len_)
+    lineStarts_.pop_back();
+}
+
+CQCsvParser::LineType
+CQCsvParser::
+lineType(int i) const
+{
+  qint64 start, end;
+
+  lineRange(i, start, end);
+
+  return calcLineType(start, end);
+}
+
+void
+CQCsvParser::
+lineFields(int i, Fields &fields) const
+{
+  qint64 start, end;
+
+  lineRange(i, start, end);
+
+  splitFields(data_, start, end, separator_, fields);
+}
+
+QString
+CQCsvParser::
+commentText(int i) const
+{
+  qint64 start, end;
+
+  lineRange(i, start, end);
+
+  // skip to comment char and following space
+  while (start < end && data_[start] != '#')
+    ++start;
+
+  if (start < end)
+    ++start;
+
+  while (start < end && (data_[start] == ' ' || data_[start] == '\t'))
+    ++start;
+
+  if (end > start && data_[end - 1] == '\r')
+    --end;
+
+  return QString::fromUtf8(data_ + start, int(end - start));
+}
+
+void
+CQCsvParser::
+lineRange(int i, qint64 &start, qint64 &end) const
+{
+  start = lineStarts_[i];
+  end   = (i + 1 < numLines() ? lineStarts_[i + 1] - 1 : end_);
+}
+
+CQCsvParser::LineType
+CQCsvParser::
+calcLineType(qint64 start, qint64 end) const
+{
+  qint64 i = start;
+
+  while (i < end && (data_[i] == ' ' || data_[i] == '\t' || data_[i] == '\r'))
+    ++i;
+
+  if (i >= end)
+    return LineType::BLANK;
+
+  if (data_[i] == '#')
+    return LineType::COMMENT;
+
+  return LineType::DATA;
+}
+
+void
+CQCsvParser::
+splitFields(const char *data, qint64 start, qint64 end, char separator, Fields &fields)
+{
+  fields.clear();
+
+  if (end > start && data[end - 1] == '\r')
+    --end;
+
+  qint64 i = start;
+
+  while (true) {
+    Field field;
+
+    field.pos = i;
+
+    // skip quoted text ("" is an escaped quote)
+    if (i < end && data[i] == '"') {
+      field.quoted = true;
+
+      ++i;
+
+      while (i < end) {
+        if (data[i] == '"') {
+          if (i + 1 < end && data[i + 1] == '"')
+            i += 2;
+          else {
+            ++i;
+            break;
+          }
+        }
+        else
+          ++i;
+      }
+    }
+
+    // skip to separator
+    while (i < end && data[i] != separator)
+      ++i;
+
+    field.len = int(i - field.pos);
+
+    fields.push_back(field);
+
+    if (i >= end)
+      break;
+
+    ++i; // skip separator
+  }
+}
+
+QString
+CQCsvParser::
+fieldString(const char *data, const Field &field)
+{
+  if (! field.quoted)
+    return QString::fromUtf8(data + field.pos, field.len);
+
+  // remove quotes and replace escaped quotes
+  QByteArray str;
+
+  str.reserve(field.len);
+
+  qint64 i   = field.pos + 1;
+  qint64 end = field.pos + field.len;
+
+  bool inQuote = true;
+
+  while (i < end) {
+    char c = data[i];
+
+    if (inQuote && c == '"') {
+      if (i + 1 < end && data[i + 1] == '"') {
+        str += '"';
+
+        i += 2;
+      }
+      else {
+        inQuote = false;
+
+        ++i;
+      }
+
+      continue;
+    }
+
+    str += c;
+
+    ++i;
+  }
+
+  return QString::fromUtf8(str);
+}
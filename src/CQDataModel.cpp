@@ -41,6 +41,580 @@ init(int numCols, int numRows)
 
 //------
 
+void
+CQDataModel::
+setColumnar(bool b)
+{
+  columnar_ = b;
+
+  // convert any existing data to new storage mode
+  if      (columnar_ && ! packed_ && ! data_.empty()) {
+    beginResetModel();
+
+    packColumns();
+
+    endResetModel();
+  }
+  else if (! columnar_ && packed_) {
+    beginResetModel();
+
+    unpackColumns();
+
+    endResetModel();
+  }
+}
+
+void
+CQDataModel::
+packColumns()
+{
+  int nc = hheader_.size();
+
+  initColumnarLoad(nc);
+
+  for (const auto &cells : data_)
+    appendColumnarRow(cells);
+
+  Data data;
+
+  data_.swap(data);
+
+  finishColumnarLoad();
+}
+
+void
+CQDataModel::
+initColumnarLoad(int numCols)
+{
+  columnStores_.clear();
+  columnStores_.resize(numCols);
+
+  numRows_ = 0;
+
+  packed_ = true;
+}
+
+void
+CQDataModel::
+appendColumnarRow(const Cells &cells)
+{
+  // add columns for long row (previous rows are missing values)
+  int nc = cells.size();
+
+  while (int(columnStores_.size()) < nc) {
+    columnStores_.push_back(ColumnStore());
+
+    columnStores_.back().nulls.resize(numRows_, ColumnStore::NULL_INVALID);
+  }
+
+  //---
+
+  // short rows have missing values
+  int nc1 = columnStores_.size();
+
+  for (int c = 0; c < nc1; ++c)
+    appendStoreValue(columnStores_[c], c < nc ? cells[c] : QVariant());
+
+  ++numRows_;
+}
+
+void
+CQDataModel::
+appendColumnarStores(ColumnStores &columnStores, int numRows)
+{
+  // add columns for long rows (previous rows are missing values)
+  int nc = columnStores.size();
+
+  while (int(columnStores_.size()) < nc) {
+    columnStores_.push_back(ColumnStore());
+
+    columnStores_.back().nulls.resize(numRows_, ColumnStore::NULL_INVALID);
+  }
+
+  //---
+
+  // append first numRows rows of each column (missing columns are missing values)
+  int nc1 = columnStores_.size();
+
+  for (int c = 0; c < nc1; ++c) {
+    if (c < nc)
+      appendStore(columnStores_[c], columnStores[c], numRows);
+    else {
+      for (int r = 0; r < numRows; ++r)
+        appendStoreNull(columnStores_[c], ColumnStore::NULL_INVALID);
+    }
+  }
+
+  numRows_ += numRows;
+}
+
+void
+CQDataModel::
+finishColumnarLoad()
+{
+  // apply column types (and clear cached converted values)
+  int nc = columnStores_.size();
+
+  for (int c = 0; c < nc; ++c)
+    resetColumnCache(c);
+}
+
+void
+CQDataModel::
+appendStoreValue(ColumnStore &store, const QVariant &var)
+{
+  using Type = ColumnStore::Type;
+
+  // add null (missing value)
+  if (! var.isValid()) {
+    appendStoreNull(store, ColumnStore::NULL_INVALID);
+    return;
+  }
+
+  // add string value
+  if (var.type() == QVariant::String) {
+    appendStoreString(store, var.toString());
+    return;
+  }
+
+  //---
+
+  // non-string value needs variant storage (loaded numbers were strings)
+  if (store.type == Type::INTEGER || store.type == Type::REAL)
+    convertStore(store, Type::STRING);
+
+  if (store.type != Type::VARIANT)
+    convertStore(store, Type::VARIANT);
+
+  store.variants.push_back(var);
+  store.nulls   .push_back(ColumnStore::NOT_NULL);
+}
+
+void
+CQDataModel::
+appendStoreNull(ColumnStore &store, ColumnStore::NullType nullType)
+{
+  using Type = ColumnStore::Type;
+
+  switch (store.type) {
+    case Type::INTEGER: store.integers.push_back(0        ); break;
+    case Type::REAL   : store.reals   .push_back(0.0      ); break;
+    case Type::STRING : store.codes   .push_back(-1       ); break;
+    case Type::VARIANT: store.variants.push_back(QVariant()); break;
+    default           :                                      break;
+  }
+
+  store.nulls.push_back(nullType);
+}
+
+void
+CQDataModel::
+appendStoreString(ColumnStore &store, const QString &str)
+{
+  using Type = ColumnStore::Type;
+
+  // add null (empty string)
+  if (str == "") {
+    appendStoreNull(store, ColumnStore::NULL_EMPTY);
+    return;
+  }
+
+  //---
+
+  // numeric values must round trip exactly so data() returns the same text
+  auto isInteger = [&](qint64 &i) {
+    bool ok;
+
+    i = str.toLongLong(&ok);
+
+    return (ok && QString::number(i) == str);
+  };
+
+  auto isReal = [&](double &d) {
+    bool ok;
+
+    d = toReal(str, ok);
+
+    return (ok && QVariant(d).toString() == str);
+  };
+
+  qint64 i = 0;
+  double d = 0.0;
+
+  // first value determines initial type
+  if (store.type == Type::NONE) {
+    if      (isInteger(i))
+      convertStore(store, Type::INTEGER);
+    else if (isReal(d))
+      convertStore(store, Type::REAL);
+    else
+      convertStore(store, Type::STRING);
+  }
+
+  // widen store if value doesn't fit (integer -> real -> string)
+  if (store.type == Type::INTEGER) {
+    if (isInteger(i)) {
+      store.integers.push_back(i);
+      store.nulls   .push_back(ColumnStore::NOT_NULL);
+      return;
+    }
+
+    convertStore(store, isReal(d) ? Type::REAL : Type::STRING);
+  }
+
+  if (store.type == Type::REAL) {
+    if (isReal(d)) {
+      store.reals.push_back(d);
+      store.nulls.push_back(ColumnStore::NOT_NULL);
+      return;
+    }
+
+    convertStore(store, Type::STRING);
+  }
+
+  if (store.type == Type::STRING) {
+    store.codes.push_back(stringCode(store, str));
+    store.nulls.push_back(ColumnStore::NOT_NULL);
+    return;
+  }
+
+  store.variants.push_back(QVariant(str));
+  store.nulls   .push_back(ColumnStore::NOT_NULL);
+}
+
+void
+CQDataModel::
+appendStore(ColumnStore &store, ColumnStore &store1, int n)
+{
+  using Type = ColumnStore::Type;
+
+  n = std::min(n, store1.size());
+
+  if (n <= 0)
+    return;
+
+  //---
+
+  // widen both stores to common type (integer -> real -> string -> variant)
+  auto typeRank = [](Type type) {
+    switch (type) {
+      case Type::INTEGER: return 1;
+      case Type::REAL   : return 2;
+      case Type::STRING : return 3;
+      case Type::VARIANT: return 4;
+      default           : return 0;
+    }
+  };
+
+  auto widenStore = [&](ColumnStore &store2, Type type) {
+    // variant values of numeric store are the loaded strings
+    if (type == Type::VARIANT && (store2.type == Type::INTEGER || store2.type == Type::REAL))
+      convertStore(store2, Type::STRING);
+
+    convertStore(store2, type);
+  };
+
+  // repeat as integer to real can fall back to string
+  while (store.type != store1.type) {
+    if      (store.type  == Type::NONE) widenStore(store , store1.type);
+    else if (store1.type == Type::NONE) widenStore(store1, store .type);
+    else if (typeRank(store.type) < typeRank(store1.type))
+      widenStore(store , store1.type);
+    else
+      widenStore(store1, store .type);
+  }
+
+  //---
+
+  // append values (string codes are remapped to store dictionary)
+  switch (store.type) {
+    case Type::INTEGER:
+      store.integers.insert(store.integers.end(),
+                            store1.integers.begin(), store1.integers.begin() + n);
+      break;
+    case Type::REAL:
+      store.reals.insert(store.reals.end(), store1.reals.begin(), store1.reals.begin() + n);
+      break;
+    case Type::STRING: {
+      std::vector<int> codeMap(store1.strings.size());
+
+      for (std::size_t i = 0; i < store1.strings.size(); ++i)
+        codeMap[i] = stringCode(store, store1.strings[i]);
+
+      for (int r = 0; r < n; ++r) {
+        int code = store1.codes[r];
+
+        store.codes.push_back(code >= 0 ? codeMap[code] : -1);
+      }
+
+      break;
+    }
+    case Type::VARIANT:
+      store.variants.insert(store.variants.end(),
+                            store1.variants.begin(), store1.variants.begin() + n);
+      break;
+    default:
+      break;
+  }
+
+  store.nulls.insert(store.nulls.end(), store1.nulls.begin(), store1.nulls.begin() + n);
+}
+
+void
+CQDataModel::
+applyStoreColumnType(ColumnStore &store, CQBaseModelType type)
+{
+  using Type = ColumnStore::Type;
+
+  // untyped column keeps inferred storage
+  if      (type == CQBaseModelType::NONE)
+    return;
+  // integer column can't have (non-integer) real values
+  else if (type == CQBaseModelType::INTEGER) {
+    if (store.type == Type::REAL)
+      convertStore(store, Type::STRING);
+  }
+  // real column stores integer values as reals (if they round trip)
+  else if (type == CQBaseModelType::REAL) {
+    if (store.type == Type::INTEGER)
+      convertStore(store, Type::REAL);
+  }
+  // other types are converted from strings
+  else {
+    if (store.type == Type::INTEGER || store.type == Type::REAL)
+      convertStore(store, Type::STRING);
+  }
+}
+
+void
+CQDataModel::
+convertStore(ColumnStore &store, ColumnStore::Type type)
+{
+  using Type = ColumnStore::Type;
+
+  if (store.type == type)
+    return;
+
+  int nr = store.size();
+
+  // integer to real only if all values round trip (otherwise string)
+  if (store.type == Type::INTEGER && type == Type::REAL) {
+    ColumnStore::Reals reals;
+
+    reals.resize(nr);
+
+    for (int r = 0; r < nr; ++r) {
+      if (store.nulls[r] != ColumnStore::NOT_NULL)
+        continue;
+
+      qint64 i = store.integers[r];
+
+      reals[r] = double(i);
+
+      if (QVariant(reals[r]).toString() != QString::number(i)) {
+        convertStore(store, Type::STRING);
+        return;
+      }
+    }
+
+    store.reals.swap(reals);
+
+    ColumnStore::Integers().swap(store.integers);
+
+    store.type = Type::REAL;
+
+    return;
+  }
+
+  //---
+
+  // get current values (numeric values are strings so text is unchanged)
+  Cells values;
+
+  if (store.type != Type::NONE) {
+    values.resize(nr);
+
+    for (int r = 0; r < nr; ++r) {
+      if (store.nulls[r] != ColumnStore::NOT_NULL)
+        continue;
+
+      if (type == Type::STRING)
+        values[r] = storeValue(store, r).toString();
+      else
+        values[r] = storeValue(store, r);
+    }
+  }
+
+  ColumnStore store1;
+
+  store1.type = type;
+
+  store1.nulls.swap(store.nulls);
+
+  switch (type) {
+    case Type::INTEGER: store1.integers.resize(nr, 0  ); break;
+    case Type::REAL   : store1.reals   .resize(nr, 0.0); break;
+    case Type::STRING : store1.codes   .resize(nr, -1 ); break;
+    case Type::VARIANT: store1.variants.resize(nr     ); break;
+    default           :                                  break;
+  }
+
+  for (int r = 0; r < nr && ! values.empty(); ++r) {
+    if (store1.nulls[r] != ColumnStore::NOT_NULL)
+      continue;
+
+    if      (type == Type::STRING)
+      store1.codes[r] = stringCode(store1, values[r].toString());
+    else if (type == Type::VARIANT)
+      store1.variants[r] = values[r];
+  }
+
+  store = std::move(store1);
+}
+
+QVariant
+CQDataModel::
+storeValue(const ColumnStore &store, int r)
+{
+  using Type = ColumnStore::Type;
+
+  // null values are the same as row storage (empty string or invalid)
+  if (store.nulls[r] == ColumnStore::NULL_EMPTY)
+    return QVariant(QString(""));
+
+  if (store.nulls[r] == ColumnStore::NULL_INVALID)
+    return QVariant();
+
+  switch (store.type) {
+    case Type::INTEGER: return QVariant(store.integers[r]);
+    case Type::REAL   : return QVariant(store.reals[r]);
+    case Type::STRING : return QVariant(store.strings[store.codes[r]]);
+    case Type::VARIANT: return store.variants[r];
+    default           : return QVariant();
+  }
+}
+
+int
+CQDataModel::
+stringCode(ColumnStore &store, const QString &str)
+{
+  auto p = store.stringInds.find(str);
+
+  if (p != store.stringInds.end())
+    return p.value();
+
+  int ind = int(store.strings.size());
+
+  store.strings.push_back(str);
+
+  store.stringInds.insert(str, ind);
+
+  return ind;
+}
+
+void
+CQDataModel::
+unpackColumns()
+{
+  int nc = columnStores_.size();
+  int nr = numRows_;
+
+  data_.clear();
+  data_.resize(nr);
+
+  for (int r = 0; r < nr; ++r) {
+    Cells &cells = data_[r];
+
+    cells.resize(nc);
+
+    for (int c = 0; c < nc; ++c)
+      cells[c] = cellValue(r, c);
+  }
+
+  columnStores_.clear();
+
+  numRows_ = 0;
+
+  packed_ = false;
+}
+
+bool
+CQDataModel::
+isValidCell(int r, int c) const
+{
+  if (r < 0 || c < 0)
+    return false;
+
+  if (packed_)
+    return (r < numRows_ && c < int(columnStores_.size()));
+
+  if (r >= int(data_.size()))
+    return false;
+
+  return (c < int(data_[r].size()));
+}
+
+QVariant
+CQDataModel::
+cellValue(int r, int c) const
+{
+  if (! packed_)
+    return data_[r][c];
+
+  return storeValue(columnStores_[c], r);
+}
+
+void
+CQDataModel::
+setCellValue(int r, int c, const QVariant &value)
+{
+  if (! packed_) {
+    data_[r][c] = value;
+    return;
+  }
+
+  using Type = ColumnStore::Type;
+
+  ColumnStore &store = columnStores_[c];
+
+  // null value (empty string or invalid) in typed array
+  bool isInvalid = ! value.isValid();
+
+  if (store.type != Type::VARIANT &&
+      (isInvalid || (value.type() == QVariant::String && value.toString() == ""))) {
+    store.nulls[r] = (isInvalid ? ColumnStore::NULL_INVALID : ColumnStore::NULL_EMPTY);
+    return;
+  }
+
+  // store in typed array if value has matching type
+  if      (store.type == Type::INTEGER &&
+           (value.type() == QVariant::Int || value.type() == QVariant::LongLong)) {
+    store.integers[r] = value.toLongLong();
+    store.nulls   [r] = ColumnStore::NOT_NULL;
+    return;
+  }
+  else if (store.type == Type::REAL && value.type() == QVariant::Double) {
+    store.reals[r] = value.toDouble();
+    store.nulls[r] = ColumnStore::NOT_NULL;
+    return;
+  }
+  else if (store.type == Type::STRING && value.type() == QVariant::String) {
+    store.codes[r] = stringCode(store, value.toString());
+    store.nulls[r] = ColumnStore::NOT_NULL;
+    return;
+  }
+
+  //---
+
+  // type mismatch so convert column to variants
+  convertStore(store, Type::VARIANT);
+
+  store.variants[r] = value;
+  store.nulls   [r] = ColumnStore::NOT_NULL;
+}
+
+//------
+
 void
 CQDataModel::
 initFilter()
@@ -152,6 +726,9 @@ rowCount(const QModelIndex &parent) const
   if (parent.isValid())
     return 0;
 
+  if (packed_)
+    return numRows_;
+
   return data_.size();
 }
 
@@ -289,16 +866,7 @@ data(const QModelIndex &index, int role) const
   int r = index.row();
   int c = index.column();
 
-  int nr = data_.size();
-
-  if (r < 0 || r >= nr)
-    return QVariant();
-
-  const Cells &cells = data_[r];
-
-  int nc = int(cells.size());
-
-  if (c < 0 || c >= nc)
+  if (! isValidCell(r, c))
     return QVariant();
 
   //---
@@ -334,7 +902,7 @@ data(const QModelIndex &index, int role) const
   //---
 
   if      (role == Qt::DisplayRole) {
-    return cells[c];
+    return cellValue(r, c);
   }
   else if (role == Qt::EditRole) {
     CQBaseModelType type = columnType(c);
@@ -348,7 +916,7 @@ data(const QModelIndex &index, int role) const
     }
 
     // not cached so get raw value
-    var = cells[c];
+    var = cellValue(r, c);
 
     // column has no type or already correct type then just return
     if (type == CQBaseModelType::NONE || isSameType(var, type))
@@ -366,7 +934,7 @@ data(const QModelIndex &index, int role) const
     return var;
   }
   else if (role == Qt::ToolTipRole) {
-    return cells[c];
+    return cellValue(r, c);
   }
   else if (role == int(CQBaseModelRole::RawValue) ||
            role == int(CQBaseModelRole::IntermediateValue) ||
@@ -378,7 +946,7 @@ data(const QModelIndex &index, int role) const
       return var;
 
     if (role == int(CQBaseModelRole::RawValue)) {
-      return cells[c];
+      return cellValue(r, c);
     }
 
     return QVariant();
@@ -410,14 +978,7 @@ setData(const QModelIndex &index, const QVariant &value, int role)
   int r = index.row();
   int c = index.column();
 
-  int nr = data_.size();
-
-  if (r >= nr)
-    return false;
-
-  Cells &cells = data_[r];
-
-  if (c >= int(cells.size()))
+  if (! isValidCell(r, c))
     return false;
 
   //---
@@ -453,14 +1014,14 @@ setData(const QModelIndex &index, const QVariant &value, int role)
   if      (role == Qt::DisplayRole) {
     //CQBaseModelType type = columnType(c);
 
-    cells[c] = value;
+    setCellValue(r, c, value);
 
     emit dataChanged(index, index, QVector<int>(1, role));
   }
   else if (role == Qt::EditRole) {
     //CQBaseModelType type = columnType(c);
 
-    cells[c] = value;
+    setCellValue(r, c, value);
 
     clearRowRoleValue(r, int(CQBaseModelRole::RawValue));
     clearRowRoleValue(r, int(CQBaseModelRole::IntermediateValue));
@@ -520,6 +1081,10 @@ void
 CQDataModel::
 resetColumnCache(int column)
 {
+  // update columnar storage for (new) column type
+  if (packed_ && column >= 0 && column < int(columnStores_.size()))
+    applyStoreColumnType(columnStores_[column], columnType(column));
+
   std::unique_lock<std::mutex> lock(mutex_);
 
   ColumnData &columnData = getColumnData(column);
@@ -605,6 +1170,37 @@ applyFilterColumns(const QStringList &columns)
       ++nc2;
   }
 
+  // remap horizontal header and column data (columnar)
+  if (packed_) {
+    ColumnStores columnStores;
+
+    columnStores_.swap(columnStores);
+
+    hheader_.clear(); hheader_.resize(nc2);
+
+    columnStores_.resize(nc2);
+
+    for (int c = 0; c < nc1; ++c) {
+      int c1 = columnMap[c];
+
+      if (c1 < 0 || c1 >= nc1)
+        continue;
+
+      hheader_[c1] = hheader[c];
+
+      if (c < int(columnStores.size()))
+        columnStores_[c1] = std::move(columnStores[c]);
+    }
+
+    // missing columns are all null
+    for (auto &store : columnStores_) {
+      if (store.size() < numRows_)
+        store.nulls.resize(numRows_, ColumnStore::NULL_INVALID);
+    }
+
+    return;
+  }
+
   // remap horizontal header and row data
   hheader_.clear(); hheader_.resize(nc2);
 
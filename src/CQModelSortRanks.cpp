@@ -0,0 +1,442 @@
+#include <CQModelSortRanks.h>
+
+#include <QAbstractItemModel>
+#include <QHash>
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <iterator>
+#include <thread>
+
+namespace {
+
+// min number of rows for parallel sort
+const int minParallelRows = 16384;
+
+}
+
+//---
+
+CQModelSortRanks::
+CQModelSortRanks()
+{
+  numThreads_ = std::max(int(std::thread::hardware_concurrency()), 1);
+}
+
+void
+CQModelSortRanks::
+reset()
+{
+  columns_.clear();
+  ranks_  .clear();
+  keys_   .clear();
+  rows_   .clear();
+
+  valid_ = false;
+}
+
+bool
+CQModelSortRanks::
+calc(const QAbstractItemModel *model, const Columns &columns, int role)
+{
+  columns_ = columns;
+  role_    = role;
+
+  ranks_.clear();
+  keys_ .clear();
+  rows_ .clear();
+
+  valid_ = false;
+
+  if (! model || columns.empty())
+    return false;
+
+  int nr = model->rowCount();
+  int nc = model->columnCount();
+
+  for (const auto &column : columns) {
+    if (column < 0 || column >= nc)
+      return false;
+  }
+
+  //---
+
+  // extract typed key values (model only accessed from this thread)
+  keys_.resize(columns.size());
+
+  for (std::size_t i = 0; i < columns.size(); ++i)
+    calcKey(model, columns[i], role, nr, keys_[i]);
+
+  //---
+
+  // sort rows by key
+  rows_.resize(nr);
+
+  for (int r = 0; r < nr; ++r)
+    rows_[r] = r;
+
+  sortRows(keys_, rows_);
+
+  calcRanks();
+
+  valid_ = true;
+
+  return true;
+}
+
+bool
+CQModelSortRanks::
+updateRows(const QAbstractItemModel *model, int row1, int row2)
+{
+  if (! valid_ || ! model)
+    return recalc(model);
+
+  int nr = int(ranks_.size());
+
+  if (model->rowCount() != nr || row1 < 0 || row2 >= nr || row1 > row2)
+    return recalc(model);
+
+  //---
+
+  // update key values of changed rows (recalc if new value doesn't fit key type)
+  for (std::size_t i = 0; i < columns_.size(); ++i) {
+    for (int r = row1; r <= row2; ++r) {
+      if (! updateKey(keys_[i], r, keyValue(model, r, columns_[i], role_)))
+        return recalc(model);
+    }
+  }
+
+  //---
+
+  // remove changed rows from sorted rows and merge back in sorted changed rows
+  auto rowLess = [&](int r1, int r2) { return (cmpRows(keys_, r1, r2) < 0); };
+
+  rows_.erase(std::remove_if(rows_.begin(), rows_.end(), [&](int r) {
+    return (r >= row1 && r <= row2); }), rows_.end());
+
+  Rows changedRows;
+
+  for (int r = row1; r <= row2; ++r)
+    changedRows.push_back(r);
+
+  std::stable_sort(changedRows.begin(), changedRows.end(), rowLess);
+
+  Rows rows;
+
+  rows.reserve(nr);
+
+  std::merge(rows_.begin(), rows_.end(), changedRows.begin(), changedRows.end(),
+             std::back_inserter(rows), rowLess);
+
+  rows_.swap(rows);
+
+  calcRanks();
+
+  return true;
+}
+
+void
+CQModelSortRanks::
+calcRanks()
+{
+  // rows with equal keys share rank of first row
+  int nr = int(rows_.size());
+
+  ranks_.resize(nr);
+
+  for (int i = 0; i < nr; ++i) {
+    if (i > 0 && cmpRows(keys_, rows_[i - 1], rows_[i]) == 0)
+      ranks_[rows_[i]] = ranks_[rows_[i - 1]];
+    else
+      ranks_[rows_[i]] = i;
+  }
+}
+
+QVariant
+CQModelSortRanks::
+keyValue(const QAbstractItemModel *model, int row, int column, int role) const
+{
+  QModelIndex ind = model->index(row, column, QModelIndex());
+
+  QVariant var = model->data(ind, role);
+
+  if (! var.isValid())
+    var = model->data(ind, Qt::DisplayRole);
+
+  return var;
+}
+
+void
+CQModelSortRanks::
+calcKey(const QAbstractItemModel *model, int column, int role, int nr, Key &key) const
+{
+  key.vars.resize(nr);
+
+  bool isReal   = true;
+  bool isString = true;
+
+  for (int r = 0; r < nr; ++r) {
+    QVariant var = keyValue(model, r, column, role);
+
+    if (! isNumeric(var))
+      isReal = false;
+
+    if (var.type() != QVariant::String)
+      isString = false;
+
+    key.vars[r] = var;
+  }
+
+  //---
+
+  if      (isReal) {
+    key.type = Key::Type::REAL;
+
+    key.reals.resize(nr);
+
+    for (int r = 0; r < nr; ++r)
+      key.reals[r] = key.vars[r].toDouble();
+
+    key.vars.clear();
+  }
+  else if (isString) {
+    key.type = Key::Type::CODE;
+
+    // sorted dictionary of unique strings (strings which compare equal share a code)
+    auto &strCodes = key.strCodes;
+
+    strCodes.clear();
+
+    for (int r = 0; r < nr; ++r)
+      strCodes[key.vars[r].toString()] = 0;
+
+    QStringList strs = strCodes.keys();
+
+    std::sort(strs.begin(), strs.end(), [&](const QString &str1, const QString &str2) {
+      return (cmpString(str1, str2, caseSensitivity_, localeAware_) < 0);
+    });
+
+    int code = 0;
+
+    for (int i = 0; i < strs.size(); ++i) {
+      if (i > 0 && cmpString(strs[i - 1], strs[i], caseSensitivity_, localeAware_) != 0)
+        ++code;
+
+      strCodes[strs[i]] = code;
+    }
+
+    key.codes.resize(nr);
+
+    for (int r = 0; r < nr; ++r)
+      key.codes[r] = strCodes[key.vars[r].toString()];
+
+    key.vars.clear();
+  }
+  else
+    key.type = Key::Type::VARIANT;
+}
+
+bool
+CQModelSortRanks::
+updateKey(Key &key, int row, const QVariant &var) const
+{
+  if      (key.type == Key::Type::REAL) {
+    if (! isNumeric(var))
+      return false;
+
+    key.reals[row] = var.toDouble();
+  }
+  else if (key.type == Key::Type::CODE) {
+    // new strings need a new dictionary
+    if (var.type() != QVariant::String)
+      return false;
+
+    auto p = key.strCodes.find(var.toString());
+
+    if (p == key.strCodes.end())
+      return false;
+
+    key.codes[row] = p.value();
+  }
+  else
+    key.vars[row] = var;
+
+  return true;
+}
+
+int
+CQModelSortRanks::
+cmpRows(const Keys &keys, int row1, int row2) const
+{
+  for (const auto &key : keys) {
+    if      (key.type == Key::Type::REAL) {
+      double r1 = key.reals[row1];
+      double r2 = key.reals[row2];
+
+      // NaN sorts after all numbers
+      bool nan1 = std::isnan(r1);
+      bool nan2 = std::isnan(r2);
+
+      if (nan1 || nan2) {
+        if (nan1 != nan2)
+          return (nan1 ? 1 : -1);
+
+        continue;
+      }
+
+      if (r1 < r2) return -1;
+      if (r1 > r2) return  1;
+    }
+    else if (key.type == Key::Type::CODE) {
+      int i1 = key.codes[row1];
+      int i2 = key.codes[row2];
+
+      if (i1 < i2) return -1;
+      if (i1 > i2) return  1;
+    }
+    else {
+      const auto &var1 = key.vars[row1];
+      const auto &var2 = key.vars[row2];
+
+      int rc = (cmpFn_ ? cmpFn_(var1, var2) :
+                         cmpVariant(var1, var2, caseSensitivity_, localeAware_));
+
+      if (rc != 0)
+        return rc;
+    }
+  }
+
+  return 0;
+}
+
+void
+CQModelSortRanks::
+sortRows(const Keys &keys, std::vector<int> &rows) const
+{
+  auto rowLess = [&](int row1, int row2) { return (cmpRows(keys, row1, row2) < 0); };
+
+  int n = int(rows.size());
+
+  int nt = (n >= minParallelRows ? numThreads_ : 1);
+
+  if (nt <= 1) {
+    std::stable_sort(rows.begin(), rows.end(), rowLess);
+    return;
+  }
+
+  // stable sort chunks in parallel
+  std::vector<int> bounds;
+
+  for (int i = 0; i < nt; ++i)
+    bounds.push_back(int((long(i)*n)/nt));
+
+  bounds.push_back(n);
+
+  std::vector<std::future<void>> futures;
+
+  for (int i = 0; i < nt; ++i) {
+    futures.push_back(std::async(std::launch::async, [&, i]() {
+      std::stable_sort(rows.begin() + bounds[i], rows.begin() + bounds[i + 1], rowLess);
+    }));
+  }
+
+  for (auto &future : futures)
+    future.get();
+
+  // merge adjacent chunks (stable)
+  for (int step = 1; step < nt; step *= 2) {
+    for (int i = 0; i + step < nt; i += 2*step) {
+      int j = std::min(i + 2*step, nt);
+
+      std::inplace_merge(rows.begin() + bounds[i], rows.begin() + bounds[i + step],
+                         rows.begin() + bounds[j], rowLess);
+    }
+  }
+}
+
+bool
+CQModelSortRanks::
+lessThan(const QModelIndex &lhs, const QModelIndex &rhs, bool &ok) const
+{
+  ok = false;
+
+  if (! valid_)
+    return false;
+
+  const auto *model = lhs.model();
+
+  if (! model || lhs.parent().isValid() || rhs.parent().isValid())
+    return false;
+
+  int nr = int(ranks_.size());
+
+  // ranks must match current rows
+  if (model->rowCount() != nr)
+    return false;
+
+  int row1 = lhs.row();
+  int row2 = rhs.row();
+
+  if (row1 < 0 || row1 >= nr || row2 < 0 || row2 >= nr)
+    return false;
+
+  ok = true;
+
+  return (ranks_[row1] < ranks_[row2]);
+}
+
+int
+CQModelSortRanks::
+cmpVariant(const QVariant &var1, const QVariant &var2, Qt::CaseSensitivity cs, bool localeAware)
+{
+  bool isNumber1 = isNumeric(var1);
+  bool isNumber2 = isNumeric(var2);
+
+  if (isNumber1 && isNumber2) {
+    double r1 = var1.toDouble();
+    double r2 = var2.toDouble();
+
+    if (r1 < r2) return -1;
+    if (r1 > r2) return  1;
+
+    return 0;
+  }
+
+  if (var1.type() != var2.type())
+    return (var1.type() < var2.type() ? -1 : 1);
+
+  return cmpString(var1.toString(), var2.toString(), cs, localeAware);
+}
+
+int
+CQModelSortRanks::
+cmpString(const QString &str1, const QString &str2, Qt::CaseSensitivity cs, bool localeAware)
+{
+  // match QSortFilterProxyModel string compare
+  int rc = (localeAware ? QString::localeAwareCompare(str1, str2) :
+                          QString::compare(str1, str2, cs));
+
+  return (rc < 0 ? -1 : (rc > 0 ? 1 : 0));
+}
+
+bool
+CQModelSortRanks::
+isNumeric(const QVariant &var)
+{
+  switch (int(var.type())) {
+    case QMetaType::Bool:
+    case QMetaType::Int:
+    case QMetaType::UInt:
+    case QMetaType::LongLong:
+    case QMetaType::ULongLong:
+    case QMetaType::Double:
+    case QMetaType::Float:
+    case QMetaType::Short:
+    case QMetaType::UShort:
+    case QMetaType::Long:
+    case QMetaType::ULong:
+      return true;
+    default:
+      return false;
+  }
+}
@@ -1,6 +1,16 @@
 #include <CQPivotModel.h>
+#include <algorithm>
+#include <future>
+#include <thread>
 #include <assert.h>
 
+namespace {
+
+// min number of rows for parallel calc
+const int minParallelRows = 16384;
+
+}
+
 //------
 
 CQPivotModel::
@@ -51,9 +61,9 @@ columnCount(const QModelIndex &parent) const
 
   // keys + vertical header + totals
   if (isIncludeTotals())
-    return hColKeys_.size() + 2;
+    return hColKeys_.length() + 2;
   else
-    return hColKeys_.size() + 1;
+    return hColKeys_.length() + 1;
 }
 
 // get number of child rows for parent
@@ -71,9 +81,9 @@ rowCount(const QModelIndex &parent) const
 
   // keys + totals
   if (isIncludeTotals())
-    return vRowKeys_.size() + 1;
+    return vRowKeys_.length() + 1;
   else
-    return vRowKeys_.size();
+    return vRowKeys_.length();
 }
 
 // get child node for row/column of parent
@@ -134,10 +144,9 @@ data(const QModelIndex &index, int role) const
           return "Totals";
       }
 
-      auto pv = vRowKeys_.find(r);
-      assert(pv != vRowKeys_.end());
+      assert(r < vRowKeys_.length());
 
-      return (*pv).second.key();
+      return vRowKeys_[r];
     }
     else
       return CQBaseModel::data(index, role);
@@ -177,28 +186,16 @@ data(const QModelIndex &index, int role) const
   // grid data
   int c1 = c - 1;
 
-  auto pv = vRowKeys_.find(r);
-  assert(pv != vRowKeys_.end());
-
-  auto ph = hColKeys_.find(c1);
-  assert(ph != hColKeys_.end());
-
-  const Keys &vkeys = (*pv).second;
-  const Keys &hkeys = (*ph).second;
+  assert(r < vRowKeys_.length() && c1 < hColKeys_.length());
 
   if (role == Qt::DisplayRole || role == Qt::EditRole || role == Qt::ToolTipRole) {
-    auto p = values_.find(hkeys.key());
-    if (p == values_.end()) return QVariant();
+    const auto *values = cellValues(c1, r);
+    if (! values) return QVariant();
 
-    auto p1 = (*p).second.find(vkeys.key());
-    if (p1 == (*p).second.end()) return QVariant();
-
-    const Values &values = (*p1).second;
-
-    if      (values.count() != 0)
-      return typeValue(values);
-    else if (values.rcount())
-      return values.rcount();
+    if      (values->count() != 0)
+      return typeValue(*values);
+    else if (values->rcount())
+      return values->rcount();
     else
       return QVariant();
 
@@ -276,11 +273,10 @@ headerData(int section, Qt::Orientation orientation, int role) const
     // horizontal keys
     int section1 = section - 1;
 
-    auto ph = hColKeys_.find(section1);
-    assert(ph != hColKeys_.end());
+    assert(section1 < hColKeys_.length());
 
     if (role == Qt::DisplayRole || role == Qt::EditRole)
-      return (*ph).second.key();
+      return hColKeys_[section1];
     else
       return CQBaseModel::headerData(section, orientation, role);
   }
@@ -344,15 +340,31 @@ bool
 CQPivotModel::
 modelInds(const QString &hkey, const QString &vkey, Inds &inds) const
 {
-  auto p = values_.find(hkey);
-  if (p == values_.end()) return false;
+  // value rows are only stored once model indices have been requested
+  if (! keepRows_) {
+    auto *th = const_cast<CQPivotModel *>(this);
+
+    th->keepRows_   = true;
+    th->modelValid_ = false;
+  }
+
+  updateModel();
 
-  auto p1 = (*p).second.find(vkey);
-  if (p1 == (*p).second.end()) return false;
+  auto ph = hKeysCol_.find(hkey);
+  if (ph == hKeysCol_.end()) return false;
 
-  const Values &values = (*p1).second;
+  auto pv = vKeysRow_.find(vkey);
+  if (pv == vKeysRow_.end()) return false;
 
-  inds = values.inds();
+  const auto *values = cellValues(ph.value(), pv.value());
+  if (! values) return false;
+
+  QAbstractItemModel *sm = sourceModel();
+
+  inds.clear();
+
+  for (const auto &row : values->rows())
+    inds.push_back(sm->index(row, valueColumn_));
 
   return true;
 }
@@ -379,62 +391,104 @@ updateModel()
 {
   modelValid_ = true;
 
-  hKeysCol_.clear();
-  hColKeys_.clear();
-  vKeysRow_.clear();
-  vRowKeys_.clear();
-  values_  .clear();
+  hKeysCol_  .clear();
+  hColKeys_  .clear();
+  vKeysRow_  .clear();
+  vRowKeys_  .clear();
+  cellValues_.clear();
 
   QAbstractItemModel *sm = sourceModel();
 
   int nr = sm->rowCount();
 
-  for (int row = 0; row < nr; ++row) {
-    Keys hkeys;
+  //---
 
-    for (auto &column : hColumns_) {
-      QModelIndex ind = sm->index(row, column);
+  // partition cells for parallel calc
+  int np = (nr >= minParallelRows ? std::max(int(std::thread::hardware_concurrency()), 1) : 1);
 
-      QVariant data = sm->data(ind);
+  cellValues_.resize(np);
 
-      if (data.isValid())
-        hkeys.add(data.toString());
-    }
+  std::vector<Rows> partitionRows(np);
 
-    //---
+  //---
+
+  // encode rows (key column values are dictionary encoded and each unique key tuple is
+  // mapped to its key string once)
+  Dictionaries hdicts(hColumns_.size());
+  Dictionaries vdicts(vColumns_.size());
+  Dictionary   sdict;
 
-    Keys vkeys;
+  KeyTable htable, vtable;
 
-    for (auto &column : vColumns_) {
-      QModelIndex ind = sm->index(row, column);
+  Rows htableCol, vtableRow;
 
-      QVariant data = sm->data(ind).toString();
+  Codes hcodes(hColumns_.size()), vcodes(vColumns_.size());
 
-      if (data.isValid())
-        vkeys.add(data.toString());
+  auto addKey = [&](const Dictionaries &dicts, const Codes &codes,
+                    KeyInd &keyInd, QStringList &indKeys) {
+    QString key;
+
+    for (std::size_t i = 0; i < codes.size(); ++i) {
+      if (codes[i] < 0)
+        continue;
+
+      if (key != "")
+        key += "/";
+
+      key += dicts[i].str(codes[i]);
     }
 
-    //---
+    auto p = keyInd.find(key);
+
+    if (p == keyInd.end()) {
+      p = keyInd.insert(key, indKeys.length());
+
+      indKeys.push_back(key);
+    }
+
+    return p.value();
+  };
+
+  bool isUnique = (valueType() == ValueType::COUNT_UNIQUE);
+
+  RowDatas rowDatas(nr);
+
+  for (int row = 0; row < nr; ++row) {
+    auto &rowData = rowDatas[row];
 
-    auto ph = hKeysCol_.find(hkeys.key());
+    for (std::size_t i = 0; i < hColumns_.size(); ++i) {
+      QModelIndex ind = sm->index(row, hColumns_[i]);
 
-    if (ph == hKeysCol_.end()) {
-      int col = hKeysCol_.size();
+      QVariant data = sm->data(ind);
 
-      hKeysCol_[hkeys.key()] = col;
-      hColKeys_[col        ] = hkeys;
+      hcodes[i] = (data.isValid() ? hdicts[i].code(data.toString()) : -1);
     }
 
-    auto pv = vKeysRow_.find(vkeys.key());
+    bool added;
+
+    int hid = htable.id(hcodes, added);
 
-    if (pv == vKeysRow_.end()) {
-      int row = vKeysRow_.size();
+    if (added)
+      htableCol.push_back(addKey(hdicts, hcodes, hKeysCol_, hColKeys_));
+
+    rowData.hkey = htableCol[hid];
+
+    //---
 
-      vKeysRow_[vkeys.key()] = row;
-      vRowKeys_[row        ] = vkeys;
+    for (std::size_t i = 0; i < vColumns_.size(); ++i) {
+      QModelIndex ind = sm->index(row, vColumns_[i]);
+
+      vcodes[i] = vdicts[i].code(sm->data(ind).toString());
     }
 
-    Values &values = values_[hkeys.key()][vkeys.key()];
+    int vid = vtable.id(vcodes, added);
+
+    if (added)
+      vtableRow.push_back(addKey(vdicts, vcodes, vKeysRow_, vRowKeys_));
+
+    rowData.vkey = vtableRow[vid];
+
+    //---
 
     if (valueColumn_ >= 0) {
       QModelIndex ind = sm->index(row, valueColumn_);
@@ -444,18 +498,42 @@ updateModel()
       if (data.isValid()) {
         bool ok;
 
-        double r = data.toReal(&ok);
+        rowData.r = data.toReal(&ok);
+
+        rowData.flags |= RowData::VALID;
 
         if (ok)
-          values.add(r);
+          rowData.flags |= RowData::REAL;
 
-        values.add(ind, data.toString());
+        if (isUnique)
+          rowData.str = sdict.code(data.toString());
       }
     }
-    else {
-      values.add(1);
+
+    //---
+
+    int ip = cellPartition(cellKey(rowData.hkey, rowData.vkey));
+
+    partitionRows[ip].push_back(row);
+  }
+
+  //---
+
+  // calc cell values for each partition
+  if (np > 1) {
+    std::vector<std::future<void>> futures;
+
+    for (int ip = 0; ip < np; ++ip) {
+      futures.push_back(std::async(std::launch::async, [&, ip]() {
+        calcCellValues(rowDatas, partitionRows[ip], cellValues_[ip]);
+      }));
     }
+
+    for (auto &future : futures)
+      future.get();
   }
+  else
+    calcCellValues(rowDatas, partitionRows[0], cellValues_[0]);
 
   //---
 
@@ -465,106 +543,146 @@ updateModel()
   //---
 
   // set horizontal header (keys)
-  Keys hkeys;
+  QString hheader;
 
   for (auto &column : hColumns_) {
     QString value = sm->headerData(column, Qt::Horizontal).toString();
 
-    hkeys.add(value);
+    if (hheader != "")
+      hheader += "/";
+
+    hheader += value;
   }
 
-  hheader_ = hkeys.key();
+  hheader_ = hheader;
 
   //---
 
   // set vertical header (keys)
-  Keys vkeys;
+  QString vheader;
 
   for (auto &column : vColumns_) {
     QString value = sm->headerData(column, Qt::Horizontal).toString();
 
-    vkeys.add(value);
+    if (vheader != "")
+      vheader += "/";
+
+    vheader += value;
   }
 
-  vheader_ = vkeys.key();
+  vheader_ = vheader;
 }
 
 void
 CQPivotModel::
-calcData()
+calcCellValues(const RowDatas &rowDatas, const Rows &rows, CellValues &cellValues) const
 {
-  int nr = vKeysRow_.size();
+  bool isUnique = (valueType() == ValueType::COUNT_UNIQUE);
+  bool isMedian = (valueType() == ValueType::MEDIAN);
 
-  vdata_.resize(nr);
+  for (const auto &row : rows) {
+    const auto &rowData = rowDatas[row];
 
-  for (const auto &pv : vKeysRow_) {
-    const QString &vkey = pv.first;
-    int            r    = pv.second;
+    auto &values = cellValues[cellKey(rowData.hkey, rowData.vkey)];
 
-    ValueData data;
+    if (valueColumn_ >= 0) {
+      if (rowData.flags & RowData::VALID) {
+        if (rowData.flags & RowData::REAL)
+          values.addReal(rowData.r, isMedian);
 
-    for (const auto &ph : hKeysCol_) {
-      const QString &hkey = ph.first;
+        values.addValue(row, rowData.str, isUnique, keepRows_);
+      }
+    }
+    else {
+      values.addReal(1, isMedian);
+    }
+  }
 
-      const Values &values = values_[hkey][vkey];
+  if (isUnique) {
+    for (auto &pc : cellValues)
+      pc.second.calcUnique();
+  }
+}
 
-      if      (values.count() != 0) {
-        double value = typeValue(values);
+int
+CQPivotModel::
+cellPartition(qint64 key) const
+{
+  int np = cellValues_.size();
 
-        data.min  = (data.set ? std::min(data.min, value) : value);
-        data.max  = (data.set ? std::max(data.max, value) : value);
-        data.sum += value;
-        data.set  = true;
-      }
-      else if (values.rcount()) {
-        data.min  = 0;
-        data.max  = 1;
-        data.sum += values.rcount();
-        data.set  = true;
-      }
-    }
+  if (np <= 1)
+    return 0;
 
-    assert(r >= 0 && r < nr);
+  // mix key bits so partitions are balanced for sequential keys
+  quint64 h = quint64(key)*0x9E3779B97F4A7C15ULL;
 
-    vdata_[r] = data;
-  }
+  return int((h >> 32) % quint64(np));
+}
 
-  //---
+const CQPivotModel::Values *
+CQPivotModel::
+cellValues(int hkey, int vkey) const
+{
+  if (cellValues_.empty())
+    return nullptr;
+
+  qint64 key = cellKey(hkey, vkey);
+
+  const auto &cellValues = cellValues_[cellPartition(key)];
+
+  auto p = cellValues.find(key);
+  if (p == cellValues.end()) return nullptr;
+
+  return &(*p).second;
+}
 
-  int nc = hKeysCol_.size();
+void
+CQPivotModel::
+calcData()
+{
+  int nr = vRowKeys_.length();
+  int nc = hColKeys_.length();
+
+  vdata_.clear();
+  hdata_.clear();
 
+  vdata_.resize(nr);
   hdata_.resize(nc);
 
-  for (const auto &ph : hKeysCol_) {
-    const QString &hkey = ph.first;
-    int            c    = ph.second;
+  auto addValue = [&](ValueData &data, double value) {
+    data.min  = (data.set ? std::min(data.min, value) : value);
+    data.max  = (data.set ? std::max(data.max, value) : value);
+    data.sum += value;
+    data.set  = true;
+  };
 
-    ValueData data;
+  auto addCount = [&](ValueData &data, int count) {
+    data.min  = 0;
+    data.max  = 1;
+    data.sum += count;
+    data.set  = true;
+  };
 
-    for (const auto &pv : vKeysRow_) {
-      const QString &vkey = pv.first;
+  for (const auto &cellValues : cellValues_) {
+    for (const auto &pc : cellValues) {
+      int c = int(pc.first >> 32);
+      int r = int(pc.first & 0xFFFFFFFF);
 
-      const Values &values = values_[hkey][vkey];
+      assert(r >= 0 && r < nr && c >= 0 && c < nc);
+
+      const Values &values = pc.second;
 
       if      (values.count() != 0) {
         double value = typeValue(values);
 
-        data.min = (data.set ? std::min(data.min, value) : value);
-        data.max = (data.set ? std::max(data.max, value) : value);
-        data.sum = value;
-        data.set = true;
+        addValue(vdata_[r], value);
+        addValue(hdata_[c], value);
       }
       else if (values.rcount()) {
-        data.min  = 0;
-        data.max  = 1;
-        data.sum += values.rcount();
-        data.set  = true;
+        addCount(vdata_[r], values.rcount());
+        addCount(hdata_[c], values.rcount());
       }
     }
-
-    assert(c >= 0 && c < nc);
-
-    hdata_[c] = data;
   }
 
   //---
@@ -572,9 +690,12 @@ calcData()
   data_ = ValueData();
 
   for (const auto &d : vdata_) {
+    if (! d.set)
+      continue;
+
     data_.min  = (data_.set ? std::min(data_.min, d.min) : d.min);
     data_.max  = (data_.set ? std::max(data_.max, d.max) : d.max);
-    data_.sum  = d.sum;
+    data_.sum += d.sum;
     data_.set  = true;
   }
 }
@@ -591,6 +712,8 @@ typeValue(const Values &values) const
     return values.max();
   else if (valueType() == ValueType::MEAN)
     return values.mean();
+  else if (valueType() == ValueType::MEDIAN)
+    return values.median();
   else if (valueType() == ValueType::COUNT)
     return values.count();
   else if (valueType() == ValueType::COUNT_UNIQUE)
@@ -607,16 +730,10 @@ hkeys(bool sorted) const
 {
   updateModel();
 
-  QStringList strs;
+  QStringList strs = hColKeys_;
 
-  if (sorted) {
-    for (const auto &ph : hKeysCol_)
-      strs << ph.first;
-  }
-  else {
-    for (const auto &ph : hColKeys_)
-      strs << ph.second.key();
-  }
+  if (sorted)
+    std::sort(strs.begin(), strs.end());
 
   return strs;
 }
@@ -627,16 +744,10 @@ vkeys(bool sorted) const
 {
   updateModel();
 
-  QStringList strs;
+  QStringList strs = vRowKeys_;
 
-  if (sorted) {
-    for (const auto &ph : vKeysRow_)
-      strs << ph.first;
-  }
-  else {
-    for (const auto &ph : vRowKeys_)
-      strs << ph.second.key();
-  }
+  if (sorted)
+    std::sort(strs.begin(), strs.end());
 
   return strs;
 }
@@ -650,7 +761,7 @@ hkeyCol(const QString &key) const
   auto p = hKeysCol_.find(key);
   if (p == hKeysCol_.end()) return -1;
 
-  return (*p).second;
+  return p.value();
 }
 
 int
@@ -662,7 +773,7 @@ vkeyRow(const QString &key) const
   auto p = vKeysRow_.find(key);
   if (p == vKeysRow_.end()) return -1;
 
-  return (*p).second;
+  return p.value();
 }
 
 double
@@ -700,3 +811,150 @@ vmax(int r) const
 
   return vdata_[r].max;
 }
+
+//------
+
+int
+CQPivotModel::Dictionary::
+code(const QString &str)
+{
+  auto p = codes_.find(str);
+
+  if (p == codes_.end()) {
+    p = codes_.insert(str, strs_.length());
+
+    strs_.push_back(str);
+  }
+
+  return p.value();
+}
+
+//------
+
+std::size_t
+CQPivotModel::KeyTable::CodesHash::
+operator()(const Codes &codes) const
+{
+  std::size_t h = codes.size();
+
+  for (const auto &code : codes)
+    h ^= std::size_t(code) + 0x9E3779B9 + (h << 6) + (h >> 2);
+
+  return h;
+}
+
+int
+CQPivotModel::KeyTable::
+id(const Codes &codes, bool &added)
+{
+  auto p = ids_.find(codes);
+
+  added = (p == ids_.end());
+
+  if (added)
+    p = ids_.insert(p, CodesIds::value_type(codes, int(ids_.size())));
+
+  return (*p).second;
+}
+
+//------
+
+void
+CQPivotModel::Values::
+calcUnique()
+{
+  std::sort(strs_.begin(), strs_.end());
+
+  countUnique_ = int(std::unique(strs_.begin(), strs_.end()) - strs_.begin());
+
+  // codes no longer needed
+  Codes().swap(strs_);
+}
+
+//------
+
+void
+CQPivotModel::MedianSketch::
+add(double r)
+{
+  // store first five values
+  if (n_ < 5) {
+    q_[n_++] = r;
+
+    if (n_ == 5)
+      std::sort(q_, q_ + 5);
+
+    return;
+  }
+
+  ++n_;
+
+  //---
+
+  // find cell containing value (update min/max markers)
+  int k;
+
+  if      (r < q_[0]) { q_[0] = r; k = 0; }
+  else if (r < q_[1]) { k = 0; }
+  else if (r < q_[2]) { k = 1; }
+  else if (r < q_[3]) { k = 2; }
+  else if (r < q_[4]) { k = 3; }
+  else                { q_[4] = r; k = 3; }
+
+  for (int i = k + 1; i < 5; ++i)
+    pos_[i] += 1.0;
+
+  // desired positions for min, p/2, p, (1 + p)/2, max (p = 0.5)
+  static const double dn[5] = { 0.0, 0.25, 0.5, 0.75, 1.0 };
+
+  for (int i = 0; i < 5; ++i)
+    npos_[i] += dn[i];
+
+  //---
+
+  // adjust middle marker heights
+  for (int i = 1; i < 4; ++i) {
+    double d = npos_[i] - pos_[i];
+
+    if ((d >=  1.0 && pos_[i + 1] - pos_[i] >  1.0) ||
+        (d <= -1.0 && pos_[i - 1] - pos_[i] < -1.0)) {
+      int id = (d >= 0.0 ? 1 : -1);
+
+      // piecewise parabolic prediction
+      double qp = q_[i] + id/(pos_[i + 1] - pos_[i - 1])*
+        ((pos_[i] - pos_[i - 1] + id)*(q_[i + 1] - q_[i])/(pos_[i + 1] - pos_[i]) +
+         (pos_[i + 1] - pos_[i] - id)*(q_[i] - q_[i - 1])/(pos_[i] - pos_[i - 1]));
+
+      // use linear prediction if parabolic is out of order
+      if (q_[i - 1] < qp && qp < q_[i + 1])
+        q_[i] = qp;
+      else
+        q_[i] += id*(q_[i + id] - q_[i])/(pos_[i + id] - pos_[i]);
+
+      pos_[i] += id;
+    }
+  }
+}
+
+double
+CQPivotModel::MedianSketch::
+value() const
+{
+  if (n_ == 0)
+    return 0.0;
+
+  if (n_ >= 5)
+    return q_[2];
+
+  // exact median of stored values
+  double q[5];
+
+  std::copy(q_, q_ + n_, q);
+
+  std::sort(q, q + n_);
+
+  if (n_ & 1)
+    return q[n_/2];
+
+  return (q[n_/2 - 1] + q[n_/2])/2.0;
+}
@@ -9,6 +9,37 @@ CQSortModel(QAbstractItemModel *model) :
   setSourceModel(model);
 }
 
+void
+CQSortModel::
+setSourceModel(QAbstractItemModel *model)
+{
+  auto *oldModel = sourceModel();
+
+  if (oldModel) {
+    disconnect(oldModel, SIGNAL(dataChanged(const QModelIndex &, const QModelIndex &)),
+               this, SLOT(sourceDataChangedSlot(const QModelIndex &, const QModelIndex &)));
+    disconnect(oldModel, SIGNAL(rowsInserted(const QModelIndex &, int, int)),
+               this, SLOT(sourceRowsChangedSlot()));
+    disconnect(oldModel, SIGNAL(rowsRemoved(const QModelIndex &, int, int)),
+               this, SLOT(sourceRowsChangedSlot()));
+    disconnect(oldModel, SIGNAL(modelReset()), this, SLOT(sourceRowsChangedSlot()));
+  }
+
+  QSortFilterProxyModel::setSourceModel(model);
+
+  sortRanks_.reset();
+
+  if (model) {
+    connect(model, SIGNAL(dataChanged(const QModelIndex &, const QModelIndex &)),
+            this, SLOT(sourceDataChangedSlot(const QModelIndex &, const QModelIndex &)));
+    connect(model, SIGNAL(rowsInserted(const QModelIndex &, int, int)),
+            this, SLOT(sourceRowsChangedSlot()));
+    connect(model, SIGNAL(rowsRemoved(const QModelIndex &, int, int)),
+            this, SLOT(sourceRowsChangedSlot()));
+    connect(model, SIGNAL(modelReset()), this, SLOT(sourceRowsChangedSlot()));
+  }
+}
+
 void
 CQSortModel::
 setFilter(const QString &filter)
@@ -45,3 +76,82 @@ setFilter(const QString &filter)
     setFilterWildcard(filter_);
   }
 }
+
+void
+CQSortModel::
+sort(int column, Qt::SortOrder order)
+{
+  std::vector<int> columns;
+
+  if (column >= 0)
+    columns.push_back(column);
+
+  sortColumns(columns, order);
+}
+
+void
+CQSortModel::
+sortColumns(const std::vector<int> &columns, Qt::SortOrder order)
+{
+  int column = (! columns.empty() ? columns[0] : -1);
+
+  // calc key ranks of source rows (sort compares ranks)
+  if (column >= 0) {
+    sortRanks_.setCaseSensitivity(sortCaseSensitivity());
+    sortRanks_.setLocaleAware    (isSortLocaleAware());
+
+    sortRanks_.calc(sourceModel(), columns, sortRole());
+  }
+  else
+    sortRanks_.reset();
+
+  QSortFilterProxyModel::sort(column, order);
+}
+
+bool
+CQSortModel::
+lessThan(const QModelIndex &lhs, const QModelIndex &rhs) const
+{
+  bool ok;
+
+  bool rc = sortRanks_.lessThan(lhs, rhs, ok);
+
+  if (ok)
+    return rc;
+
+  return QSortFilterProxyModel::lessThan(lhs, rhs);
+}
+
+void
+CQSortModel::
+sourceDataChangedSlot(const QModelIndex &from, const QModelIndex &to)
+{
+  if (! sortRanks_.isValid())
+    return;
+
+  // ranks are for top level rows
+  if (from.parent().isValid())
+    return;
+
+  for (const auto &column : sortRanks_.columns()) {
+    if (column >= from.column() && column <= to.column()) {
+      sortRanks_.updateRows(sourceModel(), from.row(), to.row());
+
+      invalidate();
+
+      break;
+    }
+  }
+}
+
+void
+CQSortModel::
+sourceRowsChangedSlot()
+{
+  if (! sortRanks_.isValid())
+    return;
+
+  sortRanks_.recalc(sourceModel());
+
+  invalidate();
+}
@@ -1,26 +1,10 @@
 #include <CQSummaryModel.h>
-#include <random>
-#include <set>
+#include <algorithm>
+#include <cmath>
 #include <cassert>
 
 namespace {
 
-class RandInRange {
- public:
-  RandInRange(int min, int max) :
-   eng_(rd_()), idis_(min, max) {
-  }
-
-  int gen() {
-    return idis_(eng_);
-  }
-
- private:
-  std::random_device                 rd_;
-  std::default_random_engine         eng_;
-  std::uniform_int_distribution<int> idis_;
-};
-
 inline bool variantReal(const QVariant &var, double &r) {
   if (var.type() == QVariant::Int   ) { r = var.toInt   (); return true; }
   if (var.type() == QVariant::Double) { r = var.toDouble(); return true; }
@@ -72,7 +56,20 @@ void
 CQSummaryModel::
 setSourceModel(QAbstractItemModel *sourceModel)
 {
+  auto *oldModel = this->sourceModel();
+
+  if (oldModel)
+    disconnect(oldModel, nullptr, this, nullptr);
+
   QAbstractProxyModel::setSourceModel(sourceModel);
+
+  if (sourceModel) {
+    connect(sourceModel, SIGNAL(rowsInserted(const QModelIndex &, int, int)),
+            this, SLOT(sourceRowsInsertedSlot(const QModelIndex &, int, int)));
+    connect(sourceModel, SIGNAL(rowsRemoved(const QModelIndex &, int, int)),
+            this, SLOT(sourceResetSlot()));
+    connect(sourceModel, SIGNAL(modelReset()), this, SLOT(sourceResetSlot()));
+  }
 }
 
 //---
@@ -108,6 +105,38 @@ setMaxRows(int maxRows)
 
 //---
 
+// random
+
+void
+CQSummaryModel::
+setRandomSeed(int i)
+{
+  if (i != randomSeed_) {
+    randomSeed_ = i;
+
+    if (isSampleMode())
+      resetMapping();
+  }
+}
+
+//---
+
+// stratified
+
+void
+CQSummaryModel::
+setGroupColumn(int c)
+{
+  if (c != groupColumn_) {
+    groupColumn_ = c;
+
+    if (mode() == Mode::STRATIFIED)
+      resetMapping();
+  }
+}
+
+//---
+
 // sort
 
 void
@@ -220,60 +249,19 @@ initMapping()
 
   //---
 
-  if      (mode() == Mode::RANDOM) {
-    // if summary count greater or equal to actual count then nothing to do
-    if (maxRows() >= nr) {
+  if      (isSampleMode()) {
+    initSample();
+
+    if (! isValidSample()) {
       mapValid_ = true;
       mapNone_  = true;
       return;
     }
 
-    // create set of random rows (sorted)
-    int nr1 = nr - maxRows();
-
-    bool invert = (nr1 < nr/2);
-
-    RowSet rowSet;
+    // single pass reservoir sample of all rows
+    addSampleRows(0, nr);
 
-    if (! invert)
-      randRows(rowSet, maxRows(), nr);
-    else
-      randRows(rowSet, nr1, nr);
-
-    //---
-
-    // create mapping
-    rowInds_.resize(maxRows());
-
-    if (! invert) {
-      int i = 0;
-
-      for (const auto &r : rowSet) {
-        rowInds_[i] = r;
-        indRows_[r] = i;
-
-        ++i;
-      }
-    }
-    else {
-      int i = 0;
-
-      for (int r = 0; r < nr; ++r) {
-        auto p = rowSet.find(r);
-
-        if (p != rowSet.end())
-          continue;
-
-        rowInds_[i] = r;
-        indRows_[r] = i;
-
-        ++i;
-      }
-    }
-
-    assert(int(indRows_.size()) == maxRows());
-
-    mapValid_ = true;
+    updateSampleMapping();
   }
   else if (mode() == Mode::SORTED) {
     int nc = (model ? model->columnCount() : 0);
@@ -342,28 +330,264 @@ initMapping()
 
 void
 CQSummaryModel::
-randRows(RowSet &rowSet, int n, int nr) const
+initSample()
+{
+  if (randomSeed() >= 0)
+    randEngine_.seed(randomSeed());
+  else
+    randEngine_.seed(std::random_device()());
+
+  sample_ = Sample();
+
+  groupSamples_.clear();
+}
+
+bool
+CQSummaryModel::
+isValidSample() const
+{
+  if (mode() != Mode::STRATIFIED)
+    return true;
+
+  auto *model = this->sourceModel();
+
+  int nc = (model ? model->columnCount() : 0);
+
+  return (groupColumn() >= 0 && groupColumn() < nc);
+}
+
+void
+CQSummaryModel::
+addSampleRows(int row1, int row2)
 {
-  // create set of random rows (sorted)
-  RandInRange rand(0, nr - 1);
+  int n = maxRows();
+
+  // reservoir sample with geometric skips (Algorithm L) so only replaced rows are visited
+  auto addRandomRows = [&](Sample &sample) {
+    auto updateSkip = [&]() {
+      sample.w *= std::exp(std::log(randReal())/n);
+
+      sample.nextRow += int(std::floor(std::log(randReal())/std::log(1.0 - sample.w))) + 1;
+    };
 
-  int numRandom = 0;
+    for (int r = row1; r < row2 && int(sample.rows.size()) < n; ++r) {
+      sample.rows.push_back(r);
 
-  int iters = 0;
+      if (int(sample.rows.size()) == n) {
+        sample.nextRow = r;
 
-  while (numRandom < n) {
-    int r = rand.gen();
+        updateSkip();
+      }
+    }
 
-    auto p = rowSet.find(r);
+    if (int(sample.rows.size()) == n) {
+      while (sample.nextRow < row2) {
+        if (sample.nextRow >= row1) {
+          std::uniform_int_distribution<int> idis(0, n - 1);
 
-    if (p == rowSet.end()) {
-      rowSet.insert(r);
+          sample.rows[idis(randEngine_)] = sample.nextRow;
+        }
 
-      ++numRandom;
+        updateSkip();
+      }
     }
 
-    ++iters;
+    sample.numRows = std::max(sample.numRows, row2);
+  };
+
+  // reservoir sample per group (Algorithm R, each row needs group value).
+  // Reservoir is kept in random order (new rows added at random position) so any
+  // prefix is also a uniform sample of the group
+  auto addGroupRows = [&]() {
+    auto *model = this->sourceModel();
+
+    for (int r = row1; r < row2; ++r) {
+      QModelIndex ind = model->index(r, groupColumn(), QModelIndex());
+
+      QVariant var = model->data(ind, Qt::EditRole);
+
+      if (! var.isValid())
+        var = model->data(ind, Qt::DisplayRole);
+
+      auto &sample = groupSamples_[var.toString()];
+
+      if (int(sample.rows.size()) < n) {
+        sample.rows.push_back(r);
+
+        std::uniform_int_distribution<int> idis(0, int(sample.rows.size()) - 1);
+
+        std::swap(sample.rows.back(), sample.rows[idis(randEngine_)]);
+      }
+      else {
+        std::uniform_int_distribution<int> idis(0, sample.numRows);
+
+        int j = idis(randEngine_);
+
+        if (j < n)
+          sample.rows[j] = r;
+      }
+
+      ++sample.numRows;
+    }
+
+    sample_.numRows = std::max(sample_.numRows, row2);
+  };
+
+  if (mode() == Mode::STRATIFIED)
+    addGroupRows();
+  else
+    addRandomRows(sample_);
+}
+
+void
+CQSummaryModel::
+updateSampleMapping()
+{
+  rowInds_.clear();
+  indRows_.clear();
+
+  mapValid_ = true;
+  mapNone_  = false;
+
+  int n  = maxRows();
+  int nr = sample_.numRows;
+
+  // if summary count greater or equal to actual count then nothing to do
+  if (n >= nr) {
+    mapNone_ = true;
+    return;
+  }
+
+  //---
+
+  if (mode() == Mode::STRATIFIED) {
+    // allocate sample rows to groups in proportion to group size using largest remainder
+    int ng = int(groupSamples_.size());
+
+    std::vector<int>    groupAlloc    (ng, 0);
+    std::vector<double> groupRemainder(ng, 0.0);
+
+    int numAlloc = 0;
+    int ig       = 0;
+
+    for (const auto &pg : groupSamples_) {
+      double quota = double(n)*pg.second.numRows/nr;
+
+      int iquota = int(std::floor(quota));
+
+      groupAlloc    [ig] = iquota;
+      groupRemainder[ig] = quota - iquota;
+
+      numAlloc += iquota;
+
+      ++ig;
+    }
+
+    std::vector<int> inds(ng);
+
+    for (int i = 0; i < ng; ++i)
+      inds[i] = i;
+
+    std::stable_sort(inds.begin(), inds.end(), [&](int i1, int i2) {
+      return groupRemainder[i1] > groupRemainder[i2]; });
+
+    for (int i = 0; i < ng && numAlloc < n; ++i) {
+      ++groupAlloc[inds[i]];
+      ++numAlloc;
+    }
+
+    //---
+
+    // use prefix of each (randomly ordered) group sample so rows are only re-randomised
+    // when the group sample or allocation changes
+    ig = 0;
+
+    for (const auto &pg : groupSamples_) {
+      const RowInds &rows = pg.second.rows;
+
+      int na = std::min(groupAlloc[ig++], int(rows.size()));
+
+      rowInds_.insert(rowInds_.end(), rows.begin(), rows.begin() + na);
+    }
+  }
+  else
+    rowInds_ = sample_.rows;
+
+  //---
+
+  // create mapping (source row order)
+  std::sort(rowInds_.begin(), rowInds_.end());
+
+  int i = 0;
+
+  for (const auto &r : rowInds_)
+    indRows_[r] = i++;
+}
+
+double
+CQSummaryModel::
+randReal()
+{
+  // random real in (0, 1)
+  std::uniform_real_distribution<double> rdis(0.0, 1.0);
+
+  double r = 0.0;
+
+  while (r <= 0.0)
+    r = rdis(randEngine_);
+
+  return r;
+}
+
+//---
+
+void
+CQSummaryModel::
+sourceRowsInsertedSlot(const QModelIndex &parent, int first, int last)
+{
+  // update sample incrementally for appended rows
+  if (isSampleMode() && mapValid_ && isValidSample() &&
+      ! parent.isValid() && first == sample_.numRows) {
+    beginResetModel();
+
+    addSampleRows(first, last + 1);
+
+    updateSampleMapping();
+
+    endResetModel();
   }
+  else
+    resetMapping();
+}
+
+void
+CQSummaryModel::
+sourceResetSlot()
+{
+  resetMapping();
+}
+
+//---
+
+int
+CQSummaryModel::
+sourceRowCount() const
+{
+  auto *model = this->sourceModel();
+
+  return (model ? model->rowCount() : 0);
+}
+
+double
+CQSummaryModel::
+sampleFraction() const
+{
+  int nr = sourceRowCount();
+
+  if (nr <= 0)
+    return 1.0;
+
+  return std::min(double(rowCount())/nr, 1.0);
 }
 
 //------
@@ -73,6 +73,12 @@ load(const QString &filename)
 
   //---
 
+  // rows are added directly to typed column storage when columnar
+  bool columnar = isColumnar();
+
+  if (columnar)
+    initColumnarLoad(numColumns);
+
   // add fields to model
   for (const auto &fields : data) {
     Cells   cells;
@@ -101,13 +107,16 @@ load(const QString &filename)
     if (isFirstColumnHeader())
       vheader_.push_back(vheader);
 
-    data_.push_back(cells);
+    if (columnar)
+      appendColumnarRow(cells);
+    else
+      data_.push_back(cells);
   }
 
   //---
 
   // expand vertical header to max number of rows
-  int numRows = data_.size();
+  int numRows = rowCount();
 
   while (int(vheader_.size()) < numRows)
     vheader_.push_back("");
@@ -123,6 +132,12 @@ load(const QString &filename)
   // clear column types
   resetColumnTypes();
 
+  //---
+
+  // apply column types to typed column storage
+  if (columnar)
+    finishColumnarLoad();
+
   return true;
 }
 
@@ -20,11 +20,13 @@
 #include <CQChartsModelDetails.h>
 #include <CQChartsColumnType.h>
 #include <CQChartsValueSet.h>
+#include <CQChartsDensity.h>
 #include <CQChartsArrow.h>
 #include <CQChartsDataLabel.h>
 #include <CQChartsModelUtil.h>
 #include <CQChartsVariant.h>
 #include <CQChartsInterfaceTheme.h>
+#include <CQChartsTextCache.h>
 
 #include <CQChartsLoadModelDlg.h>
 #include <CQChartsManageModelsDlg.h>
@@ -210,6 +212,8 @@ addCommands()
     //addCommand("charts::test_edit", new CQChartsTestEditCmd(this));
     addCommand("test_charts_edit", new CQChartsTestEditCmd(this));
 
+    addCommand("test_charts_density", new CQChartsTestDensityCmd(this));
+
     //---
 
     cmdBase_->addCommands();
@@ -265,6 +269,7 @@ loadChartsModelCmd(CQChartsCmdArgs &argv)
   argv.addCmdArg("-separator", CQChartsCmdArg::Type::String , "separator char for csv");
   argv.addCmdArg("-columns"  , CQChartsCmdArg::Type::String , "columns to load");
   argv.addCmdArg("-transpose", CQChartsCmdArg::Type::Boolean, "transpose tcl data");
+  argv.addCmdArg("-columnar" , CQChartsCmdArg::Type::Boolean, "store csv/tsv data in typed columns");
 
   argv.addCmdArg("-num_rows"   , CQChartsCmdArg::Type::Integer, "number of expression rows");
   argv.addCmdArg("-max_rows"   , CQChartsCmdArg::Type::Integer, "maximum number of file rows");
@@ -336,6 +341,7 @@ loadChartsModelCmd(CQChartsCmdArgs &argv)
     return errorMsg(QString("Invalid columns string '%1'").arg(columnsStr));
 
   inputData.transpose = argv.getParseBool("transpose");
+  inputData.columnar  = argv.getParseBool("columnar");
 
   if (argv.hasParseArg("num_rows"))
     inputData.numRows = std::max(argv.getParseInt("num_rows"), 1);
@@ -3247,6 +3253,7 @@ sortChartsModelCmd(CQChartsCmdArgs &argv)
 
   argv.addCmdArg("-model"     , CQChartsCmdArg::Type::Integer, "model id");
   argv.addCmdArg("-column"    , CQChartsCmdArg::Type::Column , "column to sort");
+  argv.addCmdArg("-columns"   , CQChartsCmdArg::Type::String , "key columns to sort");
   argv.addCmdArg("-decreasing", CQChartsCmdArg::Type::Boolean, "invert sort");
 
   bool rc;
@@ -3267,13 +3274,35 @@ sortChartsModelCmd(CQChartsCmdArgs &argv)
 
   ModelP model = modelData->currentModel();
 
-  CQChartsColumn column = argv.getParseColumn("column", model.data());
+  std::vector<int> columns;
+
+  if (argv.hasParseArg("columns")) {
+    QString columnsStr = argv.getParseStr("columns");
+
+    std::vector<CQChartsColumn> columns1;
+
+    if (! CQChartsModelUtil::stringToColumns(model.data(), columnsStr, columns1))
+      return errorMsg("Bad columns name '" + columnsStr + "'");
+
+    for (const auto &column : columns1) {
+      if (column.type() != CQChartsColumn::Type::DATA)
+        return errorMsg("Bad sort column '" + column.toString() + "'");
+
+      columns.push_back(column.column());
+    }
+  }
+  else {
+    CQChartsColumn column = argv.getParseColumn("column", model.data());
+
+    columns.push_back(column.column());
+  }
 
   //---
 
   Qt::SortOrder order = (decreasing ? Qt::DescendingOrder : Qt::AscendingOrder);
 
-  sortModel(model, column.column(), order);
+  if (! sortModel(model, columns, order))
+    return errorMsg("Multi column sort not supported for model");
 
   return true;
 }
@@ -4061,6 +4090,8 @@ createChartsPivotModelCmd(CQChartsCmdArgs &argv)
       pivotModel->setValueType(CQPivotModel::ValueType::MAX);
     else if (valueTypeStr == "mean")
       pivotModel->setValueType(CQPivotModel::ValueType::MEAN);
+    else if (valueTypeStr == "median")
+      pivotModel->setValueType(CQPivotModel::ValueType::MEDIAN);
   }
 
   if (argv.hasParseArg("include_totals"))
@@ -4946,6 +4977,9 @@ getChartsDataCmd(CQChartsCmdArgs &argv)
 
       return cmdBase_->setCmdRc(str);
     }
+    else if (name == "script_compact") {
+      return cmdBase_->setCmdRc(view->isScriptCompact());
+    }
     else if (name == "mouse_press") {
       auto p = view->mousePressPoint();
 
@@ -5452,10 +5486,21 @@ getChartsDataCmd(CQChartsCmdArgs &argv)
     else if (name == "role_names") {
       return cmdBase_->setCmdRc(CQChartsModelUtil::roleNames());
     }
+    else if (name == "text_cache_stats") {
+      // number of entries, hits and misses
+      auto *textCache = CQChartsTextCacheInst;
+
+      QVariantList vars;
+
+      vars << textCache->numEntries() << textCache->numHits() << textCache->numMisses();
+
+      return cmdBase_->setCmdRc(vars);
+    }
     else if (name == "?") {
       QStringList names = QStringList() <<
        "models" << "views" << "plot_types" << "plots" << "current_model" <<
-       "column_types" << "column_type.names" << "column_type.descs" << "annotation_types";
+       "column_types" << "column_type.names" << "column_type.descs" << "annotation_types" <<
+       "text_cache_stats";
 
       return cmdBase_->setCmdRc(names);
     }
@@ -5666,6 +5711,14 @@ setChartsDataCmd(CQChartsCmdArgs &argv)
     else if (name == "script_select_proc") {
       view->setScriptSelectProc(value);
     }
+    else if (name == "script_compact") {
+      bool ok;
+
+      bool b = CQChartsCmdBaseArgs::stringToBool(value, &ok);
+      if (! ok) return errorMsg(QString("Invalid boolean '%1'").arg(value));
+
+      view->setScriptCompact(b);
+    }
     else if (name == "?") {
       QStringList names = QStringList() <<
        "fit";
@@ -8068,14 +8121,21 @@ printChartsImageCmd(CQChartsCmdArgs &argv)
   CQPerfTrace trace("CQChartsCmds::printChartsImageCmd");
 
   argv.startCmdGroup(CQChartsCmdGroup::Type::OneReq);
-  argv.addCmdArg("-view", CQChartsCmdArg::Type::String, "view name");
-  argv.addCmdArg("-plot", CQChartsCmdArg::Type::String, "plot name");
+  argv.addCmdArg("-view" , CQChartsCmdArg::Type::String, "view name");
+  argv.addCmdArg("-plot" , CQChartsCmdArg::Type::String, "plot name");
+  argv.addCmdArg("-views", CQChartsCmdArg::Type::String, "list of view names");
   argv.endCmdGroup();
 
-  argv.addCmdArg("-file", CQChartsCmdArg::Type::String, "filename").setRequired();
+  argv.addCmdArg("-file", CQChartsCmdArg::Type::String, "filename (list for -views)").
+    setRequired();
 
   argv.addCmdArg("-layer", CQChartsCmdArg::Type::String, "layer name");
 
+  argv.addCmdArg("-width"  , CQChartsCmdArg::Type::Integer, "pixel width");
+  argv.addCmdArg("-height" , CQChartsCmdArg::Type::Integer, "pixel height");
+  argv.addCmdArg("-dpi"    , CQChartsCmdArg::Type::Real   , "dots per inch");
+  argv.addCmdArg("-threads", CQChartsCmdArg::Type::Integer, "number of paint and file write threads");
+
   bool rc;
 
   if (! argv.parse(rc))
@@ -8083,6 +8143,55 @@ printChartsImageCmd(CQChartsCmdArgs &argv)
 
   //---
 
+  // explicit size renders without using view widget size
+  QSize size(argv.getParseInt("width", -1), argv.getParseInt("height", -1));
+
+  double dpi = argv.getParseReal("dpi", -1.0);
+
+  bool render = (argv.hasParseArg("width") || argv.hasParseArg("height") || dpi > 0.0);
+
+  //---
+
+  // render multiple views
+  if (argv.hasParseArg("views")) {
+    QStringList viewNames, filenames;
+
+    if (! CQTcl::splitList(argv.getParseStr("views"), viewNames))
+      return errorMsg("Invalid views list");
+
+    if (! CQTcl::splitList(argv.getParseStr("file"), filenames))
+      return errorMsg("Invalid file list");
+
+    if (viewNames.length() != filenames.length())
+      return errorMsg("Number of views and files must match");
+
+    CQChartsView::RenderDatas renderDatas;
+
+    for (int i = 0; i < viewNames.length(); ++i) {
+      CQChartsView::RenderData renderData;
+
+      renderData.view = charts_->getView(viewNames[i]);
+
+      if (! renderData.view)
+        return errorMsg("Invalid view '" + viewNames[i] + "'");
+
+      renderData.filename = filenames[i];
+      renderData.size     = size;
+      renderData.dpi      = dpi;
+
+      renderDatas.push_back(renderData);
+    }
+
+    int numThreads = argv.getParseInt("threads", -1);
+
+    if (! CQChartsView::renderFiles(renderDatas, numThreads))
+      return errorMsg("Failed to render files");
+
+    return true;
+  }
+
+  //---
+
   CQChartsView *view = nullptr;
   CQChartsPlot *plot = nullptr;
 
@@ -8114,9 +8223,17 @@ printChartsImageCmd(CQChartsCmdArgs &argv)
       if (! plot->printLayer(type, filename))
         return errorMsg("Failed to print layer");
     }
+    else if (render) {
+      if (! view->renderFile(filename, size, dpi, plot))
+        return errorMsg("Failed to render file");
+    }
     else
       view->printFile(filename, plot);
   }
+  else if (render) {
+    if (! view->renderFile(filename, size, dpi))
+      return errorMsg("Failed to render file");
+  }
   else
     view->printFile(filename);
 
@@ -8643,6 +8760,60 @@ testEditCmd(CQChartsCmdArgs &argv)
 
 //------
 
+bool
+CQChartsCmds::
+testDensityCmd(CQChartsCmdArgs &argv)
+{
+  auto errorMsg = [&](const QString &msg) {
+    charts_->errorMsg(msg);
+    return false;
+  };
+
+  //---
+
+  CQPerfTrace trace("CQChartsCmds::testDensityCmd");
+
+  argv.addCmdArg("-values"   , CQChartsCmdArg::Type::Reals  , "values").setRequired();
+  argv.addCmdArg("-threshold", CQChartsCmdArg::Type::Integer, "binned threshold");
+  argv.addCmdArg("-samples"  , CQChartsCmdArg::Type::Integer, "number of compare samples");
+  argv.addCmdArg("-tolerance", CQChartsCmdArg::Type::Real   , "max relative error");
+
+  bool rc;
+
+  if (! argv.parse(rc))
+    return rc;
+
+  //---
+
+  CQChartsReals values = argv.getParseReals("values");
+
+  int    threshold = argv.getParseInt ("threshold", 1);
+  int    samples   = argv.getParseInt ("samples"  , 1000);
+  double tolerance = argv.getParseReal("tolerance", 1E-2);
+
+  //---
+
+  // compare binned estimate against exact estimate
+  CQChartsDensity density;
+
+  density.setXVals(values.reals());
+
+  density.setBinnedThreshold(threshold);
+
+  if (! density.isBinned())
+    return errorMsg("Density is not binned");
+
+  double error = density.binnedError(samples);
+
+  if (error > tolerance)
+    return errorMsg(QString("Binned density error %1 exceeds tolerance %2").
+                     arg(error).arg(tolerance));
+
+  return cmdBase_->setCmdRc(error);
+}
+
+//------
+
 CQChartsPlot *
 CQChartsCmds::
 createPlot(CQChartsView *view, const ModelP &model, CQChartsPlotType *type, bool reuse)
@@ -9158,6 +9329,29 @@ sortModel(ModelP &model, int column, Qt::SortOrder order)
   return true;
 }
 
+bool
+CQChartsCmds::
+sortModel(ModelP &model, const std::vector<int> &columns, Qt::SortOrder order)
+{
+  if (columns.empty())
+    return false;
+
+  // multi column key sort (if supported)
+  auto *modelFilter = qobject_cast<CQChartsModelFilter *>(model.data());
+  auto *sortModel1  = qobject_cast<CQSortModel         *>(model.data());
+
+  if      (modelFilter)
+    modelFilter->sortColumns(columns, order);
+  else if (sortModel1)
+    sortModel1->sortColumns(columns, order);
+  else if (columns.size() == 1)
+    model->sort(columns[0], order);
+  else
+    return false;
+
+  return true;
+}
+
 //------
 
 CQChartsModelData *
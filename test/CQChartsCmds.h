@@ -74,6 +74,7 @@ class CQChartsCmds : public QObject {
 
   bool sortModel(ModelP &model, const QString &args);
   bool sortModel(ModelP &model, int column, Qt::SortOrder order);
+  bool sortModel(ModelP &model, const std::vector<int> &columns, Qt::SortOrder order);
 
   //---
 
@@ -178,7 +179,8 @@ class CQChartsCmds : public QObject {
   bool showChartsTextDlgCmd        (CQChartsCmdArgs &args);
   bool showChartsHelpDlgCmd        (CQChartsCmdArgs &args);
 
-  bool testEditCmd(CQChartsCmdArgs &args);
+  bool testEditCmd   (CQChartsCmdArgs &args);
+  bool testDensityCmd(CQChartsCmdArgs &args);
 
   //---
 
@@ -325,7 +327,8 @@ CQCHARTS_DEF_CMD(ShowChartsHelpDlg        , showChartsHelpDlgCmd)
 
 //---
 
-CQCHARTS_DEF_CMD(TestEdit, testEditCmd)
+CQCHARTS_DEF_CMD(TestEdit   , testEditCmd)
+CQCHARTS_DEF_CMD(TestDensity, testDensityCmd)
 
 //---
 
@@ -0,0 +1,224 @@
+// Benchmark of plot object lookup trees (R-tree against quad tree)
+//
+// Build (header only trees, no Qt):
+//   qmake CQChartsTreeBench.pro; make
+// or
+//   g++ -O2 -std=c++14 -I../include CQChartsTreeBench.cpp -o CQChartsTreeBench -lpthread
+//
+// Usage:
+//   CQChartsTreeBench [-n <num_items>] [-q <num_queries>] [-size <max_item_size>] [-seed <seed>]
+//
+// Items are random rects in a 1000x1000 area (points when size is 0). Prints build time and
+// total time and number of results for point, touching rect and inside rect queries.
+
+#include <CQChartsRTree.h>
+#include <CQChartsQuadTree.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+
+namespace {
+
+class Rect {
+ public:
+  Rect() { }
+
+  Rect(double xmin, double ymin, double xmax, double ymax) :
+   xmin_(xmin), ymin_(ymin), xmax_(xmax), ymax_(ymax), set_(true) {
+  }
+
+  bool isSet() const { return set_; }
+
+  double getXMin() const { return xmin_; }
+  double getYMin() const { return ymin_; }
+  double getXMax() const { return xmax_; }
+  double getYMax() const { return ymax_; }
+
+ private:
+  double xmin_ { 0.0 };
+  double ymin_ { 0.0 };
+  double xmax_ { 0.0 };
+  double ymax_ { 0.0 };
+  bool   set_  { false };
+};
+
+class Item {
+ public:
+  Item(const Rect &rect) :
+   rect_(rect) {
+  }
+
+  const Rect &rect() const { return rect_; }
+
+ private:
+  Rect rect_;
+};
+
+using RTree    = CQChartsRTree<Item,Rect>;
+using QuadTree = CQChartsQuadTree<Item,Rect>;
+
+using Clock = std::chrono::steady_clock;
+
+double elapsedMs(const Clock::time_point &t) {
+  return std::chrono::duration<double,std::milli>(Clock::now() - t).count();
+}
+
+struct Queries {
+  std::vector<double> px, py;
+  std::vector<Rect>   rects;
+};
+
+template<typename TREE>
+void runQueries(const char *name, const TREE &tree, const Queries &queries, double buildMs) {
+  typename TREE::DataList dataList;
+
+  int nq = int(queries.px.size());
+
+  // point queries
+  auto t = Clock::now();
+
+  long numPoint = 0;
+
+  for (int i = 0; i < nq; ++i) {
+    tree.dataAtPoint(queries.px[i], queries.py[i], dataList);
+
+    numPoint += long(dataList.size());
+  }
+
+  double pointMs = elapsedMs(t);
+
+  // touching rect queries
+  t = Clock::now();
+
+  long numTouch = 0;
+
+  for (int i = 0; i < nq; ++i) {
+    tree.dataTouchingRect(queries.rects[i], dataList);
+
+    numTouch += long(dataList.size());
+  }
+
+  double touchMs = elapsedMs(t);
+
+  // inside rect queries
+  t = Clock::now();
+
+  long numInside = 0;
+
+  for (int i = 0; i < nq; ++i) {
+    tree.dataInsideRect(queries.rects[i], dataList);
+
+    numInside += long(dataList.size());
+  }
+
+  double insideMs = elapsedMs(t);
+
+  printf("%-9s %10.2f %10.2f %10ld %10.2f %10ld %10.2f %10ld\n", name, buildMs,
+         pointMs, numPoint, touchMs, numTouch, insideMs, numInside);
+}
+
+}
+
+int
+main(int argc, char **argv)
+{
+  int    n    = 100000;
+  int    nq   = 10000;
+  double size = 5.0;
+  int    seed = 1;
+
+  for (int i = 1; i < argc; ++i) {
+    if      (strcmp(argv[i], "-n"   ) == 0 && i < argc - 1) n    = atoi(argv[++i]);
+    else if (strcmp(argv[i], "-q"   ) == 0 && i < argc - 1) nq   = atoi(argv[++i]);
+    else if (strcmp(argv[i], "-size") == 0 && i < argc - 1) size = atof(argv[++i]);
+    else if (strcmp(argv[i], "-seed") == 0 && i < argc - 1) seed = atoi(argv[++i]);
+    else {
+      fprintf(stderr, "Usage: %s [-n <num_items>] [-q <num_queries>] "
+              "[-size <max_item_size>] [-seed <seed>]\n", argv[0]);
+      exit(1);
+    }
+  }
+
+  //---
+
+  // create items and queries
+  std::mt19937 rand(seed);
+
+  std::uniform_real_distribution<double> pos(0.0, 1000.0);
+  std::uniform_real_distribution<double> dim(0.0, size);
+  std::uniform_real_distribution<double> qdim(0.0, 50.0);
+
+  std::vector<Item> items;
+
+  items.reserve(n);
+
+  for (int i = 0; i < n; ++i) {
+    double x = pos(rand), y = pos(rand);
+
+    items.emplace_back(Rect(x, y, x + dim(rand), y + dim(rand)));
+  }
+
+  Queries queries;
+
+  for (int i = 0; i < nq; ++i) {
+    queries.px.push_back(pos(rand));
+    queries.py.push_back(pos(rand));
+
+    double x = pos(rand), y = pos(rand);
+
+    queries.rects.emplace_back(x, y, x + qdim(rand), y + qdim(rand));
+  }
+
+  RTree::Datas datas;
+
+  for (auto &item : items)
+    datas.push_back(&item);
+
+  //---
+
+  printf("items %d, queries %d, max item size %g\n\n", n, nq, size);
+
+  printf("%-9s %10s %10s %10s %10s %10s %10s %10s\n", "tree", "build ms",
+         "point ms", "found", "touch ms", "found", "inside ms", "found");
+
+  // R-tree (bulk load)
+  {
+    auto t = Clock::now();
+
+    RTree tree;
+
+    tree.build(datas);
+
+    runQueries("rtree", tree, queries, elapsedMs(t));
+  }
+
+  // R-tree (bulk load, single thread)
+  {
+    auto t = Clock::now();
+
+    RTree tree;
+
+    tree.setNumThreads(1);
+
+    tree.build(datas);
+
+    runQueries("rtree(1)", tree, queries, elapsedMs(t));
+  }
+
+  // quad tree (incremental add)
+  {
+    auto t = Clock::now();
+
+    QuadTree tree(Rect(0.0, 0.0, 1000.0, 1000.0));
+
+    for (auto &item : items)
+      tree.add(&item);
+
+    runQueries("quadtree", tree, queries, elapsedMs(t));
+  }
+
+  return 0;
+}
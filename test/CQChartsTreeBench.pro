@@ -0,0 +1,22 @@
+TEMPLATE = app
+
+TARGET = CQChartsTreeBench
+
+CONFIG -= qt
+CONFIG += console
+
+QMAKE_CXXFLAGS += \
+-std=c++14 \
+
+SOURCES += \
+CQChartsTreeBench.cpp \
+
+DESTDIR     = ../bin
+OBJECTS_DIR = ../obj
+
+INCLUDEPATH += \
+. \
+../include \
+
+unix:LIBS += \
+-lpthread